@@ -42,9 +42,15 @@ enum class Request { Dynamics = 1, Cost = 2, Constraint = 4, SoftConstraint = 8,
  */
 class RequestSet {
  public:
+  /** Constructor of an empty set */
+  constexpr RequestSet() : flags_(static_cast<Request>(0)) {}
+
   /** Constructor, implicit conversion allowed */
   constexpr RequestSet(Request computationFlag) : flags_(computationFlag) {}  // NOLINT(google-explicit-constructor)
 
+  /** Check if this Request set is empty */
+  constexpr bool empty() const;
+
   /** Check if this Request set contains item */
   constexpr bool contains(Request item) const;
 
@@ -85,6 +91,10 @@ constexpr RequestSet operator+(Request a, Request b) {
   return a | b;
 }
 
+constexpr bool RequestSet::empty() const {
+  return isUnionEmpty(flags_, flags_);
+}
+
 constexpr bool RequestSet::contains(Request item) const {
   return !isUnionEmpty(flags_, item);
 }
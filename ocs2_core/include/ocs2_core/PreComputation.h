@@ -44,6 +44,11 @@ namespace ocs2 {
  * dynamics, cost and constraint terms, which can make use of the shared pre-computation.
  *
  * If pre-computation is not used, a default constructed PreComputation() can be passed to the getters.
+ *
+ * Derived classes whose pre-computation is a pure function of the request arguments can skip repeated work through
+ * updateRequestCache(). It fingerprints the callback type, (t, x, u), and the request set of the last call and returns
+ * only the part of the request that has not been computed yet at that point. The cache holds a single point, since the
+ * pre-computed quantities are overwritten by every call with a different point.
  */
 class PreComputation {
  public:
@@ -65,9 +70,61 @@ class PreComputation {
   /** Request callback at final time */
   virtual void requestFinal(RequestSet request, scalar_t t, const vector_t& x) {}
 
+  /** Drops the cached point such that the next request is fully computed, e.g. when data outside (t, x, u) has changed. */
+  void invalidateRequestCache() { cachedPoint_ = CallbackType::None; }
+
+  /** Number of requests which were entirely served from the cache. */
+  size_t getNumCacheHits() const { return numCacheHits_; }
+
+  /** Number of requests which required (partial) computation. */
+  size_t getNumCacheMisses() const { return numCacheMisses_; }
+
+  /** Resets the cache hit and miss counters. */
+  void resetCacheCounters() {
+    numCacheHits_ = 0;
+    numCacheMisses_ = 0;
+  }
+
  protected:
   /** Copy constructor */
   PreComputation(const PreComputation& other) = default;
+
+  /** The request callback types */
+  enum class CallbackType { None, Intermediate, PreJump, Final };
+
+  /** The outcome of updateRequestCache */
+  struct CachedRequest {
+    //! The part of the request to be computed now. It is empty if everything has been computed before (a cache hit).
+    RequestSet missing;
+    //! Everything which had been computed at the same point before this call.
+    RequestSet computed;
+  };
+
+  /**
+   * Looks up the request in the single point cache and marks it as computed. If the callback type, t, x, and u match the
+   * previous call, only the difference to what has been computed so far is returned as missing. The computation levels are
+   * tracked per item, i.e., a Request::Cost after a Request::Cost + Request::Approximation is a hit while the opposite
+   * order only misses the approximation. Otherwise the full request is missing.
+   *
+   * @param [in] type: The callback type.
+   * @param [in] request: The requested computation items.
+   * @param [in] t: The time.
+   * @param [in] x: The state.
+   * @param [in] u: The input. Empty for the pre-jump and final callbacks.
+   * @return The missing and the already computed items.
+   */
+  CachedRequest updateRequestCache(CallbackType type, RequestSet request, scalar_t t, const vector_t& x, const vector_t& u = vector_t());
+
+ private:
+  CallbackType cachedPoint_ = CallbackType::None;
+  scalar_t cachedTime_ = 0.0;
+  vector_t cachedState_;
+  vector_t cachedInput_;
+  RequestSet computedValues_;
+  RequestSet computedApproximations_;
+
+  size_t numCacheHits_ = 0;
+  size_t numCacheMisses_ = 0;
 };
 
 /** Helper to cast to const reference of derived class. */
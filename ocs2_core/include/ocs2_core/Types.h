@@ -338,4 +338,54 @@ struct VectorFunctionQuadraticApproximation {
 
 std::ostream& operator<<(std::ostream& out, const VectorFunctionQuadraticApproximation& f);
 
+/**
+ * Sparsity descriptor of a linear or quadratic approximation. A sparse approximation only stores the compact blocks w.r.t. the
+ * listed state and input coordinates, i.e. dfdx has stateIndices.size() columns and dfdu has inputIndices.size() columns. The
+ * derivatives w.r.t. all other coordinates are zero. The dense fill-in is deferred to the point where the compact approximation
+ * is added to a full-size one.
+ */
+struct ApproximationSparsity {
+  /** If true, the approximation is dense and the index lists are ignored */
+  bool isDense = true;
+  /** State coordinates on which the function depends (in increasing order) */
+  size_array_t stateIndices;
+  /** Input coordinates on which the function depends (in increasing order) */
+  size_array_t inputIndices;
+
+  /** Sets the descriptor to dense */
+  ApproximationSparsity& setDense();
+
+  /** Sets the descriptor to the given coordinates */
+  ApproximationSparsity& setSparse(size_array_t stateIndicesArg, size_array_t inputIndicesArg);
+
+  /**
+   * Factory function for the descriptor of a function which depends on the given coordinates.
+   * @param[in] stateIndices: State coordinates on which the function depends.
+   * @param[in] inputIndices: Input coordinates on which the function depends.
+   */
+  static ApproximationSparsity Sparse(size_array_t stateIndices, size_array_t inputIndices);
+};
+
+/**
+ * Adds a compact quadratic approximation to the full-size one at the coordinates given by the sparsity descriptor.
+ *
+ * @param[in] compact: The compact approximation.
+ * @param[in] sparsity: The sparsity descriptor of the compact approximation.
+ * @param[in, out] accumulator: The full-size approximation.
+ */
+void accumulateSparseApproximation(const ScalarFunctionQuadraticApproximation& compact, const ApproximationSparsity& sparsity,
+                                   ScalarFunctionQuadraticApproximation& accumulator);
+
+/**
+ * Writes a compact linear approximation into the rows [rowOffset, rowOffset + compact.f.rows()) of the full-size one. The
+ * columns which are not listed in the sparsity descriptor are set to zero.
+ *
+ * @param[in] compact: The compact approximation.
+ * @param[in] sparsity: The sparsity descriptor of the compact approximation.
+ * @param[in] rowOffset: The first row of the full-size approximation to be written.
+ * @param[in, out] approximation: The full-size approximation.
+ */
+void assignSparseApproximation(const VectorFunctionLinearApproximation& compact, const ApproximationSparsity& sparsity, size_t rowOffset,
+                               VectorFunctionLinearApproximation& approximation);
+
 }  // namespace ocs2
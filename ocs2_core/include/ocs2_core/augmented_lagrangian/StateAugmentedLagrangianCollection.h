@@ -62,6 +62,13 @@ class StateAugmentedLagrangianCollection : public Collection<StateAugmentedLagra
                                                                          const std::vector<Multiplier>& termsMultiplier,
                                                                          const PreComputation& preComp) const;
 
+  /**
+   * Add the sum of state Lagrangian penalties quadratic approximation to the state blocks of the accumulator. The accumulator may
+   * also contain input blocks, which are left unchanged.
+   */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const std::vector<Multiplier>& termsMultiplier,
+                                                const PreComputation& preComp, ScalarFunctionQuadraticApproximation& accumulator) const;
+
   /** Update Lagrange/penalty multipliers, and the penalty value for each active term. */
   virtual void updateLagrangian(scalar_t time, const vector_t& state, std::vector<LagrangianMetrics>& termsMetrics,
                                 std::vector<Multiplier>& termsMultiplier) const;
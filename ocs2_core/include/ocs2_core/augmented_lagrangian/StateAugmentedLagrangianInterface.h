@@ -58,6 +58,18 @@ class StateAugmentedLagrangianInterface {
   virtual ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const Multiplier& multiplier,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Adds the constraint's penalty quadratic approximation to the state blocks of the accumulator. The accumulator may also contain
+   * input blocks, which are left unchanged. The default implementation forwards to getQuadraticApproximation().
+   */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const Multiplier& multiplier,
+                                                const PreComputation& preComp, ScalarFunctionQuadraticApproximation& accumulator) const {
+    const auto penalty = getQuadraticApproximation(time, state, multiplier, preComp);
+    accumulator.f += penalty.f;
+    accumulator.dfdx += penalty.dfdx;
+    accumulator.dfdxx += penalty.dfdxx;
+  }
+
   /** Update Lagrange/penalty multipliers and the penalty function value. */
   virtual std::pair<Multiplier, scalar_t> updateLagrangian(scalar_t time, const vector_t& state, const vector_t& constraint,
                                                            const Multiplier& multiplier) const = 0;
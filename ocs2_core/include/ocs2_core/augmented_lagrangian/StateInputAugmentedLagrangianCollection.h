@@ -62,6 +62,14 @@ class StateInputAugmentedLagrangianCollection : public Collection<StateInputAugm
                                                                          const std::vector<Multiplier>& termsMultiplier,
                                                                          const PreComputation& preComp) const;
 
+  /**
+   * Add the sum of state-input Lagrangian penalties quadratic approximation to the accumulator, which should be of size
+   * (state.rows(), input.rows()).
+   */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                const std::vector<Multiplier>& termsMultiplier, const PreComputation& preComp,
+                                                ScalarFunctionQuadraticApproximation& accumulator) const;
+
   /** Update Lagrange/penalty multipliers and the penalty value for each active term. */
   virtual void updateLagrangian(scalar_t time, const vector_t& state, const vector_t& input, std::vector<LagrangianMetrics>& termsMetrics,
                                 std::vector<Multiplier>& termsMultiplier) const;
@@ -59,6 +59,15 @@ class StateInputAugmentedLagrangianInterface {
                                                                          const Multiplier& lagrangian,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Adds the constraint's penalty quadratic approximation to the accumulator, which should be of size (state.rows(), input.rows()).
+   * The default implementation forwards to getQuadraticApproximation().
+   */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input, const Multiplier& lagrangian,
+                                                const PreComputation& preComp, ScalarFunctionQuadraticApproximation& accumulator) const {
+    accumulator += getQuadraticApproximation(time, state, input, lagrangian, preComp);
+  }
+
   /** Update Lagrange/penalty multipliers and the penalty function value. */
   virtual std::pair<Multiplier, scalar_t> updateLagrangian(scalar_t time, const vector_t& state, const vector_t& input,
                                                            const vector_t& constraint, const Multiplier& lagrangian) const = 0;
@@ -58,10 +58,24 @@ class LinearStateInputConstraint : public StateInputConstraint {
   VectorFunctionLinearApproximation getLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
                                                            const PreComputation& /* preComputation */) const final;
 
+  /**
+   * Returns the columns of C and D which have non-zero entries. Falls back to dense if more than half of the columns are used.
+   * The non-zero pattern is determined at construction, see updateSparsity().
+   */
+  VectorFunctionLinearApproximation getSparseLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
+                                                                 const PreComputation& /* preComputation */,
+                                                                 ApproximationSparsity& sparsity) const final;
+
+  /** Updates the cached non-zero pattern. It should be called if C_ or D_ are modified after construction. */
+  void updateSparsity();
+
  public:
   vector_t e_; /**< State input constraint */
   matrix_t C_; /**< State input constraint derivative wrt. state */
   matrix_t D_; /**< State input constraint derivative wrt. input */
+
+ private:
+  ApproximationSparsity sparsity_;
 };
 
 }  // namespace ocs2
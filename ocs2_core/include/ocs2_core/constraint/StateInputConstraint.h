@@ -66,6 +66,20 @@ class StateInputConstraint {
     }
   }
 
+  /**
+   * Get the constraint linear approximation in compact form. Constraints which only depend on a few coordinates can override
+   * this method to return the derivatives w.r.t. those coordinates only, see ApproximationSparsity. The default implementation
+   * returns the dense linear approximation.
+   *
+   * @param [out] sparsity: The sparsity descriptor of the returned approximation.
+   */
+  virtual VectorFunctionLinearApproximation getSparseLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                         const PreComputation& preComp,
+                                                                         ApproximationSparsity& sparsity) const {
+    sparsity.setDense();
+    return getLinearApproximation(time, state, input, preComp);
+  }
+
   /** Get the constraint quadratic approximation */
   virtual VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                          const PreComputation& preComp) const {
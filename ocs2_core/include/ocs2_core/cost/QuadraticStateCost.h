@@ -53,6 +53,10 @@ class QuadraticStateCost : public StateCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation&) const final;
 
+  /** Add cost term quadratic approximation to the state blocks of the accumulator */
+  void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                        const PreComputation&, ScalarFunctionQuadraticApproximation& accumulator) const final;
+
  protected:
   QuadraticStateCost(const QuadraticStateCost& rhs) = default;
 
@@ -56,6 +56,19 @@ class StateCost {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Adds the cost term quadratic approximation to the state blocks of the accumulator. The accumulator may also contain input blocks,
+   * which are left unchanged. The default implementation forwards to getQuadraticApproximation(). Override it to add only the
+   * nonzero blocks in place.
+   */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                                const PreComputation& preComp, ScalarFunctionQuadraticApproximation& accumulator) const {
+    const auto cost = getQuadraticApproximation(time, state, targetTrajectories, preComp);
+    accumulator.f += cost.f;
+    accumulator.dfdx += cost.dfdx;
+    accumulator.dfdxx += cost.dfdxx;
+  }
+
  protected:
   StateCost(const StateCost& rhs) = default;
 };
@@ -59,6 +59,13 @@ class StateCostCollection : public Collection<StateCost> {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const;
 
+  /**
+   * Add the state-only cost quadratic approximation to the state blocks of the accumulator. The accumulator may also contain
+   * input blocks, which are left unchanged.
+   */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                                const PreComputation& preComp, ScalarFunctionQuadraticApproximation& accumulator) const;
+
  protected:
   /** Copy constructor */
   StateCostCollection(const StateCostCollection& other);
@@ -56,6 +56,16 @@ class StateInputCost {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Adds the cost term quadratic approximation to the accumulator, which should be of size (state.rows(), input.rows()).
+   * The default implementation forwards to getQuadraticApproximation(). Override it to add only the nonzero blocks in place.
+   */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                                ScalarFunctionQuadraticApproximation& accumulator) const {
+    accumulator += getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+  }
+
  protected:
   StateInputCost(const StateInputCost& rhs) = default;
 };
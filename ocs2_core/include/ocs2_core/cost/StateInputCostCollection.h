@@ -59,6 +59,14 @@ class StateInputCostCollection : public Collection<StateInputCost> {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const;
 
+  /**
+   * Add the state-input cost quadratic approximation to the accumulator, which should be of size (state.rows(), input.rows()).
+   * Each active term adds its approximation in place, see StateInputCost::accumulateQuadraticApproximation.
+   */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                                ScalarFunctionQuadraticApproximation& accumulator) const;
+
  protected:
   /** Copy constructor */
   StateInputCostCollection(const StateInputCostCollection& other);
@@ -55,6 +55,14 @@ class LoopshapingStateAugmentedLagrangian final : public StateAugmentedLagrangia
                                                                  const std::vector<Multiplier>& termsMultiplier,
                                                                  const PreComputation& preComp) const override;
 
+  void accumulateQuadraticApproximation(scalar_t t, const vector_t& x, const std::vector<Multiplier>& termsMultiplier,
+                                        const PreComputation& preComp, ScalarFunctionQuadraticApproximation& accumulator) const override {
+    const auto penalty = getQuadraticApproximation(t, x, termsMultiplier, preComp);
+    accumulator.f += penalty.f;
+    accumulator.dfdx += penalty.dfdx;
+    accumulator.dfdxx += penalty.dfdxx;
+  }
+
   void updateLagrangian(scalar_t t, const vector_t& x, std::vector<LagrangianMetrics>& termsMetrics,
                         std::vector<Multiplier>& termsMultiplier) const override;
 
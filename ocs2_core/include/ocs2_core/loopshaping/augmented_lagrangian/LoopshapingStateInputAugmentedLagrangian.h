@@ -49,6 +49,12 @@ class LoopshapingStateInputAugmentedLagrangian : public StateInputAugmentedLagra
   void updateLagrangian(scalar_t t, const vector_t& x, const vector_t& u, std::vector<LagrangianMetrics>& termsMetrics,
                         std::vector<Multiplier>& termsMultiplier) const final override;
 
+  /** Adds the loopshaping quadratic approximation of getQuadraticApproximation() to the accumulator */
+  void accumulateQuadraticApproximation(scalar_t t, const vector_t& x, const vector_t& u, const std::vector<Multiplier>& termsMultiplier,
+                                        const PreComputation& preComp, ScalarFunctionQuadraticApproximation& accumulator) const final {
+    accumulator += getQuadraticApproximation(t, x, u, termsMultiplier, preComp);
+  }
+
  protected:
   /** Constructor */
   LoopshapingStateInputAugmentedLagrangian(const StateInputAugmentedLagrangianCollection& lagrangianCollection,
@@ -56,6 +56,14 @@ class LoopshapingStateCost final : public StateCostCollection {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation& preComp) const override;
 
+  void accumulateQuadraticApproximation(scalar_t t, const vector_t& x, const TargetTrajectories& targetTrajectories,
+                                        const PreComputation& preComp, ScalarFunctionQuadraticApproximation& accumulator) const override {
+    const auto cost = getQuadraticApproximation(t, x, targetTrajectories, preComp);
+    accumulator.f += cost.f;
+    accumulator.dfdx += cost.dfdx;
+    accumulator.dfdxx += cost.dfdxx;
+  }
+
  private:
   LoopshapingStateCost(const LoopshapingStateCost& other) = default;
 
@@ -47,6 +47,12 @@ class LoopshapingStateInputSoftConstraint : public StateInputCostCollection {
   scalar_t getValue(scalar_t t, const vector_t& x, const vector_t& u, const TargetTrajectories& targetTrajectories,
                     const PreComputation& preComp) const final;
 
+  /** Adds the loopshaping quadratic approximation of getQuadraticApproximation() to the accumulator */
+  void accumulateQuadraticApproximation(scalar_t t, const vector_t& x, const vector_t& u, const TargetTrajectories& targetTrajectories,
+                                        const PreComputation& preComp, ScalarFunctionQuadraticApproximation& accumulator) const final {
+    accumulator += getQuadraticApproximation(t, x, u, targetTrajectories, preComp);
+  }
+
  protected:
   /** Constructor */
   LoopshapingStateInputSoftConstraint(const StateInputCostCollection& systemCost,
@@ -0,0 +1,71 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+/**
+ * Installs heap allocation hooks for ocs2::allocation_counter. Include this header in exactly ONE translation unit of an
+ * executable (e.g. a benchmark or a test). The hooks wrap the glibc allocator, which covers both operator new and Eigen's
+ * aligned allocations. On other C libraries the header has no effect.
+ */
+
+#include <cstddef>
+#include <cstdlib>
+
+#include "ocs2_core/misc/AllocationCounter.h"
+
+#if defined(__GLIBC__)
+
+extern "C" {
+void* __libc_malloc(size_t size) noexcept;
+void* __libc_calloc(size_t num, size_t size) noexcept;
+void* __libc_realloc(void* ptr, size_t size) noexcept;
+
+void* malloc(size_t size) noexcept {
+  ocs2::allocation_counter::increment();
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t num, size_t size) noexcept {
+  ocs2::allocation_counter::increment();
+  return __libc_calloc(num, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+  ocs2::allocation_counter::increment();
+  return __libc_realloc(ptr, size);
+}
+}  // extern "C"
+
+namespace {
+const bool ocs2AllocationCounterEnabled = (ocs2::allocation_counter::enable(), true);
+}  // unnamed namespace
+
+#endif
@@ -43,9 +43,6 @@ void makePsdEigenvalue(matrix_t& squareMatrix, scalar_t minEigenvalue);
 
 void makePsdCholesky(matrix_t& A, scalar_t minEigenvalue);
 
-void computeConstraintProjection(const matrix_t& Dm, const matrix_t& RmInvUmUmT, matrix_t& DmDagger, matrix_t& DmDaggerTRmDmDaggerUUT,
-                                 matrix_t& RmInvConstrainedUUT);
-
 /**
  *  Set the eigenvalues of a triangular matrix to a minimum magnitude (maintaining the sign).
  */
@@ -154,11 +151,8 @@ void computeInverseMatrixUUT(const Derived& Am, Derived& AmInvUmUmT) {
  * @param [out] RmInvConstrainedUUT: The VVT decomposition of (I-DmDagger*Dm) * inv(Rm) * (I-DmDagger*Dm)^T where V is of
  * the dimension n_u*(n_u-n_c) with n_u = Rm.rows() and n_c = Dm.rows().
  */
-template <typename DerivedInputMatrix>
-void computeConstraintProjection(const matrix_t& Dm, const DerivedInputMatrix& RmInvUmUmT, matrix_t& DmDagger,
-                                 matrix_t& DmDaggerTRmDmDaggerUUT, matrix_t& RmInvConstrainedUUT) {
-  computeConstraintProjection(Dm, matrix_t(RmInvUmUmT), DmDagger, DmDaggerTRmDmDaggerUUT, RmInvConstrainedUUT);
-}
+void computeConstraintProjection(const Eigen::Ref<const matrix_t>& Dm, const Eigen::Ref<const matrix_t>& RmInvUmUmT, matrix_t& DmDagger,
+                                 matrix_t& DmDaggerTRmDmDaggerUUT, matrix_t& RmInvConstrainedUUT);
 
 /** Computes the rank of a matrix */
 template <typename Derived>
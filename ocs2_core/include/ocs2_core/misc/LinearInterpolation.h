@@ -53,6 +53,27 @@ using remove_cvref_t = typename std::remove_cv<typename std::remove_reference<T>
  */
 index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray);
 
+/**
+ * Batch version of timeSegment for a sorted (non-decreasing) array of enquiry times. Instead of a binary search per
+ * query, the time array is swept once together with the enquiry times, so the total cost is O(N + M). The result is
+ * identical to calling timeSegment for each enquiry time.
+ *
+ * @param [in] enquiryTimes: The sorted enquiry times for interpolation.
+ * @param [in] timeArray: interpolation time array.
+ * @param [out] indexAlphaArray: {index, alpha} for each enquiry time. It is resized to the size of enquiryTimes.
+ */
+void timeSegments(const std::vector<scalar_t>& enquiryTimes, const std::vector<scalar_t>& timeArray,
+                  std::vector<index_alpha_t>& indexAlphaArray);
+
+/**
+ * Batch version of timeSegment for a sorted (non-decreasing) array of enquiry times.
+ *
+ * @param [in] enquiryTimes: The sorted enquiry times for interpolation.
+ * @param [in] timeArray: interpolation time array.
+ * @return {index, alpha} for each enquiry time.
+ */
+std::vector<index_alpha_t> timeSegments(const std::vector<scalar_t>& enquiryTimes, const std::vector<scalar_t>& timeArray);
+
 /**
  * Directly uses the index and interpolation coefficient provided by the user
  * @note If sizes in data array are not equal, the interpolation will snap to the data
@@ -139,6 +160,52 @@ template <typename Data, class Alloc, class AccessFun>
 auto interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, const std::vector<Data, Alloc>& dataArray,
                  AccessFun accessFun) -> remove_cvref_t<typename std::result_of<AccessFun(const std::vector<Data, Alloc>&, size_t)>::type>;
 
+/**
+ * Batch interpolation for the given array of index and interpolation coefficient pairs (see timeSegments). The results
+ * are written into the preallocated output such that the memory of its elements is reused when their sizes match.
+ *
+ * @param [in] indexAlphaArray : index and interpolation coefficient (alpha) pairs
+ * @param [in] dataArray: vector of data
+ * @param [in] accessFun: Method to access the subfield of Data in array (see interpolate).
+ * @param [out] output: The interpolation results. Any container with resize() and operator[], e.g. std::vector or
+ *                      TrajectoryMatrix. It is resized to the size of indexAlphaArray.
+ *
+ * @tparam Data: Data type
+ * @tparam Alloc: Specialized allocation class
+ */
+template <typename Data, class Alloc, class AccessFun, class Output>
+void interpolateBatch(const std::vector<index_alpha_t>& indexAlphaArray, const std::vector<Data, Alloc>& dataArray, AccessFun accessFun,
+                      Output& output);
+
+/**
+ * Batch interpolation for the given array of index and interpolation coefficient pairs (see timeSegments).
+ *
+ * @param [in] indexAlphaArray : index and interpolation coefficient (alpha) pairs
+ * @param [in] dataArray: vector of data
+ * @param [out] output: The interpolation results. It is resized to the size of indexAlphaArray.
+ *
+ * @tparam Data: Data type
+ * @tparam Alloc: Specialized allocation class
+ */
+template <typename Data, class Alloc, class Output>
+void interpolateBatch(const std::vector<index_alpha_t>& indexAlphaArray, const std::vector<Data, Alloc>& dataArray, Output& output);
+
+/**
+ * Batch linear interpolation at a sorted (non-decreasing) array of enquiry times. The result is identical to calling
+ * interpolate for each enquiry time, while the total lookup cost is O(N + M).
+ *
+ * @param [in] enquiryTimes: The sorted enquiry times for interpolation.
+ * @param [in] timeArray: Times vector
+ * @param [in] dataArray: Data vector
+ * @param [out] output: The interpolation results. It is resized to the size of enquiryTimes.
+ *
+ * @tparam Data: Data type
+ * @tparam Alloc: Specialized allocation class
+ */
+template <typename Data, class Alloc, class Output>
+void interpolateBatch(const std::vector<scalar_t>& enquiryTimes, const std::vector<scalar_t>& timeArray,
+                      const std::vector<Data, Alloc>& dataArray, Output& output);
+
 }  // namespace LinearInterpolation
 }  // namespace ocs2
 
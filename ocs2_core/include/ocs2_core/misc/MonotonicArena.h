@@ -0,0 +1,174 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * A monotonic arena for short-lived solver temporaries. Allocation bumps a pointer in the current memory block and deallocation
+ * is a no-op; the memory is released all at once by reset() or by rewinding to a previously taken marker (see Scope). When a
+ * request does not fit in the current block, a new block is allocated. reset() coalesces all blocks into a single one of the
+ * total capacity, hence after a warm-up iteration a steady-state workload is served without any heap allocation.
+ *
+ * The arena is not thread-safe. Use getThreadLocalArena() to get an arena for the calling thread.
+ */
+class MonotonicArena {
+ public:
+  /** Default alignment of the allocations, compatible with aligned Eigen maps. */
+  static constexpr size_t defaultAlignment = EIGEN_MAX_ALIGN_BYTES > 16 ? EIGEN_MAX_ALIGN_BYTES : 16;
+
+  /** Marker to a position in the arena */
+  struct Marker {
+    size_t blockIndex;
+    size_t offset;
+  };
+
+  /** Rewinds the arena to its current position on destruction. */
+  class Scope {
+   public:
+    explicit Scope(MonotonicArena& arena) : arena_(arena), marker_(arena.mark()) {}
+    ~Scope() { arena_.rewind(marker_); }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    MonotonicArena& arena_;
+    const Marker marker_;
+  };
+
+  /**
+   * Constructor.
+   * @param [in] initialCapacity: The size of the first block in bytes. No memory is allocated if zero.
+   */
+  explicit MonotonicArena(size_t initialCapacity = 0);
+
+  /** Destructor, releases all blocks. */
+  ~MonotonicArena();
+
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+  /**
+   * Allocates memory from the arena.
+   * @param [in] numBytes: The number of bytes.
+   * @param [in] alignment: The alignment of the returned pointer. Must be a power of two.
+   */
+  void* allocate(size_t numBytes, size_t alignment = defaultAlignment);
+
+  /** Allocates an uninitialized array of n objects of type T. */
+  template <typename T>
+  T* allocate(size_t n) {
+    return static_cast<T*>(allocate(n * sizeof(T), alignof(T) > defaultAlignment ? alignof(T) : defaultAlignment));
+  }
+
+  /** Returns an uninitialized rows x cols matrix workspace backed by the arena. */
+  Eigen::Map<matrix_t, Eigen::AlignedMax> matrix(Eigen::Index rows, Eigen::Index cols) {
+    return Eigen::Map<matrix_t, Eigen::AlignedMax>(allocate<scalar_t>(rows * cols), rows, cols);
+  }
+
+  /** Returns an uninitialized vector workspace backed by the arena. */
+  Eigen::Map<vector_t, Eigen::AlignedMax> vector(Eigen::Index rows) {
+    return Eigen::Map<vector_t, Eigen::AlignedMax>(allocate<scalar_t>(rows), rows);
+  }
+
+  /** Returns a marker to the current position. */
+  Marker mark() const { return {currentBlock_, offset_}; }
+
+  /** Releases all allocations made after the marker was taken. */
+  void rewind(const Marker& marker);
+
+  /** Releases all allocations. If more than one block was in use, the blocks are coalesced into one. */
+  void reset();
+
+  /** Returns the total size of the blocks in bytes. */
+  size_t getCapacity() const;
+
+  /** Returns the number of bytes handed out since the last reset, including alignment padding. */
+  size_t getBytesInUse() const;
+
+  /** Returns the number of heap allocations made by the arena since construction. */
+  size_t getNumBlockAllocations() const { return numBlockAllocations_; }
+
+ private:
+  struct Block {
+    char* data;
+    size_t size;
+  };
+
+  void addBlock(size_t minSize);
+
+  std::vector<Block> blocks_;
+  size_t currentBlock_ = 0;
+  size_t offset_ = 0;
+  size_t numBlockAllocations_ = 0;
+};
+
+/**
+ * Standard allocator drawing from a MonotonicArena, e.g. for std::vector of temporaries. Deallocation is a no-op.
+ */
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit ArenaAllocator(MonotonicArena& arena) noexcept : arenaPtr_(&arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arenaPtr_(other.arenaPtr_) {}
+
+  T* allocate(size_t n) { return arenaPtr_->allocate<T>(n); }
+  void deallocate(T*, size_t) noexcept {}
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const noexcept {
+    return arenaPtr_ == other.arenaPtr_;
+  }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+    return arenaPtr_ != other.arenaPtr_;
+  }
+
+ private:
+  template <typename U>
+  friend class ArenaAllocator;
+
+  MonotonicArena* arenaPtr_;
+};
+
+/** Returns the arena of the calling thread. */
+MonotonicArena& getThreadLocalArena();
+
+}  // namespace ocs2
@@ -0,0 +1,186 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+#include <utility>
+
+#include "ocs2_core/Types.h"
+#include "ocs2_core/misc/LinearInterpolation.h"
+
+namespace ocs2 {
+
+/**
+ * A contiguous, structure-of-arrays storage for a trajectory of equally sized vectors. Node k is stored as column k of
+ * a single column-major matrix, so that iterating over the nodes walks linearly through memory and bulk copies reduce
+ * to a single memcpy. The indexing API mirrors vector_array_t (operator[], size, push_back, back) such that call sites
+ * written against vector_array_t keep compiling when they only read the nodes.
+ *
+ * @note All nodes must have the same dimension. Trajectories with mode-dependent dimensions should remain in vector_array_t.
+ */
+class TrajectoryMatrix {
+ public:
+  using column_t = matrix_t::ColXpr;
+  using const_column_t = matrix_t::ConstColXpr;
+
+  /** Default constructor, creates an empty trajectory. */
+  TrajectoryMatrix() = default;
+
+  /**
+   * Constructor
+   * @param [in] rows: The dimension of each node.
+   * @param [in] size: The number of nodes. The nodes are left uninitialized.
+   */
+  TrajectoryMatrix(size_t rows, size_t size) : data_(rows, size), size_(size) {}
+
+  /**
+   * Constructor from an array of vectors.
+   * @param [in] array: The trajectory. All the elements should have the same size.
+   */
+  explicit TrajectoryMatrix(const vector_array_t& array) { fromArray(array); }
+
+  /** Number of nodes. */
+  size_t size() const { return size_; }
+
+  /** Whether the trajectory has no node. */
+  bool empty() const { return size_ == 0; }
+
+  /** Dimension of each node. */
+  size_t rows() const { return static_cast<size_t>(data_.rows()); }
+
+  /** Number of nodes which can be stored without reallocation. */
+  size_t capacity() const { return static_cast<size_t>(data_.cols()); }
+
+  /** Access the k-th node. */
+  column_t operator[](size_t k) { return data_.col(k); }
+  const_column_t operator[](size_t k) const { return data_.col(k); }
+
+  /** Access the first and the last nodes. */
+  column_t front() { return data_.col(0); }
+  const_column_t front() const { return data_.col(0); }
+  column_t back() { return data_.col(size_ - 1); }
+  const_column_t back() const { return data_.col(size_ - 1); }
+
+  /** A view of the nodes as a (rows x size) matrix. */
+  matrix_t::ColsBlockXpr matrix() { return data_.leftCols(size_); }
+  matrix_t::ConstColsBlockXpr matrix() const { return data_.leftCols(size_); }
+
+  /** Raw pointer to the contiguous storage. Node k starts at data() + k * rows(). */
+  scalar_t* data() { return data_.data(); }
+  const scalar_t* data() const { return data_.data(); }
+
+  /** Removes all the nodes while keeping the allocated memory. */
+  void clear() { size_ = 0; }
+
+  /** Swaps the content with another trajectory without copying the nodes. */
+  void swap(TrajectoryMatrix& other) {
+    data_.swap(other.data_);
+    std::swap(size_, other.size_);
+  }
+
+  /**
+   * Reserves the storage for at least the given number of nodes.
+   * @param [in] rows: The dimension of each node. It can only be changed while the trajectory is empty.
+   * @param [in] capacity: The number of nodes.
+   */
+  void reserve(size_t rows, size_t capacity);
+
+  /**
+   * Resizes the trajectory. The existing nodes are kept and the new ones are left uninitialized.
+   * @param [in] rows: The dimension of each node. It can only be changed while the trajectory is empty.
+   * @param [in] size: The number of nodes.
+   */
+  void resize(size_t rows, size_t size);
+
+  /** Appends a node. The first node fixes the dimension of an empty trajectory. */
+  void push_back(const vector_t& node);
+
+  /** Assigns the content of an array of vectors. All the elements should have the same size. */
+  void fromArray(const vector_array_t& array);
+
+  /** Copies the content to an array of vectors. */
+  void toArray(vector_array_t& array) const;
+  vector_array_t toArray() const;
+
+  /** Checks whether all the elements of an array of vectors have the same size, i.e., whether it fits in a TrajectoryMatrix. */
+  static bool isUniform(const vector_array_t& array);
+
+ private:
+  matrix_t data_;
+  size_t size_ = 0;
+};
+
+namespace LinearInterpolation {
+
+/**
+ * Linear interpolation on a TrajectoryMatrix. It has the same semantics as the vector_array_t variant.
+ *
+ * @param [in] indexAlpha : index and interpolation coefficient (alpha) pair
+ * @param [in] trajectory: The contiguous data trajectory.
+ * @return The interpolation result
+ */
+vector_t interpolate(index_alpha_t indexAlpha, const TrajectoryMatrix& trajectory);
+
+/**
+ * Linear interpolation on a TrajectoryMatrix. It has the same semantics as the vector_array_t variant.
+ *
+ * @param [in] enquiryTime: The enquiry time for interpolation.
+ * @param [in] timeArray: Times vector
+ * @param [in] trajectory: The contiguous data trajectory.
+ * @return The interpolation result
+ */
+inline vector_t interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, const TrajectoryMatrix& trajectory) {
+  return interpolate(timeSegment(enquiryTime, timeArray), trajectory);
+}
+
+/**
+ * Batch interpolation into a contiguous TrajectoryMatrix. It has the same semantics as the std::vector variant.
+ *
+ * @param [in] indexAlphaArray : index and interpolation coefficient (alpha) pairs (see timeSegments).
+ * @param [in] dataArray: vector of data. All the elements should have the same size.
+ * @param [out] output: The interpolation results, one node per indexAlphaArray element.
+ */
+void interpolateBatch(const std::vector<index_alpha_t>& indexAlphaArray, const vector_array_t& dataArray, TrajectoryMatrix& output);
+
+/**
+ * Batch interpolation at a sorted (non-decreasing) array of enquiry times into a contiguous TrajectoryMatrix.
+ *
+ * @param [in] enquiryTimes: The sorted enquiry times for interpolation.
+ * @param [in] timeArray: Times vector
+ * @param [in] dataArray: vector of data. All the elements should have the same size.
+ * @param [out] output: The interpolation results, one node per enquiry time.
+ */
+inline void interpolateBatch(const std::vector<scalar_t>& enquiryTimes, const std::vector<scalar_t>& timeArray,
+                             const vector_array_t& dataArray, TrajectoryMatrix& output) {
+  interpolateBatch(timeSegments(enquiryTimes, timeArray), dataArray, output);
+}
+
+}  // namespace LinearInterpolation
+}  // namespace ocs2
@@ -66,13 +66,11 @@ const Data& stdAccessFun(const std::vector<Data, Alloc>& vec, size_t ind) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
-  // corner cases (no time set OR single time element)
-  if (timeArray.size() <= 1) {
-    return {0, scalar_t(1.0)};
-  }
-
-  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+/**
+ * Helper function which computes the interpolation coefficient given the interval index as returned by
+ * lookup::findIntervalInTimeArray. The time array should have at least two elements.
+ */
+inline index_alpha_t timeSegmentInInterval(int index, scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
   const auto lastInterval = static_cast<int>(timeArray.size() - 1);
   if (index >= 0) {
     if (index < lastInterval) {
@@ -104,6 +102,53 @@ inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+  return timeSegmentInInterval(index, enquiryTime, timeArray);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline void timeSegments(const std::vector<scalar_t>& enquiryTimes, const std::vector<scalar_t>& timeArray,
+                         std::vector<index_alpha_t>& indexAlphaArray) {
+  assert(std::is_sorted(enquiryTimes.begin(), enquiryTimes.end()));
+  indexAlphaArray.resize(enquiryTimes.size());
+
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    std::fill(indexAlphaArray.begin(), indexAlphaArray.end(), index_alpha_t{0, scalar_t(1.0)});
+    return;
+  }
+
+  // merge-style sweep: firstNotLess is the std::lower_bound of each enquiry time, which only moves forward
+  const auto numTimes = static_cast<int>(timeArray.size());
+  int firstNotLess = 0;
+  for (size_t i = 0; i < enquiryTimes.size(); i++) {
+    while (firstNotLess < numTimes && timeArray[firstNotLess] < enquiryTimes[i]) {
+      ++firstNotLess;
+    }
+    indexAlphaArray[i] = timeSegmentInInterval(firstNotLess - 1, enquiryTimes[i], timeArray);
+  }  // end of i loop
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline std::vector<index_alpha_t> timeSegments(const std::vector<scalar_t>& enquiryTimes, const std::vector<scalar_t>& timeArray) {
+  std::vector<index_alpha_t> indexAlphaArray;
+  timeSegments(enquiryTimes, timeArray, indexAlphaArray);
+  return indexAlphaArray;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -153,5 +198,50 @@ auto interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, c
   return interpolate(timeSegment(enquiryTime, timeArray), dataArray, accessFun);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Data, class Alloc, class AccessFun, class Output>
+void interpolateBatch(const std::vector<index_alpha_t>& indexAlphaArray, const std::vector<Data, Alloc>& dataArray, AccessFun accessFun,
+                      Output& output) {
+  assert(dataArray.size() > 0);
+  output.resize(indexAlphaArray.size());
+  for (size_t i = 0; i < indexAlphaArray.size(); i++) {
+    if (dataArray.size() > 1) {
+      // Normal interpolation case
+      const int index = indexAlphaArray[i].first;
+      const scalar_t alpha = indexAlphaArray[i].second;
+      const auto& lhs = accessFun(dataArray, index);
+      const auto& rhs = accessFun(dataArray, index + 1);
+      if (areSameSize(rhs, lhs)) {
+        // assigning to an existing element of the same size reuses its memory
+        output[i] = alpha * lhs + (scalar_t(1.0) - alpha) * rhs;
+      } else {
+        output[i] = (alpha > 0.5) ? lhs : rhs;
+      }
+    } else {  // dataArray.size() == 1
+      // Time vector has only 1 element -> Constant function
+      output[i] = accessFun(dataArray, 0);
+    }
+  }  // end of i loop
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Data, class Alloc, class Output>
+void interpolateBatch(const std::vector<index_alpha_t>& indexAlphaArray, const std::vector<Data, Alloc>& dataArray, Output& output) {
+  interpolateBatch(indexAlphaArray, dataArray, stdAccessFun<Data, Alloc>, output);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Data, class Alloc, class Output>
+void interpolateBatch(const std::vector<scalar_t>& enquiryTimes, const std::vector<scalar_t>& timeArray,
+                      const std::vector<Data, Alloc>& dataArray, Output& output) {
+  interpolateBatch(timeSegments(enquiryTimes, timeArray), dataArray, stdAccessFun<Data, Alloc>, output);
+}
+
 }  // namespace LinearInterpolation
 }  // namespace ocs2
@@ -47,6 +47,10 @@ namespace ocs2 {
  *   This class uses the chain rule to compute the second-order approximation of the constraint-penalty. In the case that the
  *   second-order approximation of constraint is not provided, it employs a Gauss-Newton approximation technique which only
  *   relies on the first-order approximation. In general, the penalty function can be a function of time.
+ *
+ *   The Gauss-Newton term \f$ \partial h^T diag(p'') \partial h \f$ is computed as a single symmetric rank-k update of the
+ *   rows with a nonzero penalty curvature. The scratch memory for this is kept per instance, hence, like the other OCS2
+ *   modules, an instance should not be shared between threads.
  */
 class MultidimensionalPenalty final {
  public:
@@ -81,6 +85,18 @@ class MultidimensionalPenalty final {
    */
   scalar_t getValue(scalar_t t, const vector_t& h, const vector_t* l = nullptr) const;
 
+  /**
+   * Checks whether the first and second derivatives of the penalty are negligible for all the constraints, i.e., whether the
+   * quadratic approximation of the penalty cost reduces to its value.
+   *
+   * @param [in] t: The time that the constraint is evaluated.
+   * @param [in] h: The constraint value.
+   * @param [in] tolerance: The tolerance on the absolute value of the derivatives.
+   * @param [in] l: The Lagrange multipliers.
+   * @return true if all the derivatives are below the tolerance.
+   */
+  bool hasNegligibleDerivatives(scalar_t t, const vector_t& h, scalar_t tolerance, const vector_t* l = nullptr) const;
+
   /**
    * Get the derivative of the penalty cost.
    * Implements the chain rule between the inequality constraint and penalty function.
@@ -103,6 +119,36 @@ class MultidimensionalPenalty final {
   ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t t, const VectorFunctionQuadraticApproximation& h,
                                                                  const vector_t* l = nullptr) const;
 
+  /**
+   * Adds the scaled quadratic approximation of the penalty cost to an accumulator. This avoids allocating a separate approximation.
+   * The accumulator should be at least of the state (and input) size of the constraint. For a state-only constraint, only the
+   * state blocks of the accumulator are modified.
+   *
+   * @param [in] t: The time that the constraint is evaluated.
+   * @param [in] h: The constraint linear approximation.
+   * @param [in, out] accumulator: The quadratic approximation that the penalty cost is added to.
+   * @param [in] l: The Lagrange multipliers.
+   * @param [in] scaling: The scaling factor of the penalty cost.
+   */
+  void accumulateQuadraticApproximation(scalar_t t, const VectorFunctionLinearApproximation& h,
+                                        ScalarFunctionQuadraticApproximation& accumulator, const vector_t* l = nullptr,
+                                        scalar_t scaling = 1.0) const;
+
+  /**
+   * Adds the scaled quadratic approximation of the penalty cost to an accumulator. This avoids allocating a separate approximation.
+   * The accumulator should be at least of the state (and input) size of the constraint. For a state-only constraint, only the
+   * state blocks of the accumulator are modified.
+   *
+   * @param [in] t: The time that the constraint is evaluated.
+   * @param [in] h: The constraint quadratic approximation.
+   * @param [in, out] accumulator: The quadratic approximation that the penalty cost is added to.
+   * @param [in] l: The Lagrange multipliers.
+   * @param [in] scaling: The scaling factor of the penalty cost.
+   */
+  void accumulateQuadraticApproximation(scalar_t t, const VectorFunctionQuadraticApproximation& h,
+                                        ScalarFunctionQuadraticApproximation& accumulator, const vector_t* l = nullptr,
+                                        scalar_t scaling = 1.0) const;
+
   /**
    * Updates the Lagrange multipliers.
    *
@@ -122,9 +168,19 @@ class MultidimensionalPenalty final {
   vector_t initializeMultipliers(size_t numConstraints) const;
 
  private:
-  std::tuple<scalar_t, vector_t, vector_t> getPenaltyValue1stDev2ndDev(scalar_t t, const vector_t& h, const vector_t* l) const;
+  /** Computes the penalty value and stores its first and second derivatives in penaltyDerivative_ and penaltySecondDerivative_. */
+  scalar_t computePenaltyValue1stDev2ndDev(scalar_t t, const vector_t& h, const vector_t* l, scalar_t scaling) const;
+
+  /** Adds the Gauss-Newton term [dhdx, dhdu]^T * diag(penaltySecondDerivative_) * [dhdx, dhdu] to the accumulator. */
+  void accumulateGaussNewtonHessian(const matrix_t& dhdx, const matrix_t& dhdu, ScalarFunctionQuadraticApproximation& accumulator) const;
 
   std::vector<std::unique_ptr<augmented::AugmentedPenaltyBase>> penaltyPtrArray_;
+
+  // scratch memory
+  mutable vector_t penaltyDerivative_;
+  mutable vector_t penaltySecondDerivative_;
+  mutable matrix_t weightedJacobian_;
+  mutable matrix_t gaussNewtonHessian_;
 };
 
 }  // namespace ocs2
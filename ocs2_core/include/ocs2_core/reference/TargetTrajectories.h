@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ostream>
 
 #include "ocs2_core/Types.h"
+#include "ocs2_core/misc/TrajectoryMatrix.h"
 
 namespace ocs2 {
 
@@ -52,9 +53,38 @@ struct TargetTrajectories {
   vector_t getDesiredState(scalar_t time) const;
   vector_t getDesiredInput(scalar_t time) const;
 
+  /**
+   * Samples the desired state and input once on a sorted time grid, e.g. the discretization grid of a solver. Afterwards,
+   * getDesiredState() and getDesiredInput() return the cached samples for queries exactly at the grid times and only
+   * interpolate for the other times. The samples are dropped by clear() and by resampling. They are NOT updated if the
+   * trajectories are modified directly afterwards; in that case call resample() or clearSamples() again.
+   *
+   * The samples are stored contiguously and their memory is reused by the next resample(). Hence, nothing is sampled if
+   * the nodes of the state or the input trajectory do not have the same dimension.
+   *
+   * @param [in] timeGrid: The sorted (non-decreasing) sampling times.
+   */
+  void resample(const scalar_array_t& timeGrid);
+
+  /** Drops the samples cached by resample(). */
+  void clearSamples();
+
+  /** Number of the samples cached by resample(). */
+  size_t numSamples() const { return sampleTimes_.size(); }
+
   scalar_array_t timeTrajectory;
   vector_array_t stateTrajectory;
   vector_array_t inputTrajectory;
+
+ private:
+  /** Returns the index of the cached sample at exactly the given time, or -1 if there is none. */
+  int findSample(scalar_t time) const;
+
+  scalar_array_t sampleTimes_;
+  TrajectoryMatrix sampledStates_;
+  TrajectoryMatrix sampledInputs_;
+
+  friend void swap(TargetTrajectories& lh, TargetTrajectories& rh);
 };
 
 void swap(TargetTrajectories& lh, TargetTrajectories& rh);
@@ -0,0 +1,114 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * Tracks the activity of an inequality soft constraint over the nodes of the horizon. A node at which the derivatives of the
+ * penalty have been negligible for all rows for a number of consecutive iterations is reported as prunable. There the soft
+ * constraint reduces the quadratic approximation of the penalty to its value. Since the derivatives are checked at the
+ * current point as well, the pruned approximation is consistent with the full one up to the tolerance, and a node is
+ * re-enabled as soon as any row approaches the boundary.
+ *
+ * The history is keyed on the node index in the time trajectory of the solver. It is advanced once per iteration by
+ * advanceIteration(), which should be registered as an iteration callback of the solver (see SolverBase::addIterationCallback).
+ * Nothing is pruned before the first call.
+ *
+ * The tracker is meant to be shared between the clones of a soft constraint which evaluate the same horizon in parallel.
+ * update() is lock-free: each node records its activity in its own slot. advanceIteration() and reset() are called between
+ * the iterations and must not run concurrently with update().
+ */
+class InequalityActivityTracker {
+ public:
+  struct Settings {
+    /** The penalty derivatives are negligible if their absolute values are below this tolerance. */
+    scalar_t derivativeTolerance = 1e-6;
+    /** Number of consecutive iterations with negligible derivatives after which a node is pruned. */
+    size_t numInactiveIterations = 3;
+  };
+
+  /** Constructor */
+  explicit InequalityActivityTracker(Settings settings);
+
+  /**
+   * Advances the history by one iteration and sets the nodes of the next iteration. The history of the node with index k is
+   * carried over to the node with index k of the new time trajectory.
+   *
+   * @param [in] timeTrajectory: The time trajectory of the nodes which the solver approximates in this iteration.
+   */
+  void advanceIteration(const scalar_array_t& timeTrajectory);
+
+  /**
+   * Records the activity of the node closest to the given time in the current iteration and checks whether it can be pruned.
+   *
+   * @param [in] time: The time of the node.
+   * @param [in] isNegligible: Whether the penalty derivatives of all rows are negligible at the current point.
+   * @return true if the derivatives are negligible and have been so for the set number of previous iterations.
+   */
+  bool update(scalar_t time, bool isNegligible);
+
+  /** Clears the history and the counters. */
+  void reset();
+
+  /** Number of evaluations which were pruned. */
+  size_t getNumPruned() const;
+
+  /** Number of evaluations which required the full approximation. */
+  size_t getNumFull() const;
+
+  const Settings& settings() const { return settings_; }
+
+ private:
+  /** The activity of a node in the current iteration. */
+  struct NodeSlot {
+    std::atomic<bool> isObserved{false};
+    std::atomic<bool> isNegligible{true};
+  };
+
+  size_t getNodeIndex(scalar_t time) const;
+
+  const Settings settings_;
+
+  scalar_array_t timeTrajectory_;
+  std::vector<size_t> numInactiveIterations_;
+  std::unique_ptr<NodeSlot[]> nodeSlots_;
+  std::atomic<size_t> numPruned_{0};
+  std::atomic<size_t> numFull_{0};
+};
+
+}  // namespace ocs2
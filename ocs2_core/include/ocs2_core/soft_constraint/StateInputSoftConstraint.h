@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/constraint/StateInputConstraint.h>
 #include <ocs2_core/cost/StateInputCost.h>
 #include <ocs2_core/penalties/MultidimensionalPenalty.h>
+#include <ocs2_core/soft_constraint/InequalityActivityTracker.h>
 
 namespace ocs2 {
 
@@ -89,11 +90,34 @@ class StateInputSoftConstraint final : public StateInputCost {
                                                                  const TargetTrajectories& /* targetTrajectories */,
                                                                  const PreComputation& preComp) const override;
 
+  void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                        const TargetTrajectories& /* targetTrajectories */, const PreComputation& preComp,
+                                        ScalarFunctionQuadraticApproximation& accumulator) const override;
+
+  /**
+   * Enables the activity tracking of the constraint over the horizon (disabled by default). At the nodes where the penalty
+   * derivatives stay negligible, the quadratic approximation of the penalty is reduced to its value, which skips the
+   * Jacobian products of the penalty. The tracker is shared by the clones of this term. Passing nullptr disables the tracking.
+   */
+  void setActivityTracker(std::shared_ptr<InequalityActivityTracker> activityTrackerPtr) {
+    activityTrackerPtr_ = std::move(activityTrackerPtr);
+  }
+
+  /** Gets the activity tracker, nullptr if the tracking is disabled. */
+  const std::shared_ptr<InequalityActivityTracker>& getActivityTracker() const { return activityTrackerPtr_; }
+
  private:
   StateInputSoftConstraint(const StateInputSoftConstraint& other);
 
+  /** Checks whether the approximation at this node can be reduced to the penalty value. Requires an activity tracker. */
+  bool isPruned(scalar_t time, const vector_t& h) const;
+
+  /** Gets the quadratic approximation which only holds the penalty value. */
+  ScalarFunctionQuadraticApproximation getPenaltyValueApproximation(scalar_t time, const vector_t& h, int stateDim, int inputDim) const;
+
   std::unique_ptr<StateInputConstraint> constraintPtr_;
   MultidimensionalPenalty penalty_;
+  std::shared_ptr<InequalityActivityTracker> activityTrackerPtr_;
 };
 
 }  // namespace ocs2
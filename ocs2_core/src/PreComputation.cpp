@@ -0,0 +1,83 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include "ocs2_core/PreComputation.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PreComputation::CachedRequest PreComputation::updateRequestCache(CallbackType type, RequestSet request, scalar_t t, const vector_t& x,
+                                                                 const vector_t& u) {
+  const bool samePoint = cachedPoint_ == type && cachedTime_ == t && cachedState_.size() == x.size() && cachedInput_.size() == u.size() &&
+                         cachedState_ == x && cachedInput_ == u;
+  if (!samePoint) {
+    cachedPoint_ = type;
+    cachedTime_ = t;
+    cachedState_ = x;
+    cachedInput_ = u;
+    computedValues_ = RequestSet();
+    computedApproximations_ = RequestSet();
+  }
+
+  CachedRequest result;
+  result.computed = computedValues_ + computedApproximations_;
+  if (!computedApproximations_.empty()) {
+    result.computed = result.computed + Request::Approximation;
+  }
+
+  // per item: missing if its value or the requested approximation has not been computed yet
+  const bool isApproximation = request.contains(Request::Approximation);
+  for (const auto item : {Request::Dynamics, Request::Cost, Request::Constraint, Request::SoftConstraint}) {
+    if (request.contains(item)) {
+      if (!computedValues_.contains(item) || (isApproximation && !computedApproximations_.contains(item))) {
+        result.missing = result.missing + item;
+      }
+      computedValues_ = computedValues_ + item;
+      if (isApproximation) {
+        computedApproximations_ = computedApproximations_ + item;
+      }
+    }
+  }  // end of item loop
+
+  if (result.missing.empty()) {
+    ++numCacheHits_;
+  } else {
+    ++numCacheMisses_;
+    if (isApproximation) {
+      result.missing = result.missing + Request::Approximation;
+    }
+  }
+
+  return result;
+}
+
+}  // namespace ocs2
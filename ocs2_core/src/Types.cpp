@@ -484,4 +484,95 @@ std::ostream& operator<<(std::ostream& out, const VectorFunctionQuadraticApproxi
   return out;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ApproximationSparsity& ApproximationSparsity::setDense() {
+  isDense = true;
+  stateIndices.clear();
+  inputIndices.clear();
+  return *this;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ApproximationSparsity& ApproximationSparsity::setSparse(size_array_t stateIndicesArg, size_array_t inputIndicesArg) {
+  isDense = false;
+  stateIndices = std::move(stateIndicesArg);
+  inputIndices = std::move(inputIndicesArg);
+  return *this;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ApproximationSparsity ApproximationSparsity::Sparse(size_array_t stateIndices, size_array_t inputIndices) {
+  ApproximationSparsity sparsity;
+  sparsity.setSparse(std::move(stateIndices), std::move(inputIndices));
+  return sparsity;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void accumulateSparseApproximation(const ScalarFunctionQuadraticApproximation& compact, const ApproximationSparsity& sparsity,
+                                   ScalarFunctionQuadraticApproximation& accumulator) {
+  if (sparsity.isDense) {
+    accumulator += compact;
+    return;
+  }
+
+  const auto& xIndices = sparsity.stateIndices;
+  const auto& uIndices = sparsity.inputIndices;
+  const size_t nx = xIndices.size();
+  const size_t nu = uIndices.size();
+
+  accumulator.f += compact.f;
+  for (size_t j = 0; j < nx; j++) {
+    accumulator.dfdx(xIndices[j]) += compact.dfdx(j);
+    for (size_t i = 0; i < nx; i++) {
+      accumulator.dfdxx(xIndices[i], xIndices[j]) += compact.dfdxx(i, j);
+    }  // end of i loop
+  }    // end of j loop
+
+  for (size_t j = 0; j < nu; j++) {
+    accumulator.dfdu(uIndices[j]) += compact.dfdu(j);
+    for (size_t i = 0; i < nu; i++) {
+      accumulator.dfduu(uIndices[i], uIndices[j]) += compact.dfduu(i, j);
+    }  // end of i loop
+  }    // end of j loop
+
+  for (size_t j = 0; j < nx; j++) {
+    for (size_t i = 0; i < nu; i++) {
+      accumulator.dfdux(uIndices[i], xIndices[j]) += compact.dfdux(i, j);
+    }  // end of i loop
+  }    // end of j loop
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void assignSparseApproximation(const VectorFunctionLinearApproximation& compact, const ApproximationSparsity& sparsity, size_t rowOffset,
+                               VectorFunctionLinearApproximation& approximation) {
+  const size_t nc = compact.f.rows();
+  approximation.f.segment(rowOffset, nc) = compact.f;
+
+  if (sparsity.isDense) {
+    approximation.dfdx.middleRows(rowOffset, nc) = compact.dfdx;
+    approximation.dfdu.middleRows(rowOffset, nc) = compact.dfdu;
+    return;
+  }
+
+  approximation.dfdx.middleRows(rowOffset, nc).setZero();
+  for (size_t j = 0; j < sparsity.stateIndices.size(); j++) {
+    approximation.dfdx.col(sparsity.stateIndices[j]).segment(rowOffset, nc) = compact.dfdx.col(j);
+  }  // end of j loop
+
+  approximation.dfdu.middleRows(rowOffset, nc).setZero();
+  for (size_t j = 0; j < sparsity.inputIndices.size(); j++) {
+    approximation.dfdu.col(sparsity.inputIndices[j]).segment(rowOffset, nc) = compact.dfdu.col(j);
+  }  // end of j loop
+}
+
 }  // namespace ocs2
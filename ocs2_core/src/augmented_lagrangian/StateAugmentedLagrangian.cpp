@@ -100,6 +100,26 @@ ScalarFunctionQuadraticApproximation StateAugmentedLagrangian::getQuadraticAppro
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateAugmentedLagrangian::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const Multiplier& multiplier,
+                                                                const PreComputation& preComp,
+                                                                ScalarFunctionQuadraticApproximation& accumulator) const {
+  switch (constraintPtr_->getOrder()) {
+    case ConstraintOrder::Linear:
+      penalty_.accumulateQuadraticApproximation(time, constraintPtr_->getLinearApproximation(time, state, preComp), accumulator,
+                                                &multiplier.lagrangian, multiplier.penalty);
+      break;
+    case ConstraintOrder::Quadratic:
+      penalty_.accumulateQuadraticApproximation(time, constraintPtr_->getQuadraticApproximation(time, state, preComp), accumulator,
+                                                &multiplier.lagrangian, multiplier.penalty);
+      break;
+    default:
+      throw std::runtime_error("[StateAugmentedLagrangian] Unknown constraint Order");
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
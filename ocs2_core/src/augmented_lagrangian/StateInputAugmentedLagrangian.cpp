@@ -101,6 +101,26 @@ ScalarFunctionQuadraticApproximation StateInputAugmentedLagrangian::getQuadratic
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputAugmentedLagrangian::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                     const Multiplier& multiplier, const PreComputation& preComp,
+                                                                     ScalarFunctionQuadraticApproximation& accumulator) const {
+  switch (constraintPtr_->getOrder()) {
+    case ConstraintOrder::Linear:
+      penalty_.accumulateQuadraticApproximation(time, constraintPtr_->getLinearApproximation(time, state, input, preComp), accumulator,
+                                                &multiplier.lagrangian, multiplier.penalty);
+      break;
+    case ConstraintOrder::Quadratic:
+      penalty_.accumulateQuadraticApproximation(time, constraintPtr_->getQuadraticApproximation(time, state, input, preComp),
+                                                accumulator, &multiplier.lagrangian, multiplier.penalty);
+      break;
+    default:
+      throw std::runtime_error("[StateInputAugmentedLagrangian] Unknown constraint Order");
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -35,7 +35,9 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 LinearStateInputConstraint::LinearStateInputConstraint(vector_t e, matrix_t C, matrix_t D)
-    : StateInputConstraint(ConstraintOrder::Linear), e_(std::move(e)), C_(std::move(C)), D_(std::move(D)) {}
+    : StateInputConstraint(ConstraintOrder::Linear), e_(std::move(e)), C_(std::move(C)), D_(std::move(D)) {
+  updateSparsity();
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -75,4 +77,58 @@ VectorFunctionLinearApproximation LinearStateInputConstraint::getLinearApproxima
   return g;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation LinearStateInputConstraint::getSparseLinearApproximation(scalar_t t, const vector_t& x,
+                                                                                           const vector_t& u,
+                                                                                           const PreComputation& preComputation,
+                                                                                           ApproximationSparsity& sparsity) const {
+  if (sparsity_.isDense) {
+    sparsity.setDense();
+    return getLinearApproximation(t, x, u, preComputation);
+  }
+
+  const auto& stateIndices = sparsity_.stateIndices;
+  const auto& inputIndices = sparsity_.inputIndices;
+  VectorFunctionLinearApproximation g;
+  g.f = e_;
+  g.dfdx.resize(C_.rows(), stateIndices.size());
+  g.dfdu.resize(D_.rows(), inputIndices.size());
+  for (size_t j = 0; j < stateIndices.size(); j++) {
+    g.dfdx.col(j) = C_.col(stateIndices[j]);
+    g.f.noalias() += g.dfdx.col(j) * x(stateIndices[j]);
+  }  // end of j loop
+  for (size_t j = 0; j < inputIndices.size(); j++) {
+    g.dfdu.col(j) = D_.col(inputIndices[j]);
+    g.f.noalias() += g.dfdu.col(j) * u(inputIndices[j]);
+  }  // end of j loop
+
+  sparsity = sparsity_;
+  return g;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearStateInputConstraint::updateSparsity() {
+  auto nonZeroColumns = [](const matrix_t& m) {
+    size_array_t indices;
+    for (int j = 0; j < m.cols(); j++) {
+      if (!m.col(j).isZero(0.0)) {
+        indices.push_back(j);
+      }
+    }  // end of j loop
+    return indices;
+  };
+
+  auto stateIndices = nonZeroColumns(C_);
+  auto inputIndices = nonZeroColumns(D_);
+  if (2 * (stateIndices.size() + inputIndices.size()) > static_cast<size_t>(C_.cols() + D_.cols())) {
+    sparsity_.setDense();
+  } else {
+    sparsity_.setSparse(std::move(stateIndices), std::move(inputIndices));
+  }
+}
+
 }  // namespace ocs2
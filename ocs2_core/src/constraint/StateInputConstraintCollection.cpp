@@ -91,14 +91,12 @@ VectorFunctionLinearApproximation StateInputConstraintCollection::getLinearAppro
 
   // append linearApproximation of each constraintTerm
   size_t i = 0;
+  ApproximationSparsity sparsity;
   for (const auto& constraintTerm : this->terms_) {
     if (constraintTerm->isActive(time)) {
-      const auto constraintTermApproximation = constraintTerm->getLinearApproximation(time, state, input, preComp);
-      const size_t nc = constraintTermApproximation.f.rows();
-      linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
-      linearApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
-      linearApproximation.dfdu.middleRows(i, nc) = constraintTermApproximation.dfdu;
-      i += nc;
+      const auto constraintTermApproximation = constraintTerm->getSparseLinearApproximation(time, state, input, preComp, sparsity);
+      assignSparseApproximation(constraintTermApproximation, sparsity, i, linearApproximation);
+      i += constraintTermApproximation.f.rows();
     }
   }
 
@@ -67,6 +67,19 @@ ScalarFunctionQuadraticApproximation QuadraticStateCost::getQuadraticApproximati
   return Phi;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateCost::accumulateQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                          const TargetTrajectories& targetTrajectories, const PreComputation&,
+                                                          ScalarFunctionQuadraticApproximation& accumulator) const {
+  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories);
+  const vector_t qDeviation = Q_ * xDeviation;
+  accumulator.f += 0.5 * xDeviation.dot(qDeviation);
+  accumulator.dfdx += qDeviation;
+  accumulator.dfdxx += Q_;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -96,6 +96,32 @@ ScalarFunctionQuadraticApproximation QuadraticStateInputCost::getQuadraticApprox
   return L;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateInputCost::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                               const TargetTrajectories& targetTrajectories, const PreComputation&,
+                                                               ScalarFunctionQuadraticApproximation& accumulator) const {
+  vector_t stateDeviation, inputDeviation;
+  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories);
+
+  const vector_t qDeviation = Q_ * stateDeviation;
+  const vector_t rDeviation = R_ * inputDeviation;
+  accumulator.f += 0.5 * stateDeviation.dot(qDeviation) + 0.5 * inputDeviation.dot(rDeviation);
+  accumulator.dfdx += qDeviation;
+  accumulator.dfdu += rDeviation;
+  accumulator.dfdxx += Q_;
+  accumulator.dfduu += R_;
+
+  if (P_.size() > 0) {
+    const vector_t pDeviation = P_ * stateDeviation;
+    accumulator.f += inputDeviation.dot(pDeviation);
+    accumulator.dfdu += pDeviation;
+    accumulator.dfdx.noalias() += P_.transpose() * inputDeviation;
+    accumulator.dfdux += P_;
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
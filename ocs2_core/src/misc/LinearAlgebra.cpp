@@ -89,8 +89,8 @@ void makePsdCholesky(matrix_t& A, scalar_t minEigenvalue) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void computeConstraintProjection(const matrix_t& Dm, const matrix_t& RmInvUmUmT, matrix_t& DmDagger, matrix_t& DmDaggerTRmDmDaggerUUT,
-                                 matrix_t& RmInvConstrainedUUT) {
+void computeConstraintProjection(const Eigen::Ref<const matrix_t>& Dm, const Eigen::Ref<const matrix_t>& RmInvUmUmT, matrix_t& DmDagger,
+                                 matrix_t& DmDaggerTRmDmDaggerUUT, matrix_t& RmInvConstrainedUUT) {
   const auto numConstraints = Dm.rows();
   const auto numInputs = Dm.cols();
 
@@ -0,0 +1,154 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include "ocs2_core/misc/MonotonicArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace ocs2 {
+
+constexpr size_t MonotonicArena::defaultAlignment;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MonotonicArena::MonotonicArena(size_t initialCapacity) {
+  if (initialCapacity > 0) {
+    addBlock(initialCapacity);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MonotonicArena::~MonotonicArena() {
+  for (auto& block : blocks_) {
+    std::free(block.data);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void* MonotonicArena::allocate(size_t numBytes, size_t alignment) {
+  const auto alignedOffset = [alignment](const Block& block, size_t offset) {
+    const auto address = reinterpret_cast<std::uintptr_t>(block.data) + offset;
+    return offset + ((alignment - address % alignment) % alignment);
+  };
+
+  // try the current and the following (already allocated) blocks
+  for (; currentBlock_ < blocks_.size(); ++currentBlock_, offset_ = 0) {
+    const auto& block = blocks_[currentBlock_];
+    const auto start = alignedOffset(block, offset_);
+    if (start + numBytes <= block.size) {
+      offset_ = start + numBytes;
+      return block.data + start;
+    }
+  }
+
+  // a new block at the end
+  const size_t lastSize = blocks_.empty() ? 0 : blocks_.back().size;
+  addBlock(std::max(2 * lastSize, numBytes + alignment));
+  currentBlock_ = blocks_.size() - 1;
+  const auto start = alignedOffset(blocks_.back(), 0);
+  offset_ = start + numBytes;
+  return blocks_.back().data + start;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MonotonicArena::rewind(const Marker& marker) {
+  currentBlock_ = marker.blockIndex;
+  offset_ = marker.offset;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MonotonicArena::reset() {
+  if (blocks_.size() > 1) {
+    const auto capacity = getCapacity();
+    for (auto& block : blocks_) {
+      std::free(block.data);
+    }
+    blocks_.clear();
+    addBlock(capacity);
+  }
+  currentBlock_ = 0;
+  offset_ = 0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t MonotonicArena::getCapacity() const {
+  size_t capacity = 0;
+  for (const auto& block : blocks_) {
+    capacity += block.size;
+  }
+  return capacity;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t MonotonicArena::getBytesInUse() const {
+  size_t bytesInUse = offset_;
+  for (size_t i = 0; i < std::min(currentBlock_, blocks_.size()); i++) {
+    bytesInUse += blocks_[i].size;
+  }
+  return bytesInUse;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MonotonicArena::addBlock(size_t minSize) {
+  Block block{static_cast<char*>(std::malloc(minSize)), minSize};
+  if (block.data == nullptr) {
+    throw std::bad_alloc();
+  }
+  blocks_.push_back(block);
+  ++numBlockAllocations_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MonotonicArena& getThreadLocalArena() {
+  thread_local MonotonicArena arena;
+  return arena;
+}
+
+}  // namespace ocs2
@@ -0,0 +1,160 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include "ocs2_core/misc/TrajectoryMatrix.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void TrajectoryMatrix::reserve(size_t rows, size_t capacity) {
+  if (size_ > 0 && rows != this->rows()) {
+    throw std::runtime_error("[TrajectoryMatrix::reserve] The node dimension of a non-empty trajectory cannot be changed!");
+  }
+
+  if (rows != this->rows() || capacity > this->capacity()) {
+    // conservativeResize keeps the first size_ columns in place since the storage is column-major
+    data_.conservativeResize(rows, std::max(capacity, this->capacity()));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void TrajectoryMatrix::resize(size_t rows, size_t size) {
+  reserve(rows, size);
+  size_ = size;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void TrajectoryMatrix::push_back(const vector_t& node) {
+  const size_t rows = (size_ == 0) ? static_cast<size_t>(node.size()) : this->rows();
+  if (static_cast<size_t>(node.size()) != rows) {
+    throw std::runtime_error("[TrajectoryMatrix::push_back] The node dimension (" + std::to_string(node.size()) +
+                             ") does not match the trajectory dimension (" + std::to_string(rows) + ")!");
+  }
+
+  if (size_ == capacity() || rows != this->rows()) {
+    // geometric growth to keep push_back amortized O(1)
+    reserve(rows, std::max<size_t>(2 * size_, 8));
+  }
+  data_.col(size_++) = node;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void TrajectoryMatrix::fromArray(const vector_array_t& array) {
+  if (!isUniform(array)) {
+    throw std::runtime_error("[TrajectoryMatrix::fromArray] All the elements of the array should have the same size!");
+  }
+
+  const size_t rows = array.empty() ? 0 : static_cast<size_t>(array.front().size());
+  size_ = 0;
+  resize(rows, array.size());
+  for (size_t k = 0; k < size_; k++) {
+    std::memcpy(data_.col(k).data(), array[k].data(), rows * sizeof(scalar_t));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void TrajectoryMatrix::toArray(vector_array_t& array) const {
+  array.resize(size_);
+  for (size_t k = 0; k < size_; k++) {
+    array[k] = data_.col(k);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_array_t TrajectoryMatrix::toArray() const {
+  vector_array_t array;
+  toArray(array);
+  return array;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool TrajectoryMatrix::isUniform(const vector_array_t& array) {
+  return std::all_of(array.cbegin(), array.cend(), [&](const vector_t& v) { return v.size() == array.front().size(); });
+}
+
+namespace LinearInterpolation {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t interpolate(index_alpha_t indexAlpha, const TrajectoryMatrix& trajectory) {
+  assert(trajectory.size() > 0);
+  if (trajectory.size() > 1) {
+    // Normal interpolation case
+    const auto index = static_cast<size_t>(indexAlpha.first);
+    const scalar_t alpha = indexAlpha.second;
+    return alpha * trajectory[index] + (scalar_t(1.0) - alpha) * trajectory[index + 1];
+  } else {  // trajectory.size() == 1
+    // Time vector has only 1 element -> Constant function
+    return trajectory[0];
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void interpolateBatch(const std::vector<index_alpha_t>& indexAlphaArray, const vector_array_t& dataArray, TrajectoryMatrix& output) {
+  assert(dataArray.size() > 0);
+  if (!TrajectoryMatrix::isUniform(dataArray)) {
+    throw std::runtime_error("[LinearInterpolation::interpolateBatch] All the elements of the data array should have the same size!");
+  }
+
+  output.clear();
+  output.resize(static_cast<size_t>(dataArray.front().size()), indexAlphaArray.size());
+  for (size_t i = 0; i < indexAlphaArray.size(); i++) {
+    if (dataArray.size() > 1) {
+      const auto index = static_cast<size_t>(indexAlphaArray[i].first);
+      const scalar_t alpha = indexAlphaArray[i].second;
+      output[i] = alpha * dataArray[index] + (scalar_t(1.0) - alpha) * dataArray[index + 1];
+    } else {
+      output[i] = dataArray.front();
+    }
+  }  // end of i loop
+}
+
+}  // namespace LinearInterpolation
+}  // namespace ocs2
@@ -28,6 +28,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include <cassert>
+#include <cmath>
 
 #include <ocs2_core/penalties/MultidimensionalPenalty.h>
 
@@ -134,32 +135,33 @@ scalar_t MultidimensionalPenalty::getValue(scalar_t t, const vector_t& h, const
   return penalty;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MultidimensionalPenalty::hasNegligibleDerivatives(scalar_t t, const vector_t& h, scalar_t tolerance, const vector_t* l) const {
+  const auto numConstraints = h.rows();
+  assert(penaltyPtrArray_.size() == 1 || penaltyPtrArray_.size() == static_cast<size_t>(numConstraints));
+
+  for (int i = 0; i < numConstraints; i++) {
+    const auto& penaltyTerm = (penaltyPtrArray_.size() == 1) ? penaltyPtrArray_[0] : penaltyPtrArray_[i];
+    if (std::abs(penaltyTerm->getDerivative(t, getMultiplier(l, i), h(i))) > tolerance ||
+        std::abs(penaltyTerm->getSecondDerivative(t, getMultiplier(l, i), h(i))) > tolerance) {
+      return false;
+    }
+  }  // end of i loop
+
+  return true;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation MultidimensionalPenalty::getQuadraticApproximation(scalar_t t,
                                                                                         const VectorFunctionLinearApproximation& h,
                                                                                         const vector_t* l) const {
-  const auto stateDim = h.dfdx.cols();
-  const auto inputDim = h.dfdu.cols();
-
-  scalar_t penaltyValue = 0.0;
-  vector_t penaltyDerivative, penaltySecondDerivative;
-  std::tie(penaltyValue, penaltyDerivative, penaltySecondDerivative) = getPenaltyValue1stDev2ndDev(t, h.f, l);
-  const matrix_t penaltySecondDev_dhdx = penaltySecondDerivative.asDiagonal() * h.dfdx;
-
   // to make sure that dfdux in the state-only case has a right size
-  ScalarFunctionQuadraticApproximation penaltyApproximation(stateDim, inputDim);
-
-  penaltyApproximation.f = penaltyValue;
-  penaltyApproximation.dfdx.noalias() = h.dfdx.transpose() * penaltyDerivative;
-  penaltyApproximation.dfdxx.noalias() = h.dfdx.transpose() * penaltySecondDev_dhdx;
-  if (inputDim > 0) {
-    penaltyApproximation.dfdu.noalias() = h.dfdu.transpose() * penaltyDerivative;
-    penaltyApproximation.dfdux.noalias() = h.dfdu.transpose() * penaltySecondDev_dhdx;
-    penaltyApproximation.dfduu.noalias() = h.dfdu.transpose() * penaltySecondDerivative.asDiagonal() * h.dfdu;
-  }
-
+  auto penaltyApproximation = ScalarFunctionQuadraticApproximation::Zero(h.dfdx.cols(), h.dfdu.cols());
+  accumulateQuadraticApproximation(t, h, penaltyApproximation, l);
   return penaltyApproximation;
 }
 
@@ -169,57 +171,129 @@ ScalarFunctionQuadraticApproximation MultidimensionalPenalty::getQuadraticApprox
 ScalarFunctionQuadraticApproximation MultidimensionalPenalty::getQuadraticApproximation(scalar_t t,
                                                                                         const VectorFunctionQuadraticApproximation& h,
                                                                                         const vector_t* l) const {
-  const auto stateDim = h.dfdx.cols();
-  const auto inputDim = h.dfdu.cols();
-  const auto numConstraints = h.f.rows();
-
-  scalar_t penaltyValue = 0.0;
-  vector_t penaltyDerivative, penaltySecondDerivative;
-  std::tie(penaltyValue, penaltyDerivative, penaltySecondDerivative) = getPenaltyValue1stDev2ndDev(t, h.f, l);
-  const matrix_t penaltySecondDev_dhdx = penaltySecondDerivative.asDiagonal() * h.dfdx;
-
   // to make sure that dfdux in the state-only case has a right size
-  ScalarFunctionQuadraticApproximation penaltyApproximation(stateDim, inputDim);
+  auto penaltyApproximation = ScalarFunctionQuadraticApproximation::Zero(h.dfdx.cols(), h.dfdu.cols());
+  accumulateQuadraticApproximation(t, h, penaltyApproximation, l);
+  return penaltyApproximation;
+}
 
-  penaltyApproximation.f = penaltyValue;
-  penaltyApproximation.dfdx.noalias() = h.dfdx.transpose() * penaltyDerivative;
-  penaltyApproximation.dfdxx.noalias() = h.dfdx.transpose() * penaltySecondDev_dhdx;
-  for (size_t i = 0; i < numConstraints; i++) {
-    penaltyApproximation.dfdxx.noalias() += penaltyDerivative(i) * h.dfdxx[i];
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MultidimensionalPenalty::accumulateQuadraticApproximation(scalar_t t, const VectorFunctionLinearApproximation& h,
+                                                               ScalarFunctionQuadraticApproximation& accumulator, const vector_t* l,
+                                                               scalar_t scaling) const {
+  const auto inputDim = h.dfdu.cols();
+
+  accumulator.f += computePenaltyValue1stDev2ndDev(t, h.f, l, scaling);
+  accumulator.dfdx.noalias() += h.dfdx.transpose() * penaltyDerivative_;
+  if (inputDim > 0) {
+    accumulator.dfdu.noalias() += h.dfdu.transpose() * penaltyDerivative_;
   }
+  accumulateGaussNewtonHessian(h.dfdx, h.dfdu, accumulator);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MultidimensionalPenalty::accumulateQuadraticApproximation(scalar_t t, const VectorFunctionQuadraticApproximation& h,
+                                                               ScalarFunctionQuadraticApproximation& accumulator, const vector_t* l,
+                                                               scalar_t scaling) const {
+  const auto inputDim = h.dfdu.cols();
+  const auto numConstraints = h.f.rows();
 
+  accumulator.f += computePenaltyValue1stDev2ndDev(t, h.f, l, scaling);
+  accumulator.dfdx.noalias() += h.dfdx.transpose() * penaltyDerivative_;
   if (inputDim > 0) {
-    penaltyApproximation.dfdu.noalias() = h.dfdu.transpose() * penaltyDerivative;
-    penaltyApproximation.dfdux.noalias() = h.dfdu.transpose() * penaltySecondDev_dhdx;
-    penaltyApproximation.dfduu.noalias() = h.dfdu.transpose() * penaltySecondDerivative.asDiagonal() * h.dfdu;
-    for (size_t i = 0; i < numConstraints; i++) {
-      penaltyApproximation.dfduu.noalias() += penaltyDerivative(i) * h.dfduu[i];
-      penaltyApproximation.dfdux.noalias() += penaltyDerivative(i) * h.dfdux[i];
-    }
+    accumulator.dfdu.noalias() += h.dfdu.transpose() * penaltyDerivative_;
   }
+  accumulateGaussNewtonHessian(h.dfdx, h.dfdu, accumulator);
 
-  return penaltyApproximation;
+  // second-order terms of the constraint, skipping the rows with zero penalty slope
+  for (size_t i = 0; i < numConstraints; i++) {
+    if (penaltyDerivative_(i) != 0.0) {
+      accumulator.dfdxx.noalias() += penaltyDerivative_(i) * h.dfdxx[i];
+      if (inputDim > 0) {
+        accumulator.dfduu.noalias() += penaltyDerivative_(i) * h.dfduu[i];
+        accumulator.dfdux.noalias() += penaltyDerivative_(i) * h.dfdux[i];
+      }
+    }
+  }  // end of i loop
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-std::tuple<scalar_t, vector_t, vector_t> MultidimensionalPenalty::getPenaltyValue1stDev2ndDev(scalar_t t, const vector_t& h,
-                                                                                              const vector_t* l) const {
+scalar_t MultidimensionalPenalty::computePenaltyValue1stDev2ndDev(scalar_t t, const vector_t& h, const vector_t* l, scalar_t scaling) const {
   const auto numConstraints = h.rows();
   assert(penaltyPtrArray_.size() == 1 || penaltyPtrArray_.size() == numConstraints);
 
   scalar_t penaltyValue = 0.0;
-  vector_t penaltyDerivative(numConstraints);
-  vector_t penaltySecondDerivative(numConstraints);
+  penaltyDerivative_.resize(numConstraints);
+  penaltySecondDerivative_.resize(numConstraints);
   for (size_t i = 0; i < numConstraints; i++) {
     const auto& penaltyTerm = (penaltyPtrArray_.size() == 1) ? penaltyPtrArray_[0] : penaltyPtrArray_[i];
     penaltyValue += penaltyTerm->getValue(t, getMultiplier(l, i), h(i));
-    penaltyDerivative(i) = penaltyTerm->getDerivative(t, getMultiplier(l, i), h(i));
-    penaltySecondDerivative(i) = penaltyTerm->getSecondDerivative(t, getMultiplier(l, i), h(i));
+    penaltyDerivative_(i) = penaltyTerm->getDerivative(t, getMultiplier(l, i), h(i));
+    penaltySecondDerivative_(i) = penaltyTerm->getSecondDerivative(t, getMultiplier(l, i), h(i));
   }  // end of i loop
 
-  return {penaltyValue, penaltyDerivative, penaltySecondDerivative};
+  if (scaling != 1.0) {
+    penaltyValue *= scaling;
+    penaltyDerivative_ *= scaling;
+    penaltySecondDerivative_ *= scaling;
+  }
+
+  return penaltyValue;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MultidimensionalPenalty::accumulateGaussNewtonHessian(const matrix_t& dhdx, const matrix_t& dhdu,
+                                                           ScalarFunctionQuadraticApproximation& accumulator) const {
+  const auto stateDim = dhdx.cols();
+  const auto inputDim = dhdu.cols();
+  const auto numConstraints = penaltySecondDerivative_.size();
+
+  // A negative curvature has no real square root: use the plain product (e.g. for some augmented Lagrangian penalties)
+  if ((penaltySecondDerivative_.array() < 0.0).any()) {
+    weightedJacobian_.noalias() = penaltySecondDerivative_.asDiagonal() * dhdx;
+    accumulator.dfdxx.noalias() += dhdx.transpose() * weightedJacobian_;
+    if (inputDim > 0) {
+      accumulator.dfdux.noalias() += dhdu.transpose() * weightedJacobian_;
+      weightedJacobian_.noalias() = penaltySecondDerivative_.asDiagonal() * dhdu;
+      accumulator.dfduu.noalias() += dhdu.transpose() * weightedJacobian_;
+    }
+    return;
+  }
+
+  // stack the active rows of sqrt(p'') * [dhdx, dhdu]; inactive rows (zero curvature) do not contribute
+  const auto numActive = (penaltySecondDerivative_.array() > 0.0).count();
+  if (numActive == 0) {
+    return;
+  }
+  weightedJacobian_.resize(numActive, stateDim + inputDim);
+  for (int i = 0, k = 0; i < numConstraints; i++) {
+    if (penaltySecondDerivative_(i) > 0.0) {
+      const scalar_t weight = std::sqrt(penaltySecondDerivative_(i));
+      weightedJacobian_.row(k).head(stateDim) = weight * dhdx.row(i);
+      if (inputDim > 0) {
+        weightedJacobian_.row(k).tail(inputDim) = weight * dhdu.row(i);
+      }
+      ++k;
+    }
+  }  // end of i loop
+
+  // symmetric rank-k update: only the lower triangle is computed
+  gaussNewtonHessian_.setZero(stateDim + inputDim, stateDim + inputDim);
+  gaussNewtonHessian_.selfadjointView<Eigen::Lower>().rankUpdate(weightedJacobian_.transpose());
+
+  accumulator.dfdxx += gaussNewtonHessian_.topLeftCorner(stateDim, stateDim).selfadjointView<Eigen::Lower>();
+  if (inputDim > 0) {
+    accumulator.dfdux += gaussNewtonHessian_.bottomLeftCorner(inputDim, stateDim);
+    accumulator.dfduu += gaussNewtonHessian_.bottomRightCorner(inputDim, inputDim).selfadjointView<Eigen::Lower>();
+  }
 }
 
 /******************************************************************************************************/
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_core/reference/TargetTrajectories.h"
 
+#include <algorithm>
+
 #include <ocs2_core/misc/Display.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
 
@@ -60,6 +62,7 @@ void TargetTrajectories::clear() {
   timeTrajectory.clear();
   stateTrajectory.clear();
   inputTrajectory.clear();
+  clearSamples();
 }
 
 /******************************************************************************************************/
@@ -77,6 +80,10 @@ vector_t TargetTrajectories::getDesiredState(scalar_t time) const {
   if (this->empty()) {
     throw std::runtime_error("[TargetTrajectories] TargetTrajectories is empty!");
   } else {
+    const int sampleIndex = findSample(time);
+    if (sampleIndex >= 0) {
+      return sampledStates_[sampleIndex];
+    }
     return LinearInterpolation::interpolate(time, timeTrajectory, stateTrajectory);
   }
 }
@@ -90,10 +97,52 @@ vector_t TargetTrajectories::getDesiredInput(scalar_t time) const {
   } else if (inputTrajectory.empty()) {
     throw std::runtime_error("[TargetTrajectories] TargetTrajectories does not have inputTrajectory!");
   } else {
+    const int sampleIndex = findSample(time);
+    if (sampleIndex >= 0) {
+      return sampledInputs_[sampleIndex];
+    }
     return LinearInterpolation::interpolate(time, timeTrajectory, inputTrajectory);
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+void TargetTrajectories::resample(const scalar_array_t& timeGrid) {
+  clearSamples();
+  if (this->empty() || !TrajectoryMatrix::isUniform(stateTrajectory) || !TrajectoryMatrix::isUniform(inputTrajectory)) {
+    return;
+  }
+
+  sampleTimes_ = timeGrid;
+  const auto indexAlphaArray = LinearInterpolation::timeSegments(sampleTimes_, timeTrajectory);
+  LinearInterpolation::interpolateBatch(indexAlphaArray, stateTrajectory, sampledStates_);
+  if (!inputTrajectory.empty()) {
+    LinearInterpolation::interpolateBatch(indexAlphaArray, inputTrajectory, sampledInputs_);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+void TargetTrajectories::clearSamples() {
+  sampleTimes_.clear();
+  sampledStates_.clear();
+  sampledInputs_.clear();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+int TargetTrajectories::findSample(scalar_t time) const {
+  const auto it = std::lower_bound(sampleTimes_.cbegin(), sampleTimes_.cend(), time);
+  if (it != sampleTimes_.cend() && *it == time) {
+    return static_cast<int>(it - sampleTimes_.cbegin());
+  } else {
+    return -1;
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /***************************************************************************************************** */
@@ -101,6 +150,9 @@ void swap(TargetTrajectories& lh, TargetTrajectories& rh) {
   lh.timeTrajectory.swap(rh.timeTrajectory);
   lh.stateTrajectory.swap(rh.stateTrajectory);
   lh.inputTrajectory.swap(rh.inputTrajectory);
+  lh.sampleTimes_.swap(rh.sampleTimes_);
+  lh.sampledStates_.swap(rh.sampledStates_);
+  lh.sampledInputs_.swap(rh.sampledInputs_);
 }
 
 /******************************************************************************************************/
@@ -0,0 +1,127 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include "ocs2_core/soft_constraint/InequalityActivityTracker.h"
+
+#include <algorithm>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+InequalityActivityTracker::InequalityActivityTracker(Settings settings) : settings_(std::move(settings)) {
+  if (settings_.derivativeTolerance < 0.0) {
+    throw std::runtime_error("[InequalityActivityTracker] The derivative tolerance should be non-negative!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void InequalityActivityTracker::advanceIteration(const scalar_array_t& timeTrajectory) {
+  // nodes which were not evaluated in the last iteration keep their history
+  for (size_t k = 0; k < numInactiveIterations_.size(); k++) {
+    if (nodeSlots_[k].isObserved.load(std::memory_order_relaxed)) {
+      numInactiveIterations_[k] = nodeSlots_[k].isNegligible.load(std::memory_order_relaxed) ? numInactiveIterations_[k] + 1 : 0;
+    }
+  }  // end of k loop
+
+  timeTrajectory_ = timeTrajectory;
+  numInactiveIterations_.resize(timeTrajectory_.size(), 0);
+  nodeSlots_.reset(new NodeSlot[timeTrajectory_.size()]);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool InequalityActivityTracker::update(scalar_t time, bool isNegligible) {
+  // the history and the nodes are only modified between the iterations, here each node only writes to its own slot
+  bool prune = false;
+  if (!timeTrajectory_.empty()) {
+    const size_t k = getNodeIndex(time);
+    nodeSlots_[k].isObserved.store(true, std::memory_order_relaxed);
+    if (!isNegligible) {
+      nodeSlots_[k].isNegligible.store(false, std::memory_order_relaxed);
+    }
+    prune = isNegligible && numInactiveIterations_[k] >= settings_.numInactiveIterations;
+  }
+
+  if (prune) {
+    numPruned_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    numFull_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return prune;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void InequalityActivityTracker::reset() {
+  timeTrajectory_.clear();
+  numInactiveIterations_.clear();
+  nodeSlots_.reset();
+  numPruned_ = 0;
+  numFull_ = 0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t InequalityActivityTracker::getNumPruned() const {
+  return numPruned_.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t InequalityActivityTracker::getNumFull() const {
+  return numFull_.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t InequalityActivityTracker::getNodeIndex(scalar_t time) const {
+  // closest node, the first one of the nodes with equal time at the events
+  const auto it = std::lower_bound(timeTrajectory_.begin(), timeTrajectory_.end(), time);
+  if (it == timeTrajectory_.end()) {
+    return timeTrajectory_.size() - 1;
+  }
+  const size_t k = std::distance(timeTrajectory_.begin(), it);
+  if (k > 0 && time - timeTrajectory_[k - 1] < *it - time) {
+    const auto prev = std::lower_bound(timeTrajectory_.begin(), timeTrajectory_.end(), timeTrajectory_[k - 1]);
+    return std::distance(timeTrajectory_.begin(), prev);
+  }
+  return k;
+}
+
+}  // namespace ocs2
@@ -49,7 +49,10 @@ StateInputSoftConstraint::StateInputSoftConstraint(std::unique_ptr<StateInputCon
 /******************************************************************************************************/
 /******************************************************************************************************/
 StateInputSoftConstraint::StateInputSoftConstraint(const StateInputSoftConstraint& other)
-    : StateInputCost(other), constraintPtr_(other.constraintPtr_->clone()), penalty_(other.penalty_) {}
+    : StateInputCost(other),
+      constraintPtr_(other.constraintPtr_->clone()),
+      penalty_(other.penalty_),
+      activityTrackerPtr_(other.activityTrackerPtr_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -79,6 +82,14 @@ scalar_t StateInputSoftConstraint::getValue(scalar_t time, const vector_t& state
 ScalarFunctionQuadraticApproximation StateInputSoftConstraint::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                          const vector_t& input, const TargetTrajectories&,
                                                                                          const PreComputation& preComp) const {
+  // pruning is decided on the constraint value such that the derivatives are only evaluated at the active nodes
+  if (activityTrackerPtr_ != nullptr) {
+    const auto h = constraintPtr_->getValue(time, state, input, preComp);
+    if (isPruned(time, h)) {
+      return getPenaltyValueApproximation(time, h, state.size(), input.size());
+    }
+  }
+
   switch (constraintPtr_->getOrder()) {
     case ConstraintOrder::Linear:
       return penalty_.getQuadraticApproximation(time, constraintPtr_->getLinearApproximation(time, state, input, preComp));
@@ -89,4 +100,59 @@ ScalarFunctionQuadraticApproximation StateInputSoftConstraint::getQuadraticAppro
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputSoftConstraint::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                const TargetTrajectories&, const PreComputation& preComp,
+                                                                ScalarFunctionQuadraticApproximation& accumulator) const {
+  // pruning is decided on the constraint value such that the derivatives are only evaluated at the active nodes
+  if (activityTrackerPtr_ != nullptr) {
+    const auto h = constraintPtr_->getValue(time, state, input, preComp);
+    if (isPruned(time, h)) {
+      accumulator.f += penalty_.getValue(time, h);
+      return;
+    }
+  }
+
+  switch (constraintPtr_->getOrder()) {
+    case ConstraintOrder::Linear: {
+      ApproximationSparsity sparsity;
+      const auto h = constraintPtr_->getSparseLinearApproximation(time, state, input, preComp, sparsity);
+      if (sparsity.isDense) {
+        penalty_.accumulateQuadraticApproximation(time, h, accumulator);
+      } else {
+        // penalize in the compact coordinates and only scatter the touched blocks
+        auto compact = ScalarFunctionQuadraticApproximation::Zero(h.dfdx.cols(), h.dfdu.cols());
+        penalty_.accumulateQuadraticApproximation(time, h, compact);
+        accumulateSparseApproximation(compact, sparsity, accumulator);
+      }
+      break;
+    }
+    case ConstraintOrder::Quadratic:
+      penalty_.accumulateQuadraticApproximation(time, constraintPtr_->getQuadraticApproximation(time, state, input, preComp), accumulator);
+      break;
+    default:
+      throw std::runtime_error("[StateInputSoftConstraint] Unknown constraint Order");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool StateInputSoftConstraint::isPruned(scalar_t time, const vector_t& h) const {
+  const bool isNegligible = penalty_.hasNegligibleDerivatives(time, h, activityTrackerPtr_->settings().derivativeTolerance);
+  return activityTrackerPtr_->update(time, isNegligible);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation StateInputSoftConstraint::getPenaltyValueApproximation(scalar_t time, const vector_t& h,
+                                                                                            int stateDim, int inputDim) const {
+  auto penaltyApproximation = ScalarFunctionQuadraticApproximation::Zero(stateDim, inputDim);
+  penaltyApproximation.f = penalty_.getValue(time, h);
+  return penaltyApproximation;
+}
+
 }  // namespace ocs2
@@ -48,7 +48,10 @@ StateSoftConstraint::StateSoftConstraint(std::unique_ptr<StateConstraint> constr
 /******************************************************************************************************/
 /******************************************************************************************************/
 StateSoftConstraint::StateSoftConstraint(const StateSoftConstraint& other)
-    : StateCost(other), constraintPtr_(other.constraintPtr_->clone()), penalty_(other.penalty_) {}
+    : StateCost(other),
+      constraintPtr_(other.constraintPtr_->clone()),
+      penalty_(other.penalty_),
+      activityTrackerPtr_(other.activityTrackerPtr_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -78,6 +81,14 @@ scalar_t StateSoftConstraint::getValue(scalar_t time, const vector_t& state, con
 ScalarFunctionQuadraticApproximation StateSoftConstraint::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                     const TargetTrajectories&,
                                                                                     const PreComputation& preComp) const {
+  // pruning is decided on the constraint value such that the derivatives are only evaluated at the active nodes
+  if (activityTrackerPtr_ != nullptr) {
+    const auto h = constraintPtr_->getValue(time, state, preComp);
+    if (isPruned(time, h)) {
+      return getPenaltyValueApproximation(time, h, state.size(), 0);
+    }
+  }
+
   switch (constraintPtr_->getOrder()) {
     case ConstraintOrder::Linear:
       return penalty_.getQuadraticApproximation(time, constraintPtr_->getLinearApproximation(time, state, preComp));
@@ -88,4 +99,49 @@ ScalarFunctionQuadraticApproximation StateSoftConstraint::getQuadraticApproximat
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateSoftConstraint::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories&,
+                                                           const PreComputation& preComp,
+                                                           ScalarFunctionQuadraticApproximation& accumulator) const {
+  // pruning is decided on the constraint value such that the derivatives are only evaluated at the active nodes
+  if (activityTrackerPtr_ != nullptr) {
+    const auto h = constraintPtr_->getValue(time, state, preComp);
+    if (isPruned(time, h)) {
+      accumulator.f += penalty_.getValue(time, h);
+      return;
+    }
+  }
+
+  switch (constraintPtr_->getOrder()) {
+    case ConstraintOrder::Linear:
+      penalty_.accumulateQuadraticApproximation(time, constraintPtr_->getLinearApproximation(time, state, preComp), accumulator);
+      break;
+    case ConstraintOrder::Quadratic:
+      penalty_.accumulateQuadraticApproximation(time, constraintPtr_->getQuadraticApproximation(time, state, preComp), accumulator);
+      break;
+    default:
+      throw std::runtime_error("[StateSoftConstraint] Unknown constraint Order");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool StateSoftConstraint::isPruned(scalar_t time, const vector_t& h) const {
+  const bool isNegligible = penalty_.hasNegligibleDerivatives(time, h, activityTrackerPtr_->settings().derivativeTolerance);
+  return activityTrackerPtr_->update(time, isNegligible);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation StateSoftConstraint::getPenaltyValueApproximation(scalar_t time, const vector_t& h, int stateDim,
+                                                                                       int inputDim) const {
+  auto penaltyApproximation = ScalarFunctionQuadraticApproximation::Zero(stateDim, inputDim);
+  penaltyApproximation.f = penalty_.getValue(time, h);
+  return penaltyApproximation;
+}
+
 }  // namespace ocs2
@@ -31,6 +31,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/constraint/LinearStateConstraint.h>
 #include <ocs2_core/constraint/LinearStateInputConstraint.h>
+#include <ocs2_core/constraint/StateInputConstraintCollection.h>
+#include <ocs2_core/penalties/penalties/QuadraticPenalty.h>
+#include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
 
 TEST(TestLinearConstraint, testLinearStateInputConstraint) {
   const ocs2::vector_t e = ocs2::vector_t::Random(3);
@@ -66,3 +69,46 @@ TEST(TestLinearConstraint, testLinearStateConstraint) {
   EXPECT_TRUE(approx.f.isApprox(value));
   EXPECT_TRUE(approx.dfdx.isApprox(C));
 }
+
+TEST(TestLinearConstraint, testSparseLinearStateInputConstraint) {
+  // the constraint only depends on x(1) and u(2)
+  const ocs2::vector_t e = ocs2::vector_t::Random(2);
+  ocs2::matrix_t C = ocs2::matrix_t::Zero(2, 6);
+  ocs2::matrix_t D = ocs2::matrix_t::Zero(2, 4);
+  C.col(1).setRandom();
+  D.col(2).setRandom();
+  const ocs2::LinearStateInputConstraint constraint(e, C, D);
+
+  const ocs2::scalar_t t = 0.0;
+  const ocs2::vector_t x = ocs2::vector_t::Random(6);
+  const ocs2::vector_t u = ocs2::vector_t::Random(4);
+
+  ocs2::ApproximationSparsity sparsity;
+  const auto compact = constraint.getSparseLinearApproximation(t, x, u, ocs2::PreComputation(), sparsity);
+  ASSERT_FALSE(sparsity.isDense);
+  EXPECT_EQ(sparsity.stateIndices, ocs2::size_array_t{1});
+  EXPECT_EQ(sparsity.inputIndices, ocs2::size_array_t{2});
+  EXPECT_TRUE(compact.f.isApprox(C * x + D * u + e));
+
+  // constraint collection fills in the dense rows
+  ocs2::StateInputConstraintCollection collection;
+  collection.add("sparse", std::unique_ptr<ocs2::StateInputConstraint>(constraint.clone()));
+  const auto approx = collection.getLinearApproximation(t, x, u, ocs2::PreComputation());
+  EXPECT_TRUE(approx.f.isApprox(compact.f));
+  EXPECT_TRUE(approx.dfdx.isApprox(C));
+  EXPECT_TRUE(approx.dfdu.isApprox(D));
+
+  // soft constraint penalizes in the compact coordinates
+  std::unique_ptr<ocs2::PenaltyBase> penalty(new ocs2::QuadraticPenalty(2.0));
+  ocs2::StateInputSoftConstraint softConstraint(std::unique_ptr<ocs2::StateInputConstraint>(constraint.clone()), std::move(penalty));
+  ocs2::MultidimensionalPenalty denseReference(std::unique_ptr<ocs2::PenaltyBase>(new ocs2::QuadraticPenalty(2.0)));
+  const auto expected = denseReference.getQuadraticApproximation(t, constraint.getLinearApproximation(t, x, u, ocs2::PreComputation()));
+  auto accumulator = ocs2::ScalarFunctionQuadraticApproximation::Zero(6, 4);
+  softConstraint.accumulateQuadraticApproximation(t, x, u, ocs2::TargetTrajectories(), ocs2::PreComputation(), accumulator);
+  EXPECT_NEAR(accumulator.f, expected.f, 1e-12);
+  EXPECT_TRUE(accumulator.dfdx.isApprox(expected.dfdx));
+  EXPECT_TRUE(accumulator.dfdu.isApprox(expected.dfdu));
+  EXPECT_TRUE(accumulator.dfdxx.isApprox(expected.dfdxx));
+  EXPECT_TRUE(accumulator.dfdux.isApprox(expected.dfdux));
+  EXPECT_TRUE(accumulator.dfduu.isApprox(expected.dfduu));
+}
@@ -117,6 +117,18 @@ TEST_F(StateInputCost_TestFixture, getStateInputCostApproximation) {
   EXPECT_TRUE((cost.dfdux.array() == 0.0).all());
 }
 
+TEST_F(StateInputCost_TestFixture, accumulateStateInputCostApproximation) {
+  auto accumulator = ocs2::ScalarFunctionQuadraticApproximation::Zero(STATE_DIM, INPUT_DIM);
+  accumulator.f = 1.0;
+  accumulator.dfdxx.setIdentity();
+  costCollection.accumulateQuadraticApproximation(t, x, u, targetTrajectories, {}, accumulator);
+  EXPECT_NEAR(accumulator.f, expectedCost + 1.0, 1e-6);
+  EXPECT_TRUE(accumulator.dfdx.isApprox(expectedCostApproximation.dfdx));
+  EXPECT_TRUE(accumulator.dfdu.isApprox(expectedCostApproximation.dfdu));
+  EXPECT_TRUE(accumulator.dfdxx.isApprox(expectedCostApproximation.dfdxx + ocs2::matrix_t::Identity(STATE_DIM, STATE_DIM)));
+  EXPECT_TRUE(accumulator.dfduu.isApprox(expectedCostApproximation.dfduu));
+}
+
 TEST_F(StateInputCost_TestFixture, canGetCostFunction) {
   const auto& costFunction = costCollection.get("Simple quadratic cost");
 }
@@ -220,3 +232,14 @@ TEST_F(StateCost_TestFixture, testStateCostApproximation) {
   EXPECT_TRUE(cost.dfdx.isApprox(expectedCostApproximation.dfdx));
   EXPECT_TRUE(cost.dfdxx.isApprox(expectedCostApproximation.dfdxx));
 }
+
+TEST_F(StateCost_TestFixture, accumulateStateCostApproximation) {
+  auto accumulator = ocs2::ScalarFunctionQuadraticApproximation::Zero(STATE_DIM, INPUT_DIM);
+  costCollection.accumulateQuadraticApproximation(t, x, targetTrajectories, {}, accumulator);
+  EXPECT_NEAR(accumulator.f, expectedCost, 1e-6);
+  EXPECT_TRUE(accumulator.dfdx.isApprox(expectedCostApproximation.dfdx));
+  EXPECT_TRUE(accumulator.dfdxx.isApprox(expectedCostApproximation.dfdxx));
+  // input blocks are left untouched by state-only costs
+  EXPECT_TRUE(accumulator.dfdu.isZero());
+  EXPECT_TRUE(accumulator.dfduu.isZero());
+}
@@ -132,3 +132,37 @@ TEST(testLinearInterpolation, testDifferentEigenSizes) {
   result = ocs2::LinearInterpolation::interpolate(1.1, times, data);
   EXPECT_TRUE(result.isApprox(data[1]));
 }
+
+TEST(testLinearInterpolation, testBatchInterpolation) {
+  // includes an event time and a short interval
+  const std::vector<double> times{0.0, 0.3, 0.5, 0.5, 1.0, 1.0 + 1e-12, 2.0};
+  std::vector<Eigen::VectorXd> data;
+  for (size_t i = 0; i < times.size(); i++) {
+    data.push_back(Eigen::VectorXd::Random(3));
+  }
+
+  std::vector<double> enquiryTimes{-1.0, 0.0, 0.0, 0.1, 0.3, 0.4, 0.5, 0.5, 0.7, 1.0, 1.0 + 1e-12, 1.5, 2.0, 3.0};
+  const auto indexAlphas = ocs2::LinearInterpolation::timeSegments(enquiryTimes, times);
+  ASSERT_EQ(indexAlphas.size(), enquiryTimes.size());
+
+  // preallocated output with the right sizes
+  std::vector<Eigen::VectorXd> output(enquiryTimes.size(), Eigen::VectorXd::Zero(3));
+  const auto* firstElementData = output.front().data();
+  ocs2::LinearInterpolation::interpolateBatch(enquiryTimes, times, data, output);
+  ASSERT_EQ(output.size(), enquiryTimes.size());
+  EXPECT_EQ(output.front().data(), firstElementData);
+
+  for (size_t i = 0; i < enquiryTimes.size(); i++) {
+    const auto indexAlpha = ocs2::LinearInterpolation::timeSegment(enquiryTimes[i], times);
+    EXPECT_EQ(indexAlphas[i].first, indexAlpha.first) << "t = " << enquiryTimes[i];
+    EXPECT_DOUBLE_EQ(indexAlphas[i].second, indexAlpha.second) << "t = " << enquiryTimes[i];
+    EXPECT_TRUE(output[i].isApprox(ocs2::LinearInterpolation::interpolate(enquiryTimes[i], times, data))) << "t = " << enquiryTimes[i];
+  }
+
+  // single element time array
+  const auto constantIndexAlphas = ocs2::LinearInterpolation::timeSegments(enquiryTimes, std::vector<double>{0.5});
+  for (const auto& indexAlpha : constantIndexAlphas) {
+    EXPECT_EQ(indexAlpha.first, 0);
+    EXPECT_DOUBLE_EQ(indexAlpha.second, 1.0);
+  }
+}
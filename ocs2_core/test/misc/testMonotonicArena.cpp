@@ -0,0 +1,115 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/AllocationCounterHooks.h>
+#include <ocs2_core/misc/MonotonicArena.h>
+
+using namespace ocs2;
+
+TEST(testMonotonicArena, alignmentAndReuse) {
+  MonotonicArena arena;
+  const auto mark = arena.mark();
+  auto* bytes = static_cast<char*>(arena.allocate(3, 1));
+  auto A = arena.matrix(5, 7);
+  auto v = arena.vector(11);
+  EXPECT_NE(bytes, nullptr);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(A.data()) % MonotonicArena::defaultAlignment, 0);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.data()) % MonotonicArena::defaultAlignment, 0);
+
+  A.setRandom();
+  v.setOnes();
+  const matrix_t Acopy = A;
+  EXPECT_TRUE(A.isApprox(Acopy));
+  EXPECT_GE(arena.getBytesInUse(), (5 * 7 + 11) * sizeof(scalar_t));
+
+  // rewinding hands out the same memory again
+  arena.rewind(mark);
+  EXPECT_EQ(arena.getBytesInUse(), 0);
+  EXPECT_EQ(static_cast<char*>(arena.allocate(3, 1)), bytes);
+}
+
+TEST(testMonotonicArena, coalesceOnReset) {
+  MonotonicArena arena(64);
+  for (int i = 0; i < 10; i++) {
+    arena.vector(100);
+  }
+  const auto numBlocks = arena.getNumBlockAllocations();
+  EXPECT_GT(numBlocks, 1);
+
+  arena.reset();
+  const auto capacity = arena.getCapacity();
+  EXPECT_EQ(arena.getNumBlockAllocations(), numBlocks + 1);
+
+  // the steady-state workload fits into the coalesced block
+  for (int iter = 0; iter < 3; iter++) {
+    for (int i = 0; i < 10; i++) {
+      arena.vector(100);
+    }
+    arena.reset();
+  }
+  EXPECT_EQ(arena.getNumBlockAllocations(), numBlocks + 1);
+  EXPECT_EQ(arena.getCapacity(), capacity);
+}
+
+TEST(testMonotonicArena, noHeapAllocationInSteadyState) {
+  ASSERT_TRUE(allocation_counter::isEnabled());
+  auto& arena = getThreadLocalArena();
+
+  const auto workload = [&arena]() {
+    MonotonicArena::Scope scope(arena);
+    auto A = arena.matrix(12, 12);
+    auto b = arena.vector(12);
+    auto Ab = arena.vector(12);
+    A.setIdentity();
+    b.setOnes();
+    Ab.noalias() = A * b;
+    std::vector<scalar_t, ArenaAllocator<scalar_t>> values{ArenaAllocator<scalar_t>(arena)};
+    values.reserve(32);
+    values.push_back(Ab.sum());
+    return values.front();
+  };
+
+  workload();  // warm-up
+  const auto countBefore = allocation_counter::getCount();
+  scalar_t sum = 0.0;
+  for (int i = 0; i < 10; i++) {
+    sum += workload();
+  }
+  EXPECT_EQ(allocation_counter::getCount(), countBefore);
+  EXPECT_DOUBLE_EQ(sum, 120.0);
+
+  // the counter sees allocations from dynamic-size Eigen types
+  const auto countBeforeDynamic = allocation_counter::getCount();
+  const vector_t dynamicVector = vector_t::Ones(100);
+  EXPECT_GT(allocation_counter::getCount(), countBeforeDynamic);
+  EXPECT_DOUBLE_EQ(dynamicVector.sum(), 100.0);
+}
@@ -0,0 +1,124 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_core/misc/TrajectoryMatrix.h>
+
+using namespace ocs2;
+
+TEST(testTrajectoryMatrix, arrayRoundTrip) {
+  vector_array_t array(7, vector_t::Zero(4));
+  for (auto& v : array) {
+    v.setRandom();
+  }
+
+  const TrajectoryMatrix trajectory(array);
+  ASSERT_EQ(trajectory.size(), array.size());
+  ASSERT_EQ(trajectory.rows(), 4);
+  for (size_t k = 0; k < array.size(); k++) {
+    EXPECT_TRUE(trajectory[k].isApprox(array[k]));
+    // nodes are stored back to back
+    EXPECT_EQ(trajectory[k].data(), trajectory.data() + k * trajectory.rows());
+  }
+  EXPECT_TRUE(trajectory.back().isApprox(array.back()));
+
+  const auto copy = trajectory.toArray();
+  ASSERT_EQ(copy.size(), array.size());
+  for (size_t k = 0; k < array.size(); k++) {
+    EXPECT_TRUE(copy[k].isApprox(array[k]));
+  }
+}
+
+TEST(testTrajectoryMatrix, pushBack) {
+  TrajectoryMatrix trajectory;
+  vector_array_t array;
+  for (size_t k = 0; k < 100; k++) {
+    array.push_back(vector_t::Random(3));
+    trajectory.push_back(array.back());
+  }
+  ASSERT_EQ(trajectory.size(), array.size());
+  EXPECT_GE(trajectory.capacity(), trajectory.size());
+  for (size_t k = 0; k < array.size(); k++) {
+    EXPECT_TRUE(trajectory[k].isApprox(array[k]));
+  }
+  EXPECT_TRUE(trajectory.matrix().col(42).isApprox(array[42]));
+
+  EXPECT_ANY_THROW(trajectory.push_back(vector_t::Zero(2)));
+
+  // clear keeps the memory and allows a new dimension
+  trajectory.clear();
+  EXPECT_TRUE(trajectory.empty());
+  trajectory.push_back(vector_t::Ones(5));
+  EXPECT_EQ(trajectory.rows(), 5);
+  EXPECT_EQ(trajectory.size(), 1);
+}
+
+TEST(testTrajectoryMatrix, nonUniformArray) {
+  const vector_array_t array{vector_t::Zero(2), vector_t::Zero(3)};
+  EXPECT_FALSE(TrajectoryMatrix::isUniform(array));
+  EXPECT_ANY_THROW(TrajectoryMatrix{array});
+}
+
+TEST(testTrajectoryMatrix, interpolation) {
+  const scalar_array_t timeArray{0.0, 0.5, 1.0, 1.0, 2.0};
+  vector_array_t array;
+  for (size_t k = 0; k < timeArray.size(); k++) {
+    array.push_back(vector_t::Random(6));
+  }
+  const TrajectoryMatrix trajectory(array);
+
+  for (const scalar_t t : {-1.0, 0.0, 0.25, 0.5, 0.9, 1.0, 1.5, 2.0, 3.0}) {
+    const vector_t expected = LinearInterpolation::interpolate(t, timeArray, array);
+    const vector_t actual = LinearInterpolation::interpolate(t, timeArray, trajectory);
+    EXPECT_TRUE(actual.isApprox(expected)) << "t = " << t;
+  }
+
+  // single node implies a constant function
+  const TrajectoryMatrix single(vector_array_t{array.front()});
+  EXPECT_TRUE(LinearInterpolation::interpolate(0.7, scalar_array_t{0.0}, single).isApprox(array.front()));
+}
+
+TEST(testTrajectoryMatrix, batchInterpolation) {
+  const scalar_array_t timeArray{0.0, 0.5, 1.0, 1.0, 2.0};
+  vector_array_t array;
+  for (size_t k = 0; k < timeArray.size(); k++) {
+    array.push_back(vector_t::Random(4));
+  }
+
+  const scalar_array_t enquiryTimes{-0.5, 0.0, 0.2, 0.7, 1.0, 1.0, 1.2, 2.5};
+  TrajectoryMatrix output;
+  LinearInterpolation::interpolateBatch(enquiryTimes, timeArray, array, output);
+  ASSERT_EQ(output.size(), enquiryTimes.size());
+  for (size_t i = 0; i < enquiryTimes.size(); i++) {
+    EXPECT_TRUE(output[i].isApprox(LinearInterpolation::interpolate(enquiryTimes[i], timeArray, array))) << "t = " << enquiryTimes[i];
+  }
+}
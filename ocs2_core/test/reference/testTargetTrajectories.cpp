@@ -0,0 +1,94 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+
+using namespace ocs2;
+
+namespace {
+TargetTrajectories getRandomTargetTrajectories() {
+  const scalar_array_t timeTrajectory{0.0, 0.4, 1.0, 1.0, 2.0};
+  vector_array_t stateTrajectory, inputTrajectory;
+  for (size_t i = 0; i < timeTrajectory.size(); i++) {
+    stateTrajectory.push_back(vector_t::Random(3));
+    inputTrajectory.push_back(vector_t::Random(2));
+  }
+  return {timeTrajectory, stateTrajectory, inputTrajectory};
+}
+}  // unnamed namespace
+
+TEST(testTargetTrajectories, resample) {
+  const auto reference = getRandomTargetTrajectories();
+  auto sampled = reference;
+
+  const scalar_array_t timeGrid{0.0, 0.1, 0.5, 1.0, 1.5, 2.5};
+  sampled.resample(timeGrid);
+  ASSERT_EQ(sampled.numSamples(), timeGrid.size());
+
+  // on and off the sampling grid
+  for (const scalar_t t : {-1.0, 0.0, 0.05, 0.1, 0.5, 0.7, 1.0, 1.5, 2.0, 2.5}) {
+    EXPECT_TRUE(sampled.getDesiredState(t).isApprox(reference.getDesiredState(t))) << "t = " << t;
+    EXPECT_TRUE(sampled.getDesiredInput(t).isApprox(reference.getDesiredInput(t))) << "t = " << t;
+  }
+}
+
+TEST(testTargetTrajectories, samplesAreDropped) {
+  auto sampled = getRandomTargetTrajectories();
+  sampled.resample({0.5, 1.5});
+
+  // the samples are used instead of the trajectories
+  const vector_t cachedState = sampled.getDesiredState(0.5);
+  sampled.stateTrajectory[0].setZero();
+  sampled.stateTrajectory[1].setZero();
+  EXPECT_TRUE(sampled.getDesiredState(0.5).isApprox(cachedState));
+
+  sampled.clearSamples();
+  EXPECT_EQ(sampled.numSamples(), 0);
+  EXPECT_TRUE(sampled.getDesiredState(0.5).isApprox(sampled.stateTrajectory[2] / 6.0));
+
+  sampled.resample({0.5});
+  sampled.clear();
+  EXPECT_EQ(sampled.numSamples(), 0);
+  EXPECT_ANY_THROW(sampled.getDesiredState(0.5));
+}
+
+TEST(testTargetTrajectories, nonUniformNodes) {
+  auto reference = getRandomTargetTrajectories();
+  reference.stateTrajectory.back() = vector_t::Random(4);
+
+  // the samples are stored contiguously, therefore nothing is sampled for nodes of different dimensions
+  reference.resample({0.5, 1.5});
+  EXPECT_EQ(reference.numSamples(), 0);
+  EXPECT_TRUE(reference.getDesiredInput(0.5).isApprox(LinearInterpolation::interpolate(0.5, reference.timeTrajectory,
+                                                                                         reference.inputTrajectory)));
+}
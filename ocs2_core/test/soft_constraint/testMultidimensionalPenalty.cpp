@@ -0,0 +1,145 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/penalties/MultidimensionalPenalty.h>
+#include <ocs2_core/penalties/Penalties.h>
+
+using namespace ocs2;
+
+namespace {
+/** A penalty with negative curvature for h < 0 */
+class CubicPenalty final : public PenaltyBase {
+ public:
+  CubicPenalty* clone() const override { return new CubicPenalty(*this); }
+  std::string name() const override { return "CubicPenalty"; }
+  scalar_t getValue(scalar_t t, scalar_t h) const override { return h * h * h; }
+  scalar_t getDerivative(scalar_t t, scalar_t h) const override { return 3.0 * h * h; }
+  scalar_t getSecondDerivative(scalar_t t, scalar_t h) const override { return 6.0 * h; }
+};
+
+/** Reference implementation with dense products */
+ScalarFunctionQuadraticApproximation referenceApproximation(const PenaltyBase& penalty, const VectorFunctionLinearApproximation& h) {
+  const auto numConstraints = h.f.size();
+  vector_t d1(numConstraints), d2(numConstraints);
+  auto approximation = ScalarFunctionQuadraticApproximation::Zero(h.dfdx.cols(), h.dfdu.cols());
+  for (int i = 0; i < numConstraints; i++) {
+    approximation.f += penalty.getValue(0.0, h.f(i));
+    d1(i) = penalty.getDerivative(0.0, h.f(i));
+    d2(i) = penalty.getSecondDerivative(0.0, h.f(i));
+  }
+  approximation.dfdx = h.dfdx.transpose() * d1;
+  approximation.dfdu = h.dfdu.transpose() * d1;
+  approximation.dfdxx = h.dfdx.transpose() * d2.asDiagonal() * h.dfdx;
+  approximation.dfdux = h.dfdu.transpose() * d2.asDiagonal() * h.dfdx;
+  approximation.dfduu = h.dfdu.transpose() * d2.asDiagonal() * h.dfdu;
+  return approximation;
+}
+
+VectorFunctionLinearApproximation getRandomConstraint(size_t numConstraints, size_t stateDim, size_t inputDim) {
+  VectorFunctionLinearApproximation h;
+  h.f = vector_t::Random(numConstraints);
+  h.dfdx = matrix_t::Random(numConstraints, stateDim);
+  h.dfdu = matrix_t::Random(numConstraints, inputDim);
+  return h;
+}
+
+void checkApproximation(const PenaltyBase& penalty, const VectorFunctionLinearApproximation& h) {
+  const MultidimensionalPenalty multidimensionalPenalty(std::unique_ptr<PenaltyBase>(penalty.clone()));
+  const auto expected = referenceApproximation(penalty, h);
+  // evaluate twice to exercise the reuse of the scratch memory
+  multidimensionalPenalty.getQuadraticApproximation(0.0, getRandomConstraint(h.f.size() + 3, h.dfdx.cols(), h.dfdu.cols()));
+  const auto actual = multidimensionalPenalty.getQuadraticApproximation(0.0, h);
+  EXPECT_NEAR(actual.f, expected.f, 1e-9);
+  EXPECT_TRUE(actual.dfdx.isApprox(expected.dfdx));
+  EXPECT_TRUE(actual.dfdu.isApprox(expected.dfdu));
+  EXPECT_TRUE(actual.dfdxx.isApprox(expected.dfdxx));
+  EXPECT_TRUE(actual.dfdux.isApprox(expected.dfdux));
+  EXPECT_TRUE(actual.dfduu.isApprox(expected.dfduu));
+}
+}  // unnamed namespace
+
+TEST(testMultidimensionalPenalty, gaussNewtonHessian) {
+  const auto h = getRandomConstraint(10, 6, 3);
+  checkApproximation(RelaxedBarrierPenalty({0.1, 0.5}), h);
+  // about half of the rows are inactive
+  checkApproximation(SquaredHingePenalty({10.0, 0.01}), h);
+  // negative curvature
+  checkApproximation(CubicPenalty(), h);
+}
+
+TEST(testMultidimensionalPenalty, stateOnlyGaussNewtonHessian) {
+  const auto h = getRandomConstraint(8, 5, 0);
+  checkApproximation(SquaredHingePenalty({10.0, 0.01}), h);
+}
+
+TEST(testMultidimensionalPenalty, benchmarkGaussNewtonHessian) {
+  constexpr size_t numRepetitions = 10000;
+  constexpr size_t numConstraints = 50;
+  constexpr size_t stateDim = 24;
+  constexpr size_t inputDim = 12;
+
+  for (const bool allActive : {true, false}) {
+    std::unique_ptr<PenaltyBase> penaltyPtr;
+    if (allActive) {
+      penaltyPtr.reset(new RelaxedBarrierPenalty({0.1, 0.5}));
+    } else {
+      penaltyPtr.reset(new SquaredHingePenalty({10.0, 0.01}));
+    }
+    const MultidimensionalPenalty multidimensionalPenalty(std::unique_ptr<PenaltyBase>(penaltyPtr->clone()));
+    const auto h = getRandomConstraint(numConstraints, stateDim, inputDim);
+
+    benchmark::RepeatedTimer denseTimer, rankUpdateTimer;
+    auto accumulator = ScalarFunctionQuadraticApproximation::Zero(stateDim, inputDim);
+    scalar_t checksum = 0.0;
+    for (size_t n = 0; n < numRepetitions; n++) {
+      denseTimer.startTimer();
+      const auto expected = referenceApproximation(*penaltyPtr, h);
+      denseTimer.endTimer();
+      checksum += expected.dfdxx.sum() + expected.dfduu.sum();
+
+      accumulator.setZero(stateDim, inputDim);
+      rankUpdateTimer.startTimer();
+      multidimensionalPenalty.accumulateQuadraticApproximation(0.0, h, accumulator);
+      rankUpdateTimer.endTimer();
+      checksum -= accumulator.dfdxx.sum() + accumulator.dfduu.sum();
+    }  // end of n loop
+
+    std::cerr << "[MultidimensionalPenalty] Hessian of " << numConstraints << " constraints (nx = " << stateDim << ", nu = " << inputDim
+              << ", " << (allActive ? "all rows active" : "partially active") << ")\n";
+    std::cerr << "  dense products: " << 1e3 * denseTimer.getAverageInMilliseconds() << " [us]\n";
+    std::cerr << "  rank-k update:  " << 1e3 * rankUpdateTimer.getAverageInMilliseconds() << " [us]\n";
+    EXPECT_NEAR(checksum, 0.0, 1e-6 * numRepetitions);
+  }
+}
@@ -27,8 +27,12 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <thread>
+
 #include <gtest/gtest.h>
 
+#include <ocs2_core/constraint/LinearStateConstraint.h>
+#include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/penalties/Penalties.h>
 #include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
 #include <ocs2_core/soft_constraint/StateSoftConstraint.h>
@@ -226,3 +230,233 @@ TEST(testSoftConstraint, checkActivityStateInputConstraint) {
   softConstraint->get<ActivityTestStateInputConstraint>().setActivity(false);
   EXPECT_FALSE(std::unique_ptr<ocs2::StateInputCost>(softConstraint->clone())->isActive(0.0));
 }
+
+TEST(testSoftConstraint, activityTracker) {
+  ocs2::InequalityActivityTracker::Settings settings;
+  settings.derivativeTolerance = 1e-6;
+  settings.numInactiveIterations = 2;
+
+  // h = x
+  std::unique_ptr<ocs2::LinearStateConstraint> constraint(
+      new ocs2::LinearStateConstraint(ocs2::vector_t::Zero(2), ocs2::matrix_t::Identity(2, 2)));
+  std::unique_ptr<ocs2::RelaxedBarrierPenalty> penalty(new ocs2::RelaxedBarrierPenalty({1e-6, 1e-3}));
+  ocs2::StateSoftConstraint softConstraint(std::move(constraint), std::move(penalty));
+  softConstraint.setActivityTracker(std::make_shared<ocs2::InequalityActivityTracker>(settings));
+  std::unique_ptr<ocs2::StateSoftConstraint> softConstraintClone(softConstraint.clone());
+  ASSERT_EQ(softConstraintClone->getActivityTracker(), softConstraint.getActivityTracker());
+  auto& tracker = *softConstraint.getActivityTracker();
+
+  const ocs2::TargetTrajectories targetTrajectories;
+  const ocs2::PreComputation preComp;
+  const ocs2::vector_t farState = ocs2::vector_t::Constant(2, 10.0);  // penalty derivatives: 1e-7 and 1e-8
+  const ocs2::vector_t nearState = ocs2::vector_t::Constant(2, 1e-4);
+  const ocs2::scalar_t value = softConstraint.getValue(0.0, farState, targetTrajectories, preComp);
+  const auto isPruned = [&](const ocs2::StateSoftConstraint& term, ocs2::scalar_t time, const ocs2::vector_t& state) {
+    const auto approximation = term.getQuadraticApproximation(time, state, targetTrajectories, preComp);
+    return approximation.dfdx.isZero(0.0) && approximation.dfdxx.isZero(0.0);
+  };
+
+  // nothing is pruned before the first iteration callback
+  EXPECT_FALSE(isPruned(softConstraint, 0.0, farState));
+  EXPECT_FALSE(isPruned(softConstraint, 0.0, farState));
+  EXPECT_FALSE(isPruned(softConstraint, 0.0, farState));
+
+  // full approximation in the first numInactiveIterations iterations, independent of the number of evaluations per iteration
+  const ocs2::scalar_array_t timeTrajectory{0.0, 0.1, 0.2};
+  for (size_t iter = 0; iter < settings.numInactiveIterations; iter++) {
+    tracker.advanceIteration(timeTrajectory);
+    EXPECT_FALSE(isPruned(softConstraint, 0.0, farState));
+    EXPECT_FALSE(isPruned(*softConstraintClone, 0.01, farState));  // same node, shared between the clones
+  }
+
+  // the pruned approximation only keeps the value and is consistent with the full one
+  tracker.advanceIteration(timeTrajectory);
+  const auto pruned = softConstraint.getQuadraticApproximation(0.0, farState, targetTrajectories, preComp);
+  EXPECT_DOUBLE_EQ(pruned.f, value);
+  EXPECT_TRUE(pruned.dfdx.isZero(0.0));
+  EXPECT_TRUE(pruned.dfdxx.isZero(0.0));
+  EXPECT_EQ(pruned.dfdx.size(), 2);
+  EXPECT_TRUE(isPruned(*softConstraintClone, 0.0, farState));
+
+  auto accumulator = ocs2::ScalarFunctionQuadraticApproximation::Zero(2, 0);
+  softConstraintClone->accumulateQuadraticApproximation(0.0, farState, targetTrajectories, preComp, accumulator);
+  EXPECT_DOUBLE_EQ(accumulator.f, value);
+  EXPECT_TRUE(accumulator.dfdx.isZero(0.0));
+
+  // other nodes have their own history
+  EXPECT_FALSE(isPruned(softConstraint, 0.1, farState));
+
+  // re-enabled as soon as the node approaches the boundary, and its history restarts in the next iteration
+  EXPECT_FALSE(isPruned(softConstraint, 0.0, nearState));
+  tracker.advanceIteration(timeTrajectory);
+  EXPECT_FALSE(isPruned(softConstraint, 0.0, farState));
+
+  EXPECT_EQ(tracker.getNumPruned(), 3);
+  EXPECT_EQ(tracker.getNumFull(), 10);
+
+  tracker.reset();
+  EXPECT_EQ(tracker.getNumPruned(), 0);
+  EXPECT_EQ(tracker.getNumFull(), 0);
+  EXPECT_FALSE(isPruned(softConstraint, 0.0, farState));
+}
+
+/** h = x, counts the evaluations of its Jacobian. */
+class JacobianCountingStateConstraint final : public ocs2::StateConstraint {
+ public:
+  explicit JacobianCountingStateConstraint(std::shared_ptr<size_t> numJacobiansPtr)
+      : StateConstraint(ocs2::ConstraintOrder::Linear), numJacobiansPtr_(std::move(numJacobiansPtr)) {}
+  ~JacobianCountingStateConstraint() override = default;
+  JacobianCountingStateConstraint* clone() const override { return new JacobianCountingStateConstraint(*this); }
+
+  size_t getNumConstraints(ocs2::scalar_t time) const override { return 2; }
+  ocs2::vector_t getValue(ocs2::scalar_t time, const ocs2::vector_t& state, const ocs2::PreComputation&) const override { return state; }
+  ocs2::VectorFunctionLinearApproximation getLinearApproximation(ocs2::scalar_t time, const ocs2::vector_t& state,
+                                                                 const ocs2::PreComputation&) const override {
+    ++(*numJacobiansPtr_);
+    ocs2::VectorFunctionLinearApproximation h;
+    h.f = state;
+    h.dfdx.setIdentity(state.size(), state.size());
+    return h;
+  }
+
+ private:
+  JacobianCountingStateConstraint(const JacobianCountingStateConstraint& other) = default;
+
+  std::shared_ptr<size_t> numJacobiansPtr_;
+};
+
+TEST(testSoftConstraint, activityTrackerSkipsDerivatives) {
+  ocs2::InequalityActivityTracker::Settings settings;
+  settings.derivativeTolerance = 1e-6;
+  settings.numInactiveIterations = 1;
+
+  auto numJacobiansPtr = std::make_shared<size_t>(0);
+  std::unique_ptr<JacobianCountingStateConstraint> constraint(new JacobianCountingStateConstraint(numJacobiansPtr));
+  std::unique_ptr<ocs2::RelaxedBarrierPenalty> penalty(new ocs2::RelaxedBarrierPenalty({1e-6, 1e-3}));
+  ocs2::StateSoftConstraint softConstraint(std::move(constraint), std::move(penalty));
+  softConstraint.setActivityTracker(std::make_shared<ocs2::InequalityActivityTracker>(settings));
+  auto& tracker = *softConstraint.getActivityTracker();
+
+  const ocs2::TargetTrajectories targetTrajectories;
+  const ocs2::PreComputation preComp;
+  const ocs2::vector_t farState = ocs2::vector_t::Constant(2, 10.0);
+  const ocs2::vector_t nearState = ocs2::vector_t::Constant(2, 1e-4);
+  const ocs2::scalar_array_t timeTrajectory{0.0, 0.1};
+  auto accumulator = ocs2::ScalarFunctionQuadraticApproximation::Zero(2, 0);
+
+  // the first iteration records the history and evaluates the Jacobian
+  tracker.advanceIteration(timeTrajectory);
+  softConstraint.accumulateQuadraticApproximation(0.0, farState, targetTrajectories, preComp, accumulator);
+  EXPECT_EQ(*numJacobiansPtr, 1);
+
+  // pruned nodes only evaluate the constraint value
+  tracker.advanceIteration(timeTrajectory);
+  softConstraint.accumulateQuadraticApproximation(0.0, farState, targetTrajectories, preComp, accumulator);
+  softConstraint.getQuadraticApproximation(0.0, farState, targetTrajectories, preComp);
+  EXPECT_EQ(*numJacobiansPtr, 1);
+  EXPECT_EQ(tracker.getNumPruned(), 2);
+
+  // a node close to the boundary is never pruned
+  softConstraint.getQuadraticApproximation(0.0, nearState, targetTrajectories, preComp);
+  EXPECT_EQ(*numJacobiansPtr, 2);
+}
+
+TEST(testSoftConstraint, activityTrackerConcurrentUpdates) {
+  constexpr size_t numNodes = 64;
+  constexpr size_t numThreads = 4;
+  ocs2::InequalityActivityTracker::Settings settings;
+  settings.numInactiveIterations = 1;
+  ocs2::InequalityActivityTracker tracker(settings);
+
+  ocs2::scalar_array_t timeTrajectory(numNodes);
+  for (size_t k = 0; k < numNodes; k++) {
+    timeTrajectory[k] = 0.01 * k;
+  }
+
+  // every node is evaluated by all the threads, only the odd nodes are negligible in all the evaluations
+  const auto evaluateNodes = [&]() {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < numThreads; i++) {
+      threads.emplace_back([&, i]() {
+        for (size_t k = 0; k < numNodes; k++) {
+          tracker.update(timeTrajectory[k], k % 2 == 1 || i != 0);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  };
+
+  tracker.advanceIteration(timeTrajectory);
+  evaluateNodes();
+  EXPECT_EQ(tracker.getNumPruned(), 0);
+  EXPECT_EQ(tracker.getNumFull(), numThreads * numNodes);
+
+  // in the next iteration the odd nodes are pruned by the threads which report them as negligible
+  tracker.advanceIteration(timeTrajectory);
+  evaluateNodes();
+  EXPECT_EQ(tracker.getNumPruned(), numThreads * numNodes / 2);
+  EXPECT_EQ(tracker.getNumFull(), numThreads * numNodes + numThreads * numNodes / 2);
+}
+
+TEST(testSoftConstraint, activityTrackerTiming) {
+  constexpr size_t stateDim = 30;
+  constexpr size_t numConstraints = 100;
+  constexpr size_t numNodes = 100;
+  constexpr size_t numIterations = 20;
+
+  // h = C x + e with all rows far from the boundary at the evaluation points
+  const ocs2::vector_t e = ocs2::vector_t::Constant(numConstraints, 1e3);
+  const ocs2::matrix_t C = ocs2::matrix_t::Random(numConstraints, stateDim);
+  const auto getSoftConstraint = [&]() {
+    std::unique_ptr<ocs2::LinearStateConstraint> constraint(new ocs2::LinearStateConstraint(e, C));
+    std::unique_ptr<ocs2::RelaxedBarrierPenalty> penalty(new ocs2::RelaxedBarrierPenalty({1e-3, 1e-3}));
+    return std::unique_ptr<ocs2::StateSoftConstraint>(new ocs2::StateSoftConstraint(std::move(constraint), std::move(penalty)));
+  };
+  auto fullConstraint = getSoftConstraint();
+  auto trackedConstraint = getSoftConstraint();
+  ocs2::InequalityActivityTracker::Settings settings;
+  settings.derivativeTolerance = 1e-5;
+  settings.numInactiveIterations = 2;
+  trackedConstraint->setActivityTracker(std::make_shared<ocs2::InequalityActivityTracker>(settings));
+
+  ocs2::scalar_array_t timeTrajectory(numNodes);
+  ocs2::vector_array_t stateTrajectory(numNodes);
+  for (size_t k = 0; k < numNodes; k++) {
+    timeTrajectory[k] = 0.01 * k;
+    stateTrajectory[k] = ocs2::vector_t::Random(stateDim);
+  }
+
+  const ocs2::TargetTrajectories targetTrajectories;
+  const ocs2::PreComputation preComp;
+  ocs2::benchmark::RepeatedTimer fullTimer;
+  ocs2::benchmark::RepeatedTimer trackedTimer;
+  for (size_t iter = 0; iter < numIterations; iter++) {
+    trackedConstraint->getActivityTracker()->advanceIteration(timeTrajectory);
+    for (size_t k = 0; k < numNodes; k++) {
+      auto fullApproximation = ocs2::ScalarFunctionQuadraticApproximation::Zero(stateDim, 0);
+      fullTimer.startTimer();
+      fullConstraint->accumulateQuadraticApproximation(timeTrajectory[k], stateTrajectory[k], targetTrajectories, preComp,
+                                                       fullApproximation);
+      fullTimer.endTimer();
+
+      auto trackedApproximation = ocs2::ScalarFunctionQuadraticApproximation::Zero(stateDim, 0);
+      trackedTimer.startTimer();
+      trackedConstraint->accumulateQuadraticApproximation(timeTrajectory[k], stateTrajectory[k], targetTrajectories, preComp,
+                                                          trackedApproximation);
+      trackedTimer.endTimer();
+
+      ASSERT_DOUBLE_EQ(fullApproximation.f, trackedApproximation.f);
+      ASSERT_TRUE((trackedApproximation.dfdx - fullApproximation.dfdx).isZero(1e-3));
+      ASSERT_TRUE((trackedApproximation.dfdxx - fullApproximation.dfdxx).isZero(1e-3));
+    }  // end of k loop
+  }    // end of iter loop
+
+  const auto& tracker = *trackedConstraint->getActivityTracker();
+  EXPECT_EQ(tracker.getNumPruned(), (numIterations - settings.numInactiveIterations) * numNodes);
+  std::cerr << "[InequalityActivityTracker] " << numConstraints << " rows, " << stateDim
+            << " states, average time of the full approximation: " << fullTimer.getAverageInMilliseconds()
+            << " [ms], with the activity tracker: " << trackedTimer.getAverageInMilliseconds() << " [ms] (" << tracker.getNumPruned()
+            << " pruned, " << tracker.getNumFull() << " full)\n";
+}
@@ -74,3 +74,77 @@ TEST(testPrecomputation, containtsAnyAll) {
   constexpr auto request3 = Request::Constraint + Request::Cost + Request::Approximation;
   ASSERT_TRUE(request3.containsAll(request2));
 }
+
+namespace {
+/** Counts the computed items, caching on the request arguments */
+class CachingPreComputation final : public ocs2::PreComputation {
+ public:
+  CachingPreComputation* clone() const override { return new CachingPreComputation(*this); }
+
+  void request(ocs2::RequestSet request, ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u) override {
+    const auto cached = updateRequestCache(CallbackType::Intermediate, request, t, x, u);
+    lastMissing = cached.missing;
+    lastComputed = cached.computed;
+  }
+
+  void requestFinal(ocs2::RequestSet request, ocs2::scalar_t t, const ocs2::vector_t& x) override {
+    lastMissing = updateRequestCache(CallbackType::Final, request, t, x).missing;
+  }
+
+  ocs2::RequestSet lastMissing;
+  ocs2::RequestSet lastComputed;
+};
+}  // unnamed namespace
+
+TEST(testPrecomputation, emptySet) {
+  constexpr ocs2::RequestSet request;
+  ASSERT_TRUE(request.empty());
+  ASSERT_FALSE(request.contains(Request::Cost));
+  ASSERT_FALSE((request + Request::Cost).empty());
+}
+
+TEST(testPrecomputation, requestCache) {
+  const ocs2::vector_t x = ocs2::vector_t::Random(3);
+  const ocs2::vector_t u = ocs2::vector_t::Random(2);
+  CachingPreComputation preComputation;
+
+  // first call computes everything
+  preComputation.request(Request::Cost + Request::Constraint, 0.1, x, u);
+  ASSERT_TRUE(preComputation.lastMissing.containsAll(Request::Cost + Request::Constraint));
+  ASSERT_TRUE(preComputation.lastComputed.empty());
+
+  // same point and subset of the request: hit
+  preComputation.request(Request::Cost, 0.1, x, u);
+  ASSERT_TRUE(preComputation.lastMissing.empty());
+
+  // approximation of a computed value: only the delta is missing
+  preComputation.request(Request::Cost + Request::Approximation, 0.1, x, u);
+  ASSERT_TRUE(preComputation.lastMissing.containsAll(Request::Cost + Request::Approximation));
+  ASSERT_FALSE(preComputation.lastMissing.contains(Request::Constraint));
+  ASSERT_TRUE(preComputation.lastComputed.containsAll(Request::Cost + Request::Constraint));
+  ASSERT_FALSE(preComputation.lastComputed.contains(Request::Approximation));
+
+  // values are implied by the approximation, while the constraint approximation is not
+  preComputation.request(Request::Cost, 0.1, x, u);
+  ASSERT_TRUE(preComputation.lastMissing.empty());
+  preComputation.request(Request::Constraint + Request::Approximation, 0.1, x, u);
+  ASSERT_TRUE(preComputation.lastMissing.containsAll(Request::Constraint + Request::Approximation));
+
+  // a different point, or another callback type at the same state, misses
+  preComputation.request(Request::Cost, 0.2, x, u);
+  ASSERT_TRUE(preComputation.lastMissing.contains(Request::Cost));
+  preComputation.requestFinal(Request::Cost, 0.2, x);
+  ASSERT_TRUE(preComputation.lastMissing.contains(Request::Cost));
+  preComputation.request(Request::Cost, 0.2, x, u);
+  ASSERT_TRUE(preComputation.lastMissing.contains(Request::Cost));
+
+  // invalidation
+  preComputation.invalidateRequestCache();
+  preComputation.request(Request::Cost, 0.2, x, u);
+  ASSERT_TRUE(preComputation.lastMissing.contains(Request::Cost));
+
+  EXPECT_EQ(preComputation.getNumCacheHits(), 2);
+  EXPECT_EQ(preComputation.getNumCacheMisses(), 7);
+  preComputation.resetCacheCounters();
+  EXPECT_EQ(preComputation.getNumCacheHits() + preComputation.getNumCacheMisses(), 0);
+}
@@ -101,6 +101,13 @@ struct DualDataContainer {
     valueFunctionTrajectory.swap(other.valueFunctionTrajectory);
   }
 
+  /** Swaps the backward pass data, i.e., all the members except the dual solution. */
+  void swapBackwardPassData(DualDataContainer& other) {
+    projectedModelDataTrajectory.swap(other.projectedModelDataTrajectory);
+    riccatiModificationTrajectory.swap(other.riccatiModificationTrajectory);
+    valueFunctionTrajectory.swap(other.valueFunctionTrajectory);
+  }
+
   void clear() {
     dualSolution.clear();
     projectedModelDataTrajectory.clear();
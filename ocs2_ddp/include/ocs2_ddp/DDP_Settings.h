@@ -95,6 +95,12 @@ struct Settings {
   scalar_t timeStep_ = 1e-2;
   /** The backward pass integrator type: SLQ uses it for solving Riccati equation and ILQR uses it for discretizing LQ approximation. */
   IntegratorType backwardPassIntegratorType_ = IntegratorType::ODE45;
+  /**
+   * If true, SLQ integrates the Riccati equations on the time grid of the rollout with a fixed-step (Heun) scheme instead of the
+   * backwardPassIntegratorType_ integrator. This evaluates the LQ model only at the rollout nodes, hence the backward pass has a
+   * deterministic cost. The accuracy is determined by the rollout's time step.
+   */
+  bool fixedGridRiccati_ = false;
 
   /** The initial coefficient of the quadratic penalty function in the merit function. It should be greater than one. */
   scalar_t constraintPenaltyInitialValue_ = 2.0;
@@ -107,6 +113,13 @@ struct Settings {
   /** Use either the optimized control policy (true) or the optimized state-input trajectory (false). */
   bool useFeedbackPolicy_ = false;
 
+  /**
+   * Real-time iteration: if true, after each run the LQ approximation, the backward pass, and the controller around the optimized
+   * solution are computed in the background. The first iteration of the next run then starts from the new initial state with the
+   * prepared value function and feedback gains instead of an initial rollout, provided that the mode schedule is unchanged.
+   */
+  bool realTimeIteration_ = false;
+
   /** The risk sensitivity coefficient for risk aware DDP. */
   scalar_t riskSensitiveCoeff_ = 0.0;
 
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <future>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/dynamics/SystemDynamicsBase.h>
@@ -94,21 +96,37 @@ class GaussNewtonDDP : public SolverBase {
   const ProblemMetrics& getSolutionMetrics() const override { return optimizedProblemMetrics_; }
 
   ScalarFunctionQuadraticApproximation getValueFunction(scalar_t time, const vector_t& state) const override {
+    waitForRealTimeIterationPreparation();
     return getValueFunctionImpl(time, state, nominalPrimalData_.primalSolution, nominalDualData_.valueFunctionTrajectory);
   }
 
   ScalarFunctionQuadraticApproximation getHamiltonian(scalar_t time, const vector_t& state, const vector_t& input) override;
 
   vector_t getStateInputEqualityConstraintLagrangian(scalar_t time, const vector_t& state) const override {
+    waitForRealTimeIterationPreparation();
     return getStateInputEqualityConstraintLagrangianImpl(time, state, nominalPrimalData_, nominalDualData_);
   }
 
   MultiplierCollection getIntermediateDualSolution(scalar_t time) const override {
+    waitForRealTimeIterationPreparation();
     return getIntermediateDualSolutionAtTime(nominalDualData_.dualSolution, time);
   }
 
   std::string getBenchmarkingInfo() const override;
 
+  /** Load balancing telemetry of a worker, accumulated over the iterations since the last reset(). */
+  struct WorkerTelemetry {
+    scalar_t busyTimeInMilliseconds = 0.0;
+    size_t numNodes = 0;
+    size_t numChunks = 0;
+  };
+
+  /** Per-worker telemetry of the LQ approximation of the intermediate nodes. */
+  const std::vector<WorkerTelemetry>& getLinearQuadraticApproximationTelemetry() const { return lqApproximationTelemetry_; }
+
+  /** Number of the real-time iteration steps which were rejected by the search strategy since the last reset(). */
+  size_t getNumRejectedRealTimeIterationSteps() const { return numRejectedRealTimeIterationSteps_; }
+
   /**
    * Const access to ddp settings
    */
@@ -125,28 +143,44 @@ class GaussNewtonDDP : public SolverBase {
     threadPool_.runParallel([&](int) { taskFunction(); }, N);
   }
 
+  /**
+   * Runs taskFunction(workerIndex, timeIndex) for all the time indices in [0, N) on ddpSettings_.nThreads_ workers (blocking).
+   * The time indices are handed out in chunks of consecutive nodes whose size shrinks with the number of remaining nodes
+   * (guided scheduling). Therefore, the workers rarely contend on the shared counter and write to contiguous parts of the output
+   * trajectories, while the final small chunks still balance the load.
+   *
+   * @param [in] N: The number of time indices.
+   * @param [in] taskFunction: The task, called as taskFunction(workerIndex, timeIndex). The workerIndex is in [0, nThreads) and
+   * unique among the concurrent workers, e.g. to index optimalControlProblemStock_.
+   * @param [out] telemetryPtr: If not nullptr, the busy time, the number of nodes, and the number of chunks of each worker are
+   * added to (*telemetryPtr)[workerIndex].
+   */
+  void runParallelOverNodes(size_t N, const std::function<void(size_t, size_t)>& taskFunction,
+                            std::vector<WorkerTelemetry>* telemetryPtr = nullptr);
+
   /**
    * Takes the following steps: (1) Computes the Hessian of the Hamiltonian (i.e., Hm) (2) Based on Hm, it calculates
    * the range space and the null space projections of the input-state equality constraints. (3) Based on these two
    * projections, defines the projected LQ model. (4) Finally, defines the Riccati equation modifiers based on the
    * search strategy.
    *
+   * @param [in] timeIndex: The index of the node in the nominal time trajectory.
    * @param [in] modelData: The model data.
    * @param [in] Sm: The Riccati matrix.
    * @param [out] projectedModelData: The projected model data.
    * @param [out] riccatiModification: The Riccati equation modifier.
    */
-  void computeProjectionAndRiccatiModification(const ModelData& modelData, const matrix_t& Sm, ModelData& projectedModelData,
-                                               riccati_modification::Data& riccatiModification) const;
+  void computeProjectionAndRiccatiModification(size_t timeIndex, const ModelData& modelData, const matrix_t& Sm,
+                                               ModelData& projectedModelData, riccati_modification::Data& riccatiModification) const;
 
   /**
    * Computes the Hessian of Hamiltonian based on the search strategy and algorithm.
    *
    * @param [in] modelData: The model data.
    * @param [in] Sm: The Riccati matrix.
-   * @return The Hessian matrix of the Hamiltonian.
+   * @param [out] Hm: The Hessian matrix of the Hamiltonian. Its memory is reused if the size does not change.
    */
-  virtual matrix_t computeHamiltonianHessian(const ModelData& modelData, const matrix_t& Sm) const = 0;
+  virtual void computeHamiltonianHessian(const ModelData& modelData, const matrix_t& Sm, matrix_t& Hm) const = 0;
 
   /**
    * Calculates an LQ approximate of the optimal control problem for the nodes.
@@ -193,6 +227,12 @@ class GaussNewtonDDP : public SolverBase {
   virtual void riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
                                       const ScalarFunctionQuadraticApproximation& finalValueFunction) = 0;
 
+  /**
+   * Blocks until the real-time iteration preparation, which runs in the background in between two calls of run(), is finished.
+   * The derived classes should call it in their destructor.
+   */
+  void waitForRealTimeIterationPreparation() const;
+
  private:
   /**
    * Get the State Input Equality Constraint Lagrangian Impl object
@@ -321,8 +361,24 @@ class GaussNewtonDDP : public SolverBase {
    */
   void initializeDualSolutionAndMetrics();
 
-  /** Based on the current LQ solution updates the optimized primal and dual solutions. */
-  void takePrimalDualStep(scalar_t lqModelExpectedCost);
+  /**
+   * Based on the current LQ solution updates the optimized primal and dual solutions.
+   * @return True if the search strategy was successful.
+   */
+  bool takePrimalDualStep(scalar_t lqModelExpectedCost);
+
+  /**
+   * Solves the LQ problem and calculates the controller for each trial of the search strategy. Then, based on the selected trial,
+   * it updates the optimized primal and dual solutions. The nominal dual data and the unoptimized controller are set to the ones
+   * of the selected trial.
+   *
+   * @param [in] numTrials: The number of the trials.
+   * @param [in] initialSolutionExists: Whether the nominal rollout is not purely from the Initializer.
+   */
+  void takePrimalDualTrialStep(size_t numTrials, bool initialSolutionExists);
+
+  /** Updates the optimized dual solution after a successful search, otherwise it reverts the optimized solutions to the nominal ones. */
+  void finalizePrimalDualStep(bool success);
 
   /**
    * Checks convergence of the main loop of DDP.
@@ -352,6 +408,7 @@ class GaussNewtonDDP : public SolverBase {
   // multi-threading helper variables
   std::atomic_size_t nextTaskId_{0};
   std::atomic_size_t nextTimeIndex_{0};
+  std::vector<WorkerTelemetry> lqApproximationTelemetry_;
 
   scalar_t initTime_ = 0.0;
   scalar_t finalTime_ = 0.0;
@@ -361,6 +418,33 @@ class GaussNewtonDDP : public SolverBase {
   std::vector<OptimalControlProblem> optimalControlProblemStock_;
 
  private:
+  void waitForBackgroundWork() override;
+
+  void launchBackgroundWork() override;
+
+  /**
+   * Real-time iteration preparation: constructs the LQ problem around the optimized solution, solves it, and calculates the
+   * unoptimized controller. It runs in the background in between two calls of run().
+   *
+   * @return true if the preparation was successful.
+   */
+  bool prepareRealTimeIteration();
+
+  /**
+   * Real-time iteration step: runs the search strategy from the new initial state with the prepared controller. The prepared data
+   * is discarded if the mode schedule has changed or the new initial time is outside of the prepared time horizon.
+   *
+   * @return true if the step was successful, otherwise the caller should start from an initial rollout.
+   */
+  bool takeRealTimeIterationStep();
+
+  /**
+   * Computes the baseline performance of the real-time iteration step by rolling out the prepared nominal controller from the new
+   * initial state, as initializePrimalSolution() does. The performance of the previous run starts from the previous initial state
+   * and time horizon, hence it is not comparable with the step.
+   */
+  PerformanceIndex computeRealTimeIterationBaseline();
+
   const ddp::Settings ddpSettings_;
 
   ThreadPool threadPool_;
@@ -383,6 +467,10 @@ class GaussNewtonDDP : public SolverBase {
   DualDataContainer cachedDualData_;
   PrimalDataContainer cachedPrimalData_;
 
+  // the backward pass data and the controllers of the search strategy's trials
+  std::vector<DualDataContainer> trialDualData_;
+  std::vector<LinearController> trialControllers_;
+
   struct ConstraintPenaltyCoefficients {
     scalar_t penaltyTol = 1e-3;
     scalar_t penaltyCoeff = 0.0;
@@ -400,6 +488,12 @@ class GaussNewtonDDP : public SolverBase {
   benchmark::RepeatedTimer computeControllerTimer_;
   benchmark::RepeatedTimer searchStrategyTimer_;
   benchmark::RepeatedTimer totalDualSolutionTimer_;
+  size_t numHeapAllocations_ = 0;  // counted only if the executable installs ocs2_core/misc/AllocationCounterHooks.h
+
+  // real-time iteration
+  std::future<bool> realTimeIterationPreparation_;
+  bool isRealTimeIterationPrepared_ = false;
+  size_t numRejectedRealTimeIterationSteps_ = 0;
 };
 
 }  // namespace ocs2
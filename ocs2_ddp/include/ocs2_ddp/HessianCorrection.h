@@ -29,7 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
 #include <string>
+#include <vector>
 
 #include <ocs2_core/NumericTraits.h>
 #include <ocs2_core/misc/LinearAlgebra.h>
@@ -87,5 +89,80 @@ void shiftHessian(Strategy strategy, Eigen::MatrixBase<Derived>& matrix,
   }
 }
 
+/**
+ * A per-node cache for the Hessian correction of a trajectory. Before running the full modification of the strategy, it
+ * checks with a Cholesky factorization whether the new Hessian already satisfies the minimum eigenvalue, in which case the
+ * modification reduces to a symmetrization. The nodes which failed the check in the previous iteration skip it once before
+ * retrying. The factorization uses one workspace per thread, hence the cache only stores a flag per node.
+ *
+ * The check only applies to CHOLESKY_MODIFICATION and EIGENVALUE_MODIFICATION. For the other strategies, the correction is
+ * already cheap and shiftHessian is called directly.
+ *
+ * The nodes can be corrected in parallel as long as each node index is accessed by only one thread at a time. resize() and
+ * clear() are not thread-safe.
+ */
+class CorrectionCache {
+ public:
+  /** The cache hit statistics. */
+  struct Statistics {
+    /** Number of the Hessians which passed the check. */
+    size_t numHits = 0;
+    /** Number of the Hessians which failed the check. */
+    size_t numMisses = 0;
+    /** Number of the Hessians which were directly modified since their node failed the check in the previous iteration. */
+    size_t numSkippedChecks = 0;
+
+    /** The ratio of the hits to the total number of the cached corrections. */
+    scalar_t hitRate() const {
+      const auto numTotal = numHits + numMisses + numSkippedChecks;
+      return (numTotal > 0) ? static_cast<scalar_t>(numHits) / static_cast<scalar_t>(numTotal) : 0.0;
+    }
+  };
+
+  /**
+   * Constructor.
+   *
+   * @param [in] strategy: Hessian matrix correction strategy.
+   * @param [in] minEigenvalue: The minimum expected eigenvalue after correction.
+   */
+  explicit CorrectionCache(Strategy strategy, scalar_t minEigenvalue = numeric_traits::limitEpsilon<scalar_t>());
+
+  /** Sets the number of the nodes. The cached data of the remaining nodes is kept. */
+  void resize(size_t numNodes);
+
+  /** Clears the cached data of all the nodes and resets the statistics. */
+  void clear();
+
+  /** Number of the nodes. */
+  size_t size() const { return nodes_.size(); }
+
+  /**
+   * Shifts the Hessian of the given node.
+   *
+   * @param [in] nodeIndex: The node index which should be smaller than size().
+   * @param matrix: The Hessian matrix.
+   */
+  void shiftHessian(size_t nodeIndex, matrix_t& matrix);
+
+  /** Gets the hit statistics accumulated since the last call to resetStatistics() or clear(). */
+  Statistics getStatistics() const;
+
+  /** Resets the hit statistics. */
+  void resetStatistics();
+
+ private:
+  struct Node {
+    bool failedLastCheck = false;
+  };
+
+  const Strategy strategy_;
+  const scalar_t minEigenvalue_;
+  std::vector<Node> nodes_;
+
+  std::atomic_size_t numHits_{0};
+  std::atomic_size_t numMisses_{0};
+  std::atomic_size_t numSkippedChecks_{0};
+};
+
 }  // namespace hessian_correction
 }  // namespace ocs2
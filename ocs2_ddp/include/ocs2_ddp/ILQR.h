@@ -54,9 +54,9 @@ class ILQR : public GaussNewtonDDP {
        const Initializer& initializer);
 
   /**
-   * Default destructor.
+   * Destructor. It waits for the real-time iteration preparation, since it uses the members of this class.
    */
-  ~ILQR() override = default;
+  ~ILQR() override { waitForRealTimeIterationPreparation(); }
 
  protected:
   scalar_t solveSequentialRiccatiEquations(const ScalarFunctionQuadraticApproximation& finalValueFunction) override;
@@ -67,7 +67,7 @@ class ILQR : public GaussNewtonDDP {
   void calculateControllerWorker(size_t timeIndex, const PrimalDataContainer& primalData, const DualDataContainer& dualData,
                                  LinearController& dstController) override;
 
-  matrix_t computeHamiltonianHessian(const ModelData& modelData, const matrix_t& Sm) const override;
+  void computeHamiltonianHessian(const ModelData& modelData, const matrix_t& Sm, matrix_t& Hm) const override;
 
   void approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) override;
 
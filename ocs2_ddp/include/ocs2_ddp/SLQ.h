@@ -54,12 +54,12 @@ class SLQ final : public GaussNewtonDDP {
       const Initializer& initializer);
 
   /**
-   * Default destructor.
+   * Destructor. It waits for the real-time iteration preparation, since it uses the members of this class.
    */
-  ~SLQ() override = default;
+  ~SLQ() override { waitForRealTimeIterationPreparation(); }
 
  protected:
-  matrix_t computeHamiltonianHessian(const ModelData& modelData, const matrix_t& Sm) const override;
+  void computeHamiltonianHessian(const ModelData& modelData, const matrix_t& Sm, matrix_t& Hm) const override;
 
   void approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) override;
 
@@ -89,6 +89,21 @@ class SLQ final : public GaussNewtonDDP {
                                            scalar_array_t& SsNormalizedTime, size_array_t& SsNormalizedPostEventIndices,
                                            vector_array_t& allSsTrajectory);
 
+  /**
+   * Integrates the riccati equation on the nominal time trajectory with the fixed-step Heun scheme. The flow map is only evaluated
+   * at the nodes, therefore neither the time search nor the interpolation between the nodes is required.
+   *
+   * @param riccatiEquation [in] : Riccati equation object
+   * @param partitionInterval [in] : The partition of the nominal time trajectory, [first, second].
+   * @param nominalTimeTrajectory [in] : time trajectory produced in the forward rollout.
+   * @param nominalEventsPastTheEndIndices [in] : Indices into nominalTimeTrajectory to point to times right after event times
+   * @param allSsFinal [in] : Final value of the value function.
+   * @param allSsTrajectory [out] : Value function in vector format in the reverse order of nominalTimeTrajectory.
+   */
+  void integrateRiccatiEquationFixedGrid(ContinuousTimeRiccatiEquations& riccatiEquation, const std::pair<int, int>& partitionInterval,
+                                         const scalar_array_t& nominalTimeTrajectory, const size_array_t& nominalEventsPastTheEndIndices,
+                                         vector_t allSsFinal, vector_array_t& allSsTrajectory);
+
   /****************
    *** Variables **
    ****************/
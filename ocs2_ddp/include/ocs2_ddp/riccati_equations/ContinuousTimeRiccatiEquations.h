@@ -134,6 +134,16 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
    */
   static vector_t convert2Vector(const matrix_t& Sm, const vector_t& Sv, const scalar_t& s);
 
+  /**
+   * Transcribe symmetric matrix Sm, vector Sv and scalar s into a single vector. Only the upper triangular part of Sm is read.
+   *
+   * @param [in] Sm: \f$ S_m \f$
+   * @param [in] Sv: \f$ S_v \f$
+   * @param [in] s: \f$ s \f$
+   * @param [out] allSs: Single vector constructed by concatenating Sm, Sv and s. Its memory is reused if it has the correct size.
+   */
+  static void convert2Vector(const matrix_t& Sm, const vector_t& Sv, scalar_t s, vector_t& allSs);
+
   /**
    * Transcribe value function approximation into a single vector.
    *
@@ -195,7 +205,20 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
    */
   vector_t computeFlowMap(scalar_t z, const vector_t& allSs) override;
 
+  /**
+   * Computes derivatives at a node of the time stamp trajectory. In contrast to computeFlowMap, this method does not search
+   * the time stamp trajectory and uses the node's data directly.
+   *
+   * @param [in] index: The index of the node in the time stamp trajectory.
+   * @param [in] allSs: A flattened vector constructed by concatenating Sm, Sv and s.
+   * @return d(allSs)/dz.
+   */
+  vector_t computeFlowMapAtNode(size_t index, const vector_t& allSs);
+
  private:
+  /** Computes derivatives for the given interpolation index and coefficient pair. */
+  vector_t computeFlowMapImpl(std::pair<int, scalar_t> indexAlpha, const vector_t& allSs);
+
   /**
    * Computes the Riccati equations for SLQ problem.
    *
@@ -29,7 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
 #include <functional>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -57,12 +59,15 @@ class LevenbergMarquardtStrategy final : public SearchStrategyBase {
    *
    * @param [in] baseSettings: The basic settings for the search strategy algorithms.
    * @param [in] settings: The Levenberg Marquardt settings.
-   * @param [in] rolloutRef: A reference to the rollout.
-   * @param [in] optimalControlProblemRef: A reference to the optimal control problem.
+   * @param [in] threadPoolRef: A reference to the thread pool instance which runs the parallel trials.
+   * @param [in] rolloutRefStock: An array of references to the rollout, one per thread.
+   * @param [in] optimalControlProblemRefStock: An array of references to the optimal control problem, one per thread.
    * @param [in] meritFunc: the merit function which gets the PerformanceIndex and returns the merit function value.
    */
-  LevenbergMarquardtStrategy(search_strategy::Settings baseSettings, levenberg_marquardt::Settings settings, RolloutBase& rolloutRefStock,
-                             OptimalControlProblem& optimalControlProblemRef, std::function<scalar_t(const PerformanceIndex&)> meritFunc);
+  LevenbergMarquardtStrategy(search_strategy::Settings baseSettings, levenberg_marquardt::Settings settings, ThreadPool& threadPoolRef,
+                             std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock,
+                             std::vector<std::reference_wrapper<OptimalControlProblem>> optimalControlProblemRefStock,
+                             std::function<scalar_t(const PerformanceIndex&)> meritFunc);
 
   ~LevenbergMarquardtStrategy() override = default;
   LevenbergMarquardtStrategy(const LevenbergMarquardtStrategy&) = delete;
@@ -74,13 +79,22 @@ class LevenbergMarquardtStrategy final : public SearchStrategyBase {
            const LinearController& unoptimizedController, const DualSolution& dualSolution, const ModeSchedule& modeSchedule,
            search_strategy::SolutionRef solution) override;
 
+  size_t initializeTrials() override;
+
+  void activateTrial(size_t trialIndex) override { activeTrial_ = trialIndex; }
+
+  std::pair<bool, size_t> runTrials(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState,
+                                    const scalar_array_t& expectedCosts, const std::vector<const LinearController*>& unoptimizedControllers,
+                                    const DualSolution& dualSolution, const ModeSchedule& modeSchedule,
+                                    search_strategy::SolutionRef solution) override;
+
   std::pair<bool, std::string> checkConvergence(bool unreliableControllerIncrement, const PerformanceIndex& previousPerformanceIndex,
                                                 const PerformanceIndex& currentPerformanceIndex) const override;
 
-  void computeRiccatiModification(const ModelData& projectedModelData, matrix_t& deltaQm, vector_t& deltaGv,
+  void computeRiccatiModification(size_t nodeIndex, const ModelData& projectedModelData, matrix_t& deltaQm, vector_t& deltaGv,
                                   matrix_t& deltaGm) const override;
 
-  matrix_t augmentHamiltonianHessian(const ModelData& modelData, const matrix_t& Hm) const override;
+  void augmentHamiltonianHessian(const ModelData& modelData, matrix_t& Hm) const override;
 
  private:
   /** computes the ratio between actual reduction and predicted reduction */
@@ -101,14 +115,42 @@ class LevenbergMarquardtStrategy final : public SearchStrategyBase {
     size_t numSuccessiveRejections = 0;           // the number of successive rejections of solution.
   };
 
+  /** Adjusts the Riccati multiple of the module based on pho (the ratio between actual reduction and predicted reduction). */
+  void adjustRiccatiMultiple(scalar_t pho, LevenbergMarquardtModule& lmModule) const;
+
+  /** The Riccati multiple of the active trial. */
+  scalar_t activeRiccatiMultiple() const {
+    return (activeTrial_ < trialModules_.size()) ? trialModules_[activeTrial_].riccatiMultiple : lmModule_.riccatiMultiple;
+  }
+
+  /** Computes the solution of a trial on a thread. */
+  void computeSolution(size_t taskId, scalar_t stepLength, const LinearController& unoptimizedController,
+                       search_strategy::Solution& solution);
+
+  /** Prints to output. */
+  void printString(const std::string& text) const;
+
   const levenberg_marquardt::Settings settings_;
   LevenbergMarquardtModule lmModule_;
 
-  RolloutBase& rolloutRef_;
-  OptimalControlProblem& optimalControlProblemRef_;
+  ThreadPool& threadPoolRef_;
+  std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock_;
+  std::vector<std::reference_wrapper<OptimalControlProblem>> optimalControlProblemRefStock_;
   std::function<scalar_t(PerformanceIndex)> meritFunc_;
 
-  DualSolution tempDualSolution_;
+  // trials: the k-th trial uses the Riccati multiple of k successive rejections from lmModule_
+  std::vector<LevenbergMarquardtModule> trialModules_;
+  size_t activeTrial_ = 0;
+  std::vector<search_strategy::Solution> trialSolutions_;
+
+  // input of the trials
+  const std::pair<scalar_t, scalar_t>* timePeriodPtr_ = nullptr;
+  const vector_t* initStatePtr_ = nullptr;
+  const DualSolution* dualSolutionPtr_ = nullptr;
+  const ModeSchedule* modeSchedulePtr_ = nullptr;
+
+  std::vector<DualSolution> tempDualSolutions_;
+  mutable std::mutex outputDisplayGuardMutex_;
 };
 
 }  // namespace ocs2
@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -40,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/rollout/RolloutBase.h>
 
+#include "ocs2_ddp/HessianCorrection.h"
 #include "ocs2_ddp/search_strategy/SearchStrategyBase.h"
 #include "ocs2_ddp/search_strategy/StrategySettings.h"
 
@@ -70,7 +72,7 @@ class LineSearchStrategy final : public SearchStrategyBase {
   LineSearchStrategy(const LineSearchStrategy&) = delete;
   LineSearchStrategy& operator=(const LineSearchStrategy&) = delete;
 
-  void reset() override {}
+  void reset() override;
 
   bool run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState, const scalar_t expectedCost,
            const LinearController& unoptimizedController, const DualSolution& dualSolution, const ModeSchedule& modeSchedule,
@@ -79,10 +81,17 @@ class LineSearchStrategy final : public SearchStrategyBase {
   std::pair<bool, std::string> checkConvergence(bool unreliableControllerIncrement, const PerformanceIndex& previousPerformanceIndex,
                                                 const PerformanceIndex& currentPerformanceIndex) const override;
 
-  void computeRiccatiModification(const ModelData& projectedModelData, matrix_t& deltaQm, vector_t& deltaGv,
+  void computeRiccatiModification(size_t nodeIndex, const ModelData& projectedModelData, matrix_t& deltaQm, vector_t& deltaGv,
                                   matrix_t& deltaGm) const override;
 
-  matrix_t augmentHamiltonianHessian(const ModelData& /*modelData*/, const matrix_t& Hm) const override { return Hm; }
+  void initializeRiccatiModification(size_t numNodes) override;
+
+  void augmentHamiltonianHessian(const ModelData& /*modelData*/, matrix_t& /*Hm*/) const override {}
+
+  std::string getBenchmarkingInfo() const override;
+
+  /** Gets the hit statistics of the Hessian correction cache. They are zero if line_search::Settings::hessianCorrectionCache is false. */
+  hessian_correction::CorrectionCache::Statistics getHessianCorrectionStatistics() const;
 
  private:
   struct LineSearchInputRef {
@@ -115,6 +124,7 @@ class LineSearchStrategy final : public SearchStrategyBase {
   std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock_;
   std::vector<std::reference_wrapper<OptimalControlProblem>> optimalControlProblemRefStock_;
   std::function<scalar_t(PerformanceIndex)> meritFunc_;
+  std::unique_ptr<hessian_correction::CorrectionCache> hessianCorrectionCachePtr_;
 
   // input
   LineSearchInputRef lineSearchInputRef_;
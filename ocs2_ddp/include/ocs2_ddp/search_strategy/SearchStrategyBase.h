@@ -30,6 +30,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <functional>
+#include <stdexcept>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -90,6 +92,41 @@ class SearchStrategyBase {
                    const LinearController& unoptimizedController, const DualSolution& dualSolution, const ModeSchedule& modeSchedule,
                    search_strategy::SolutionRef solution) = 0;
 
+  /**
+   * Prepares the trials of the next iteration. A strategy may evaluate several trials per iteration where each trial has its
+   * own Riccati modification. For each trial, the caller activates it by activateTrial(), computes the backward pass and the
+   * controller, and finally passes all the controllers to runTrials().
+   *
+   * @return The number of the trials.
+   */
+  virtual size_t initializeTrials() { return 1; }
+
+  /**
+   * Activates the given trial for the following calls of computeRiccatiModification() and augmentHamiltonianHessian().
+   *
+   * @param [in] trialIndex: The trial index which should be smaller than the value returned by initializeTrials().
+   */
+  virtual void activateTrial(size_t trialIndex) {}
+
+  /**
+   * Finds the optimal trajectories, controller, and performance index among the trials. The default implementation only
+   * supports a single trial and calls run().
+   *
+   * @param [in] timePeriod: Initial and final times pair.
+   * @param [in] initState: Initial state
+   * @param [in] expectedCosts: The expected cost of each trial based on its LQ model optimization.
+   * @param [in] unoptimizedControllers: The unoptimized controller of each trial.
+   * @param [in] dualSolution: The dual solution.
+   * @param [in] ModeSchedule The current mode schedule.
+   * @param [out] solution: Output of search (primalSolution, performanceIndex, problemMetrics, avgTimeStep)
+   * @return A pair of (whether the search was successful, the index of the selected trial).
+   */
+  virtual std::pair<bool, size_t> runTrials(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState,
+                                            const scalar_array_t& expectedCosts,
+                                            const std::vector<const LinearController*>& unoptimizedControllers,
+                                            const DualSolution& dualSolution, const ModeSchedule& modeSchedule,
+                                            search_strategy::SolutionRef solution);
+
   /**
    * Checks convergence of the main loop of DDP.
    *
@@ -103,25 +140,38 @@ class SearchStrategyBase {
                                                         const PerformanceIndex& previousPerformanceIndex,
                                                         const PerformanceIndex& currentPerformanceIndex) const = 0;
 
+  /**
+   * Prepares the strategy for computing the Riccati modification over a trajectory. It is called before computeRiccatiModification
+   * is evaluated, possibly in parallel, over the nodes of the trajectory.
+   *
+   * @param [in] numNodes: The number of the nodes in the trajectory.
+   */
+  virtual void initializeRiccatiModification(size_t numNodes) {}
+
   /**
    * Computes the Riccati modification based on the strategy.
    *
+   * @param [in] nodeIndex: The index of the node in the trajectory.
    * @param [in] projectedModelData: The projected data model
    * @param [out] deltaQm: The Riccati modifier to cost 2nd derivative w.r.t. state.
    * @param [out] deltaGv: The Riccati modifier to cost derivative w.r.t. input.
    * @param [out] deltaGm: The Riccati modifier to cost input-state derivative.
    */
-  virtual void computeRiccatiModification(const ModelData& projectedModelData, matrix_t& deltaQm, vector_t& deltaGv,
+  virtual void computeRiccatiModification(size_t nodeIndex, const ModelData& projectedModelData, matrix_t& deltaQm, vector_t& deltaGv,
                                           matrix_t& deltaGm) const = 0;
 
   /**
    * Augments the Hessian of Hamiltonian based on the strategy.
    *
    * @param [in] modelData: The model data.
-   * @param [in] Hm: The Hessian of Hamiltonian that should be augmented.
-   * @return The augmented Hamiltonian's Hessian.
+   * @param [in, out] Hm: The Hessian of Hamiltonian that is augmented in place.
    */
-  virtual matrix_t augmentHamiltonianHessian(const ModelData& modelData, const matrix_t& Hm) const = 0;
+  virtual void augmentHamiltonianHessian(const ModelData& modelData, matrix_t& Hm) const = 0;
+
+  /**
+   * Returns the strategy-specific benchmarking information.
+   */
+  virtual std::string getBenchmarkingInfo() const { return {}; }
 
  protected:
   const search_strategy::Settings baseSettings_;
@@ -175,4 +225,21 @@ inline void swap(SolutionRef lhs, SolutionRef rhs) {
 }
 
 }  // namespace search_strategy
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline std::pair<bool, size_t> SearchStrategyBase::runTrials(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState,
+                                                             const scalar_array_t& expectedCosts,
+                                                             const std::vector<const LinearController*>& unoptimizedControllers,
+                                                             const DualSolution& dualSolution, const ModeSchedule& modeSchedule,
+                                                             search_strategy::SolutionRef solution) {
+  if (expectedCosts.size() != 1 || unoptimizedControllers.size() != 1) {
+    throw std::runtime_error("[SearchStrategyBase::runTrials] The search strategy only supports a single trial!");
+  }
+  const bool success =
+      run(timePeriod, initState, expectedCosts.front(), *unoptimizedControllers.front(), dualSolution, modeSchedule, solution);
+  return {success, 0};
+}
+
 }  // namespace ocs2
@@ -97,6 +97,8 @@ struct Settings {
   hessian_correction::Strategy hessianCorrectionStrategy = hessian_correction::Strategy::DIAGONAL_SHIFT;
   /** The multiple used for correcting the Hessian for numerical stability of the Riccati backward pass.*/
   scalar_t hessianCorrectionMultiple = numeric_traits::limitEpsilon<scalar_t>();
+  /** Whether to skip the Hessian correction of the already PD Hessians, see hessian_correction::CorrectionCache. */
+  bool hessianCorrectionCache = false;
 };  // end of Settings
 
 /**
@@ -129,6 +131,10 @@ struct Settings {
   scalar_t riccatiMultipleDefaultFactor = 1e-6;
   /** Maximum number of successive rejections of the iteration's solution. */
   size_t maxNumSuccessiveRejections = 5;
+  /** Number of the Riccati multiples evaluated per iteration. For values larger than one, the backward passes of the next
+   * multiples in the rejection sequence are computed together with the current one and their rollouts run in parallel.
+   * */
+  size_t numParallelTrials = 1;
 };  // end of Settings
 
 /**
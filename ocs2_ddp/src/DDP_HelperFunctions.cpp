@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/PreComputation.h>
 #include <ocs2_core/integration/TrapezoidalIntegration.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_core/misc/MonotonicArena.h>
 #include <ocs2_oc/approximate_model/ChangeOfInputVariables.h>
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
 
@@ -229,10 +230,14 @@ void projectLQ(const ModelData& modelData, const matrix_t& constraintRangeProjec
     projectedModelData.stateInputEqConstraint.dfdx.noalias() = constraintRangeProjector * modelData.stateInputEqConstraint.dfdx;
     projectedModelData.stateInputEqConstraint.dfdu.noalias() = constraintRangeProjector * modelData.stateInputEqConstraint.dfdu;
 
-    // Change of variable matrices
+    // Change of variable matrices, the temporaries are drawn from the thread's arena
+    auto& arena = getThreadLocalArena();
+    MonotonicArena::Scope arenaScope(arena);
     const auto& Pu = constraintNullProjector;
-    const matrix_t Px = -projectedModelData.stateInputEqConstraint.dfdx;
-    const matrix_t u0 = -projectedModelData.stateInputEqConstraint.f;
+    auto Px = arena.matrix(projectedModelData.stateInputEqConstraint.dfdx.rows(), projectedModelData.stateInputEqConstraint.dfdx.cols());
+    Px = -projectedModelData.stateInputEqConstraint.dfdx;
+    auto u0 = arena.vector(projectedModelData.stateInputEqConstraint.f.rows());
+    u0 = -projectedModelData.stateInputEqConstraint.f;
 
     // dynamics
     projectedModelData.dynamics = modelData.dynamics;
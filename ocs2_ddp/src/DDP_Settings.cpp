@@ -86,6 +86,7 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   auto integratorName = integrator_type::toString(settings.backwardPassIntegratorType_);  // keep default
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".backwardPassIntegratorType", verbose);
   settings.backwardPassIntegratorType_ = integrator_type::fromString(integratorName);
+  loadData::loadPtreeValue(pt, settings.fixedGridRiccati_, fieldName + ".fixedGridRiccati", verbose);
 
   loadData::loadPtreeValue(pt, settings.constraintPenaltyInitialValue_, fieldName + ".constraintPenaltyInitialValue", verbose);
   loadData::loadPtreeValue(pt, settings.constraintPenaltyIncreaseRate_, fieldName + ".constraintPenaltyIncreaseRate", verbose);
@@ -94,6 +95,8 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
 
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy_, fieldName + ".useFeedbackPolicy", verbose);
 
+  loadData::loadPtreeValue(pt, settings.realTimeIteration_, fieldName + ".realTimeIteration", verbose);
+
   loadData::loadPtreeValue(pt, settings.riskSensitiveCoeff_, fieldName + ".riskSensitiveCoeff", verbose);
 
   std::string strategyName = search_strategy::toString(settings.strategy_);
@@ -30,11 +30,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_ddp/GaussNewtonDDP.h"
 
 #include <algorithm>
+#include <chrono>
 #include <numeric>
 
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/integration/TrapezoidalIntegration.h>
+#include <ocs2_core/misc/AllocationCounter.h>
 #include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/misc/MonotonicArena.h>
 
 #include <ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h>
 #include <ocs2_oc/rollout/InitializerRollout.h>
@@ -84,6 +87,7 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
     optimalControlProblemStock_.push_back(optimalControlProblem);
     dynamicsForwardRolloutPtrStock_.emplace_back(rollout.clone());
   }  // end of i loop
+  lqApproximationTelemetry_.resize(ddpSettings_.nThreads_);
 
   // search strategy method
   const auto basicStrategySettings = [&]() {
@@ -108,10 +112,14 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
       break;
     }
     case search_strategy::Type::LEVENBERG_MARQUARDT: {
-      constexpr size_t threadID = 0;
-      searchStrategyPtr_.reset(new LevenbergMarquardtStrategy(basicStrategySettings, ddpSettings_.levenbergMarquardt_,
-                                                              *dynamicsForwardRolloutPtrStock_[threadID],
-                                                              optimalControlProblemStock_[threadID], meritFunc));
+      std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock;
+      std::vector<std::reference_wrapper<OptimalControlProblem>> problemRefStock;
+      for (size_t i = 0; i < ddpSettings_.nThreads_; i++) {
+        rolloutRefStock.emplace_back(*dynamicsForwardRolloutPtrStock_[i]);
+        problemRefStock.emplace_back(optimalControlProblemStock_[i]);
+      }  // end of i loop
+      searchStrategyPtr_.reset(new LevenbergMarquardtStrategy(basicStrategySettings, ddpSettings_.levenbergMarquardt_, threadPool_,
+                                                              std::move(rolloutRefStock), std::move(problemRefStock), meritFunc));
       break;
     }
   }  // end of switch-case
@@ -126,15 +134,64 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
 /******************************************************************************************************/
 /******************************************************************************************************/
 GaussNewtonDDP::~GaussNewtonDDP() {
+  waitForRealTimeIterationPreparation();
+
   if (ddpSettings_.displayInfo_ || ddpSettings_.displayShortSummary_) {
     std::cerr << getBenchmarkingInfo() << std::endl;
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::runParallelOverNodes(size_t N, const std::function<void(size_t, size_t)>& taskFunction,
+                                          std::vector<WorkerTelemetry>* telemetryPtr) {
+  const size_t numWorkers = std::max(ddpSettings_.nThreads_, size_t(1));
+
+  nextTimeIndex_ = 0;
+  nextTaskId_ = 0;
+  auto task = [&]() {
+    const size_t workerIndex = nextTaskId_++;  // assign worker ID (atomic)
+    const auto startTime = std::chrono::steady_clock::now();
+
+    // no arena memory is held across the node tasks, hence the thread's arena is released and its blocks coalesced
+    getThreadLocalArena().reset();
+
+    size_t numNodes = 0;
+    size_t numChunks = 0;
+    size_t chunkBegin = nextTimeIndex_.load();
+    while (chunkBegin < N) {
+      // guided chunk size: a fraction of the remaining nodes per worker
+      const size_t chunkSize = std::max((N - chunkBegin) / (2 * numWorkers), size_t(1));
+      // on failure, chunkBegin is updated to the current value of the counter
+      if (nextTimeIndex_.compare_exchange_weak(chunkBegin, chunkBegin + chunkSize)) {
+        const size_t chunkEnd = chunkBegin + chunkSize;
+        for (size_t timeIndex = chunkBegin; timeIndex < chunkEnd; timeIndex++) {
+          taskFunction(workerIndex, timeIndex);
+        }
+        numNodes += chunkSize;
+        ++numChunks;
+        chunkBegin = nextTimeIndex_.load();
+      }
+    }  // end of while loop
+
+    // each worker writes its own entry once
+    if (telemetryPtr != nullptr) {
+      auto& telemetry = (*telemetryPtr)[workerIndex];
+      telemetry.busyTimeInMilliseconds += std::chrono::duration<scalar_t, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+      telemetry.numNodes += numNodes;
+      telemetry.numChunks += numChunks;
+    }
+  };
+  runParallel(task, numWorkers);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 std::string GaussNewtonDDP::getBenchmarkingInfo() const {
+  waitForRealTimeIterationPreparation();
+
   const auto initializationTotal = initializationTimer_.getTotalInMilliseconds();
   const auto linearQuadraticApproximationTotal = linearQuadraticApproximationTimer_.getTotalInMilliseconds();
   const auto backwardPassTotal = backwardPassTimer_.getTotalInMilliseconds();
@@ -161,7 +218,20 @@ std::string GaussNewtonDDP::getBenchmarkingInfo() const {
     infoStream << "\tSearch Strategy    :\t" << searchStrategyTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << searchStrategyTotal / benchmarkTotal * 100 << "%)\n";
     infoStream << "\tDual Solution      :\t" << totalDualSolutionTimer_.getAverageInMilliseconds() << " [ms] \t\t("
-               << dualSolutionTotal / benchmarkTotal * 100 << "%)\n\n";
+               << dualSolutionTotal / benchmarkTotal * 100 << "%)\n";
+    if (allocation_counter::isEnabled() && totalNumIterations_ > 0) {
+      infoStream << "\tHeap Allocations   :\t" << numHeapAllocations_ / totalNumIterations_ << " [per iteration]\n";
+    }
+    if (lqApproximationTelemetry_.size() > 1 && totalNumIterations_ > 0) {
+      infoStream << "\tLQ Approximation Workers [nodes, chunks, busy time [ms] per iteration]:\n";
+      for (size_t i = 0; i < lqApproximationTelemetry_.size(); i++) {
+        const auto& telemetry = lqApproximationTelemetry_[i];
+        infoStream << "\t\tworker " << i << ":\t" << telemetry.numNodes / totalNumIterations_ << ",\t"
+                   << telemetry.numChunks / totalNumIterations_ << ",\t" << telemetry.busyTimeInMilliseconds / totalNumIterations_ << "\n";
+      }
+    }
+    infoStream << searchStrategyPtr_->getBenchmarkingInfo();
+    infoStream << "\n";
   }
   return infoStream.str();
 }
@@ -170,6 +240,12 @@ std::string GaussNewtonDDP::getBenchmarkingInfo() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::reset() {
+  // real-time iteration
+  waitForRealTimeIterationPreparation();
+  realTimeIterationPreparation_ = std::future<bool>();
+  isRealTimeIterationPrepared_ = false;
+  numRejectedRealTimeIterationSteps_ = 0;
+
   // search strategy
   searchStrategyPtr_->reset();
 
@@ -197,6 +273,8 @@ void GaussNewtonDDP::reset() {
   computeControllerTimer_.reset();
   searchStrategyTimer_.reset();
   totalDualSolutionTimer_.reset();
+  numHeapAllocations_ = 0;
+  lqApproximationTelemetry_.assign(ddpSettings_.nThreads_, WorkerTelemetry());
 }
 
 /******************************************************************************************************/
@@ -594,15 +672,10 @@ void GaussNewtonDDP::calculateController() {
   unoptimizedController_.biasArray_.resize(N);
   unoptimizedController_.deltaBiasArray_.resize(N);
 
-  nextTimeIndex_ = 0;
-  auto task = [this, N] {
-    int timeIndex;
-    // get next time index (atomic)
-    while ((timeIndex = nextTimeIndex_++) < N) {
-      calculateControllerWorker(timeIndex, nominalPrimalData_, nominalDualData_, unoptimizedController_);
-    }
+  auto task = [this](size_t /*workerIndex*/, size_t timeIndex) {
+    calculateControllerWorker(timeIndex, nominalPrimalData_, nominalDualData_, unoptimizedController_);
   };
-  runParallel(task, ddpSettings_.nThreads_);
+  runParallelOverNodes(N, task);
 
   // Since the controller for the last timestamp is invalid, if the last time is not the event time, use the control policy of the second to
   // last time for the last time
@@ -645,6 +718,8 @@ void GaussNewtonDDP::calculateController() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::approximateOptimalControlProblem() {
+  iterationCallbacks(nominalPrimalData_.primalSolution.timeTrajectory_);
+
   /*
    * compute and augment the LQ approximation of intermediate times
    */
@@ -731,11 +806,12 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void GaussNewtonDDP::computeProjectionAndRiccatiModification(const ModelData& modelData, const matrix_t& Sm, ModelData& projectedModelData,
+void GaussNewtonDDP::computeProjectionAndRiccatiModification(size_t timeIndex, const ModelData& modelData, const matrix_t& Sm,
+                                                             ModelData& projectedModelData,
                                                              riccati_modification::Data& riccatiModification) const {
   // compute the Hamiltonian's Hessian
   riccatiModification.time_ = modelData.time;
-  riccatiModification.hamiltonianHessian_ = computeHamiltonianHessian(modelData, Sm);
+  computeHamiltonianHessian(modelData, Sm, riccatiModification.hamiltonianHessian_);
 
   // compute projectors
   computeProjections(riccatiModification.hamiltonianHessian_, modelData.stateInputEqConstraint.dfdu,
@@ -745,8 +821,8 @@ void GaussNewtonDDP::computeProjectionAndRiccatiModification(const ModelData& mo
   projectLQ(modelData, riccatiModification.constraintRangeProjector_, riccatiModification.constraintNullProjector_, projectedModelData);
 
   // compute deltaQm, deltaGv, deltaGm
-  searchStrategyPtr_->computeRiccatiModification(projectedModelData, riccatiModification.deltaQm_, riccatiModification.deltaGv_,
-                                                 riccatiModification.deltaGm_);
+  searchStrategyPtr_->computeRiccatiModification(timeIndex, projectedModelData, riccatiModification.deltaQm_,
+                                                 riccatiModification.deltaGv_, riccatiModification.deltaGm_);
 }
 
 /******************************************************************************************************/
@@ -754,9 +830,17 @@ void GaussNewtonDDP::computeProjectionAndRiccatiModification(const ModelData& mo
 /******************************************************************************************************/
 void GaussNewtonDDP::computeProjections(const matrix_t& Hm, const matrix_t& Dm, matrix_t& constraintRangeProjector,
                                         matrix_t& constraintNullProjector) const {
-  // UUT decomposition of inv(Hm)
-  matrix_t HmInvUmUmT;
-  LinearAlgebra::computeInverseMatrixUUT(Hm, HmInvUmUmT);
+  // temporaries are drawn from the thread's arena and released at the end of this scope
+  auto& arena = getThreadLocalArena();
+  MonotonicArena::Scope arenaScope(arena);
+
+  // UUT decomposition of inv(Hm), Hm = Lm Lm^T --> inv(Hm) = inv(Lm^T) inv(Lm) where Lm^T is upper triangular
+  auto HmFactor = arena.matrix(Hm.rows(), Hm.cols());
+  HmFactor = Hm;
+  Eigen::LLT<Eigen::Ref<matrix_t>> lltOfHm(HmFactor);  // in-place factorization
+  auto HmInvUmUmT = arena.matrix(Hm.rows(), Hm.cols());
+  HmInvUmUmT.setIdentity();
+  lltOfHm.matrixU().solveInPlace(HmInvUmUmT);
 
   // compute DmDagger, DmDaggerTHmDmDaggerUUT, HmInverseConstrainedLowRank
   if (Dm.rows() == 0) {
@@ -772,8 +856,11 @@ void GaussNewtonDDP::computeProjections(const matrix_t& Hm, const matrix_t& Dm,
 
   // check
   if (ddpSettings_.checkNumericalStability_) {
-    matrix_t HmProjected = constraintNullProjector.transpose() * Hm * constraintNullProjector;
     const int nullSpaceDim = Hm.rows() - Dm.rows();
+    auto HmNullProjector = arena.matrix(Hm.rows(), nullSpaceDim);
+    HmNullProjector.noalias() = Hm * constraintNullProjector;
+    auto HmProjected = arena.matrix(nullSpaceDim, nullSpaceDim);
+    HmProjected.noalias() = constraintNullProjector.transpose() * HmNullProjector;
     if (!HmProjected.isApprox(matrix_t::Identity(nullSpaceDim, nullSpaceDim), 1e-6)) {
       std::cerr << "HmProjected:\n" << HmProjected << "\n";
       throw std::runtime_error("HmProjected should be identity!");
@@ -900,7 +987,7 @@ void GaussNewtonDDP::initializeDualSolutionAndMetrics() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void GaussNewtonDDP::takePrimalDualStep(scalar_t lqModelExpectedCost) {
+bool GaussNewtonDDP::takePrimalDualStep(scalar_t lqModelExpectedCost) {
   // update primal: run search strategy and find the optimal stepLength
   searchStrategyTimer_.startTimer();
   scalar_t avgTimeStep;
@@ -915,6 +1002,67 @@ void GaussNewtonDDP::takePrimalDualStep(scalar_t lqModelExpectedCost) {
   }
   searchStrategyTimer_.endTimer();
 
+  finalizePrimalDualStep(success);
+  return success;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::takePrimalDualTrialStep(size_t numTrials, bool initialSolutionExists) {
+  trialDualData_.resize(numTrials);
+  trialControllers_.resize(numTrials);
+  scalar_array_t expectedCosts(numTrials);
+  std::vector<const LinearController*> trialControllerPtrs(numTrials);
+
+  // nominal --> nominal: solves the LQ problem and calculates the controller of each trial. The results are moved to the trial data.
+  for (size_t k = 0; k < numTrials; k++) {
+    searchStrategyPtr_->activateTrial(k);
+
+    backwardPassTimer_.startTimer();
+    searchStrategyPtr_->initializeRiccatiModification(nominalPrimalData_.primalSolution.timeTrajectory_.size());
+    avgTimeStepBP_ = solveSequentialRiccatiEquations(nominalPrimalData_.modelDataFinalTime.cost);
+    backwardPassTimer_.endTimer();
+
+    computeControllerTimer_.startTimer();
+    calculateController();
+    computeControllerTimer_.endTimer();
+
+    // the expected cost/merit calculated by the Riccati solution is not reliable
+    expectedCosts[k] = initialSolutionExists ? nominalDualData_.valueFunctionTrajectory.front().f : performanceIndex_.merit;
+
+    nominalDualData_.swapBackwardPassData(trialDualData_[k]);
+    swap(unoptimizedController_, trialControllers_[k]);
+    trialControllerPtrs[k] = &trialControllers_[k];
+  }  // end of k loop
+
+  // update primal: run search strategy on all the trials
+  searchStrategyTimer_.startTimer();
+  scalar_t avgTimeStep;
+  const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
+  search_strategy::SolutionRef solution(avgTimeStep, optimizedDualSolution_, optimizedPrimalSolution_, optimizedProblemMetrics_,
+                                        performanceIndex_);
+  bool success;
+  size_t selectedTrial;
+  std::tie(success, selectedTrial) = searchStrategyPtr_->runTrials({initTime_, finalTime_}, initState_, expectedCosts, trialControllerPtrs,
+                                                                   nominalDualData_.dualSolution, modeSchedule, solution);
+
+  if (success) {
+    avgTimeStepFP_ = 0.9 * avgTimeStepFP_ + 0.1 * avgTimeStep;
+  }
+  searchStrategyTimer_.endTimer();
+
+  // the nominal backward pass data and controller of the selected trial
+  nominalDualData_.swapBackwardPassData(trialDualData_[selectedTrial]);
+  swap(unoptimizedController_, trialControllers_[selectedTrial]);
+
+  finalizePrimalDualStep(success);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::finalizePrimalDualStep(bool success) {
   // update dual
   totalDualSolutionTimer_.startTimer();
   if (success) {
@@ -933,6 +1081,135 @@ void GaussNewtonDDP::takePrimalDualStep(scalar_t lqModelExpectedCost) {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::waitForRealTimeIterationPreparation() const {
+  if (realTimeIterationPreparation_.valid()) {
+    realTimeIterationPreparation_.wait();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::waitForBackgroundWork() {
+  isRealTimeIterationPrepared_ = realTimeIterationPreparation_.valid() && realTimeIterationPreparation_.get();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::launchBackgroundWork() {
+  if (ddpSettings_.realTimeIteration_ && !optimizedPrimalSolution_.timeTrajectory_.empty()) {
+    realTimeIterationPreparation_ = std::async(std::launch::async, [this]() { return prepareRealTimeIteration(); });
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool GaussNewtonDDP::prepareRealTimeIteration() {
+  try {
+    // optimized --> nominal: the optimized solution is copied since it remains the solution of the solver
+    nominalDualData_.swap(cachedDualData_);
+    nominalPrimalData_.swap(cachedPrimalData_);
+    nominalDualData_.dualSolution = optimizedDualSolution_;
+    nominalPrimalData_.primalSolution = optimizedPrimalSolution_;
+    nominalPrimalData_.problemMetrics = optimizedProblemMetrics_;
+
+    // nominal --> nominal: constructs the LQ problem around the nominal trajectories
+    linearQuadraticApproximationTimer_.startTimer();
+    approximateOptimalControlProblem();
+    linearQuadraticApproximationTimer_.endTimer();
+
+    // nominal --> nominal: solves the LQ problem
+    backwardPassTimer_.startTimer();
+    searchStrategyPtr_->initializeRiccatiModification(nominalPrimalData_.primalSolution.timeTrajectory_.size());
+    avgTimeStepBP_ = solveSequentialRiccatiEquations(nominalPrimalData_.modelDataFinalTime.cost);
+    backwardPassTimer_.endTimer();
+
+    // calculate controller and store the result in unoptimizedController_
+    computeControllerTimer_.startTimer();
+    calculateController();
+    computeControllerTimer_.endTimer();
+
+    return true;
+
+  } catch (const std::exception& error) {
+    if (ddpSettings_.displayInfo_) {
+      printString("[GaussNewtonDDP::prepareRealTimeIteration] preparation failed: " + std::string(error.what()) + '\n');
+    }
+    return false;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool GaussNewtonDDP::takeRealTimeIterationStep() {
+  const auto& nominalTimeTrajectory = nominalPrimalData_.primalSolution.timeTrajectory_;
+  const auto& nominalModeSchedule = nominalPrimalData_.primalSolution.modeSchedule_;
+  const auto& modeSchedule = getReferenceManager().getModeSchedule();
+  if (nominalModeSchedule.eventTimes != modeSchedule.eventTimes || nominalModeSchedule.modeSequence != modeSchedule.modeSequence ||
+      nominalTimeTrajectory.empty() || initTime_ < nominalTimeTrajectory.front() || initTime_ >= nominalTimeTrajectory.back()) {
+    return false;
+  }
+
+  bool success = false;
+  try {
+    // the baseline of the step starts from the new initial state
+    performanceIndex_ = computeRealTimeIterationBaseline();
+    performanceIndexHistory_.push_back(performanceIndex_);
+
+    // the expected cost is the prepared value function at the new initial state. The cost of the horizon extension beyond the
+    // prepared horizon is in the baseline but not in the LQ model.
+    const auto lqModelExpectedCost = getValueFunction(initTime_, initState_).f;
+
+    // nominal --> optimized: the search strategy starts with a rollout of the prepared controller from the new initial state
+    success = takePrimalDualStep(lqModelExpectedCost);
+
+  } catch (const std::exception& error) {
+    if (ddpSettings_.displayInfo_) {
+      std::cerr << "[GaussNewtonDDP::takeRealTimeIterationStep] " << error.what() << '\n';
+    }
+  }
+
+  // on failure, the optimized solution is the prepared nominal one which starts from the previous initial state
+  if (!success) {
+    ++numRejectedRealTimeIterationSteps_;
+    performanceIndexHistory_.clear();
+  }
+  return success;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PerformanceIndex GaussNewtonDDP::computeRealTimeIterationBaseline() {
+  // the prepared nominal controller is cloned since the nominal data is the fallback of a failed step
+  PrimalSolution nominalControllerSolution;
+  nominalControllerSolution.modeSchedule_ = nominalPrimalData_.primalSolution.modeSchedule_;
+  nominalControllerSolution.controllerPtr_.reset(nominalPrimalData_.primalSolution.controllerPtr_->clone());
+
+  PrimalSolution baselinePrimalSolution;
+  baselinePrimalSolution.modeSchedule_ = getReferenceManager().getModeSchedule();
+  if (!rolloutInitialController(nominalControllerSolution, baselinePrimalSolution)) {
+    throw std::runtime_error("[GaussNewtonDDP::computeRealTimeIterationBaseline] the prepared controller does not cover the initial time!");
+  }
+  rolloutInitializer(baselinePrimalSolution);
+
+  DualSolution baselineDualSolution;
+  ProblemMetrics baselineProblemMetrics;
+  ocs2::initializeDualSolution(optimalControlProblemStock_[0], baselinePrimalSolution, nominalDualData_.dualSolution,
+                               baselineDualSolution);
+  computeRolloutMetrics(optimalControlProblemStock_[0], baselinePrimalSolution, baselineDualSolution, baselineProblemMetrics);
+
+  auto performanceIndex = computeRolloutPerformanceIndex(baselinePrimalSolution.timeTrajectory_, baselineProblemMetrics);
+  performanceIndex.merit = calculateRolloutMerit(performanceIndex);
+  return performanceIndex;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -948,6 +1225,7 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
       throw std::runtime_error("[GaussNewtonDDP::run] controller must be a LinearController type!");
     }
     optimizedPrimalSolution_.controllerPtr_.reset(linearControllerPtr->clone());
+    isRealTimeIterationPrepared_ = false;  // the prepared LQ solution does not correspond to the external controller
   }
 
   runImpl(initTime, initState, finalTime);
@@ -970,6 +1248,7 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
     optimizedPrimalSolution_.postEventIndices_ = primalSolution.postEventIndices_;
     optimizedPrimalSolution_.stateTrajectory_ = primalSolution.stateTrajectory_;
     optimizedPrimalSolution_.inputTrajectory_ = primalSolution.inputTrajectory_;
+    isRealTimeIterationPrepared_ = false;  // the prepared LQ solution does not correspond to the input PrimalSolution
     runImpl(initTime, initState, finalTime);
   }
 }
@@ -999,27 +1278,34 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
   const auto initIteration = totalNumIterations_;
   initializeConstraintPenalties();  // initialize penalty coefficients
 
-  // display
-  if (ddpSettings_.displayInfo_) {
-    std::cerr << "\n###################";
-    std::cerr << "\n#### Initial Rollout";
-    std::cerr << "\n###################\n";
-  }
+  // real-time iteration: the first step is taken with the LQ solution prepared in the background after the previous run
+  bool isRealTimeIterationStep = isRealTimeIterationPrepared_ && takeRealTimeIterationStep();
+  isRealTimeIterationPrepared_ = false;
+  bool initialSolutionExists = true;  // true if the rollout is not purely from the Initializer
 
-  // swap primal and dual data to cache
-  nominalDualData_.swap(cachedDualData_);
-  nominalPrimalData_.swap(cachedPrimalData_);
+  if (!isRealTimeIterationStep) {
+    // display
+    if (ddpSettings_.displayInfo_) {
+      std::cerr << "\n###################";
+      std::cerr << "\n#### Initial Rollout";
+      std::cerr << "\n###################\n";
+    }
 
-  // optimized --> nominal: initializes the nominal primal and dual solutions based on the optimized ones
-  initializationTimer_.startTimer();
-  bool initialSolutionExists = initializePrimalSolution();  // true if the rollout is not purely from the Initializer
-  initializeDualSolutionAndMetrics();
-  performanceIndexHistory_.push_back(performanceIndex_);
-  initializationTimer_.endTimer();
+    // swap primal and dual data to cache
+    nominalDualData_.swap(cachedDualData_);
+    nominalPrimalData_.swap(cachedPrimalData_);
 
-  // display
-  if (ddpSettings_.displayInfo_) {
-    std::cerr << performanceIndex_ << '\n';
+    // optimized --> nominal: initializes the nominal primal and dual solutions based on the optimized ones
+    initializationTimer_.startTimer();
+    initialSolutionExists = initializePrimalSolution();
+    initializeDualSolutionAndMetrics();
+    performanceIndexHistory_.push_back(performanceIndex_);
+    initializationTimer_.endTimer();
+
+    // display
+    if (ddpSettings_.displayInfo_) {
+      std::cerr << performanceIndex_ << '\n';
+    }
   }
 
   // convergence variables of the main loop
@@ -1034,29 +1320,51 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
       std::cerr << "\n###################\n";
     }
 
-    // nominal --> nominal: constructs the LQ problem around the nominal trajectories
-    linearQuadraticApproximationTimer_.startTimer();
-    approximateOptimalControlProblem();
-    linearQuadraticApproximationTimer_.endTimer();
+    const auto numHeapAllocationsBefore = allocation_counter::getCount();
 
-    // nominal --> nominal: solves the LQ problem
-    backwardPassTimer_.startTimer();
-    avgTimeStepBP_ = solveSequentialRiccatiEquations(nominalPrimalData_.modelDataFinalTime.cost);
-    backwardPassTimer_.endTimer();
-
-    // calculate controller and store the result in unoptimizedController_
-    computeControllerTimer_.startTimer();
-    calculateController();
-    computeControllerTimer_.endTimer();
+    // release the arena temporaries of the previous iteration, the worker threads do the same in runParallelOverNodes()
+    getThreadLocalArena().reset();
 
-    // the expected cost/merit calculated by the Riccati solution is not reliable
-    const auto lqModelExpectedCost = initialSolutionExists ? nominalDualData_.valueFunctionTrajectory.front().f : performanceIndex_.merit;
+    if (isRealTimeIterationStep) {
+      // nominal --> optimized: the LQ problem is solved in the background after the previous run and the step is taken by
+      // takeRealTimeIterationStep()
+      isRealTimeIterationStep = false;
 
-    // nominal --> optimized: based on the current LQ solution updates the optimized primal and dual solutions
-    takePrimalDualStep(lqModelExpectedCost);
+    } else {
+      // nominal --> nominal: constructs the LQ problem around the nominal trajectories
+      linearQuadraticApproximationTimer_.startTimer();
+      approximateOptimalControlProblem();
+      linearQuadraticApproximationTimer_.endTimer();
+
+      const size_t numTrials = searchStrategyPtr_->initializeTrials();
+      if (numTrials > 1) {
+        // nominal --> optimized: solves the LQ problem of each trial and updates the optimized solutions based on the selected one
+        takePrimalDualTrialStep(numTrials, initialSolutionExists);
+
+      } else {
+        // nominal --> nominal: solves the LQ problem
+        backwardPassTimer_.startTimer();
+        searchStrategyPtr_->initializeRiccatiModification(nominalPrimalData_.primalSolution.timeTrajectory_.size());
+        avgTimeStepBP_ = solveSequentialRiccatiEquations(nominalPrimalData_.modelDataFinalTime.cost);
+        backwardPassTimer_.endTimer();
+
+        // calculate controller and store the result in unoptimizedController_
+        computeControllerTimer_.startTimer();
+        calculateController();
+        computeControllerTimer_.endTimer();
+
+        // the expected cost/merit calculated by the Riccati solution is not reliable
+        const auto lqModelExpectedCost =
+            initialSolutionExists ? nominalDualData_.valueFunctionTrajectory.front().f : performanceIndex_.merit;
+
+        // nominal --> optimized: based on the current LQ solution updates the optimized primal and dual solutions
+        takePrimalDualStep(lqModelExpectedCost);
+      }
+    }
 
     // iteration info
     ++totalNumIterations_;
+    numHeapAllocations_ += allocation_counter::getCount() - numHeapAllocationsBefore;
     performanceIndexHistory_.push_back(performanceIndex_);
 
     // display
@@ -31,9 +31,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <unordered_map>
 
+#include <Eigen/Cholesky>
+
 namespace ocs2 {
 namespace hessian_correction {
 
+namespace {
+/** The factorization workspace of the calling thread. Its memory is reused as long as the Hessian size does not change. */
+Eigen::LLT<matrix_t>& getThreadLocalLlt() {
+  thread_local Eigen::LLT<matrix_t> llt;
+  return llt;
+}
+}  // unnamed namespace
+
 std::string toString(Strategy strategy) {
   static const std::unordered_map<Strategy, std::string> strategyMap{{Strategy::DIAGONAL_SHIFT, "DIAGONAL_SHIFT"},
                                                                      {Strategy::CHOLESKY_MODIFICATION, "CHOLESKY_MODIFICATION"},
@@ -50,5 +60,79 @@ Strategy fromString(const std::string& name) {
   return strategyMap.at(name);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CorrectionCache::CorrectionCache(Strategy strategy, scalar_t minEigenvalue) : strategy_(strategy), minEigenvalue_(minEigenvalue) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CorrectionCache::resize(size_t numNodes) {
+  nodes_.resize(numNodes);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CorrectionCache::clear() {
+  nodes_.clear();
+  resetStatistics();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CorrectionCache::shiftHessian(size_t nodeIndex, matrix_t& matrix) {
+  assert(matrix.rows() == matrix.cols());
+  if (strategy_ != Strategy::CHOLESKY_MODIFICATION && strategy_ != Strategy::EIGENVALUE_MODIFICATION) {
+    hessian_correction::shiftHessian(strategy_, matrix, minEigenvalue_);
+    return;
+  }
+
+  auto& node = nodes_[nodeIndex];
+  if (node.failedLastCheck) {
+    node.failedLastCheck = false;
+    ++numSkippedChecks_;
+    hessian_correction::shiftHessian(strategy_, matrix, minEigenvalue_);
+    return;
+  }
+
+  // the matrix is left unchanged if all its eigenvalues are larger than minEigenvalue, i.e., (matrix - minEigenvalue * I) is PD
+  matrix = 0.5 * (matrix + matrix.transpose()).eval();
+  matrix.diagonal().array() -= minEigenvalue_;
+  auto& llt = getThreadLocalLlt();
+  llt.compute(matrix);
+  matrix.diagonal().array() += minEigenvalue_;
+
+  if (llt.info() == Eigen::Success) {
+    ++numHits_;
+  } else {
+    node.failedLastCheck = true;
+    ++numMisses_;
+    hessian_correction::shiftHessian(strategy_, matrix, minEigenvalue_);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CorrectionCache::Statistics CorrectionCache::getStatistics() const {
+  Statistics statistics;
+  statistics.numHits = numHits_;
+  statistics.numMisses = numMisses_;
+  statistics.numSkippedChecks = numSkippedChecks_;
+  return statistics;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CorrectionCache::resetStatistics() {
+  numHits_ = 0;
+  numMisses_ = 0;
+  numSkippedChecks_ = 0;
+}
+
 }  // namespace hessian_correction
 }  // namespace ocs2
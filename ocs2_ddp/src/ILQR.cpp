@@ -28,6 +28,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include "ocs2_ddp/ILQR.h"
+
+#include <ocs2_core/misc/MonotonicArena.h>
+
 #include <ocs2_ddp/riccati_equations/RiccatiTransversalityConditions.h>
 
 namespace ocs2 {
@@ -85,50 +88,45 @@ void ILQR::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDat
   const auto& multiplierTrajectory = dualSolution.intermediates;
   auto& modelDataTrajectory = primalData.modelDataTrajectory;
 
-  modelDataTrajectory.clear();
+  // the nodes are overwritten in place such that their memory is reused across iterations
   modelDataTrajectory.resize(timeTrajectory.size());
 
-  nextTimeIndex_ = 0;
-  nextTaskId_ = 0;
-  auto task = [&]() {
-    size_t taskId = nextTaskId_++;  // assign task ID (atomic)
-
-    ModelData continuousTimeModelData;
-
-    // get next time index is atomic
-    size_t timeIndex;
-    while ((timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
-      // approximate continuous LQ for the given time index
-      ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
-                                      inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], continuousTimeModelData);
-
-      // checking the numerical properties
-      if (settings().checkNumericalStability_) {
-        const auto errSize = checkSize(continuousTimeModelData, stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
-        if (!errSize.empty()) {
-          throw std::runtime_error("[ILQR::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errSize);
-        }
-        const auto errProperties = checkDynamicsProperties(continuousTimeModelData) + checkCostProperties(continuousTimeModelData) +
-                                   checkConstraintProperties(continuousTimeModelData);
-        if (!errProperties.empty()) {
-          throw std::runtime_error("[ILQR::approximateIntermediateLQ] Ill-posed problem at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errProperties);
-        }
-      }
+  // continuous-time LQ approximation of each worker
+  std::vector<ModelData> continuousTimeModelDataStock(settings().nThreads_);
+
+  auto task = [&](size_t workerIndex, size_t timeIndex) {
+    ModelData& continuousTimeModelData = continuousTimeModelDataStock[workerIndex];
+
+    // approximate continuous LQ for the given time index
+    ocs2::approximateIntermediateLQ(optimalControlProblemStock_[workerIndex], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
+                                    inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], continuousTimeModelData);
 
-      // discretize LQ problem
-      const scalar_t timeStep = (timeIndex + 1 < timeTrajectory.size()) ? (timeTrajectory[timeIndex + 1] - timeTrajectory[timeIndex]) : 0.0;
-      if (!numerics::almost_eq(timeStep, 0.0)) {
-        discreteLQWorker(*optimalControlProblemStock_[taskId].dynamicsPtr, timeTrajectory[timeIndex], stateTrajectory[timeIndex],
-                         inputTrajectory[timeIndex], timeStep, continuousTimeModelData, modelDataTrajectory[timeIndex]);
-      } else {
-        modelDataTrajectory[timeIndex] = continuousTimeModelData;
+    // checking the numerical properties
+    if (settings().checkNumericalStability_) {
+      const auto errSize = checkSize(continuousTimeModelData, stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
+      if (!errSize.empty()) {
+        throw std::runtime_error("[ILQR::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " +
+                                 std::to_string(timeTrajectory[timeIndex]) + "\n" + errSize);
       }
+      const auto errProperties = checkDynamicsProperties(continuousTimeModelData) + checkCostProperties(continuousTimeModelData) +
+                                 checkConstraintProperties(continuousTimeModelData);
+      if (!errProperties.empty()) {
+        throw std::runtime_error("[ILQR::approximateIntermediateLQ] Ill-posed problem at intermediate time: " +
+                                 std::to_string(timeTrajectory[timeIndex]) + "\n" + errProperties);
+      }
+    }
+
+    // discretize LQ problem
+    const scalar_t timeStep = (timeIndex + 1 < timeTrajectory.size()) ? (timeTrajectory[timeIndex + 1] - timeTrajectory[timeIndex]) : 0.0;
+    if (!numerics::almost_eq(timeStep, 0.0)) {
+      discreteLQWorker(*optimalControlProblemStock_[workerIndex].dynamicsPtr, timeTrajectory[timeIndex], stateTrajectory[timeIndex],
+                       inputTrajectory[timeIndex], timeStep, continuousTimeModelData, modelDataTrajectory[timeIndex]);
+    } else {
+      modelDataTrajectory[timeIndex] = continuousTimeModelData;
     }
   };
 
-  runParallel(task, settings().nThreads_);
+  runParallelOverNodes(timeTrajectory.size(), task, &lqApproximationTelemetry_);
 }
 
 /******************************************************************************************************/
@@ -141,6 +139,7 @@ void ILQR::discreteLQWorker(SystemDynamicsBase& system, scalar_t time, const vec
   modelData.inputDim = continuousTimeModelData.inputDim;
 
   // linearize system dynamics
+  modelData.dynamicsCovariance.resize(0, 0);
   modelData.dynamicsBias.setZero(modelData.stateDim);
   modelData.dynamics = sensitivityDiscretizer_(system, time, state, input, timeStep);
   modelData.dynamics.f.setZero(modelData.stateDim);
@@ -198,7 +197,7 @@ scalar_t ILQR::solveSequentialRiccatiEquations(const ScalarFunctionQuadraticAppr
   auto& finalProjectedKmFinal = projectedKmTrajectoryStock_.back();
 
   const matrix_t SmDummy = matrix_t::Zero(finalModelData.stateDim, finalModelData.stateDim);
-  computeProjectionAndRiccatiModification(finalModelData, SmDummy, finalProjectedModelData, finalRiccatiModification);
+  computeProjectionAndRiccatiModification(N - 1, finalModelData, SmDummy, finalProjectedModelData, finalRiccatiModification);
 
   // projected feedforward
   finalProjectedLvFinal = -finalProjectedModelData.cost.dfdu - finalRiccatiModification.deltaGv_;
@@ -214,11 +213,15 @@ scalar_t ILQR::solveSequentialRiccatiEquations(const ScalarFunctionQuadraticAppr
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-matrix_t ILQR::computeHamiltonianHessian(const ModelData& modelData, const matrix_t& Sm) const {
-  const matrix_t BmTransSm = modelData.dynamics.dfdu.transpose() * Sm;
-  matrix_t Hm = modelData.cost.dfduu;
+void ILQR::computeHamiltonianHessian(const ModelData& modelData, const matrix_t& Sm, matrix_t& Hm) const {
+  auto& arena = getThreadLocalArena();
+  MonotonicArena::Scope arenaScope(arena);
+  auto BmTransSm = arena.matrix(modelData.dynamics.dfdu.cols(), Sm.cols());
+  BmTransSm.noalias() = modelData.dynamics.dfdu.transpose() * Sm;
+
+  Hm = modelData.cost.dfduu;
   Hm.noalias() += BmTransSm * modelData.dynamics.dfdu;
-  return searchStrategyPtr_->augmentHamiltonianHessian(modelData, Hm);
+  searchStrategyPtr_->augmentHamiltonianHessian(modelData, Hm);
 }
 
 /******************************************************************************************************/
@@ -253,7 +256,8 @@ void ILQR::riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>&
     auto& curSv = nominalDualData_.valueFunctionTrajectory[curIndex].dfdx;
     auto& curs = nominalDualData_.valueFunctionTrajectory[curIndex].f;
 
-    computeProjectionAndRiccatiModification(curModelData, valueFunctionNext->dfdxx, curProjectedModelData, curRiccatiModification);
+    computeProjectionAndRiccatiModification(curIndex, curModelData, valueFunctionNext->dfdxx, curProjectedModelData,
+                                            curRiccatiModification);
 
     riccatiEquationsPtrStock_[workerIndex]->computeMap(curProjectedModelData, curRiccatiModification, valueFunctionNext->dfdxx,
                                                        valueFunctionNext->dfdx, valueFunctionNext->f, curProjectedKm, curProjectedLv, curSm,
@@ -277,7 +281,7 @@ void ILQR::riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>&
       auto& finalProjectedKmFinal = projectedKmTrajectoryStock_[curIndex];
 
       const matrix_t SmDummy = matrix_t::Zero(finalModelData.stateDim, finalModelData.stateDim);
-      computeProjectionAndRiccatiModification(finalModelData, SmDummy, finalProjectedModelData, finalRiccatiModification);
+      computeProjectionAndRiccatiModification(curIndex, finalModelData, SmDummy, finalProjectedModelData, finalRiccatiModification);
 
       // projected feedforward
       finalProjectedLvFinal = -finalProjectedModelData.cost.dfdu - finalRiccatiModification.deltaGv_;
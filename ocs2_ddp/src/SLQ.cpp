@@ -55,7 +55,7 @@ SLQ::SLQ(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalCon
   riccatiIntegratorPtrStock_.reserve(settings().nThreads_);
 
   const auto integratorType = settings().backwardPassIntegratorType_;
-  if (integratorType != IntegratorType::ODE45 && integratorType != IntegratorType::BULIRSCH_STOER &&
+  if (!settings().fixedGridRiccati_ && integratorType != IntegratorType::ODE45 && integratorType != IntegratorType::BULIRSCH_STOER &&
       integratorType != IntegratorType::ODE45_OCS2 && integratorType != IntegratorType::RK4) {
     throw(std::runtime_error("Unsupported Riccati equation integrator type: " +
                              integrator_type::toString(settings().backwardPassIntegratorType_)));
@@ -84,41 +84,33 @@ void SLQ::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalData
   const auto& multiplierTrajectory = dualSolution.intermediates;
   auto& modelDataTrajectory = primalData.modelDataTrajectory;
 
-  modelDataTrajectory.clear();
+  // the nodes are overwritten in place such that their memory is reused across iterations
   modelDataTrajectory.resize(timeTrajectory.size());
 
-  nextTimeIndex_ = 0;
-  nextTaskId_ = 0;
-  auto task = [&]() {
-    const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
-
-    // get next time index is atomic
-    size_t timeIndex;
-    while ((timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
-      // approximate LQ for the given time index
-      ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
-                                      inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], modelDataTrajectory[timeIndex]);
-
-      // checking the numerical properties
-      if (settings().checkNumericalStability_) {
-        const auto errSize =
-            checkSize(modelDataTrajectory[timeIndex], stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
-        if (!errSize.empty()) {
-          throw std::runtime_error("[SLQ::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errSize);
-        }
-        const std::string errProperties = checkDynamicsProperties(modelDataTrajectory[timeIndex]) +
-                                          checkCostProperties(modelDataTrajectory[timeIndex]) +
-                                          checkConstraintProperties(modelDataTrajectory[timeIndex]);
-        if (!errProperties.empty()) {
-          throw std::runtime_error("[SLQ::approximateIntermediateLQ] Ill-posed problem at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errProperties);
-        }
+  auto task = [&](size_t workerIndex, size_t timeIndex) {
+    // approximate LQ for the given time index
+    ocs2::approximateIntermediateLQ(optimalControlProblemStock_[workerIndex], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
+                                    inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], modelDataTrajectory[timeIndex]);
+
+    // checking the numerical properties
+    if (settings().checkNumericalStability_) {
+      const auto errSize =
+          checkSize(modelDataTrajectory[timeIndex], stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
+      if (!errSize.empty()) {
+        throw std::runtime_error("[SLQ::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " +
+                                 std::to_string(timeTrajectory[timeIndex]) + "\n" + errSize);
       }
-    }  // end of while loop
+      const std::string errProperties = checkDynamicsProperties(modelDataTrajectory[timeIndex]) +
+                                        checkCostProperties(modelDataTrajectory[timeIndex]) +
+                                        checkConstraintProperties(modelDataTrajectory[timeIndex]);
+      if (!errProperties.empty()) {
+        throw std::runtime_error("[SLQ::approximateIntermediateLQ] Ill-posed problem at intermediate time: " +
+                                 std::to_string(timeTrajectory[timeIndex]) + "\n" + errProperties);
+      }
+    }
   };
 
-  runParallel(task, settings().nThreads_);
+  runParallelOverNodes(timeTrajectory.size(), task, &lqApproximationTelemetry_);
 }
 
 /******************************************************************************************************/
@@ -181,20 +173,13 @@ scalar_t SLQ::solveSequentialRiccatiEquations(const ScalarFunctionQuadraticAppro
 
   if (N > 0) {
     // perform the computeRiccatiModificationTerms for partition i
-    nextTimeIndex_ = 0;
-    nextTaskId_ = 0;
-    auto task = [this, N]() {
-      int timeIndex;
-      const matrix_t SmDummy = matrix_t::Zero(0, 0);
-
-      // get next time index is atomic
-      while ((timeIndex = nextTimeIndex_++) < N) {
-        computeProjectionAndRiccatiModification(nominalPrimalData_.modelDataTrajectory[timeIndex], SmDummy,
-                                                nominalDualData_.projectedModelDataTrajectory[timeIndex],
-                                                nominalDualData_.riccatiModificationTrajectory[timeIndex]);
-      }
+    const matrix_t SmDummy = matrix_t::Zero(0, 0);
+    auto task = [this, &SmDummy](size_t /*workerIndex*/, size_t timeIndex) {
+      computeProjectionAndRiccatiModification(timeIndex, nominalPrimalData_.modelDataTrajectory[timeIndex], SmDummy,
+                                              nominalDualData_.projectedModelDataTrajectory[timeIndex],
+                                              nominalDualData_.riccatiModificationTrajectory[timeIndex]);
     };
-    runParallel(task, settings().nThreads_);
+    runParallelOverNodes(N, task);
   }
 
   return solveSequentialRiccatiEquationsImpl(finalValueFunction);
@@ -203,8 +188,9 @@ scalar_t SLQ::solveSequentialRiccatiEquations(const ScalarFunctionQuadraticAppro
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-matrix_t SLQ::computeHamiltonianHessian(const ModelData& modelData, const matrix_t& Sm) const {
-  return searchStrategyPtr_->augmentHamiltonianHessian(modelData, modelData.cost.dfduu);
+void SLQ::computeHamiltonianHessian(const ModelData& modelData, const matrix_t& Sm, matrix_t& Hm) const {
+  Hm = modelData.cost.dfduu;
+  searchStrategyPtr_->augmentHamiltonianHessian(modelData, Hm);
 }
 
 /******************************************************************************************************/
@@ -239,12 +225,19 @@ void SLQ::riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>&
    *  SsNormalized = [-10.0, ..., -2.0, -1.0, -0.0]
    */
   vector_array_t& allSsTrajectory = allSsTrajectoryStock_[workerIndex];
-  integrateRiccatiEquationNominalTime(*riccatiIntegratorPtrStock_[workerIndex], *riccatiEquationsPtrStock_[workerIndex], partitionInterval,
-                                      nominalTimeTrajectory, nominalEventsPastTheEndIndices, std::move(allSsFinal), SsNormalizedTime,
-                                      SsNormalizedPostEventIndices, allSsTrajectory);
+  if (settings().fixedGridRiccati_) {
+    retrieveActiveNormalizedTime(partitionInterval, nominalTimeTrajectory, nominalEventsPastTheEndIndices, SsNormalizedTime,
+                                 SsNormalizedPostEventIndices);
+    integrateRiccatiEquationFixedGrid(*riccatiEquationsPtrStock_[workerIndex], partitionInterval, nominalTimeTrajectory,
+                                      nominalEventsPastTheEndIndices, std::move(allSsFinal), allSsTrajectory);
+  } else {
+    integrateRiccatiEquationNominalTime(*riccatiIntegratorPtrStock_[workerIndex], *riccatiEquationsPtrStock_[workerIndex],
+                                        partitionInterval, nominalTimeTrajectory, nominalEventsPastTheEndIndices, std::move(allSsFinal),
+                                        SsNormalizedTime, SsNormalizedPostEventIndices, allSsTrajectory);
+  }
 
   // Convert value function to matrix format
-  size_t outputN = SsNormalizedTime.size();
+  const size_t outputN = allSsTrajectory.size();
   for (size_t k = partitionInterval.first; k < partitionInterval.second; k++) {
     ContinuousTimeRiccatiEquations::convert2Matrix(allSsTrajectory[outputN - 1 - k + partitionInterval.first], valueFunctionTrajectory[k]);
   }  // end of k loop
@@ -301,4 +294,38 @@ void SLQ::integrateRiccatiEquationNominalTime(IntegratorBase& riccatiIntegrator,
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SLQ::integrateRiccatiEquationFixedGrid(ContinuousTimeRiccatiEquations& riccatiEquation, const std::pair<int, int>& partitionInterval,
+                                            const scalar_array_t& nominalTimeTrajectory, const size_array_t& nominalEventsPastTheEndIndices,
+                                            vector_t allSsFinal, vector_array_t& allSsTrajectory) {
+  allSsTrajectory.clear();
+  allSsTrajectory.reserve(partitionInterval.second - partitionInterval.first + 1);
+  allSsTrajectory.push_back(std::move(allSsFinal));
+
+  // past the end of the events within (first, second]
+  const auto& eventIndices = nominalEventsPastTheEndIndices;
+  auto eventItr = std::upper_bound(eventIndices.cbegin(), eventIndices.cend(), static_cast<size_t>(partitionInterval.second));
+
+  vector_t k1, k2, allSsPredicted;
+  for (int k = partitionInterval.second; k > partitionInterval.first; k--) {
+    const vector_t& allSs = allSsTrajectory.back();
+
+    if (eventItr != eventIndices.cbegin() && static_cast<int>(*std::prev(eventItr)) == k) {
+      // node k-1 is the pre-event node of the event at nominalTimeTrajectory[k]
+      --eventItr;
+      allSsTrajectory.push_back(riccatiEquation.computeJumpMap(-nominalTimeTrajectory[k], allSs));
+
+    } else {
+      // Heun's method in the normalized time, z = -t
+      const scalar_t dz = nominalTimeTrajectory[k] - nominalTimeTrajectory[k - 1];
+      k1 = riccatiEquation.computeFlowMapAtNode(k, allSs);
+      allSsPredicted = allSs + dz * k1;
+      k2 = riccatiEquation.computeFlowMapAtNode(k - 1, allSsPredicted);
+      allSsTrajectory.push_back(allSs + (0.5 * dz) * (k1 + k2));
+    }
+  }  // end of k loop
+}
+
 }  // namespace ocs2
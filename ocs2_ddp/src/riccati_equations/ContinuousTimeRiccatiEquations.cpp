@@ -36,6 +36,30 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+/**
+ * Same as LinearInterpolation::interpolate, but writes the result into the output. The output's memory is reused if it
+ * already has the correct size, which avoids one allocation per coefficient in every flow map evaluation.
+ */
+template <typename Data, class Alloc, class AccessFun, class Output>
+void interpolateInPlace(LinearInterpolation::index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataArray, AccessFun accessFun,
+                        Output& output) {
+  assert(dataArray.size() > 0);
+  if (dataArray.size() > 1) {
+    const scalar_t alpha = indexAlpha.second;
+    const auto& lhs = accessFun(dataArray, indexAlpha.first);
+    const auto& rhs = accessFun(dataArray, indexAlpha.first + 1);
+    if (LinearInterpolation::areSameSize(rhs, lhs)) {
+      output = alpha * lhs + (scalar_t(1.0) - alpha) * rhs;
+    } else {
+      output = (alpha > 0.5) ? lhs : rhs;
+    }
+  } else {
+    output = accessFun(dataArray, 0);
+  }
+}
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -53,31 +77,36 @@ void ContinuousTimeRiccatiEquations::setRiskSensitiveCoefficient(scalar_t riskSe
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t ContinuousTimeRiccatiEquations::convert2Vector(const matrix_t& Sm, const vector_t& Sv, const scalar_t& s) {
-  /* Sm is symmetric. Here, we only extract the upper triangular part and
-   * transcribe it in column-wise fashion into allSs*/
-  size_t count = 0;  // count the total number of scalar entries covered
-  size_t nRows = 0;
+  vector_t allSs;
+  convert2Vector(Sm, Sv, s, allSs);
+  return allSs;
+}
 
-  const auto state_dim = Sm.cols();
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ContinuousTimeRiccatiEquations::convert2Vector(const matrix_t& Sm, const vector_t& Sv, scalar_t s, vector_t& allSs) {
+  /* Sm is symmetric. Here, we only extract the upper triangular part and
+   * transcribe it in column-wise fashion into allSs. The strictly lower part of Sm is not read. */
+  const int state_dim = Sm.cols();
   assert(state_dim > 0);
   assert(Sm.rows() == state_dim);
   assert(Sv.rows() == state_dim);
 
-  vector_t allSs(s_vector_dim(state_dim));
+  allSs.resize(s_vector_dim(state_dim));
 
-  for (size_t col = 0; col < state_dim; col++) {
-    nRows = col + 1;
-    allSs.segment(count, nRows) << Eigen::Map<const vector_t>(Sm.data() + col * state_dim, nRows);
+  int count = 0;  // count the total number of scalar entries covered
+  for (int col = 0; col < state_dim; col++) {
+    const int nRows = col + 1;
+    allSs.segment(count, nRows) = Sm.col(col).head(nRows);
     count += nRows;
   }
 
   /* add data from Sv on top*/
-  allSs.segment(count, state_dim) << Eigen::Map<const vector_t>(Sv.data(), state_dim);
+  allSs.segment(count, state_dim) = Sv;
 
   /* add s as last element*/
-  allSs.template tail<1>() << s;
-
-  return allSs;
+  allSs(count + state_dim) = s;
 }
 
 /******************************************************************************************************/
@@ -152,8 +181,25 @@ vector_t ContinuousTimeRiccatiEquations::computeJumpMap(scalar_t z, const vector
 vector_t ContinuousTimeRiccatiEquations::computeFlowMap(scalar_t z, const vector_t& allSs) {
   // index
   const scalar_t t = -z;  // denormalized time
-  const auto indexAlpha = LinearInterpolation::timeSegment(t, *timeStampPtr_);
+  return computeFlowMapImpl(LinearInterpolation::timeSegment(t, *timeStampPtr_), allSs);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t ContinuousTimeRiccatiEquations::computeFlowMapAtNode(size_t index, const vector_t& allSs) {
+  assert(index < timeStampPtr_->size());
+  // the interpolation weights of the node, the last node is the right end of the last segment
+  const int lastIndex = static_cast<int>(timeStampPtr_->size()) - 1;
+  const auto indexAlpha = (static_cast<int>(index) < lastIndex) ? std::make_pair(static_cast<int>(index), scalar_t(1.0))
+                                                                : std::make_pair(std::max(lastIndex - 1, 0), scalar_t(0.0));
+  return computeFlowMapImpl(indexAlpha, allSs);
+}
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t ContinuousTimeRiccatiEquations::computeFlowMapImpl(std::pair<int, scalar_t> indexAlpha, const vector_t& allSs) {
   convert2Matrix(allSs, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_);
   if (isRiskSensitive_) {
     computeFlowMapILEG(indexAlpha, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_,
@@ -177,31 +223,35 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
   /* note: according to some discussions on stackoverflow, it does not buy
    * computation time if multiplications with symmetric matrices are executed
    * using selfadjointView(). Doing the full multiplication seems to be faster
-   * because of vectorization
+   * because of vectorization.
+   *
+   * However, since only the upper triangular part of dSm is transcribed to the flattened vector, the symmetric terms of dSm are
+   * only accumulated on the upper triangular part. For the symmetric products, e.g. Km^T * Gm, this halves their complexity.
+   * The strictly lower triangular part of dSm is therefore not valid.
    */
 
   // Hv
-  creCache.projectedHv_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamicsBias);
+  interpolateInPlace(indexAlpha, *projectedModelDataPtr_, model_data::dynamicsBias, creCache.projectedHv_);
   // Am
-  creCache.projectedAm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamics_dfdx);
+  interpolateInPlace(indexAlpha, *projectedModelDataPtr_, model_data::dynamics_dfdx, creCache.projectedAm_);
   // Bm
-  creCache.projectedBm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamics_dfdu);
+  interpolateInPlace(indexAlpha, *projectedModelDataPtr_, model_data::dynamics_dfdu, creCache.projectedBm_);
   // q
   ds = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_f);
   // Qv
-  dSv = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdx);
+  interpolateInPlace(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdx, dSv);
   // Qm
-  dSm = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdxx);
+  interpolateInPlace(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdxx, dSm);
   // Rv
-  creCache.projectedGv_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdu);
+  interpolateInPlace(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdu, creCache.projectedGv_);
   // Pm
-  creCache.projectedGm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdux);
+  interpolateInPlace(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdux, creCache.projectedGm_);
   // delatQm
-  creCache.deltaQm_ = LinearInterpolation::interpolate(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaQm);
+  interpolateInPlace(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaQm, creCache.deltaQm_);
   // delatGm
-  creCache.projectedKm_ = LinearInterpolation::interpolate(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaGm);
+  interpolateInPlace(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaGm, creCache.projectedKm_);
   // delatGv
-  creCache.projectedLv_ = LinearInterpolation::interpolate(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaGv);
+  interpolateInPlace(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaGv, creCache.projectedLv_);
 
   // projectedGm = projectedPm + projectedBm^T * Sm [COMPLEXITY: nx^2 * np]
   creCache.projectedGm_.noalias() += creCache.projectedBm_.transpose() * Sm;
@@ -215,12 +265,11 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
   creCache.projectedLv_ = -(creCache.projectedGv_ + creCache.projectedLv_);
 
   // precomputation
-  // [COMPLEXITY: nx^3 + nx^2 * np]
+  // [COMPLEXITY: nx^3]
   creCache.SmTrans_projectedAm_.noalias() = Sm.transpose() * creCache.projectedAm_;
-  creCache.projectedKm_T_projectedGm_.noalias() = creCache.projectedKm_.transpose() * creCache.projectedGm_;
   if (!reducedFormRiccati_) {
     // Rm
-    creCache.projectedRm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfduu);
+    interpolateInPlace(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfduu, creCache.projectedRm_);
     // [COMPLEXITY: nx * np^2]
     creCache.projectedRm_projectedKm_.noalias() = creCache.projectedRm_ * creCache.projectedKm_;
     // [COMPLEXITY: np^2]
@@ -228,23 +277,25 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
   }
 
   /*
-   * Sm
+   * Sm (upper triangular part)
    *
    * reducedFormRiccati:
-   *   [TOTAL COMPLEXITY: (nx^3) + 2(nx^2 * np)]
+   *   [TOTAL COMPLEXITY: (nx^3) + 1.5(nx^2 * np)]
    * other
-   *   [TOTAL COMPLEXITY: (nx^3) + 3(nx^2 * np) + (nx * np^2)]
+   *   [TOTAL COMPLEXITY: (nx^3) + 2.5(nx^2 * np) + (nx * np^2)]
    */
+  auto dSmUpper = dSm.triangularView<Eigen::Upper>();
   // += deltaQm + Sm^T * Am + Am^T * Sm
-  dSm += creCache.deltaQm_ + creCache.SmTrans_projectedAm_ + creCache.SmTrans_projectedAm_.transpose();
+  dSmUpper += creCache.deltaQm_ + creCache.SmTrans_projectedAm_ + creCache.SmTrans_projectedAm_.transpose();
   if (reducedFormRiccati_) {
-    // += Km^T * Gm-
-    dSm += creCache.projectedKm_T_projectedGm_;
+    // += Km^T * Gm
+    dSmUpper += creCache.projectedKm_.transpose() * creCache.projectedGm_;
   } else {
     // += Km^T * Gm + Gm^T * Km
-    dSm += creCache.projectedKm_T_projectedGm_ + creCache.projectedKm_T_projectedGm_.transpose();
+    creCache.projectedKm_T_projectedGm_.noalias() = creCache.projectedKm_.transpose() * creCache.projectedGm_;
+    dSmUpper += creCache.projectedKm_T_projectedGm_ + creCache.projectedKm_T_projectedGm_.transpose();
     // += Km^T * Hm * Km
-    dSm.noalias() += creCache.projectedKm_.transpose() * creCache.projectedRm_projectedKm_;
+    dSmUpper += creCache.projectedKm_.transpose() * creCache.projectedRm_projectedKm_;
   }
 
   /*
@@ -300,12 +351,13 @@ void ContinuousTimeRiccatiEquations::computeFlowMapILEG(std::pair<int, scalar_t>
   computeFlowMapSLQ(indexAlpha, Sm, Sv, s, creCache, dSm, dSv, ds);
 
   // Sigma
-  creCache.dynamicsCovariance_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamicsCovariance);
+  interpolateInPlace(indexAlpha, *projectedModelDataPtr_, model_data::dynamicsCovariance, creCache.dynamicsCovariance_);
 
   creCache.Sigma_Sv_.noalias() = creCache.dynamicsCovariance_ * Sv;
   creCache.Sigma_Sm_.noalias() = creCache.dynamicsCovariance_ * Sm;
 
-  dSm.noalias() += riskSensitiveCoeff_ * Sm.transpose() * creCache.Sigma_Sm_;
+  // only the upper triangular part of dSm is valid, see computeFlowMapSLQ
+  dSm.triangularView<Eigen::Upper>() += (riskSensitiveCoeff_ * Sm.transpose()) * creCache.Sigma_Sm_;
   dSv.noalias() += riskSensitiveCoeff_ * creCache.Sigma_Sm_.transpose() * Sv;
   ds += 0.5 * creCache.Sigma_Sm_.trace() + 0.5 * riskSensitiveCoeff_ * Sv.dot(creCache.Sigma_Sv_);
 }
@@ -40,20 +40,101 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-LevenbergMarquardtStrategy::LevenbergMarquardtStrategy(search_strategy::Settings baseSettings, levenberg_marquardt::Settings settings,
-                                                       RolloutBase& rolloutRef, OptimalControlProblem& optimalControlProblemRef,
-                                                       std::function<scalar_t(const PerformanceIndex&)> meritFunc)
+LevenbergMarquardtStrategy::LevenbergMarquardtStrategy(
+    search_strategy::Settings baseSettings, levenberg_marquardt::Settings settings, ThreadPool& threadPoolRef,
+    std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock,
+    std::vector<std::reference_wrapper<OptimalControlProblem>> optimalControlProblemRefStock,
+    std::function<scalar_t(const PerformanceIndex&)> meritFunc)
     : SearchStrategyBase(std::move(baseSettings)),
       settings_(std::move(settings)),
-      rolloutRef_(rolloutRef),
-      optimalControlProblemRef_(optimalControlProblemRef),
-      meritFunc_(std::move(meritFunc)) {}
+      threadPoolRef_(threadPoolRef),
+      rolloutRefStock_(std::move(rolloutRefStock)),
+      optimalControlProblemRefStock_(std::move(optimalControlProblemRefStock)),
+      meritFunc_(std::move(meritFunc)),
+      tempDualSolutions_(rolloutRefStock_.size()) {
+  if (rolloutRefStock_.empty() || rolloutRefStock_.size() != optimalControlProblemRefStock_.size()) {
+    throw std::runtime_error("[LevenbergMarquardtStrategy] The rollout and optimal control problem stocks should have the same size!");
+  }
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void LevenbergMarquardtStrategy::reset() {
   lmModule_ = LevenbergMarquardtModule();
+  trialModules_.clear();
+  activeTrial_ = 0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t LevenbergMarquardtStrategy::initializeTrials() {
+  // the trials beyond the maximum number of successive rejections are not evaluated. If it is already exceeded, a single trial
+  // is evaluated and run() throws.
+  size_t numTrials = std::max(settings_.numParallelTrials, size_t(1));
+  if (lmModule_.numSuccessiveRejections <= settings_.maxNumSuccessiveRejections) {
+    numTrials = std::min(numTrials, settings_.maxNumSuccessiveRejections + 1 - lmModule_.numSuccessiveRejections);
+  } else {
+    numTrials = 1;
+  }
+
+  // the k-th trial has the Riccati multiple after k successive rejections
+  trialModules_.resize(numTrials);
+  trialModules_.front() = lmModule_;
+  for (size_t k = 1; k < numTrials; k++) {
+    trialModules_[k] = trialModules_[k - 1];
+    adjustRiccatiMultiple(0.0, trialModules_[k]);
+    ++trialModules_[k].numSuccessiveRejections;
+  }  // end of k loop
+
+  activeTrial_ = 0;
+  return numTrials;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LevenbergMarquardtStrategy::computeSolution(size_t taskId, scalar_t stepLength, const LinearController& unoptimizedController,
+                                                 search_strategy::Solution& solution) {
+  auto& rollout = rolloutRefStock_[taskId].get();
+  auto& problem = optimalControlProblemRefStock_[taskId].get();
+
+  // compute primal solution
+  solution.primalSolution.modeSchedule_ = *modeSchedulePtr_;
+  incrementController(stepLength, unoptimizedController, getLinearController(solution.primalSolution));
+  solution.avgTimeStep = rolloutTrajectory(rollout, timePeriodPtr_->first, *initStatePtr_, timePeriodPtr_->second, solution.primalSolution);
+
+  // adjust dual solution only if it is required
+  const DualSolution* adjustedDualSolutionPtr = dualSolutionPtr_;
+  if (!dualSolutionPtr_->timeTrajectory.empty()) {
+    // trajectory spreading
+    constexpr bool debugPrint = false;
+    TrajectorySpreading trajectorySpreading(debugPrint);
+    const auto status = trajectorySpreading.set(*modeSchedulePtr_, solution.primalSolution.modeSchedule_, dualSolutionPtr_->timeTrajectory);
+    if (status.willTruncate || status.willPerformTrajectorySpreading) {
+      trajectorySpread(trajectorySpreading, *dualSolutionPtr_, tempDualSolutions_[taskId]);
+      adjustedDualSolutionPtr = &tempDualSolutions_[taskId];
+    }
+  }
+
+  // initialize dual solution
+  initializeDualSolution(problem, solution.primalSolution, *adjustedDualSolutionPtr, solution.dualSolution);
+
+  // compute problem metrics
+  computeRolloutMetrics(problem, solution.primalSolution, solution.dualSolution, solution.problemMetrics);
+
+  // compute performanceIndex
+  solution.performanceIndex = computeRolloutPerformanceIndex(solution.primalSolution.timeTrajectory_, solution.problemMetrics);
+  solution.performanceIndex.merit = meritFunc_(solution.performanceIndex);
+
+  // display
+  if (baseSettings_.displayInfo) {
+    std::stringstream infoDisplay;
+    infoDisplay << "    [Thread " << taskId << "] - step length " << stepLength << '\n';
+    infoDisplay << std::setw(4) << solution.performanceIndex << "\n\n";
+    printString(infoDisplay.str());
+  }
 }
 
 /******************************************************************************************************/
@@ -63,95 +144,112 @@ bool LevenbergMarquardtStrategy::run(const std::pair<scalar_t, scalar_t>& timePe
                                      const scalar_t expectedCost, const LinearController& unoptimizedController,
                                      const DualSolution& dualSolution, const ModeSchedule& modeSchedule,
                                      search_strategy::SolutionRef solution) {
-  constexpr size_t taskId = 0;
+  trialModules_.assign(1, lmModule_);
+  return runTrials(timePeriod, initState, {expectedCost}, {&unoptimizedController}, dualSolution, modeSchedule, solution).first;
+}
 
-  // previous merit and the expected reduction
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<bool, size_t> LevenbergMarquardtStrategy::runTrials(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState,
+                                                              const scalar_array_t& expectedCosts,
+                                                              const std::vector<const LinearController*>& unoptimizedControllers,
+                                                              const DualSolution& dualSolution, const ModeSchedule& modeSchedule,
+                                                              search_strategy::SolutionRef solution) {
+  const size_t numTrials = unoptimizedControllers.size();
+  if (expectedCosts.size() != numTrials || trialModules_.size() != numTrials) {
+    throw std::runtime_error("[LevenbergMarquardtStrategy::runTrials] The number of trials does not match the one of initializeTrials()!");
+  }
+
+  // initialize the trials' inputs
+  timePeriodPtr_ = &timePeriod;
+  initStatePtr_ = &initState;
+  dualSolutionPtr_ = &dualSolution;
+  modeSchedulePtr_ = &modeSchedule;
+  trialSolutions_.resize(numTrials);
+  for (auto& trialSolution : trialSolutions_) {
+    if (trialSolution.primalSolution.controllerPtr_ == nullptr) {
+      trialSolution.primalSolution.controllerPtr_.reset(new LinearController);
+    }
+  }
+
+  // previous merit
   const auto prevMerit = solution.performanceIndex.merit;
-  const auto expectedReduction = solution.performanceIndex.merit - expectedCost;
-
-  // stepsize
-  const scalar_t stepLength = numerics::almost_eq(expectedReduction, 0.0) ? 0.0 : 1.0;
-
-  try {
-    // compute primal solution
-    solution.primalSolution.modeSchedule_ = modeSchedule;
-    incrementController(stepLength, unoptimizedController, getLinearController(solution.primalSolution));
-    solution.avgTimeStep = rolloutTrajectory(rolloutRef_, timePeriod.first, initState, timePeriod.second, solution.primalSolution);
-
-    // adjust dual solution only if it is required
-    const DualSolution* adjustedDualSolutionPtr = &dualSolution;
-    if (!dualSolution.timeTrajectory.empty()) {
-      // trajectory spreading
-      constexpr bool debugPrint = false;
-      TrajectorySpreading trajectorySpreading(debugPrint);
-      const auto status = trajectorySpreading.set(modeSchedule, solution.primalSolution.modeSchedule_, dualSolution.timeTrajectory);
-      if (status.willTruncate || status.willPerformTrajectorySpreading) {
-        trajectorySpread(trajectorySpreading, dualSolution, tempDualSolution_);
-        adjustedDualSolutionPtr = &tempDualSolution_;
+
+  auto evaluateTrial = [&](size_t taskId, size_t trialIndex) {
+    const auto expectedReduction = prevMerit - expectedCosts[trialIndex];
+    const scalar_t stepLength = numerics::almost_eq(expectedReduction, 0.0) ? 0.0 : 1.0;
+    auto& trialSolution = trialSolutions_[trialIndex];
+    try {
+      computeSolution(taskId, stepLength, *unoptimizedControllers[trialIndex], trialSolution);
+    } catch (const std::exception& error) {
+      if (baseSettings_.displayInfo) {
+        printString("    [Thread " + std::to_string(taskId) + "] rollout with step length " + std::to_string(stepLength) +
+                    " is terminated: " + error.what() + "\n");
       }
+      trialSolution.performanceIndex.merit = std::numeric_limits<scalar_t>::max();
+      trialSolution.performanceIndex.cost = std::numeric_limits<scalar_t>::max();
     }
+  };
 
-    // initialize dual solution
-    initializeDualSolution(optimalControlProblemRef_, solution.primalSolution, *adjustedDualSolutionPtr, solution.dualSolution);
-
-    // compute problem metrics
-    computeRolloutMetrics(optimalControlProblemRef_, solution.primalSolution, solution.dualSolution, solution.problemMetrics);
+  // evaluate the trials
+  if (numTrials == 1) {
+    constexpr size_t taskId = 0;
+    evaluateTrial(taskId, 0);
+  } else {
+    std::atomic_size_t nextTaskId{0};
+    std::atomic_size_t nextTrialIndex{0};
+    auto task = [&](int) {
+      const size_t taskId = nextTaskId++;
+      size_t trialIndex;
+      while ((trialIndex = nextTrialIndex++) < numTrials) {
+        evaluateTrial(taskId, trialIndex);
+      }
+    };
+    threadPoolRef_.runParallel(task, std::min(numTrials, rolloutRefStock_.size()));
+  }
 
-    // compute performanceIndex
-    solution.performanceIndex = computeRolloutPerformanceIndex(solution.primalSolution.timeTrajectory_, solution.problemMetrics);
-    solution.performanceIndex.merit = meritFunc_(solution.performanceIndex);
+  // compute pho (the ratio between actual reduction and predicted reduction) and choose the accepted trial with the lowest merit.
+  // If no trial is accepted, the last one is chosen as it carries all the rejections.
+  bool success = false;
+  size_t selectedTrial = numTrials - 1;
+  scalar_array_t phoArray(numTrials);
+  for (size_t k = 0; k < numTrials; k++) {
+    const auto expectedReduction = prevMerit - expectedCosts[k];
+    const auto actualReduction = prevMerit - trialSolutions_[k].performanceIndex.merit;
+    phoArray[k] = reductionToPredictedReduction(actualReduction, expectedReduction);
 
     // display
     if (baseSettings_.displayInfo) {
-      std::stringstream infoDisplay;
-      infoDisplay << "    [Thread " << taskId << "] - step length " << stepLength << '\n';
-      infoDisplay << std::setw(4) << solution.performanceIndex << "\n\n";
-      std::cerr << infoDisplay.str();
+      if (numTrials > 1) {
+        std::cerr << "[Trial " << k << ", Riccati multiple " << trialModules_[k].riccatiMultiple << "] ";
+      }
+      std::cerr << "Actual Reduction: " << actualReduction << ",   Predicted Reduction: " << expectedReduction << "\n";
     }
 
-  } catch (const std::exception& error) {
-    if (baseSettings_.displayInfo) {
-      std::cerr << "    [Thread " << taskId << "] rollout with step length " << stepLength << " is terminated: " << error.what() << "\n";
+    const bool isAccepted = phoArray[k] >= settings_.minAcceptedPho;
+    if (isAccepted && (!success || trialSolutions_[k].performanceIndex.merit < trialSolutions_[selectedTrial].performanceIndex.merit)) {
+      success = true;
+      selectedTrial = k;
     }
-    solution.performanceIndex.merit = std::numeric_limits<scalar_t>::max();
-    solution.performanceIndex.cost = std::numeric_limits<scalar_t>::max();
-  }
+  }  // end of k loop
 
-  // compute pho (the ratio between actual reduction and predicted reduction)
-  const auto actualReduction = prevMerit - solution.performanceIndex.merit;
-  const auto pho = reductionToPredictedReduction(actualReduction, expectedReduction);
-
-  // display
-  if (baseSettings_.displayInfo) {
-    std::cerr << "Actual Reduction: " << actualReduction << ",   Predicted Reduction: " << expectedReduction << "\n";
-  }
+  // the Levenberg-Marquardt module as if the trials up to the selected one were evaluated successively
+  lmModule_ = trialModules_[selectedTrial];
+  const auto pho = phoArray[selectedTrial];
+  trialModules_.clear();
+  activeTrial_ = 0;
 
   // adjust riccatiMultipleAdaptiveRatio and riccatiMultiple
-  if (pho < 0.25) {
-    // increase riccatiMultipleAdaptiveRatio
-    lmModule_.riccatiMultipleAdaptiveRatio = std::max(1.0, lmModule_.riccatiMultipleAdaptiveRatio) * settings_.riccatiMultipleDefaultRatio;
-
-    // increase riccatiMultiple
-    const auto riccatiMultipleTemp = lmModule_.riccatiMultipleAdaptiveRatio * lmModule_.riccatiMultiple;
-    lmModule_.riccatiMultiple = std::max(riccatiMultipleTemp, settings_.riccatiMultipleDefaultFactor);
-
-  } else if (pho > 0.75) {
-    // decrease riccatiMultipleAdaptiveRatio
-    lmModule_.riccatiMultipleAdaptiveRatio = std::min(1.0, lmModule_.riccatiMultipleAdaptiveRatio) / settings_.riccatiMultipleDefaultRatio;
-
-    // decrease riccatiMultiple
-    const auto riccatiMultipleTemp = lmModule_.riccatiMultipleAdaptiveRatio * lmModule_.riccatiMultiple;
-    lmModule_.riccatiMultiple = (riccatiMultipleTemp > settings_.riccatiMultipleDefaultFactor) ? riccatiMultipleTemp : 0.0;
-
-  } else {
-    lmModule_.riccatiMultipleAdaptiveRatio = 1.0;
-    // lmModule_.riccatiMultiple will not change.
-  }
+  adjustRiccatiMultiple(pho, lmModule_);
 
   // display
   if (baseSettings_.displayInfo) {
     std::stringstream displayInfo;
-    if (lmModule_.numSuccessiveRejections == 0) {
+    if (numTrials > 1) {
+      displayInfo << "Trial " << selectedTrial << " out of " << numTrials << " is selected. ";
+    }
+    if (success) {
       displayInfo << "The step is accepted with pho: " << pho << ". ";
     } else {
       displayInfo << "The step is rejected with pho: " << pho << " (" << lmModule_.numSuccessiveRejections << " out of "
@@ -175,16 +273,44 @@ bool LevenbergMarquardtStrategy::run(const std::pair<scalar_t, scalar_t>& timePe
     throw std::runtime_error("The maximum number of successive solution rejections has been reached!");
   }
 
+  // output the selected trial
+  swap(solution, trialSolutions_[selectedTrial]);
+
   // accept or reject the step and modify numSuccessiveRejections
-  if (pho >= settings_.minAcceptedPho) {
+  if (success) {
     // accept the solution
     lmModule_.numSuccessiveRejections = 0;
-    return true;
-
   } else {
     // reject the solution
     ++lmModule_.numSuccessiveRejections;
-    return false;
+  }
+
+  return {success, selectedTrial};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LevenbergMarquardtStrategy::adjustRiccatiMultiple(scalar_t pho, LevenbergMarquardtModule& lmModule) const {
+  if (pho < 0.25) {
+    // increase riccatiMultipleAdaptiveRatio
+    lmModule.riccatiMultipleAdaptiveRatio = std::max(1.0, lmModule.riccatiMultipleAdaptiveRatio) * settings_.riccatiMultipleDefaultRatio;
+
+    // increase riccatiMultiple
+    const auto riccatiMultipleTemp = lmModule.riccatiMultipleAdaptiveRatio * lmModule.riccatiMultiple;
+    lmModule.riccatiMultiple = std::max(riccatiMultipleTemp, settings_.riccatiMultipleDefaultFactor);
+
+  } else if (pho > 0.75) {
+    // decrease riccatiMultipleAdaptiveRatio
+    lmModule.riccatiMultipleAdaptiveRatio = std::min(1.0, lmModule.riccatiMultipleAdaptiveRatio) / settings_.riccatiMultipleDefaultRatio;
+
+    // decrease riccatiMultiple
+    const auto riccatiMultipleTemp = lmModule.riccatiMultipleAdaptiveRatio * lmModule.riccatiMultiple;
+    lmModule.riccatiMultiple = (riccatiMultipleTemp > settings_.riccatiMultipleDefaultFactor) ? riccatiMultipleTemp : 0.0;
+
+  } else {
+    lmModule.riccatiMultipleAdaptiveRatio = 1.0;
+    // lmModule.riccatiMultiple will not change.
   }
 }
 
@@ -225,25 +351,32 @@ std::pair<bool, std::string> LevenbergMarquardtStrategy::checkConvergence(bool u
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void LevenbergMarquardtStrategy::computeRiccatiModification(const ModelData& projectedModelData, matrix_t& deltaQm, vector_t& deltaGv,
-                                                            matrix_t& deltaGm) const {
+void LevenbergMarquardtStrategy::computeRiccatiModification(size_t /*nodeIndex*/, const ModelData& projectedModelData, matrix_t& deltaQm,
+                                                            vector_t& deltaGv, matrix_t& deltaGm) const {
   const auto& HvProjected = projectedModelData.dynamicsBias;
   const auto& AmProjected = projectedModelData.dynamics.dfdx;
   const auto& BmProjected = projectedModelData.dynamics.dfdu;
 
   // deltaQm, deltaRm, deltaPm
   deltaQm.setZero(projectedModelData.stateDim, projectedModelData.stateDim);
-  deltaGv.noalias() = lmModule_.riccatiMultiple * BmProjected.transpose() * HvProjected;
-  deltaGm.noalias() = lmModule_.riccatiMultiple * BmProjected.transpose() * AmProjected;
+  const auto riccatiMultiple = activeRiccatiMultiple();
+  deltaGv.noalias() = riccatiMultiple * BmProjected.transpose() * HvProjected;
+  deltaGm.noalias() = riccatiMultiple * BmProjected.transpose() * AmProjected;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LevenbergMarquardtStrategy::augmentHamiltonianHessian(const ModelData& modelData, matrix_t& Hm) const {
+  Hm.noalias() += activeRiccatiMultiple() * modelData.dynamics.dfdu.transpose() * modelData.dynamics.dfdu;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-matrix_t LevenbergMarquardtStrategy::augmentHamiltonianHessian(const ModelData& modelData, const matrix_t& Hm) const {
-  matrix_t HmAug = Hm;
-  HmAug.noalias() += lmModule_.riccatiMultiple * modelData.dynamics.dfdu.transpose() * modelData.dynamics.dfdu;
-  return HmAug;
+void LevenbergMarquardtStrategy::printString(const std::string& text) const {
+  std::lock_guard<std::mutex> outputDisplayGuard(outputDisplayGuardMutex_);
+  std::cerr << text;
 }
 
 }  // namespace ocs2
@@ -61,6 +61,20 @@ LineSearchStrategy::LineSearchStrategy(search_strategy::Settings baseSettings, l
   for (auto& solution : workersSolution_) {
     solution.primalSolution.controllerPtr_.reset(new LinearController);
   }
+
+  if (settings_.hessianCorrectionCache) {
+    hessianCorrectionCachePtr_.reset(
+        new hessian_correction::CorrectionCache(settings_.hessianCorrectionStrategy, settings_.hessianCorrectionMultiple));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LineSearchStrategy::reset() {
+  if (hessianCorrectionCachePtr_ != nullptr) {
+    hessianCorrectionCachePtr_->clear();
+  }
 }
 
 /******************************************************************************************************/
@@ -289,8 +303,8 @@ std::pair<bool, std::string> LineSearchStrategy::checkConvergence(bool unreliabl
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void LineSearchStrategy::computeRiccatiModification(const ModelData& projectedModelData, matrix_t& deltaQm, vector_t& deltaGv,
-                                                    matrix_t& deltaGm) const {
+void LineSearchStrategy::computeRiccatiModification(size_t nodeIndex, const ModelData& projectedModelData, matrix_t& deltaQm,
+                                                    vector_t& deltaGv, matrix_t& deltaGm) const {
   const auto& QmProjected = projectedModelData.cost.dfdxx;
   const auto& PmProjected = projectedModelData.cost.dfdux;
 
@@ -300,7 +314,11 @@ void LineSearchStrategy::computeRiccatiModification(const ModelData& projectedMo
 
   // deltaQm
   deltaQm = Q_minus_PTRinvP;
-  hessian_correction::shiftHessian(settings_.hessianCorrectionStrategy, deltaQm, settings_.hessianCorrectionMultiple);
+  if (hessianCorrectionCachePtr_ != nullptr) {
+    hessianCorrectionCachePtr_->shiftHessian(nodeIndex, deltaQm);
+  } else {
+    hessian_correction::shiftHessian(settings_.hessianCorrectionStrategy, deltaQm, settings_.hessianCorrectionMultiple);
+  }
   deltaQm -= Q_minus_PTRinvP;
 
   // deltaGv, deltaGm
@@ -309,6 +327,39 @@ void LineSearchStrategy::computeRiccatiModification(const ModelData& projectedMo
   deltaGm.setZero(projectedInputDim, projectedModelData.stateDim);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LineSearchStrategy::initializeRiccatiModification(size_t numNodes) {
+  if (hessianCorrectionCachePtr_ != nullptr) {
+    hessianCorrectionCachePtr_->resize(numNodes);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+hessian_correction::CorrectionCache::Statistics LineSearchStrategy::getHessianCorrectionStatistics() const {
+  if (hessianCorrectionCachePtr_ != nullptr) {
+    return hessianCorrectionCachePtr_->getStatistics();
+  } else {
+    return {};
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string LineSearchStrategy::getBenchmarkingInfo() const {
+  std::stringstream infoStream;
+  if (hessianCorrectionCachePtr_ != nullptr) {
+    const auto statistics = hessianCorrectionCachePtr_->getStatistics();
+    infoStream << "\tHessian Correction Cache [hits, misses, skipped checks]:\t" << statistics.numHits << ",\t" << statistics.numMisses
+               << ",\t" << statistics.numSkippedChecks << "\t(hit rate: " << 100.0 * statistics.hitRate() << "%)\n";
+  }
+  return infoStream.str();
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -83,6 +83,7 @@ Settings load(const std::string& filename, const std::string& fieldName, bool ve
   settings.hessianCorrectionStrategy = hessian_correction::fromString(hessianCorrectionStrategyName);
 
   loadData::loadPtreeValue(pt, settings.hessianCorrectionMultiple, fieldName + ".hessianCorrectionMultiple", verbose);
+  loadData::loadPtreeValue(pt, settings.hessianCorrectionCache, fieldName + ".hessianCorrectionCache", verbose);
 
   if (verbose) {
     std::cerr << " #### }" << std::endl;
@@ -111,6 +112,7 @@ Settings load(const std::string& filename, const std::string& fieldName, bool ve
   loadData::loadPtreeValue(pt, settings.riccatiMultipleDefaultRatio, fieldName + ".riccatiMultipleDefaultRatio", verbose);
   loadData::loadPtreeValue(pt, settings.riccatiMultipleDefaultFactor, fieldName + ".riccatiMultipleDefaultFactor", verbose);
   loadData::loadPtreeValue(pt, settings.maxNumSuccessiveRejections, fieldName + ".maxNumSuccessiveRejections", verbose);
+  loadData::loadPtreeValue(pt, settings.numParallelTrials, fieldName + ".numParallelTrials", verbose);
   if (verbose) {
     std::cerr << " #### }" << std::endl;
   }
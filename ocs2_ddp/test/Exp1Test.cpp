@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 #include <ocs2_oc/test/EXP1.h>
 
@@ -229,6 +230,45 @@ TEST_P(Exp1, SLQ) {
 
   // performanceIndeces test
   performanceIndexTest(ddpSettings, performanceIndex);
+
+  // all the nodes are approximated by the workers
+  const auto& telemetry = ddp.getLinearQuadraticApproximationTelemetry();
+  ASSERT_EQ(telemetry.size(), getNumThreads());
+  size_t numNodes = 0;
+  for (const auto& workerTelemetry : telemetry) {
+    EXPECT_LE(workerTelemetry.numChunks, workerTelemetry.numNodes);
+    numNodes += workerTelemetry.numNodes;
+  }
+  EXPECT_GT(numNodes, 0);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_P(Exp1, SLQ_fixedGridRiccati) {
+  // ddp settings
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, getNumThreads(), getSearchStrategy());
+  ddpSettings.fixedGridRiccati_ = true;
+
+  // dynamics and rollout
+  ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  // instantiate
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+
+  if (ddpSettings.displayInfo_ || ddpSettings.displayShortSummary_) {
+    std::cerr << "\n" << getTestName(ddpSettings) << " (fixed-grid Riccati)\n";
+  }
+
+  // run ddp
+  ddp.run(startTime, initState, finalTime);
+  // get performance index
+  const auto performanceIndex = ddp.getPerformanceIndeces();
+
+  // performanceIndeces test
+  performanceIndexTest(ddpSettings, performanceIndex);
 }
 
 /******************************************************************************************************/
@@ -259,6 +299,149 @@ TEST_P(Exp1, ILQR) {
   performanceIndexTest(ddpSettings, performanceIndex);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, levenbergMarquardtParallelTrials) {
+  constexpr size_t numThreads = 3;
+  for (const auto algorithm : {ocs2::ddp::Algorithm::SLQ, ocs2::ddp::Algorithm::ILQR}) {
+    // ddp settings
+    auto ddpSettings = getSettings(algorithm, numThreads, ocs2::search_strategy::Type::LEVENBERG_MARQUARDT);
+    ddpSettings.levenbergMarquardt_.numParallelTrials = numThreads;
+
+    // dynamics and rollout
+    ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+    ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+    // instantiate
+    std::unique_ptr<ocs2::GaussNewtonDDP> ddpPtr;
+    if (algorithm == ocs2::ddp::Algorithm::SLQ) {
+      ddpPtr.reset(new ocs2::SLQ(ddpSettings, rollout, problem, *initializerPtr));
+    } else {
+      ddpPtr.reset(new ocs2::ILQR(ddpSettings, rollout, problem, *initializerPtr));
+    }
+    ddpPtr->setReferenceManager(referenceManagerPtr);
+
+    if (ddpSettings.displayInfo_ || ddpSettings.displayShortSummary_) {
+      std::cerr << "\n" << getTestName(ddpSettings) << " (parallel trials)\n";
+    }
+
+    // run ddp
+    ddpPtr->run(startTime, initState, finalTime);
+    // get performance index
+    const auto performanceIndex = ddpPtr->getPerformanceIndeces();
+
+    // performanceIndeces test
+    performanceIndexTest(ddpSettings, performanceIndex);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, realTimeIteration) {
+  constexpr size_t numThreads = 2;
+  for (const auto algorithm : {ocs2::ddp::Algorithm::SLQ, ocs2::ddp::Algorithm::ILQR}) {
+    // ddp settings
+    const auto ddpSettings = getSettings(algorithm, numThreads, ocs2::search_strategy::Type::LINE_SEARCH);
+    auto rtiSettings = ddpSettings;
+    rtiSettings.realTimeIteration_ = true;
+
+    // dynamics and rollout
+    ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+    ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+    // instantiate
+    std::unique_ptr<ocs2::GaussNewtonDDP> ddpPtr, rtiPtr;
+    if (algorithm == ocs2::ddp::Algorithm::SLQ) {
+      ddpPtr.reset(new ocs2::SLQ(ddpSettings, rollout, problem, *initializerPtr));
+      rtiPtr.reset(new ocs2::SLQ(rtiSettings, rollout, problem, *initializerPtr));
+    } else {
+      ddpPtr.reset(new ocs2::ILQR(ddpSettings, rollout, problem, *initializerPtr));
+      rtiPtr.reset(new ocs2::ILQR(rtiSettings, rollout, problem, *initializerPtr));
+    }
+    ddpPtr->setReferenceManager(referenceManagerPtr);
+    rtiPtr->setReferenceManager(referenceManagerPtr);
+
+    if (ddpSettings.displayInfo_ || ddpSettings.displayShortSummary_) {
+      std::cerr << "\n" << getTestName(ddpSettings) << " (real-time iteration)\n";
+    }
+
+    // the first run starts from an initial rollout
+    rtiPtr->run(startTime, initState, finalTime);
+    performanceIndexTest(rtiSettings, rtiPtr->getPerformanceIndeces());
+
+    // MPC-like calls on a shrinking horizon from the states of the previous solution
+    for (const ocs2::scalar_t initTime : {startTime, 0.05, 0.1, 0.15}) {
+      const auto previousPerformance = rtiPtr->getPerformanceIndeces();
+      const auto previousSolution = rtiPtr->primalSolution(finalTime);
+      const auto currentState = ocs2::LinearInterpolation::interpolate(initTime, previousSolution.timeTrajectory_,
+                                                                       previousSolution.stateTrajectory_);
+
+      rtiPtr->run(initTime, currentState, finalTime);
+      ddpPtr->run(initTime, currentState, finalTime);
+
+      // the first step is taken with the prepared LQ solution, its baseline is the rollout from the new initial state
+      const auto& iterationsLog = rtiPtr->getIterationsLog();
+      ASSERT_GE(iterationsLog.size(), 2);
+      if (initTime > startTime) {
+        // the same baseline as the initial rollout of the warm-started solver, on a shorter horizon than the previous call
+        EXPECT_NEAR(iterationsLog.front().merit, ddpPtr->getIterationsLog().front().merit, 10.0 * minRelCost);
+        EXPECT_LT(iterationsLog.front().merit, previousPerformance.merit);
+      }
+      EXPECT_EQ(rtiPtr->getNumRejectedRealTimeIterationSteps(), 0);
+      EXPECT_NEAR(rtiPtr->getPerformanceIndeces().cost, ddpPtr->getPerformanceIndeces().cost, 10.0 * minRelCost)
+          << "MESSAGE: " << getTestName(rtiSettings) << ": failed at initial time " << initTime;
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, realTimeIterationStateJump) {
+  for (const auto algorithm : {ocs2::ddp::Algorithm::SLQ, ocs2::ddp::Algorithm::ILQR}) {
+    // ddp settings, the Levenberg-Marquardt strategy rejects the steps whose actual reduction does not match the LQ model
+    const auto ddpSettings = getSettings(algorithm, 1, ocs2::search_strategy::Type::LEVENBERG_MARQUARDT);
+    auto rtiSettings = ddpSettings;
+    rtiSettings.realTimeIteration_ = true;
+
+    // dynamics and rollout
+    ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+    ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+    // instantiate
+    std::unique_ptr<ocs2::GaussNewtonDDP> ddpPtr, rtiPtr;
+    if (algorithm == ocs2::ddp::Algorithm::SLQ) {
+      ddpPtr.reset(new ocs2::SLQ(ddpSettings, rollout, problem, *initializerPtr));
+      rtiPtr.reset(new ocs2::SLQ(rtiSettings, rollout, problem, *initializerPtr));
+    } else {
+      ddpPtr.reset(new ocs2::ILQR(ddpSettings, rollout, problem, *initializerPtr));
+      rtiPtr.reset(new ocs2::ILQR(rtiSettings, rollout, problem, *initializerPtr));
+    }
+    ddpPtr->setReferenceManager(referenceManagerPtr);
+    rtiPtr->setReferenceManager(referenceManagerPtr);
+
+    rtiPtr->run(startTime, initState, finalTime);
+    ddpPtr->run(startTime, initState, finalTime);
+
+    // the initial state of the next call is far from the prepared solution, hence the LQ model is not valid
+    constexpr ocs2::scalar_t initTime = 0.05;
+    const auto previousSolution = rtiPtr->primalSolution(finalTime);
+    const ocs2::vector_t jumpedState =
+        ocs2::LinearInterpolation::interpolate(initTime, previousSolution.timeTrajectory_, previousSolution.stateTrajectory_) +
+        ocs2::vector_t::Ones(STATE_DIM);
+    rtiPtr->run(initTime, jumpedState, finalTime);
+    ddpPtr->run(initTime, jumpedState, finalTime);
+
+    // the step is rejected and the solver falls back to the initial rollout
+    EXPECT_EQ(rtiPtr->getNumRejectedRealTimeIterationSteps(), 1) << "MESSAGE: " << getTestName(rtiSettings);
+    EXPECT_NEAR(rtiPtr->getIterationsLog().front().merit, ddpPtr->getIterationsLog().front().merit, 10.0 * minRelCost);
+    EXPECT_NEAR(rtiPtr->getPerformanceIndeces().cost, ddpPtr->getPerformanceIndeces().cost, 10.0 * minRelCost)
+        << "MESSAGE: " << getTestName(rtiSettings);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
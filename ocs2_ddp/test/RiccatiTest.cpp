@@ -104,6 +104,56 @@ TEST(RiccatiTest, compareImplementations) {
   EXPECT_LE((dSdz_precompute - dSdz_noPrecompute).array().abs().maxCoeff(), 1e-9);
 }
 
+TEST(RiccatiTest, compareWithDenseImplementation) {
+  constexpr int STATE_DIM = 24;
+  constexpr int INPUT_DIM = 12;
+
+  using riccati_t = ocs2::ContinuousTimeRiccatiEquations;
+
+  RiccatiInitializer ri(STATE_DIM, INPUT_DIM);
+  ri.riccatiModificationTrajectory[0].deltaGm_.setRandom(INPUT_DIM, STATE_DIM);
+  ri.riccatiModificationTrajectory[0].deltaGv_.setRandom(INPUT_DIM);
+  ri.riccatiModificationTrajectory[1] = ri.riccatiModificationTrajectory[0];
+
+  const ocs2::vector_t S = ocs2::vector_t::Random(ocs2::s_vector_dim(STATE_DIM));
+  ocs2::matrix_t Sm;
+  ocs2::vector_t Sv;
+  ocs2::scalar_t s;
+  riccati_t::convert2Matrix(S, Sm, Sv, s);
+
+  // dense evaluation of the Riccati equations
+  const auto& modelData = ri.projectedModelDataTrajectory[0];
+  const auto& modification = ri.riccatiModificationTrajectory[0];
+  const ocs2::matrix_t Gm = modelData.cost.dfdux + modelData.dynamics.dfdu.transpose() * Sm;
+  const ocs2::vector_t Gv = modelData.cost.dfdu + modelData.dynamics.dfdu.transpose() * Sv;
+  const ocs2::matrix_t Km = -(Gm + modification.deltaGm_);
+  const ocs2::vector_t Lv = -(Gv + modification.deltaGv_);
+  const ocs2::matrix_t& Am = modelData.dynamics.dfdx;
+  const ocs2::vector_t& Hv = modelData.dynamicsBias;
+  const ocs2::matrix_t& Rm = modelData.cost.dfduu;
+
+  const ocs2::matrix_t dSmReduced = modelData.cost.dfdxx + modification.deltaQm_ + Sm * Am + Am.transpose() * Sm + Km.transpose() * Gm;
+  const ocs2::vector_t dSvReduced = modelData.cost.dfdx + Sm * Hv + Am.transpose() * Sv + Gm.transpose() * Lv;
+  const ocs2::scalar_t dsReduced = modelData.cost.f + Hv.dot(Sv) + 0.5 * Lv.dot(Gv);
+
+  const ocs2::matrix_t dSm = modelData.cost.dfdxx + modification.deltaQm_ + Sm * Am + Am.transpose() * Sm + Km.transpose() * Gm +
+                             Gm.transpose() * Km + Km.transpose() * Rm * Km;
+  const ocs2::vector_t dSv =
+      modelData.cost.dfdx + Sm * Hv + Am.transpose() * Sv + Gm.transpose() * Lv + Km.transpose() * Gv + Km.transpose() * Rm * Lv;
+  const ocs2::scalar_t ds = modelData.cost.f + Hv.dot(Sv) + Lv.dot(Gv) + 0.5 * Lv.dot(Rm * Lv);
+
+  riccati_t riccatiEquationPrecompute(true);
+  riccati_t riccatiEquationNoPrecompute(false);
+  ri.initialize(riccatiEquationPrecompute);
+  ri.initialize(riccatiEquationNoPrecompute);
+
+  const ocs2::vector_t dSdz_precompute = riccatiEquationPrecompute.computeFlowMap(-0.6, S);
+  const ocs2::vector_t dSdz_noPrecompute = riccatiEquationNoPrecompute.computeFlowMap(-0.6, S);
+
+  EXPECT_TRUE(dSdz_precompute.isApprox(riccati_t::convert2Vector(dSmReduced, dSvReduced, dsReduced)));
+  EXPECT_TRUE(dSdz_noPrecompute.isApprox(riccati_t::convert2Vector(dSm, dSv, ds)));
+}
+
 TEST(RiccatiTest, testFlattenSMatrix) {
   const int stateDim = 4;
   using riccati_t = ocs2::ContinuousTimeRiccatiEquations;
@@ -128,6 +178,12 @@ TEST(RiccatiTest, testFlattenSMatrix) {
   allSs = riccati_t::convert2Vector(Sm, Sv, s);
 
   EXPECT_EQ(allSs, allSs_expect);
+
+  // only the upper triangular part is read
+  Sm.triangularView<Eigen::StrictlyLower>().setZero();
+  riccati_t::convert2Vector(Sm, Sv, s, allSs);
+
+  EXPECT_EQ(allSs, allSs_expect);
 }
 
 TEST(RiccatiTest, testFlattenAndUnflatten) {
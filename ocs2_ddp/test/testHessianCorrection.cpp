@@ -0,0 +1,90 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_ddp/HessianCorrection.h>
+
+using namespace ocs2;
+
+namespace {
+matrix_t randomSymmetricMatrix(size_t n, scalar_t minEigenvalue) {
+  const matrix_t Q = Eigen::HouseholderQR<matrix_t>(matrix_t::Random(n, n)).householderQ();
+  const vector_t lambda = vector_t::Random(n).cwiseAbs() + vector_t::Constant(n, minEigenvalue);
+  return Q * lambda.asDiagonal() * Q.transpose();
+}
+}  // unnamed namespace
+
+TEST(testHessianCorrection, correctionCache) {
+  constexpr size_t n = 8;
+  constexpr size_t numNodes = 4;
+  constexpr scalar_t minEigenvalue = 1e-3;
+  constexpr scalar_t tol = 1e-9;
+
+  for (const auto strategy : {hessian_correction::Strategy::CHOLESKY_MODIFICATION, hessian_correction::Strategy::EIGENVALUE_MODIFICATION,
+                              hessian_correction::Strategy::DIAGONAL_SHIFT, hessian_correction::Strategy::GERSHGORIN_MODIFICATION}) {
+    const bool isCached =
+        strategy == hessian_correction::Strategy::CHOLESKY_MODIFICATION || strategy == hessian_correction::Strategy::EIGENVALUE_MODIFICATION;
+
+    hessian_correction::CorrectionCache cache(strategy, minEigenvalue);
+    cache.resize(numNodes);
+
+    // node 0 and 1 are PD, node 2 and 3 are indefinite
+    std::vector<matrix_t> hessians(numNodes);
+    hessians[0] = randomSymmetricMatrix(n, 2.0 * minEigenvalue);
+    hessians[1] = randomSymmetricMatrix(n, 2.0 * minEigenvalue);
+    hessians[2] = randomSymmetricMatrix(n, 0.0) - 10.0 * matrix_t::Identity(n, n);
+    hessians[3] = randomSymmetricMatrix(n, 0.0) - 10.0 * matrix_t::Identity(n, n);
+
+    for (size_t iter = 0; iter < 3; iter++) {
+      for (size_t i = 0; i < numNodes; i++) {
+        matrix_t expected = hessians[i];
+        hessian_correction::shiftHessian(strategy, expected, minEigenvalue);
+        matrix_t cached = hessians[i];
+        cache.shiftHessian(i, cached);
+        EXPECT_TRUE(cached.isApprox(expected, tol)) << "strategy: " << hessian_correction::toString(strategy) << ", node: " << i;
+      }
+    }
+
+    // indefinite nodes: miss, skipped check, miss
+    const auto statistics = cache.getStatistics();
+    if (isCached) {
+      EXPECT_EQ(statistics.numHits, 6);
+      EXPECT_EQ(statistics.numMisses, 4);
+      EXPECT_EQ(statistics.numSkippedChecks, 2);
+      EXPECT_DOUBLE_EQ(statistics.hitRate(), 0.5);
+    } else {
+      EXPECT_EQ(statistics.numHits + statistics.numMisses + statistics.numSkippedChecks, 0);
+    }
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(cache.getStatistics().numHits, 0);
+  }
+}
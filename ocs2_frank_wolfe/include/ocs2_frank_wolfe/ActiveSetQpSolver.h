@@ -0,0 +1,91 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * A dense primal active-set solver for the small strictly convex QP
+ * \f[
+ *    \min_x \ \frac{1}{2} x^T x + c^T x \quad s.t. \quad A_{eq} x = b_{eq}, \quad A_{in} x \geq b_{in}.
+ * \f]
+ * It is meant for the low-dimensional parameter spaces of the upper-level problems (e.g. event times),
+ * where setting up a general purpose LP/QP solver dominates the solve time. The working set of the
+ * previous call is used to warm-start the next one if its minimizer is feasible. For more discussion on this algorithm, the reader
+ * should refer to Nocedal and Wright, "Numerical Optimization", chapter 16.5.
+ */
+class ActiveSetQpSolver {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] maxIterations: The maximum number of working-set changes.
+   * @param [in] tolerance: The tolerance for the primal feasibility and the step size.
+   */
+  explicit ActiveSetQpSolver(size_t maxIterations = 100, scalar_t tolerance = 1e-9);
+
+  /**
+   * Default destructor.
+   */
+  ~ActiveSetQpSolver() = default;
+
+  /**
+   * Solves the QP. Unless warm-started, the initial point is the minimum-norm solution of the equality
+   * constraints which should satisfy the inequality constraints, e.g. x = 0 for a feasible Frank-Wolfe iterate. Throws a
+   * std::runtime_error if the optimality conditions do not hold after maxIterations working-set changes.
+   *
+   * @param [in] c: The linear cost term.
+   * @param [in] Aeq: The equality constraints matrix.
+   * @param [in] beq: The equality constraints right-hand side.
+   * @param [in] Ain: The inequality constraints matrix.
+   * @param [in] bin: The inequality constraints right-hand side.
+   * @return The minimizer.
+   */
+  vector_t solve(const vector_t& c, const matrix_t& Aeq, const vector_t& beq, const matrix_t& Ain, const vector_t& bin);
+
+  /** Gets the indices of the active inequality constraints at the last solution. */
+  const std::vector<size_t>& getWorkingSet() const { return workingSet_; }
+
+  /** Gets the number of iterations of the last call. */
+  size_t getNumIterations() const { return numIterations_; }
+
+ private:
+  const size_t maxIterations_;
+  const scalar_t tolerance_;
+
+  std::vector<size_t> workingSet_;
+  size_t numIterations_ = 0;
+};
+
+}  // namespace ocs2
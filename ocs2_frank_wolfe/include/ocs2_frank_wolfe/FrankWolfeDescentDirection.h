@@ -36,6 +36,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/misc/Numerics.h>
+#include <ocs2_frank_wolfe/ActiveSetQpSolver.h>
 #include <ocs2_frank_wolfe/NLP_Constraints.h>
 
 namespace ocs2 {
@@ -44,15 +45,23 @@ namespace ocs2 {
  * This class implements the Frank-Wolfe algorithm for computing the descent direction
  * respecting linear equalities and inequalities. For more discussion on this
  * algorithm, the reader should refer to \cite jaggi13 .
+ *
+ * The LP is kept in a persistent GLPK workspace: it is only rebuilt if the problem dimensions change, the
+ * constraint matrix is only reloaded if the constraint Jacobians change, and the simplex method is
+ * warm-started from the basis of the previous call (untested against GLPK, see setupLP()). Alternatively, the
+ * descent direction can be computed as the solution of the QP \f$ \min_d \ 0.5 d^T d + \nabla f^T d \f$ over the
+ * same feasible set by a dense active-set solver, which is cheaper for the small parameter dimensions of the
+ * upper-level problems.
  */
 class FrankWolfeDescentDirection {
  public:
   /**
    * Constructor.
    *
-   * @param [in] display:
+   * @param [in] display: Whether to display the GLPK messages.
+   * @param [in] useActiveSetQp: Whether to use the dense active-set QP solver instead of the GLPK LP.
    */
-  explicit FrankWolfeDescentDirection(bool display);
+  explicit FrankWolfeDescentDirection(bool display, bool useActiveSetQp = false);
 
   /**
    * Default destructor.
@@ -79,25 +88,62 @@ class FrankWolfeDescentDirection {
 
  private:
   /**
-   * Instantiates GLPK solver
+   * Instantiates GLPK solver for the given problem dimensions.
+   *
+   * @param [in] numParameters: The number of parameters.
+   * @param [in] numConstraints: The total number of equality and inequality constraints.
    */
-  void instantiateGLPK();
+  void instantiateGLPK(size_t numParameters, size_t numConstraints);
 
   /**
-   * Sets up Frank-Wolfe linear program.
+   * Evaluates the domain constraints at the current parameter vector.
    *
    * @param [in] parameter: The value of parameter vector.
+   * @param [in] nlpConstraintsPtr: A pointer to the NLP constraints.
+   */
+  void evaluateConstraints(const vector_t& parameter, NLP_Constraints* nlpConstraintsPtr);
+
+  /**
+   * Sets up Frank-Wolfe linear program by updating the persistent GLPK workspace.
+   *
    * @param [in] gradient: The gradient at the current parameter vector.
    * @param [in] maxGradientInverse: descent directions element-wise maximum inverse, \f$ e_v \f$.
-   * @param [in] nlpConstraintsPtr: A pointer to the NLP constraints.
    */
-  void setupLP(const vector_t& parameter, const vector_t& gradient, const vector_t& maxGradientInverse, NLP_Constraints* nlpConstraintsPtr);
+  void setupLP(const vector_t& gradient, const vector_t& maxGradientInverse);
+
+  /**
+   * Solves the Frank-Wolfe linear program with GLPK.
+   *
+   * @param [in] gradient: The gradient at the current parameter vector.
+   * @param [in] maxGradientInverse: descent directions element-wise maximum inverse, \f$ e_v \f$.
+   * @return The descent direction.
+   */
+  vector_t solveLP(const vector_t& gradient, const vector_t& maxGradientInverse);
+
+  /**
+   * Solves the descent-direction QP with the dense active-set solver.
+   *
+   * @param [in] gradient: The gradient at the current parameter vector.
+   * @param [in] maxGradientInverse: descent directions element-wise maximum inverse, \f$ e_v \f$.
+   * @return The descent direction.
+   */
+  vector_t solveQP(const vector_t& gradient, const vector_t& maxGradientInverse);
 
   /***********
    * Variables
    **********/
+  const bool useActiveSetQp_;
+
   std::unique_ptr<glp_prob, void (*)(glp_prob*)> lpPtr_;
   std::unique_ptr<glp_smcp> lpOptionsPtr_;
+  matrix_t lpConstraintMatrix_;  // the constraint matrix loaded in GLPK
+
+  ActiveSetQpSolver activeSetQpSolver_;
+
+  vector_t g_;
+  matrix_t dgdx_;
+  vector_t h_;
+  matrix_t dhdx_;
 };
 
 }  // namespace ocs2
@@ -44,7 +44,8 @@ class NLP_Settings {
         minRelCost_(1e-6),
         maxLearningRate_(1.0),
         minLearningRate_(0.05),
-        useAscendingLineSearchNLP_(true) {}
+        useAscendingLineSearchNLP_(true),
+        useActiveSetQpDescentDirection_(false) {}
 
   /** This value determines to display the log output.*/
   bool displayInfo_;
@@ -62,6 +63,12 @@ class NLP_Settings {
    * - \b Descending: The step size eventually decreases from the minimum value to the maximum.
    * */
   bool useAscendingLineSearchNLP_;
+  /**
+   * This value determines the solver of the constrained descent direction. \n
+   * - \b false: The Frank-Wolfe linear program is solved by GLPK. \n
+   * - \b true: The direction QP is solved by the dense active-set solver, suited for small parameter dimensions.
+   * */
+  bool useActiveSetQpDescentDirection_;
 };
 
 }  // namespace ocs2
@@ -0,0 +1,153 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_frank_wolfe/ActiveSetQpSolver.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ActiveSetQpSolver::ActiveSetQpSolver(size_t maxIterations, scalar_t tolerance) : maxIterations_(maxIterations), tolerance_(tolerance) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t ActiveSetQpSolver::solve(const vector_t& c, const matrix_t& Aeq, const vector_t& beq, const matrix_t& Ain, const vector_t& bin) {
+  const int n = c.size();
+  if (Aeq.rows() != beq.size() || (Aeq.rows() > 0 && Aeq.cols() != n)) {
+    throw std::runtime_error("[ActiveSetQpSolver] The equality constraints are incompatible to the parameter size.");
+  }
+  if (Ain.rows() != bin.size() || (Ain.rows() > 0 && Ain.cols() != n)) {
+    throw std::runtime_error("[ActiveSetQpSolver] The inequality constraints are incompatible to the parameter size.");
+  }
+
+  // warm start: the minimizer on the working set of the previous call if it is feasible
+  vector_t x;
+  const bool isWarmStarted = [&]() {
+    if (workingSet_.empty() || *std::max_element(workingSet_.cbegin(), workingSet_.cend()) >= static_cast<size_t>(Ain.rows())) {
+      return false;
+    }
+    matrix_t Aw(Aeq.rows() + workingSet_.size(), n);
+    vector_t bw(Aw.rows());
+    Aw.topRows(Aeq.rows()) = Aeq;
+    bw.head(Aeq.rows()) = beq;
+    for (size_t i = 0; i < workingSet_.size(); i++) {
+      Aw.row(Aeq.rows() + i) = Ain.row(workingSet_[i]);
+      bw(Aeq.rows() + i) = bin(workingSet_[i]);
+    }
+    // x = -c + y where y is the minimum-norm solution of Aw * y = bw + Aw * c
+    x = Aw.completeOrthogonalDecomposition().solve(bw + Aw * c) - c;
+    const bool isOnWorkingSet = (Aw * x - bw).lpNorm<Eigen::Infinity>() <= tolerance_ * (1.0 + bw.lpNorm<Eigen::Infinity>());
+    return isOnWorkingSet && (Ain * x - bin).minCoeff() >= -tolerance_;
+  }();
+
+  // cold start: the minimum-norm point on the equality constraints
+  if (!isWarmStarted) {
+    workingSet_.clear();
+    x.setZero(n);
+    if (Aeq.rows() > 0) {
+      x = Aeq.completeOrthogonalDecomposition().solve(beq);
+      if ((Aeq * x - beq).lpNorm<Eigen::Infinity>() > tolerance_ * (1.0 + beq.lpNorm<Eigen::Infinity>())) {
+        throw std::runtime_error("[ActiveSetQpSolver] The equality constraints are inconsistent.");
+      }
+    }
+    if (Ain.rows() > 0 && (Ain * x - bin).minCoeff() < -tolerance_) {
+      throw std::runtime_error("[ActiveSetQpSolver] The initial point violates the inequality constraints.");
+    }
+  }
+
+  matrix_t Aw;
+  bool isOptimal = false;
+  for (numIterations_ = 0; numIterations_ < maxIterations_; numIterations_++) {
+    // constraints in the working set
+    Aw.resize(Aeq.rows() + workingSet_.size(), n);
+    Aw.topRows(Aeq.rows()) = Aeq;
+    for (size_t i = 0; i < workingSet_.size(); i++) {
+      Aw.row(Aeq.rows() + i) = Ain.row(workingSet_[i]);
+    }
+
+    // equality-constrained step: p = Aw^T * lambda - (x + c) with Aw * p = 0
+    const vector_t gradient = x + c;
+    vector_t lambda;
+    vector_t p = -gradient;
+    if (Aw.rows() > 0) {
+      lambda = Aw.transpose().colPivHouseholderQr().solve(gradient);
+      p.noalias() += Aw.transpose() * lambda;
+    }
+
+    if (p.lpNorm<Eigen::Infinity>() <= tolerance_) {
+      // optimal if the multipliers of the active inequalities are non-negative
+      if (workingSet_.empty()) {
+        isOptimal = true;
+        break;
+      }
+      size_t minIndex;
+      const scalar_t minMultiplier = lambda.tail(workingSet_.size()).minCoeff(&minIndex);
+      if (minMultiplier >= -tolerance_) {
+        isOptimal = true;
+        break;
+      }
+      workingSet_.erase(workingSet_.begin() + minIndex);
+
+    } else {
+      // the largest feasible step along p
+      scalar_t stepLength = 1.0;
+      int blockingIndex = -1;
+      for (int j = 0; j < Ain.rows(); j++) {
+        if (std::find(workingSet_.cbegin(), workingSet_.cend(), static_cast<size_t>(j)) != workingSet_.cend()) {
+          continue;
+        }
+        const scalar_t ap = Ain.row(j).dot(p);
+        if (ap < -tolerance_) {
+          const scalar_t maxStep = std::max((bin(j) - Ain.row(j).dot(x)) / ap, 0.0);
+          if (maxStep < stepLength) {
+            stepLength = maxStep;
+            blockingIndex = j;
+          }
+        }
+      }  // end of j loop
+
+      x += stepLength * p;
+      if (blockingIndex >= 0) {
+        workingSet_.push_back(blockingIndex);
+      }
+    }
+  }  // end of iteration loop
+
+  if (!isOptimal) {
+    throw std::runtime_error("[ActiveSetQpSolver] The maximum number of iterations is reached before the optimality conditions hold.");
+  }
+  return x;
+}
+
+}  // namespace ocs2
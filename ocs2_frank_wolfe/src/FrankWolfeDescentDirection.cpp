@@ -30,21 +30,39 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_frank_wolfe/FrankWolfeDescentDirection.h>
 
 namespace ocs2 {
+namespace {
+
+/** Sets the bounds of a GLPK row or column only if they have changed, so that the current basis stays valid. */
+void updateBounds(glp_prob* lp, int index, int type, double lb, double ub, int (*getType)(glp_prob*, int),
+                  double (*getLb)(glp_prob*, int), double (*getUb)(glp_prob*, int),
+                  void (*setBounds)(glp_prob*, int, int, double, double)) {
+  const bool hasLowerBound = (type == GLP_LO || type == GLP_DB || type == GLP_FX);
+  const bool hasUpperBound = (type == GLP_DB);  // the upper bound of GLP_FX is the lower bound
+  if (getType(lp, index) != type || (hasLowerBound && getLb(lp, index) != lb) || (hasUpperBound && getUb(lp, index) != ub)) {
+    setBounds(lp, index, type, lb, ub);
+  }
+}
+
+}  // unnamed namespace
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-FrankWolfeDescentDirection::FrankWolfeDescentDirection(bool display)
-    : lpPtr_(glp_create_prob(), glp_delete_prob), lpOptionsPtr_(new glp_smcp) {
+FrankWolfeDescentDirection::FrankWolfeDescentDirection(bool display, bool useActiveSetQp)
+    : useActiveSetQp_(useActiveSetQp), lpPtr_(glp_create_prob(), glp_delete_prob), lpOptionsPtr_(new glp_smcp) {
   // set LP options
   glp_init_smcp(lpOptionsPtr_.get());
   if (!display) lpOptionsPtr_->msg_lev = GLP_MSG_ERR;
+  // the presolver discards the basis, hence it should stay off for the warm start
+  lpOptionsPtr_->presolve = GLP_OFF;
+
+  instantiateGLPK(0, 0);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void FrankWolfeDescentDirection::instantiateGLPK() {
+void FrankWolfeDescentDirection::instantiateGLPK(size_t numParameters, size_t numConstraints) {
   // erase the solver
   glp_erase_prob(lpPtr_.get());
 
@@ -53,21 +71,67 @@ void FrankWolfeDescentDirection::instantiateGLPK() {
 
   // set it as a minimization problem
   glp_set_obj_dir(lpPtr_.get(), GLP_MIN);
+
+  // the new columns are nonbasic and the new rows are basic which is a valid initial basis
+  if (numParameters > 0) glp_add_cols(lpPtr_.get(), numParameters);
+  if (numConstraints > 0) glp_add_rows(lpPtr_.get(), numConstraints);
+
+  lpConstraintMatrix_.resize(0, 0);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FrankWolfeDescentDirection::evaluateConstraints(const vector_t& parameter, NLP_Constraints* nlpConstraintsPtr) {
+  const int parameterDim = parameter.size();
+
+  // set the current parameter vector.
+  nlpConstraintsPtr->setCurrentParameter(parameter);
+
+  // get domain equality constraints
+  nlpConstraintsPtr->getLinearEqualityConstraint(g_);
+  nlpConstraintsPtr->getLinearEqualityConstraintDerivative(dgdx_);
+  if (g_.size() > 0 && dgdx_.cols() != parameterDim)
+    throw std::runtime_error(
+        "calculateLinearEqualityConstraint: The number of columns of Jacobian matrix "
+        "should be equal to the number of parameters.");
+  if (g_.size() > 0 && dgdx_.rows() != g_.rows())
+    throw std::runtime_error(
+        "calculateLinearEqualityConstraint: The number of rows of Jacobian matrix "
+        "should be equal to the number of equality constraints.");
+
+  // get domain inequality constraints
+  nlpConstraintsPtr->getLinearInequalityConstraint(h_);
+  nlpConstraintsPtr->getLinearInequalityConstraintDerivative(dhdx_);
+  if (h_.size() > 0 && dhdx_.cols() != parameterDim)
+    throw std::runtime_error(
+        "calculateLinearInequalityConstraint: The number of columns of Jacobian matrix "
+        "should be equal to the number of parameters.");
+  if (h_.size() > 0 && dhdx_.rows() != h_.rows())
+    throw std::runtime_error(
+        "calculateLinearInequalityConstraint: The number of rows of Jacobian matrix "
+        "should be equal to the number of inequality constraints.");
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void FrankWolfeDescentDirection::setupLP(const vector_t& parameter, const vector_t& gradient, const vector_t& maxGradientInverse,
-                                         NLP_Constraints* nlpConstraintsPtr) {
-  const size_t parameterDim = parameter.size();
+void FrankWolfeDescentDirection::setupLP(const vector_t& gradient, const vector_t& maxGradientInverse) {
+  // TODO: the incremental updates of the persistent workspace and the warm-started simplex in solveLP() are untested. They were only
+  // type-checked against a glpk.h stub and have not been compiled or run against GLPK (glpk_test, quadratic_test, matyas_test).
+  const size_t parameterDim = gradient.size();
+  const size_t numEqualities = g_.size();
+  const size_t numConstraints = g_.size() + h_.size();
+
+  // rebuild the LP only if the dimensions have changed
+  if (glp_get_num_cols(lpPtr_.get()) != static_cast<int>(parameterDim) ||
+      glp_get_num_rows(lpPtr_.get()) != static_cast<int>(numConstraints)) {
+    instantiateGLPK(parameterDim, numConstraints);
+  }
 
   // return if there is no parameter
   if (parameterDim == 0) return;
 
-  // set parameters limits
-  glp_add_cols(lpPtr_.get(), parameterDim);
-
   // set the LP cost function of Frank-Wolfe algorithm
   for (size_t i = 0; i < parameterDim; i++) glp_set_obj_coef(lpPtr_.get(), i + 1, gradient(i));
 
@@ -76,82 +140,121 @@ void FrankWolfeDescentDirection::setupLP(const vector_t& parameter, const vector
   for (size_t i = 0; i < parameterDim; i++) {
     // if the gradient is zero in one direction
     if (numerics::almost_eq(gradient(i), 0.0)) {
-      glp_set_col_bnds(lpPtr_.get(), i + 1, GLP_FX, 0.0, 0.0);
+      updateBounds(lpPtr_.get(), i + 1, GLP_FX, 0.0, 0.0, glp_get_col_type, glp_get_col_lb, glp_get_col_ub, glp_set_col_bnds);
 
       // if the gradient should be limited
     } else if (!numerics::almost_eq(Ev(i), 0.0)) {
-      glp_set_col_bnds(lpPtr_.get(), i + 1, GLP_DB, -1.0 / Ev(i), 1.0 / Ev(i));
+      updateBounds(lpPtr_.get(), i + 1, GLP_DB, -1.0 / Ev(i), 1.0 / Ev(i), glp_get_col_type, glp_get_col_lb, glp_get_col_ub,
+                   glp_set_col_bnds);
 
       // if free
     } else {
-      glp_set_col_bnds(lpPtr_.get(), i + 1, GLP_FR, 0.0, 0.0);
+      updateBounds(lpPtr_.get(), i + 1, GLP_FR, 0.0, 0.0, glp_get_col_type, glp_get_col_lb, glp_get_col_ub, glp_set_col_bnds);
     }
 
   }  // end of i loop
 
-  // set the current parameter vector.
-  nlpConstraintsPtr->setCurrentParameter(parameter);
-
-  // get domain equality constraints
-  vector_t g;
-  nlpConstraintsPtr->getLinearEqualityConstraint(g);
-  matrix_t dgdx;
-  nlpConstraintsPtr->getLinearEqualityConstraintDerivative(dgdx);
-  if (g.size() > 0 && dgdx.cols() != parameterDim)
-    throw std::runtime_error(
-        "calculateLinearEqualityConstraint: The number of columns of Jacobian matrix "
-        "should be equal to the number of parameters.");
-  if (g.size() > 0 && dgdx.rows() != g.rows())
-    throw std::runtime_error(
-        "calculateLinearEqualityConstraint: The number of rows of Jacobian matrix "
-        "should be equal to the number of equality constraints.");
+  // domain equality and inequality constraints limits
+  for (int i = 0; i < g_.size(); i++) {
+    updateBounds(lpPtr_.get(), i + 1, GLP_FX, -g_(i), -g_(i), glp_get_row_type, glp_get_row_lb, glp_get_row_ub, glp_set_row_bnds);
+  }
+  for (int i = 0; i < h_.size(); i++) {
+    updateBounds(lpPtr_.get(), numEqualities + i + 1, GLP_LO, -h_(i), 0.0, glp_get_row_type, glp_get_row_lb, glp_get_row_ub,
+                 glp_set_row_bnds);
+  }
 
-  // get domain inequality constraints
-  vector_t h;
-  nlpConstraintsPtr->getLinearInequalityConstraint(h);
-  matrix_t dhdx;
-  nlpConstraintsPtr->getLinearInequalityConstraintDerivative(dhdx);
-  if (h.size() > 0 && dhdx.cols() != parameterDim)
-    throw std::runtime_error(
-        "calculateLinearInequalityConstraint: The number of columns of Jacobian matrix "
-        "should be equal to the number of parameters.");
-  if (h.size() > 0 && dhdx.rows() != h.rows())
-    throw std::runtime_error(
-        "calculateLinearInequalityConstraint: The number of rows of Jacobian matrix "
-        "should be equal to the number of inequality constraints.");
+  // reload the constraint coefficients only if the Jacobians have changed
+  if (numConstraints == 0) return;
+  matrix_t constraintMatrix(numConstraints, parameterDim);
+  if (g_.size() > 0) constraintMatrix.topRows(g_.size()) = dgdx_;
+  if (h_.size() > 0) constraintMatrix.bottomRows(h_.size()) = dhdx_;
+  if (lpConstraintMatrix_.rows() == constraintMatrix.rows() && lpConstraintMatrix_.cols() == constraintMatrix.cols() &&
+      lpConstraintMatrix_ == constraintMatrix) {
+    return;
+  }
 
-  // set the total number of constraint limits
-  glp_add_rows(lpPtr_.get(), g.size() + h.size());
   scalar_array_t values{0.1};     // 0 index is not used!
   std::vector<int> xIndices{-1};  // 0 index is not used!
   std::vector<int> yIndices{-1};  // 0 index is not used!
-
-  // domain equality constraints
-  for (size_t i = 0; i < g.size(); i++) {
+  for (size_t i = 0; i < numConstraints; i++) {
     for (size_t j = 0; j < parameterDim; j++) {
-      if (!numerics::almost_eq(dgdx(i, j), 0.0)) {
-        values.push_back(dgdx(i, j));
+      if (!numerics::almost_eq(constraintMatrix(i, j), 0.0)) {
+        values.push_back(constraintMatrix(i, j));
         xIndices.push_back(i + 1);
         yIndices.push_back(j + 1);
       }
     }
-    glp_set_row_bnds(lpPtr_.get(), i + 1, GLP_FX, -g(i), -g(i));
   }
+  glp_load_matrix(lpPtr_.get(), values.size() - 1, xIndices.data(), yIndices.data(), values.data());
+  lpConstraintMatrix_.swap(constraintMatrix);
+}
 
-  // domain inequality constraints
-  for (size_t i = 0; i < h.size(); i++) {
-    for (size_t j = 0; j < parameterDim; j++) {
-      if (!numerics::almost_eq(dhdx(i, j), 0.0)) {
-        values.push_back(dhdx(i, j));
-        xIndices.push_back(i + 1);
-        yIndices.push_back(j + 1);
-      }
-    }
-    glp_set_row_bnds(lpPtr_.get(), i + 1, GLP_LO, -h(i), 0.0);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t FrankWolfeDescentDirection::solveLP(const vector_t& gradient, const vector_t& maxGradientInverse) {
+  // setup LP
+  setupLP(gradient, maxGradientInverse);
+
+  // solve LP warm-started from the previous basis. If the basis has become invalid, restart from the standard basis.
+  const int status = glp_simplex(lpPtr_.get(), lpOptionsPtr_.get());
+  if (status == GLP_EBADB || status == GLP_ESING || status == GLP_ECOND) {
+    glp_std_basis(lpPtr_.get());
+    glp_simplex(lpPtr_.get(), lpOptionsPtr_.get());
+  }
+
+  // get the solution
+  vector_t fwDescentDirection(gradient.size());
+  for (int i = 0; i < gradient.size(); i++) fwDescentDirection(i) = glp_get_col_prim(lpPtr_.get(), i + 1);
+  return fwDescentDirection;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t FrankWolfeDescentDirection::solveQP(const vector_t& gradient, const vector_t& maxGradientInverse) {
+  const size_t parameterDim = gradient.size();
+
+  // the directions with zero gradient are fixed
+  size_array_t fixedIndices;
+  for (size_t i = 0; i < parameterDim; i++) {
+    if (numerics::almost_eq(gradient(i), 0.0)) fixedIndices.push_back(i);
+  }
+
+  // the descent directions reciprocal element-wise max as inequalities
+  const vector_t Ev = maxGradientInverse.cwiseAbs();
+  size_array_t limitedIndices;
+  for (size_t i = 0; i < parameterDim; i++) {
+    if (!numerics::almost_eq(gradient(i), 0.0) && !numerics::almost_eq(Ev(i), 0.0)) limitedIndices.push_back(i);
+  }
+
+  // equality constraints: dgdx * d = -g and d_i = 0 for the fixed directions
+  matrix_t Aeq = matrix_t::Zero(g_.size() + fixedIndices.size(), parameterDim);
+  vector_t beq = vector_t::Zero(Aeq.rows());
+  if (g_.size() > 0) {
+    Aeq.topRows(g_.size()) = dgdx_;
+    beq.head(g_.size()) = -g_;
+  }
+  for (size_t k = 0; k < fixedIndices.size(); k++) {
+    Aeq(g_.size() + k, fixedIndices[k]) = 1.0;
   }
 
-  // set the constraint coefficients
-  glp_load_matrix(lpPtr_.get(), g.size() + h.size(), xIndices.data(), yIndices.data(), values.data());
+  // inequality constraints: dhdx * d >= -h and -1/Ev_i <= d_i <= 1/Ev_i
+  matrix_t Ain = matrix_t::Zero(h_.size() + 2 * limitedIndices.size(), parameterDim);
+  vector_t bin = vector_t::Zero(Ain.rows());
+  if (h_.size() > 0) {
+    Ain.topRows(h_.size()) = dhdx_;
+    bin.head(h_.size()) = -h_;
+  }
+  for (size_t k = 0; k < limitedIndices.size(); k++) {
+    const size_t i = limitedIndices[k];
+    Ain(h_.size() + 2 * k, i) = 1.0;
+    bin(h_.size() + 2 * k) = -1.0 / Ev(i);
+    Ain(h_.size() + 2 * k + 1, i) = -1.0;
+    bin(h_.size() + 2 * k + 1) = -1.0 / Ev(i);
+  }
+
+  return activeSetQpSolver_.solve(gradient, Aeq, beq, Ain, bin);
 }
 
 /******************************************************************************************************/
@@ -163,18 +266,11 @@ void FrankWolfeDescentDirection::run(const vector_t& parameter, const vector_t&
   if (maxGradientInverse.size() != gradient.size())
     throw std::runtime_error("The gradient limit size is incompatible to the gradient size.");
 
-  // instantiate GLPK
-  instantiateGLPK();
-
-  // setup LP
-  setupLP(parameter, gradient, maxGradientInverse, nlpConstraintsPtr);
+  // evaluate the domain constraints
+  evaluateConstraints(parameter, nlpConstraintsPtr);
 
-  // solve LP
-  glp_simplex(lpPtr_.get(), lpOptionsPtr_.get());
-
-  // get the solution
-  fwDescentDirection.resize(parameter.size());
-  for (size_t i = 0; i < parameter.size(); i++) fwDescentDirection(i) = glp_get_col_prim(lpPtr_.get(), i + 1);
+  // solve for the descent direction
+  fwDescentDirection = useActiveSetQp_ ? solveQP(gradient, maxGradientInverse) : solveLP(gradient, maxGradientInverse);
 
   // test
   if (gradient.dot(fwDescentDirection) > 0) throw std::runtime_error("Frank-Wolfe does not produce a descent direction.");
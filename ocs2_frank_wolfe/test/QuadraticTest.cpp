@@ -120,3 +120,30 @@ TEST(QuadraticTest, QuadraticTest) {
 
   ASSERT_NEAR(cost, optimalCost, nlpSettings.minRelCost_) << "MESSAGE: Frank_Wolfe failed in the Quadratic test!";
 }
+
+TEST(QuadraticTest, ActiveSetQpTest) {
+  NLP_Settings nlpSettings;
+  nlpSettings.displayInfo_ = false;
+  nlpSettings.maxIterations_ = 500;
+  nlpSettings.minRelCost_ = 1e-6;
+  nlpSettings.maxLearningRate_ = 1.0;
+  nlpSettings.minLearningRate_ = 1e-4;
+  nlpSettings.useAscendingLineSearchNLP_ = false;
+  nlpSettings.useActiveSetQpDescentDirection_ = true;
+
+  GradientDescent nlpSolver(nlpSettings);
+  std::unique_ptr<QuadraticCost> costPtr(new QuadraticCost);
+
+  vector_t maxX = Eigen::Vector2d(3.0, 3.0);
+  vector_t minX = Eigen::Vector2d(1.0, 1.0);
+  std::unique_ptr<QuadraticConstraints> constraintsPtr(new QuadraticConstraints(minX, maxX));
+
+  Eigen::Vector2d initParameters = 0.5 * (maxX + minX) + 0.5 * (maxX - minX).cwiseProduct(Eigen::Vector2d::Random());
+  nlpSolver.run(initParameters, 0.1 * Eigen::Vector2d::Ones(), costPtr.get(), constraintsPtr.get());
+
+  double cost;
+  nlpSolver.getCost(cost);
+
+  const double optimalCost = 1.0;
+  ASSERT_NEAR(cost, optimalCost, nlpSettings.minRelCost_) << "MESSAGE: active-set QP failed in the Quadratic test!";
+}
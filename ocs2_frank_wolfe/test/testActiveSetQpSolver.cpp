@@ -0,0 +1,118 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_frank_wolfe/ActiveSetQpSolver.h"
+
+using namespace ocs2;
+
+TEST(testActiveSetQpSolver, unconstrained) {
+  ActiveSetQpSolver qpSolver;
+  const vector_t c = (vector_t(3) << 1.0, -2.0, 3.0).finished();
+  const vector_t x = qpSolver.solve(c, matrix_t(0, 3), vector_t(0), matrix_t(0, 3), vector_t(0));
+  EXPECT_TRUE(x.isApprox(-c));
+}
+
+TEST(testActiveSetQpSolver, box) {
+  // -1 <= x <= 1
+  matrix_t Ain(4, 2);
+  Ain << matrix_t::Identity(2, 2), -matrix_t::Identity(2, 2);
+  const vector_t bin = -vector_t::Ones(4);
+  const vector_t c = (vector_t(2) << -3.0, 0.5).finished();
+
+  ActiveSetQpSolver qpSolver;
+  const vector_t x = qpSolver.solve(c, matrix_t(0, 2), vector_t(0), Ain, bin);
+  EXPECT_TRUE(x.isApprox((vector_t(2) << 1.0, -0.5).finished()));
+  ASSERT_EQ(qpSolver.getWorkingSet().size(), 1);
+  EXPECT_EQ(qpSolver.getWorkingSet().front(), 2);
+}
+
+TEST(testActiveSetQpSolver, maxIterations) {
+  // -1 <= x <= 1, the minimizer is reached after adding one constraint to the working set and a step on it
+  matrix_t Ain(4, 2);
+  Ain << matrix_t::Identity(2, 2), -matrix_t::Identity(2, 2);
+  const vector_t bin = -vector_t::Ones(4);
+  const vector_t c = (vector_t(2) << -3.0, 0.5).finished();
+
+  ActiveSetQpSolver qpSolver(1);
+  EXPECT_THROW(qpSolver.solve(c, matrix_t(0, 2), vector_t(0), Ain, bin), std::runtime_error);
+
+  ActiveSetQpSolver qpSolverConverged(3);
+  EXPECT_NO_THROW(qpSolverConverged.solve(c, matrix_t(0, 2), vector_t(0), Ain, bin));
+}
+
+TEST(testActiveSetQpSolver, equalityAndInequality) {
+  // x1 + x2 = 1, x1 >= 0.8
+  const matrix_t Aeq = (matrix_t(1, 2) << 1.0, 1.0).finished();
+  const vector_t beq = (vector_t(1) << 1.0).finished();
+  const matrix_t Ain = (matrix_t(1, 2) << 1.0, 0.0).finished();
+  const vector_t bin = (vector_t(1) << 0.8).finished();
+
+  ActiveSetQpSolver qpSolver;
+  const vector_t xEq = qpSolver.solve(vector_t::Zero(2), Aeq, beq, matrix_t(0, 2), vector_t(0));
+  EXPECT_TRUE(xEq.isApprox((vector_t(2) << 0.5, 0.5).finished()));
+
+  const vector_t c = (vector_t(2) << 0.0, -1.0).finished();
+  const vector_t x = qpSolver.solve(c, Aeq, beq, -Ain, -(vector_t(1) << 1.0).finished());
+  EXPECT_TRUE(x.isApprox((vector_t(2) << 0.0, 1.0).finished()));
+
+  EXPECT_THROW(qpSolver.solve(c, Aeq, beq, Ain, bin), std::runtime_error);  // the minimum-norm point is infeasible
+}
+
+TEST(testActiveSetQpSolver, warmStart) {
+  // the projection of -c on the simplex-like set sum(x) <= 1, x >= -1
+  constexpr size_t n = 5;
+  matrix_t Ain(n + 1, n);
+  Ain << matrix_t::Identity(n, n), -vector_t::Ones(n).transpose();
+  vector_t bin(n + 1);
+  bin << -vector_t::Ones(n), -1.0;
+  const vector_t c = (vector_t(n) << -2.0, -1.0, 0.5, 3.0, -0.2).finished();
+
+  ActiveSetQpSolver qpSolver;
+  const vector_t x = qpSolver.solve(c, matrix_t(0, n), vector_t(0), Ain, bin);
+  const size_t coldIterations = qpSolver.getNumIterations();
+
+  // KKT conditions
+  const vector_t slack = Ain * x - bin;
+  EXPECT_GE(slack.minCoeff(), -1e-9);
+  const auto& workingSet = qpSolver.getWorkingSet();
+  matrix_t Aw(workingSet.size(), n);
+  for (size_t i = 0; i < workingSet.size(); i++) {
+    Aw.row(i) = Ain.row(workingSet[i]);
+  }
+  const vector_t lambda = Aw.transpose().colPivHouseholderQr().solve(x + c);
+  EXPECT_TRUE((Aw.transpose() * lambda).isApprox(x + c));
+  EXPECT_GE(lambda.minCoeff(), -1e-9);
+
+  // the second solve starts from the optimal working set
+  const vector_t xWarm = qpSolver.solve(c, matrix_t(0, n), vector_t(0), Ain, bin);
+  EXPECT_TRUE(xWarm.isApprox(x));
+  EXPECT_LT(qpSolver.getNumIterations(), coldIterations);
+}
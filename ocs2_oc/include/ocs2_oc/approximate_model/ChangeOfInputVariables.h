@@ -47,11 +47,30 @@ namespace ocs2 {
  * @param Px : Matrix defining the range of \delta x
  * @param u0 : Input offset
  */
-void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticApproximation, const matrix_t& Pu,
-                            const matrix_t& Px = matrix_t(), const vector_t& u0 = vector_t());
+void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticApproximation, const Eigen::Ref<const matrix_t>& Pu,
+                            const Eigen::Ref<const matrix_t>& Px = matrix_t(), const Eigen::Ref<const vector_t>& u0 = vector_t());
 
 /** Applies the change of input variables to a linear system */
-void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximation, const matrix_t& Pu, const matrix_t& Px = matrix_t(),
-                            const vector_t& u0 = vector_t());
+void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximation, const Eigen::Ref<const matrix_t>& Pu,
+                            const Eigen::Ref<const matrix_t>& Px = matrix_t(), const Eigen::Ref<const vector_t>& u0 = vector_t());
+
+/**
+ * Applies the change of input variables to a compact quadratic approximation (see ApproximationSparsity). Only the rows of Pu,
+ * Px, and u0 which correspond to the input coordinates in the sparsity descriptor take part in the products. The altered model
+ * data is full-size, i.e. stateDim=n, inputDim=p.
+ *
+ * @param quadraticApproximation : Compact approximation to be adapted in-place
+ * @param sparsity : The sparsity descriptor of the compact approximation
+ * @param stateDim : The full state dimension n
+ * @param Pu : Matrix defining the range of \tilde{\delta u}
+ * @param Px : Matrix defining the range of \delta x
+ * @param u0 : Input offset
+ */
+void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticApproximation, const ApproximationSparsity& sparsity,
+                            int stateDim, const matrix_t& Pu, const matrix_t& Px = matrix_t(), const vector_t& u0 = vector_t());
+
+/** Applies the change of input variables to a compact linear system. The altered model data is full-size. */
+void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximation, const ApproximationSparsity& sparsity, int stateDim,
+                            const matrix_t& Pu, const matrix_t& Px = matrix_t(), const vector_t& u0 = vector_t());
 
 }  // namespace ocs2
\ No newline at end of file
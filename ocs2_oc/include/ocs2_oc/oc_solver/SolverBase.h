@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -141,6 +142,14 @@ class SolverBase {
     augmentedLagrangianObservers_.push_back(std::move(observerModule));
   }
 
+  /**
+   * Adds a callback which is called once per iteration, right before the solver approximates the problem around its nominal
+   * trajectory. The argument is the time trajectory of the nodes to be approximated. It can be used to advance per-iteration
+   * bookkeeping of the cost and constraint terms, e.g. InequalityActivityTracker::advanceIteration.
+   * @note: The callback may be called from a background thread of the solver.
+   */
+  void addIterationCallback(std::function<void(const scalar_array_t&)> callback) { iterationCallbacks_.push_back(std::move(callback)); }
+
   /**
    * @brief Returns a const reference to the definition of optimal control problem.
    *
@@ -254,6 +263,18 @@ class SolverBase {
    */
   void printString(const std::string& text) const;
 
+ protected:
+  /**
+   * Calls the iteration callbacks. The solvers call it once per iteration before approximating the problem.
+   *
+   * @param [in] timeTrajectory: The time trajectory of the nodes to be approximated.
+   */
+  void iterationCallbacks(const scalar_array_t& timeTrajectory) const {
+    for (const auto& callback : iterationCallbacks_) {
+      callback(timeTrajectory);
+    }
+  }
+
  private:
   virtual void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) = 0;
 
@@ -261,6 +282,18 @@ class SolverBase {
 
   virtual void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution) = 0;
 
+  /**
+   * Waits for the work that the solver runs in the background in between two calls of run(). It is called at the beginning of
+   * run(), before the reference manager and the synchronized modules are updated.
+   */
+  virtual void waitForBackgroundWork() {}
+
+  /**
+   * Launches the work that the solver runs in the background in between two calls of run(). It is called at the end of run(),
+   * after the synchronized modules are updated.
+   */
+  virtual void launchBackgroundWork() {}
+
   void preRun(scalar_t initTime, const vector_t& initState, scalar_t finalTime);
 
   void postRun();
@@ -272,6 +305,7 @@ class SolverBase {
   std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;  // this pointer cannot be nullptr
   std::vector<std::shared_ptr<SolverSynchronizedModule>> synchronizedModules_;
   std::vector<std::unique_ptr<AugmentedLagrangianObserver>> augmentedLagrangianObservers_;
+  std::vector<std::function<void(const scalar_array_t&)>> iterationCallbacks_;
 };
 
 }  // namespace ocs2
@@ -29,10 +29,38 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/approximate_model/ChangeOfInputVariables.h"
 
+#include <ocs2_core/misc/MonotonicArena.h>
+
 namespace ocs2 {
 
-void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticApproximation, const matrix_t& Pu, const matrix_t& Px,
-                            const vector_t& u0) {
+namespace {
+
+/** Selects the given rows of a matrix or vector. An empty input stays empty. */
+template <typename Derived>
+Eigen::Matrix<scalar_t, Eigen::Dynamic, Derived::ColsAtCompileTime> selectRows(const Eigen::MatrixBase<Derived>& m,
+                                                                               const size_array_t& indices) {
+  Eigen::Matrix<scalar_t, Eigen::Dynamic, Derived::ColsAtCompileTime> selection(m.size() > 0 ? indices.size() : 0, m.cols());
+  if (m.size() > 0) {
+    for (size_t i = 0; i < indices.size(); i++) {
+      selection.row(i) = m.row(indices[i]);
+    }  // end of i loop
+  }
+  return selection;
+}
+
+/** Scatters the columns of a compact matrix to the given columns of a zero matrix with the given number of columns. */
+matrix_t scatterColumns(const matrix_t& compact, const size_array_t& indices, int cols) {
+  matrix_t full = matrix_t::Zero(compact.rows(), cols);
+  for (size_t j = 0; j < indices.size(); j++) {
+    full.col(indices[j]) = compact.col(j);
+  }  // end of j loop
+  return full;
+}
+
+}  // unnamed namespace
+
+void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticApproximation, const Eigen::Ref<const matrix_t>& Pu,
+                            const Eigen::Ref<const matrix_t>& Px, const Eigen::Ref<const vector_t>& u0) {
   /*
    * 3 temporaries are needed in any branch because Pu is non-zero and:
    *  - new P contains a product Pu'*P
@@ -42,18 +70,25 @@ void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticAppro
    *
    *  The terms of the quadratic functions have the following notation:
    *  dfdxx = Q, dfdux = P, dfduu = R, dfdx = q, dfdu = r, f = c.
+   *
+   *  The temporaries are drawn from the thread's arena.
    */
   const bool hasPx(Px.size() > 0);
   const bool hasu0(u0.size() > 0);
 
+  auto& arena = getThreadLocalArena();
+  MonotonicArena::Scope arenaScope(arena);
+
   // Shared term number 1
-  matrix_t P_plus_R_Px = quadraticApproximation.dfdux;
+  auto P_plus_R_Px = arena.matrix(quadraticApproximation.dfdux.rows(), quadraticApproximation.dfdux.cols());
+  P_plus_R_Px = quadraticApproximation.dfdux;
   if (hasPx) {
     P_plus_R_Px.noalias() += quadraticApproximation.dfduu * Px;
   }  // else added term is zero
 
   // Shared term number 2
-  vector_t r_plus_R_u0 = quadraticApproximation.dfdu;
+  auto r_plus_R_u0 = arena.vector(quadraticApproximation.dfdu.rows());
+  r_plus_R_u0 = quadraticApproximation.dfdu;
   if (hasu0) {
     r_plus_R_u0.noalias() += quadraticApproximation.dfduu * u0;
   }  // else added term is zero
@@ -81,15 +116,16 @@ void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticAppro
   quadraticApproximation.dfdux.noalias() = Pu.transpose() * P_plus_R_Px;
 
   // R = Pu' * R * Pu
-  matrix_t R_Pu = quadraticApproximation.dfduu * Pu;  // make the required temporary explicit, to save it in the second multiplication
+  auto R_Pu = arena.matrix(quadraticApproximation.dfduu.rows(), Pu.cols());
+  R_Pu.noalias() = quadraticApproximation.dfduu * Pu;  // make the required temporary explicit, to save it in the second multiplication
   quadraticApproximation.dfduu.noalias() = Pu.transpose() * R_Pu;
 
   // r = Pu' * (R*u0 + r)
   quadraticApproximation.dfdu.noalias() = Pu.transpose() * r_plus_R_u0;
 }
 
-void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximation, const matrix_t& Pu, const matrix_t& Px,
-                            const vector_t& u0) {
+void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximation, const Eigen::Ref<const matrix_t>& Pu,
+                            const Eigen::Ref<const matrix_t>& Px, const Eigen::Ref<const vector_t>& u0) {
   const bool hasPx(Px.size() > 0);
   const bool hasu0(u0.size() > 0);
 
@@ -107,4 +143,41 @@ void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximati
   linearApproximation.dfdu = linearApproximation.dfdu * Pu;  // temporary matrix unavoidable
 }
 
+void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticApproximation, const ApproximationSparsity& sparsity,
+                            int stateDim, const matrix_t& Pu, const matrix_t& Px, const vector_t& u0) {
+  if (sparsity.isDense) {
+    changeOfInputVariables(quadraticApproximation, Pu, Px, u0);
+    return;
+  }
+
+  // Expand the state blocks. The input blocks remain compact and only the matching rows of the transformation are used.
+  const auto& xIndices = sparsity.stateIndices;
+  vector_t dfdx = vector_t::Zero(stateDim);
+  matrix_t dfdxx = matrix_t::Zero(stateDim, stateDim);
+  for (size_t j = 0; j < xIndices.size(); j++) {
+    dfdx(xIndices[j]) = quadraticApproximation.dfdx(j);
+    for (size_t i = 0; i < xIndices.size(); i++) {
+      dfdxx(xIndices[i], xIndices[j]) = quadraticApproximation.dfdxx(i, j);
+    }  // end of i loop
+  }    // end of j loop
+  quadraticApproximation.dfdx.swap(dfdx);
+  quadraticApproximation.dfdxx.swap(dfdxx);
+  quadraticApproximation.dfdux = scatterColumns(quadraticApproximation.dfdux, xIndices, stateDim);
+
+  const auto& uIndices = sparsity.inputIndices;
+  changeOfInputVariables(quadraticApproximation, selectRows(Pu, uIndices), selectRows(Px, uIndices), selectRows(u0, uIndices));
+}
+
+void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximation, const ApproximationSparsity& sparsity, int stateDim,
+                            const matrix_t& Pu, const matrix_t& Px, const vector_t& u0) {
+  if (sparsity.isDense) {
+    changeOfInputVariables(linearApproximation, Pu, Px, u0);
+    return;
+  }
+
+  const auto& uIndices = sparsity.inputIndices;
+  linearApproximation.dfdx = scatterColumns(linearApproximation.dfdx, sparsity.stateIndices, stateDim);
+  changeOfInputVariables(linearApproximation, selectRows(Pu, uIndices), selectRows(Px, uIndices), selectRows(u0, uIndices));
+}
+
 }  // namespace ocs2
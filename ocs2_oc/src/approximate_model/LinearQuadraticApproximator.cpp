@@ -35,6 +35,28 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+
+/** Adds the intermediate cost and soft constraint approximations in place */
+void accumulateCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state, const vector_t& input,
+                    ScalarFunctionQuadraticApproximation& cost) {
+  const auto& targetTrajectories = *problem.targetTrajectoriesPtr;
+  const auto& preComputation = *problem.preComputationPtr;
+
+  problem.costPtr->accumulateQuadraticApproximation(time, state, input, targetTrajectories, preComputation, cost);
+  if (!problem.softConstraintPtr->empty()) {
+    problem.softConstraintPtr->accumulateQuadraticApproximation(time, state, input, targetTrajectories, preComputation, cost);
+  }
+  if (!problem.stateCostPtr->empty()) {
+    problem.stateCostPtr->accumulateQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
+  }
+  if (!problem.stateSoftConstraintPtr->empty()) {
+    problem.stateSoftConstraintPtr->accumulateQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
+  }
+}
+
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -54,7 +76,8 @@ void approximateIntermediateLQ(OptimalControlProblem& problem, const scalar_t ti
   modelData.dynamics = problem.dynamicsPtr->linearApproximation(time, state, input, preComputation);
 
   // Cost
-  modelData.cost = ocs2::approximateCost(problem, time, state, input);
+  modelData.cost.setZero(state.rows(), input.rows());
+  accumulateCost(problem, time, state, input, modelData.cost);
 
   // Equality constraints
   modelData.stateEqConstraint = problem.stateEqualityConstraintPtr->getLinearApproximation(time, state, preComputation);
@@ -62,24 +85,20 @@ void approximateIntermediateLQ(OptimalControlProblem& problem, const scalar_t ti
 
   // Lagrangians
   if (!problem.stateEqualityLagrangianPtr->empty()) {
-    auto approx = problem.stateEqualityLagrangianPtr->getQuadraticApproximation(time, state, multipliers.stateEq, preComputation);
-    modelData.cost.f += approx.f;
-    modelData.cost.dfdx += approx.dfdx;
-    modelData.cost.dfdxx += approx.dfdxx;
+    problem.stateEqualityLagrangianPtr->accumulateQuadraticApproximation(time, state, multipliers.stateEq, preComputation,
+                                                                         modelData.cost);
   }
   if (!problem.stateInequalityLagrangianPtr->empty()) {
-    auto approx = problem.stateInequalityLagrangianPtr->getQuadraticApproximation(time, state, multipliers.stateIneq, preComputation);
-    modelData.cost.f += approx.f;
-    modelData.cost.dfdx += approx.dfdx;
-    modelData.cost.dfdxx += approx.dfdxx;
+    problem.stateInequalityLagrangianPtr->accumulateQuadraticApproximation(time, state, multipliers.stateIneq, preComputation,
+                                                                           modelData.cost);
   }
   if (!problem.equalityLagrangianPtr->empty()) {
-    modelData.cost +=
-        problem.equalityLagrangianPtr->getQuadraticApproximation(time, state, input, multipliers.stateInputEq, preComputation);
+    problem.equalityLagrangianPtr->accumulateQuadraticApproximation(time, state, input, multipliers.stateInputEq, preComputation,
+                                                                    modelData.cost);
   }
   if (!problem.inequalityLagrangianPtr->empty()) {
-    modelData.cost +=
-        problem.inequalityLagrangianPtr->getQuadraticApproximation(time, state, input, multipliers.stateInputIneq, preComputation);
+    problem.inequalityLagrangianPtr->accumulateQuadraticApproximation(time, state, input, multipliers.stateInputIneq, preComputation,
+                                                                      modelData.cost);
   }
 }
 
@@ -101,23 +120,24 @@ void approximatePreJumpLQ(OptimalControlProblem& problem, const scalar_t& time,
   modelData.dynamics = problem.dynamicsPtr->jumpMapLinearApproximation(time, state, preComputation);
 
   // Pre-jump cost
-  modelData.cost = approximateEventCost(problem, time, state);
+  modelData.cost.setZero(state.rows(), 0);
+  problem.preJumpCostPtr->accumulateQuadraticApproximation(time, state, *problem.targetTrajectoriesPtr, preComputation, modelData.cost);
+  if (!problem.preJumpSoftConstraintPtr->empty()) {
+    problem.preJumpSoftConstraintPtr->accumulateQuadraticApproximation(time, state, *problem.targetTrajectoriesPtr, preComputation,
+                                                                       modelData.cost);
+  }
 
   // state equality constraint
   modelData.stateEqConstraint = problem.preJumpEqualityConstraintPtr->getLinearApproximation(time, state, preComputation);
 
   // Lagrangians
   if (!problem.preJumpEqualityLagrangianPtr->empty()) {
-    auto approx = problem.preJumpEqualityLagrangianPtr->getQuadraticApproximation(time, state, multipliers.stateEq, preComputation);
-    modelData.cost.f += approx.f;
-    modelData.cost.dfdx += approx.dfdx;
-    modelData.cost.dfdxx += approx.dfdxx;
+    problem.preJumpEqualityLagrangianPtr->accumulateQuadraticApproximation(time, state, multipliers.stateEq, preComputation,
+                                                                           modelData.cost);
   }
   if (!problem.preJumpInequalityLagrangianPtr->empty()) {
-    auto approx = problem.preJumpInequalityLagrangianPtr->getQuadraticApproximation(time, state, multipliers.stateIneq, preComputation);
-    modelData.cost.f += approx.f;
-    modelData.cost.dfdx += approx.dfdx;
-    modelData.cost.dfdxx += approx.dfdxx;
+    problem.preJumpInequalityLagrangianPtr->accumulateQuadraticApproximation(time, state, multipliers.stateIneq, preComputation,
+                                                                             modelData.cost);
   }
 }
 
@@ -142,20 +162,21 @@ void approximateFinalLQ(OptimalControlProblem& problem, const scalar_t& time, co
   modelData.stateEqConstraint = problem.finalEqualityConstraintPtr->getLinearApproximation(time, state, preComputation);
 
   // Final cost
-  modelData.cost = approximateFinalCost(problem, time, state);
+  modelData.cost.setZero(state.rows(), 0);
+  problem.finalCostPtr->accumulateQuadraticApproximation(time, state, *problem.targetTrajectoriesPtr, preComputation, modelData.cost);
+  if (!problem.finalSoftConstraintPtr->empty()) {
+    problem.finalSoftConstraintPtr->accumulateQuadraticApproximation(time, state, *problem.targetTrajectoriesPtr, preComputation,
+                                                                     modelData.cost);
+  }
 
   // Lagrangians
   if (!problem.finalEqualityLagrangianPtr->empty()) {
-    auto approx = problem.finalEqualityLagrangianPtr->getQuadraticApproximation(time, state, multipliers.stateEq, preComputation);
-    modelData.cost.f += approx.f;
-    modelData.cost.dfdx += approx.dfdx;
-    modelData.cost.dfdxx += approx.dfdxx;
+    problem.finalEqualityLagrangianPtr->accumulateQuadraticApproximation(time, state, multipliers.stateEq, preComputation,
+                                                                         modelData.cost);
   }
   if (!problem.finalInequalityLagrangianPtr->empty()) {
-    auto approx = problem.finalInequalityLagrangianPtr->getQuadraticApproximation(time, state, multipliers.stateIneq, preComputation);
-    modelData.cost.f += approx.f;
-    modelData.cost.dfdx += approx.dfdx;
-    modelData.cost.dfdxx += approx.dfdxx;
+    problem.finalInequalityLagrangianPtr->accumulateQuadraticApproximation(time, state, multipliers.stateIneq, preComputation,
+                                                                           modelData.cost);
   }
 }
 
@@ -180,31 +201,8 @@ scalar_t computeCost(const OptimalControlProblem& problem, const scalar_t& time,
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation approximateCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
                                                      const vector_t& input) {
-  const auto& targetTrajectories = *problem.targetTrajectoriesPtr;
-  const auto& preComputation = *problem.preComputationPtr;
-
-  // get the state-input cost approximations
-  auto cost = problem.costPtr->getQuadraticApproximation(time, state, input, targetTrajectories, preComputation);
-
-  if (!problem.softConstraintPtr->empty()) {
-    cost += problem.softConstraintPtr->getQuadraticApproximation(time, state, input, targetTrajectories, preComputation);
-  }
-
-  // get the state only cost approximations
-  if (!problem.stateCostPtr->empty()) {
-    auto stateCost = problem.stateCostPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
-    cost.f += stateCost.f;
-    cost.dfdx += stateCost.dfdx;
-    cost.dfdxx += stateCost.dfdxx;
-  }
-
-  if (!problem.stateSoftConstraintPtr->empty()) {
-    auto stateCost = problem.stateSoftConstraintPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
-    cost.f += stateCost.f;
-    cost.dfdx += stateCost.dfdx;
-    cost.dfdxx += stateCost.dfdxx;
-  }
-
+  auto cost = ScalarFunctionQuadraticApproximation::Zero(state.rows(), input.rows());
+  accumulateCost(problem, time, state, input, cost);
   return cost;
 }
 
@@ -91,6 +91,8 @@ void SolverBase::printString(const std::string& text) const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::preRun(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  waitForBackgroundWork();
+
   referenceManagerPtr_->preSolverRun(initTime, finalTime, initState);
 
   for (auto& module : synchronizedModules_) {
@@ -112,6 +114,8 @@ void SolverBase::postRun() {
       observer->extractTermMultipliers(getOptimalControlProblem(), getDualSolution());
     }
   }
+
+  launchBackgroundWork();
 }
 
 }  // namespace ocs2
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/misc/Benchmark.h>
+
 #include "ocs2_oc/approximate_model/ChangeOfInputVariables.h"
 #include "ocs2_oc/test/testProblemsGeneration.h"
 
@@ -255,4 +257,104 @@ TEST(linear_change_of_input_variables, bothPx_U0) {
   const vector_t unprojected = evaluate(linear, dx, Pu * du_tilde + Px * dx + u0);
   const vector_t projected = evaluate(linearProjected, dx, du_tilde);
   ASSERT_TRUE(unprojected.isApprox(projected));
-}
\ No newline at end of file
+}
+
+TEST(quadratic_change_of_input_variables, sparse) {
+  const int n = 6;
+  const int m = 5;
+  const int p = 3;
+
+  // Create change of variables
+  const matrix_t Pu = matrix_t::Random(m, p);
+  const matrix_t Px = matrix_t::Random(m, n);
+  const vector_t u0 = vector_t::Random(m);
+
+  // Compact approximation and its full-size counterpart
+  const auto sparsity = ApproximationSparsity::Sparse({1, 4}, {0, 3});
+  const auto compact = getRandomCost(2, 2);
+  auto quadratic = ScalarFunctionQuadraticApproximation::Zero(n, m);
+  accumulateSparseApproximation(compact, sparsity, quadratic);
+
+  // Apply change of variables
+  auto quadraticProjected = compact;
+  changeOfInputVariables(quadraticProjected, sparsity, n, Pu, Px, u0);
+  ASSERT_TRUE(checkSize(n, p, quadraticProjected, "quadraticProjected").empty());
+
+  // Evaluation point
+  const vector_t du_tilde = vector_t::Random(p);
+  const vector_t dx = vector_t::Random(n);
+
+  // Evaluate and compare
+  const scalar_t unprojected = evaluate(quadratic, dx, Pu * du_tilde + Px * dx + u0);
+  const scalar_t projected = evaluate(quadraticProjected, dx, du_tilde);
+  ASSERT_NEAR(unprojected, projected, 1e-12);
+}
+
+TEST(linear_change_of_input_variables, sparse) {
+  const int n = 6;
+  const int m = 5;
+  const int p = 3;
+
+  // Create change of variables
+  const matrix_t Pu = matrix_t::Random(m, p);
+  const matrix_t Px = matrix_t::Random(m, n);
+  const vector_t u0 = vector_t::Random(m);
+
+  // Compact approximation and its full-size counterpart
+  const auto sparsity = ApproximationSparsity::Sparse({2}, {1, 2, 4});
+  const auto compact = getRandomDynamics(1, 3);
+  auto linear = VectorFunctionLinearApproximation::Zero(1, n, m);
+  assignSparseApproximation(compact, sparsity, 0, linear);
+
+  // Apply change of variables
+  auto linearProjected = compact;
+  changeOfInputVariables(linearProjected, sparsity, n, Pu, Px, u0);
+
+  // Evaluation point
+  const vector_t du_tilde = vector_t::Random(p);
+  const vector_t dx = vector_t::Random(n);
+
+  // Evaluate and compare
+  const vector_t unprojected = evaluate(linear, dx, Pu * du_tilde + Px * dx + u0);
+  const vector_t projected = evaluate(linearProjected, dx, du_tilde);
+  ASSERT_TRUE(unprojected.isApprox(projected));
+}
+
+TEST(quadratic_change_of_input_variables, sparseTiming) {
+  // legged robot dimensions: a term of a single foot depends on its three contact forces and the base pose
+  const int n = 24;
+  const int m = 24;
+  const int p = 12;
+  const auto sparsity = ApproximationSparsity::Sparse({0, 1, 2, 3, 4, 5}, {6, 7, 8});
+  constexpr size_t numRepetitions = 10000;
+
+  const matrix_t Pu = matrix_t::Random(m, p);
+  const matrix_t Px = matrix_t::Random(m, n);
+  const vector_t u0 = vector_t::Random(m);
+  const auto compact = getRandomCost(sparsity.stateIndices.size(), sparsity.inputIndices.size());
+  auto quadratic = ScalarFunctionQuadraticApproximation::Zero(n, m);
+  accumulateSparseApproximation(compact, sparsity, quadratic);
+
+  ocs2::benchmark::RepeatedTimer denseTimer;
+  ocs2::benchmark::RepeatedTimer sparseTimer;
+  ScalarFunctionQuadraticApproximation denseProjected;
+  ScalarFunctionQuadraticApproximation sparseProjected;
+  for (size_t i = 0; i < numRepetitions; i++) {
+    denseTimer.startTimer();
+    denseProjected = quadratic;
+    changeOfInputVariables(denseProjected, Pu, Px, u0);
+    denseTimer.endTimer();
+
+    sparseTimer.startTimer();
+    sparseProjected = compact;
+    changeOfInputVariables(sparseProjected, sparsity, n, Pu, Px, u0);
+    sparseTimer.endTimer();
+  }
+
+  EXPECT_TRUE(denseProjected.dfdxx.isApprox(sparseProjected.dfdxx));
+  EXPECT_TRUE(denseProjected.dfduu.isApprox(sparseProjected.dfduu));
+  EXPECT_TRUE(denseProjected.dfdux.isApprox(sparseProjected.dfdux));
+  std::cerr << "[changeOfInputVariables] n=" << n << ", m=" << m << ", p=" << p << ", compact " << sparsity.stateIndices.size() << "x"
+            << sparsity.inputIndices.size() << ": dense " << denseTimer.getAverageInMilliseconds() * 1e3 << " [us], sparse "
+            << sparseTimer.getAverageInMilliseconds() * 1e3 << " [us]\n";
+}
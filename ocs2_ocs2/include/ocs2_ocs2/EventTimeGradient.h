@@ -0,0 +1,89 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblem.h>
+#include <ocs2_oc/oc_solver/SolverBase.h>
+
+namespace ocs2 {
+
+/**
+ * Computes the gradient of the optimal cost with respect to the event times of a time-triggered switched system. For a fixed mode
+ * sequence, the adjoint form of the sensitivity equations reduces the derivative w.r.t. the i'th event time to the jump of the
+ * Hamiltonian across the event:
+ *
+ *   dJ/dt_i = H(t_i^-, x^-, u^-, lambda^-) - H(t_i^+, x^+, u^+, lambda^+),   H = L + lambda' * f + nu' * g,
+ *
+ * where the costate lambda is the gradient of the solver's value function. Therefore, the gradient is exact for a converged solution.
+ * The Hamiltonians of the events are evaluated in parallel on the thread pool.
+ */
+class EventTimeGradient {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] optimalControlProblem: The optimal control problem formulation. It is cloned for each thread.
+   * @param [in] nThreads: Number of threads used for evaluating the Hamiltonians.
+   * @param [in] threadPriority: Priority of the threads.
+   */
+  explicit EventTimeGradient(const OptimalControlProblem& optimalControlProblem, size_t nThreads = 1, int threadPriority = 50);
+
+  /**
+   * Computes the gradient of the cost w.r.t. the event times of primalSolution.modeSchedule_. The entries of the events which are
+   * not crossed by primalSolution are zero.
+   *
+   * @param [in] solver: The solver which has computed primalSolution. Its value function and dual solution are used.
+   * @param [in] primalSolution: The primal solution of the solver.
+   * @return The gradient of size primalSolution.modeSchedule_.eventTimes.size().
+   */
+  vector_t compute(const SolverBase& solver, const PrimalSolution& primalSolution);
+
+ private:
+  /** The Hamiltonian's arguments at one side of an event. */
+  struct Node {
+    scalar_t time;
+    vector_t state;
+    vector_t input;
+    vector_t costate;
+    vector_t lagrangian;
+    MultiplierCollection multipliers;
+  };
+
+  scalar_t computeHamiltonian(OptimalControlProblem& problem, const Node& node) const;
+
+  std::vector<OptimalControlProblem> optimalControlProblemStock_;
+  ThreadPool threadPool_;
+};
+
+}  // namespace ocs2
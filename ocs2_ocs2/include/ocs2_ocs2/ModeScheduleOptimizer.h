@@ -0,0 +1,120 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_oc/oc_solver/SolverBase.h>
+#include <ocs2_oc/synchronized_module/SolverSynchronizedModule.h>
+
+#include "ocs2_ocs2/EventTimeGradient.h"
+
+namespace ocs2 {
+namespace mode_schedule_optimizer {
+
+/**
+ * This structure contains the settings of the ModeScheduleOptimizer.
+ */
+struct Settings {
+  /** The step size of the gradient descent on the event times. */
+  scalar_t stepSize = 0.05;
+  /** The maximum change of an event time per update. */
+  scalar_t maxEventTimeChange = 0.02;
+  /** The minimum accepted difference between two consecutive event times. */
+  scalar_t minEventTimeDifference = 0.05;
+  /** The events which are closer than this value to the initial time are not modified. */
+  scalar_t minTimeToEvent = 0.02;
+
+  /** Number of threads used for computing the gradient. */
+  size_t nThreads = 1;
+  /** Priority of the threads used for computing the gradient. */
+  int threadPriority = 50;
+};
+
+/**
+ * This function loads the "mode_schedule_optimizer::Settings" variables from a config file.
+ *
+ * @param [in] filename: File name which contains the configuration data.
+ * @param [in] fieldName: Field name which contains the configuration data.
+ * @param [in] verbose: Flag to determine whether to print out the loaded settings or not (The default is true).
+ */
+Settings loadSettings(const std::string& filename, const std::string& fieldName = "mode_schedule_optimizer", bool verbose = true);
+
+}  // namespace mode_schedule_optimizer
+
+/**
+ * A solver synchronized module which optimizes the event times of the mode schedule in between two MPC calls. After each run of the
+ * solver, it takes a projected gradient step on the event times inside the horizon and sets the result to the reference manager's
+ * buffer, hence it is used in the next run. The mode sequence is not modified.
+ *
+ * @note: The reference manager should keep the mode schedule which is set by setModeSchedule(). A mode schedule set by the user after
+ * the solver run overrides the update.
+ */
+class ModeScheduleOptimizer final : public SolverSynchronizedModule {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] settings: The optimizer settings.
+   * @param [in] optimalControlProblem: The optimal control problem formulation.
+   * @param [in] solver: The solver to which this module is added. It should provide the value function and the dual solution.
+   */
+  ModeScheduleOptimizer(mode_schedule_optimizer::Settings settings, const OptimalControlProblem& optimalControlProblem,
+                        SolverBase& solver);
+
+  ~ModeScheduleOptimizer() override = default;
+
+  void preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                    const ReferenceManagerInterface& referenceManager) override;
+
+  void postSolverRun(const PrimalSolution& primalSolution) override;
+
+  /** The gradient of the cost w.r.t. the event times of the last solution. */
+  const vector_t& getEventTimesGradient() const { return eventTimesGradient_; }
+
+ private:
+  /**
+   * Takes a projected gradient step on the event times in (initTime + minTimeToEvent, finalTime). The updated event times keep
+   * their order with a minimum difference of minEventTimeDifference.
+   */
+  scalar_array_t updateEventTimes(const scalar_array_t& eventTimes, const vector_t& gradient) const;
+
+  const mode_schedule_optimizer::Settings settings_;
+  SolverBase& solver_;
+  EventTimeGradient eventTimeGradient_;
+
+  scalar_t initTime_ = 0.0;
+  scalar_t finalTime_ = 0.0;
+  vector_t eventTimesGradient_;
+};
+
+}  // namespace ocs2
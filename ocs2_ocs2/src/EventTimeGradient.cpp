@@ -0,0 +1,122 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ocs2/EventTimeGradient.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include <ocs2_core/NumericTraits.h>
+#include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+EventTimeGradient::EventTimeGradient(const OptimalControlProblem& optimalControlProblem, size_t nThreads, int threadPriority)
+    : threadPool_(std::max(nThreads, size_t(1)) - 1, threadPriority) {
+  optimalControlProblemStock_.reserve(std::max(nThreads, size_t(1)));
+  for (size_t i = 0; i < std::max(nThreads, size_t(1)); i++) {
+    optimalControlProblemStock_.push_back(optimalControlProblem);
+  }  // end of i loop
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t EventTimeGradient::compute(const SolverBase& solver, const PrimalSolution& primalSolution) {
+  const auto& eventTimes = primalSolution.modeSchedule_.eventTimes;
+  const auto& timeTrajectory = primalSolution.timeTrajectory_;
+  vector_t gradient = vector_t::Zero(eventTimes.size());
+
+  for (auto& problem : optimalControlProblemStock_) {
+    problem.targetTrajectoriesPtr = &solver.getReferenceManager().getTargetTrajectories();
+  }
+
+  // the nodes before and after each event. The time is shifted by the offset to select the side of the event.
+  constexpr scalar_t offset = numeric_traits::limitEpsilon<scalar_t>();
+  auto getNode = [&](scalar_t time, size_t index) {
+    Node node;
+    node.time = time;
+    node.state = primalSolution.stateTrajectory_[index];
+    node.input = primalSolution.inputTrajectory_[index];
+    node.costate = solver.getValueFunction(time, node.state).dfdx;
+    node.lagrangian = solver.getStateInputEqualityConstraintLagrangian(time, node.state);
+    node.multipliers = solver.getIntermediateDualSolution(time);
+    return node;
+  };
+
+  // the queries to the solver are not thread safe, hence the nodes are collected sequentially
+  std::vector<size_t> eventIndices;
+  std::vector<std::pair<Node, Node>> eventNodes;
+  for (const auto postEventIndex : primalSolution.postEventIndices_) {
+    if (postEventIndex == 0 || postEventIndex >= timeTrajectory.size()) {
+      continue;
+    }
+
+    const scalar_t eventTime = timeTrajectory[postEventIndex];
+    const auto eventTimeItr = std::lower_bound(eventTimes.cbegin(), eventTimes.cend(), eventTime - offset);
+    if (eventTimeItr == eventTimes.cend() || std::abs(*eventTimeItr - eventTime) > offset) {
+      continue;
+    }
+
+    eventIndices.push_back(std::distance(eventTimes.cbegin(), eventTimeItr));
+    eventNodes.emplace_back(getNode(eventTime - offset, postEventIndex - 1), getNode(eventTime + offset, postEventIndex));
+  }  // end of postEventIndex loop
+
+  // the Hamiltonian jump of each event
+  std::atomic_size_t nextEvent{0};
+  auto task = [&](int workerIndex) {
+    auto& problem = optimalControlProblemStock_[workerIndex];
+    size_t i = nextEvent++;
+    while (i < eventIndices.size()) {
+      gradient(eventIndices[i]) = computeHamiltonian(problem, eventNodes[i].first) - computeHamiltonian(problem, eventNodes[i].second);
+      i = nextEvent++;
+    }
+  };
+  threadPool_.runParallel(task, optimalControlProblemStock_.size());
+
+  return gradient;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t EventTimeGradient::computeHamiltonian(OptimalControlProblem& problem, const Node& node) const {
+  const auto modelData = approximateIntermediateLQ(problem, node.time, node.state, node.input, node.multipliers);
+
+  scalar_t hamiltonian = modelData.cost.f + node.costate.dot(modelData.dynamics.f);
+  if (node.lagrangian.size() > 0) {
+    hamiltonian += node.lagrangian.dot(modelData.stateInputEqConstraint.f);
+  }
+  return hamiltonian;
+}
+
+}  // namespace ocs2
@@ -0,0 +1,127 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ocs2/ModeScheduleOptimizer.h"
+
+#include <algorithm>
+
+#include <boost/property_tree/info_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <ocs2_core/misc/LoadData.h>
+
+namespace ocs2 {
+namespace mode_schedule_optimizer {
+
+Settings loadSettings(const std::string& filename, const std::string& fieldName, bool verbose) {
+  boost::property_tree::ptree pt;
+  boost::property_tree::read_info(filename, pt);
+
+  Settings settings;
+
+  if (verbose) {
+    std::cerr << "\n #### Mode Schedule Optimizer Settings: ";
+    std::cerr << "\n #### =============================================================================\n";
+  }
+
+  loadData::loadPtreeValue(pt, settings.stepSize, fieldName + ".stepSize", verbose);
+  loadData::loadPtreeValue(pt, settings.maxEventTimeChange, fieldName + ".maxEventTimeChange", verbose);
+  loadData::loadPtreeValue(pt, settings.minEventTimeDifference, fieldName + ".minEventTimeDifference", verbose);
+  loadData::loadPtreeValue(pt, settings.minTimeToEvent, fieldName + ".minTimeToEvent", verbose);
+  loadData::loadPtreeValue(pt, settings.nThreads, fieldName + ".nThreads", verbose);
+  loadData::loadPtreeValue(pt, settings.threadPriority, fieldName + ".threadPriority", verbose);
+
+  if (verbose) {
+    std::cerr << " #### =============================================================================" << std::endl;
+  }
+
+  return settings;
+}
+
+}  // namespace mode_schedule_optimizer
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ModeScheduleOptimizer::ModeScheduleOptimizer(mode_schedule_optimizer::Settings settings, const OptimalControlProblem& optimalControlProblem,
+                                             SolverBase& solver)
+    : settings_(std::move(settings)),
+      solver_(solver),
+      eventTimeGradient_(optimalControlProblem, settings_.nThreads, settings_.threadPriority) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ModeScheduleOptimizer::preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                                         const ReferenceManagerInterface& referenceManager) {
+  initTime_ = initTime;
+  finalTime_ = finalTime;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ModeScheduleOptimizer::postSolverRun(const PrimalSolution& primalSolution) {
+  eventTimesGradient_ = eventTimeGradient_.compute(solver_, primalSolution);
+
+  // the update is used in the next run
+  ModeSchedule modeSchedule = primalSolution.modeSchedule_;
+  modeSchedule.eventTimes = updateEventTimes(modeSchedule.eventTimes, eventTimesGradient_);
+  solver_.getReferenceManager().setModeSchedule(std::move(modeSchedule));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_array_t ModeScheduleOptimizer::updateEventTimes(const scalar_array_t& eventTimes, const vector_t& gradient) const {
+  const scalar_t minEventTime = initTime_ + settings_.minTimeToEvent;
+
+  scalar_array_t updatedEventTimes = eventTimes;
+  for (size_t i = 0; i < eventTimes.size(); i++) {
+    if (eventTimes[i] <= minEventTime || eventTimes[i] >= finalTime_) {
+      continue;
+    }
+
+    // the feasible interval is bounded by the updated previous event and the next event
+    const scalar_t lowerBound =
+        (i > 0) ? std::max(minEventTime, updatedEventTimes[i - 1] + settings_.minEventTimeDifference) : minEventTime;
+    const scalar_t upperBound = (i + 1 < eventTimes.size()) ? eventTimes[i + 1] - settings_.minEventTimeDifference : finalTime_;
+    if (lowerBound > upperBound) {
+      continue;
+    }
+
+    const scalar_t maxChange = settings_.maxEventTimeChange;
+    const scalar_t step = std::max(-maxChange, std::min(-settings_.stepSize * gradient(i), maxChange));
+    updatedEventTimes[i] = std::max(lowerBound, std::min(eventTimes[i] + step, upperBound));
+  }  // end of i loop
+
+  return updatedEventTimes;
+}
+
+}  // namespace ocs2
@@ -0,0 +1,183 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_ddp/SLQ.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+#include <ocs2_oc/test/EXP1.h>
+
+#include "ocs2_ocs2/EventTimeGradient.h"
+#include "ocs2_ocs2/ModeScheduleOptimizer.h"
+
+using namespace ocs2;
+
+class Exp1EventTimes : public testing::Test {
+ protected:
+  static constexpr scalar_t startTime = 0.0;
+  static constexpr scalar_t finalTime = 3.0;
+
+  /** The SLQ solver of EXP1 for the given event times. */
+  struct Exp1Solver {
+    explicit Exp1Solver(const scalar_array_t& eventTimes, size_t numThreads = 2)
+        : referenceManagerPtr(getExp1ReferenceManager(eventTimes, {0, 1, 2})),
+          problem(createExp1Problem(referenceManagerPtr)),
+          initializer(1),
+          rollout(EXP1_System(referenceManagerPtr), rolloutSettings()),
+          slq(ddpSettings(numThreads), rollout, problem, initializer) {
+      slq.setReferenceManager(referenceManagerPtr);
+    }
+
+    static rollout::Settings rolloutSettings() {
+      rollout::Settings settings;
+      settings.absTolODE = 1e-10;
+      settings.relTolODE = 1e-7;
+      settings.timeStep = 1e-3;
+      return settings;
+    }
+
+    static ddp::Settings ddpSettings(size_t numThreads) {
+      ddp::Settings settings;
+      settings.algorithm_ = ddp::Algorithm::SLQ;
+      settings.nThreads_ = numThreads;
+      settings.maxNumIterations_ = 50;
+      settings.minRelCost_ = 1e-9;
+      settings.absTolODE_ = 1e-10;
+      settings.relTolODE_ = 1e-7;
+      settings.timeStep_ = 1e-3;
+      settings.useFeedbackPolicy_ = true;
+      settings.displayInfo_ = false;
+      settings.displayShortSummary_ = false;
+      settings.lineSearch_.minStepLength = 1e-4;
+      return settings;
+    }
+
+    std::shared_ptr<ReferenceManager> referenceManagerPtr;
+    OptimalControlProblem problem;
+    DefaultInitializer initializer;
+    TimeTriggeredRollout rollout;
+    SLQ slq;
+  };
+
+  /** Solves EXP1 for the given event times and returns the cost */
+  scalar_t solveCost(const scalar_array_t& eventTimes) const {
+    Exp1Solver solver(eventTimes);
+    solver.slq.run(startTime, initState, finalTime);
+    return solver.slq.getPerformanceIndeces().cost;
+  }
+
+  const vector_t initState = (vector_t(2) << 2.0, 3.0).finished();
+  const scalar_array_t optimalEventTimes{0.2262, 1.0176};
+};
+
+constexpr scalar_t Exp1EventTimes::startTime;
+constexpr scalar_t Exp1EventTimes::finalTime;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1EventTimes, gradientAtOptimalEventTimes) {
+  Exp1Solver solver(optimalEventTimes);
+  solver.slq.run(startTime, initState, finalTime);
+
+  EventTimeGradient eventTimeGradient(solver.problem, 2);
+  const vector_t gradient = eventTimeGradient.compute(solver.slq, solver.slq.primalSolution(finalTime));
+
+  ASSERT_EQ(gradient.size(), optimalEventTimes.size());
+  EXPECT_TRUE(gradient.isZero(5e-2)) << "gradient: " << gradient.transpose();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1EventTimes, compareWithFiniteDifference) {
+  const scalar_array_t eventTimes{0.5, 1.5};
+  // the optimal cost is only resolved up to the convergence tolerance of SLQ, hence a rather large perturbation
+  constexpr scalar_t delta = 1e-2;
+
+  // Hamiltonian jump
+  benchmark::RepeatedTimer gradientTimer;
+  Exp1Solver solver(eventTimes);
+  solver.slq.run(startTime, initState, finalTime);
+  EventTimeGradient eventTimeGradient(solver.problem, 2);
+  gradientTimer.startTimer();
+  const vector_t gradient = eventTimeGradient.compute(solver.slq, solver.slq.primalSolution(finalTime));
+  gradientTimer.endTimer();
+
+  // central finite difference of the optimal cost as in NumGDDP
+  benchmark::RepeatedTimer finiteDifferenceTimer;
+  finiteDifferenceTimer.startTimer();
+  vector_t finiteDifferenceGradient(eventTimes.size());
+  for (size_t i = 0; i < eventTimes.size(); i++) {
+    auto eventTimesPlus = eventTimes;
+    auto eventTimesMinus = eventTimes;
+    eventTimesPlus[i] += delta;
+    eventTimesMinus[i] -= delta;
+    finiteDifferenceGradient(i) = (solveCost(eventTimesPlus) - solveCost(eventTimesMinus)) / (2.0 * delta);
+  }  // end of i loop
+  finiteDifferenceTimer.endTimer();
+
+  std::cerr << "[EventTimeGradient] gradient:          " << gradient.transpose() << "  (" << gradientTimer.getTotalInMilliseconds()
+            << " [ms])\n";
+  std::cerr << "[EventTimeGradient] finite difference: " << finiteDifferenceGradient.transpose() << "  ("
+            << finiteDifferenceTimer.getTotalInMilliseconds() << " [ms])\n";
+
+  EXPECT_TRUE(gradient.isApprox(finiteDifferenceGradient, 1e-1)) << "gradient: " << gradient.transpose()
+                                                                 << "\nfinite difference: " << finiteDifferenceGradient.transpose();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1EventTimes, modeScheduleOptimizer) {
+  const scalar_array_t initialEventTimes{0.5, 1.5};
+  Exp1Solver solver(initialEventTimes);
+
+  mode_schedule_optimizer::Settings settings;
+  settings.nThreads = 2;
+  auto modeScheduleOptimizerPtr = std::make_shared<ModeScheduleOptimizer>(settings, solver.problem, solver.slq);
+  solver.slq.addSynchronizedModule(modeScheduleOptimizerPtr);
+
+  // repeated calls on the same horizon
+  solver.slq.run(startTime, initState, finalTime);
+  const auto initialCost = solver.slq.getPerformanceIndeces().cost;
+  for (size_t i = 0; i < 40; i++) {
+    solver.slq.run(startTime, initState, finalTime);
+  }  // end of i loop
+  const auto finalCost = solver.slq.getPerformanceIndeces().cost;
+
+  EXPECT_LT(finalCost, initialCost);
+  EXPECT_NEAR(finalCost, solveCost(optimalEventTimes), 1e-2);
+  const auto& eventTimes = solver.referenceManagerPtr->getModeSchedule().eventTimes;
+  EXPECT_NEAR(eventTimes[0], optimalEventTimes[0], 1e-2);
+  EXPECT_NEAR(eventTimes[1], optimalEventTimes[1], 1e-2);
+  EXPECT_TRUE(modeScheduleOptimizerPtr->getEventTimesGradient().isZero(1e-1));
+}
@@ -39,6 +39,7 @@ namespace ocs2 {
 class DistanceTransformInterface {
  public:
   using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
+  using matrix3x_t = Eigen::Matrix<scalar_t, 3, Eigen::Dynamic>;
 
   DistanceTransformInterface() = default;
   virtual ~DistanceTransformInterface() = default;
@@ -56,6 +57,37 @@ class DistanceTransformInterface {
 
   /** Gets the distance's value and its gradient at the given point. */
   virtual std::pair<scalar_t, vector3_t> getLinearApproximation(const vector3_t& p) const = 0;
+
+  /**
+   * Gets the distances to a batch of points. The default implementation calls getValue() for each point.
+   *
+   * @param [in] points: The query points stored column-wise (3 x N).
+   * @param [out] values: The distances (N).
+   */
+  virtual void getValues(const Eigen::Ref<const matrix3x_t>& points, vector_t& values) const {
+    values.resize(points.cols());
+    for (Eigen::Index i = 0; i < points.cols(); i++) {
+      values(i) = getValue(points.col(i));
+    }
+  }
+
+  /**
+   * Gets the distances' values and their gradients for a batch of points. The default implementation calls
+   * getLinearApproximation() for each point.
+   *
+   * @param [in] points: The query points stored column-wise (3 x N).
+   * @param [out] values: The distances (N).
+   * @param [out] gradients: The gradients stored column-wise (3 x N).
+   */
+  virtual void getLinearApproximations(const Eigen::Ref<const matrix3x_t>& points, vector_t& values, matrix3x_t& gradients) const {
+    values.resize(points.cols());
+    gradients.resize(3, points.cols());
+    for (Eigen::Index i = 0; i < points.cols(); i++) {
+      const auto valueGradient = getLinearApproximation(points.col(i));
+      values(i) = valueGradient.first;
+      gradients.col(i) = valueGradient.second;
+    }
+  }
 };
 
 /** Identity distance transform with constant zero value and zero gradients. */
@@ -67,6 +99,12 @@ class IdentityDistanceTransform : public DistanceTransformInterface {
   scalar_t getValue(const vector3_t&) const override { return 0.0; }
   vector3_t getProjectedPoint(const vector3_t& p) const override { return p; }
   std::pair<scalar_t, vector3_t> getLinearApproximation(const vector3_t&) const override { return {0.0, vector3_t::Zero()}; }
+
+  void getValues(const Eigen::Ref<const matrix3x_t>& points, vector_t& values) const override { values.setZero(points.cols()); }
+  void getLinearApproximations(const Eigen::Ref<const matrix3x_t>& points, vector_t& values, matrix3x_t& gradients) const override {
+    values.setZero(points.cols());
+    gradients.setZero(3, points.cols());
+  }
 };
 
 }  // namespace ocs2
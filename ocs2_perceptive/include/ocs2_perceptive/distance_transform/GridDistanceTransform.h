@@ -0,0 +1,145 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_perceptive/distance_transform/DistanceTransformInterface.h"
+
+namespace ocs2 {
+
+/**
+ * A 3D voxel grid of Euclidean distances which is tri-linearly interpolated between the voxel centers. The horizontal
+ * axes are stored in a circular buffer: the voxel column of the global cell index (ix, iy) is located at
+ * (ix mod sizeX, iy mod sizeY). Therefore a window which rolls over the grid does not need to relocate its data.
+ *
+ * The query methods only read the data, therefore a snapshot can be shared among multiple threads.
+ */
+class GridDistanceTransform final : public DistanceTransformInterface {
+ public:
+  /** The grid geometry. */
+  struct Config {
+    /** The edge length of the cubic voxels. */
+    scalar_t resolution = 0.05;
+    /** The number of voxels along the x-axis. */
+    size_t sizeX = 0;
+    /** The number of voxels along the y-axis. */
+    size_t sizeY = 0;
+    /** The number of voxels along the z-axis. */
+    size_t sizeZ = 0;
+    /** The height of the bottom face of the grid. */
+    scalar_t minZ = 0.0;
+  };
+
+  /**
+   * Constructor
+   * @param [in] config: The grid geometry.
+   */
+  explicit GridDistanceTransform(Config config);
+
+  /** Default destructor */
+  ~GridDistanceTransform() override = default;
+
+  /**
+   * Sets the grid data.
+   * @param [in] originX: The global index of the first cell of the window along the x-axis.
+   * @param [in] originY: The global index of the first cell of the window along the y-axis.
+   * @param [in] data: The distances in the circular buffer layout, i.e., the value of voxel (ix, iy, iz) is stored at
+   *                   ((ix mod sizeX) * sizeY + (iy mod sizeY)) * sizeZ + iz.
+   */
+  void set(std::ptrdiff_t originX, std::ptrdiff_t originY, const std::vector<float>& data);
+
+  scalar_t getValue(const vector3_t& p) const override;
+  vector3_t getProjectedPoint(const vector3_t& p) const override;
+  std::pair<scalar_t, vector3_t> getLinearApproximation(const vector3_t& p) const override;
+
+  /** The batch queries first locate all cells and prefetch their voxels, then interpolate all points with vectorized kernels. */
+  void getValues(const Eigen::Ref<const matrix3x_t>& points, vector_t& values) const override;
+  void getLinearApproximations(const Eigen::Ref<const matrix3x_t>& points, vector_t& values, matrix3x_t& gradients) const override;
+
+  const Config& getConfig() const { return config_; }
+  std::ptrdiff_t getOriginX() const { return originX_; }
+  std::ptrdiff_t getOriginY() const { return originY_; }
+
+  /** Maps a global cell index to its location in the circular buffer of the given size. */
+  static size_t wrapIndex(std::ptrdiff_t index, size_t size) {
+    const auto n = static_cast<std::ptrdiff_t>(size);
+    return static_cast<size_t>(((index % n) + n) % n);
+  }
+
+  /** Gets the value of the voxel with the given index relative to the window's origin. */
+  scalar_t getVoxelValue(size_t i, size_t j, size_t k) const { return data_[getIndex(i, j, k)]; }
+
+ private:
+  /** The interpolation cell of a point: the index of the lower voxel center and the normalized offset from it. */
+  struct InterpolationCell {
+    size_t i, j, k;
+    vector3_t offset;
+    /** Whether the point lies inside the span of the voxel centers along each axis. */
+    Eigen::Matrix<bool, 3, 1> isInside;
+  };
+
+  /** The interpolation cells of a batch of points. Each column holds one quantity for all the points. */
+  struct InterpolationBatch {
+    /** The corner values ordered as in getCornerValues() (N x 8). */
+    Eigen::Matrix<scalar_t, Eigen::Dynamic, 8> cornerValues;
+    /** The normalized offsets (N x 3). */
+    Eigen::Matrix<scalar_t, Eigen::Dynamic, 3> offsets;
+    /** The inside flags (N x 3). */
+    Eigen::Matrix<bool, Eigen::Dynamic, 3> isInside;
+  };
+
+  InterpolationCell getInterpolationCell(const vector3_t& p) const;
+
+  void getInterpolationBatch(const Eigen::Ref<const matrix3x_t>& points, InterpolationBatch& batch) const;
+
+  /** Gets the values of the eight voxels of the cell, ordered as v[4 * dx + 2 * dy + dz]. */
+  std::array<scalar_t, 8> getCornerValues(const InterpolationCell& cell) const;
+
+  size_t getIndex(size_t i, size_t j, size_t k) const {
+    const size_t x = (startX_ + i < config_.sizeX) ? startX_ + i : startX_ + i - config_.sizeX;
+    const size_t y = (startY_ + j < config_.sizeY) ? startY_ + j : startY_ + j - config_.sizeY;
+    return (x * config_.sizeY + y) * config_.sizeZ + k;
+  }
+
+  const Config config_;
+  std::ptrdiff_t originX_ = 0;
+  std::ptrdiff_t originY_ = 0;
+  size_t startX_ = 0;
+  size_t startY_ = 0;
+  std::vector<float> data_;
+};
+
+}  // namespace ocs2
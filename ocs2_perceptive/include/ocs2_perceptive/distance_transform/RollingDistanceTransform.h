@@ -0,0 +1,137 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_perceptive/distance_transform/GridDistanceTransform.h"
+
+namespace ocs2 {
+
+/**
+ * A distance field of the terrain within a horizontal window which rolls with the robot. The terrain is given as an
+ * elevation map, and every voxel below the terrain is considered as occupied. The distances are truncated at
+ * maxDistance, therefore a change in the elevation map only influences the voxels within maxDistance of it.
+ *
+ * The grid uses circular-buffer indexing (see GridDistanceTransform). When the window moves, only the newly exposed
+ * strips and the region influenced by them (and by the cells which left the window) are recomputed. Likewise,
+ * setElevation() only marks the influence region of the changed cells for recomputation.
+ *
+ * The results are published as immutable snapshots through double buffering. The writer methods (moveTo, reset,
+ * setElevation, update) should be called from a single thread, while getSnapshot() can be called from any thread.
+ * A snapshot which is held by a reader is never modified.
+ */
+class RollingDistanceTransform {
+ public:
+  using vector2_t = Eigen::Matrix<scalar_t, 2, 1>;
+  /** Elevation query with signature: scalar_t(const vector2_t& position). Returns -infinity for the unknown cells. */
+  using elevation_function_t = std::function<scalar_t(const vector2_t&)>;
+
+  /**
+   * Constructor. The elevation of all cells is initialized as unknown, and a snapshot of the (empty) field is published.
+   * @param [in] config: The grid geometry.
+   * @param [in] maxDistance: The truncation distance of the field.
+   * @param [in] center: The initial center of the window.
+   */
+  RollingDistanceTransform(GridDistanceTransform::Config config, scalar_t maxDistance, const vector2_t& center);
+
+  /** Refills the whole window centered at the given position, and marks it for recomputation. */
+  void reset(const vector2_t& center, const elevation_function_t& getElevation);
+
+  /**
+   * Moves the window center to the given position. The elevation of the newly exposed cells are queried from getElevation
+   * and their influence region is marked for recomputation.
+   */
+  void moveTo(const vector2_t& center, const elevation_function_t& getElevation);
+
+  /** Sets the elevation of the cell which contains the given position. Positions outside of the window are ignored. */
+  void setElevation(const vector2_t& position, scalar_t elevation);
+
+  /** Recomputes the marked regions and publishes a new snapshot. */
+  void update();
+
+  /** Gets the latest published snapshot. This method is thread-safe. */
+  std::shared_ptr<const GridDistanceTransform> getSnapshot() const;
+
+  /** Gets the number of voxels which were recomputed in the last call to update(). */
+  size_t getNumRecomputedVoxels() const { return numRecomputedVoxels_; }
+
+  const GridDistanceTransform::Config& getConfig() const { return config_; }
+
+ private:
+  /** A half-open box [x0, x1) x [y0, y1) of global cell indices. */
+  struct Box {
+    std::ptrdiff_t x0, y0, x1, y1;
+    bool isEmpty() const { return x0 >= x1 || y0 >= y1; }
+    size_t area() const { return isEmpty() ? 0 : static_cast<size_t>((x1 - x0) * (y1 - y0)); }
+  };
+
+  std::ptrdiff_t getCellIndex(scalar_t coordinate) const;
+  Box getWindow() const { return {originX_, originY_, originX_ + sizeX_, originY_ + sizeY_}; }
+  Box dilateAndClip(const Box& box, std::ptrdiff_t margin) const;
+  void fillElevation(const Box& box, const elevation_function_t& getElevation);
+  /** The squared distance in cells of voxel k to the terrain of the column (ix, iy), capped at (maxDistanceInCells + 1)^2. */
+  float getColumnSquaredDistance(std::ptrdiff_t ix, std::ptrdiff_t iy, size_t k) const;
+  /** Recomputes the voxels in the target box from the elevations in the source box. */
+  void recompute(const Box& target, const Box& source);
+  void publish();
+
+  const GridDistanceTransform::Config config_;
+  const scalar_t maxDistance_;
+  const std::ptrdiff_t maxDistanceInCells_;
+  const std::ptrdiff_t sizeX_;
+  const std::ptrdiff_t sizeY_;
+
+  std::ptrdiff_t originX_ = 0;
+  std::ptrdiff_t originY_ = 0;
+  std::vector<scalar_t> elevation_;
+  std::vector<float> distance_;
+  std::vector<Box> changedBoxes_;
+  Box changedCellsBox_{0, 0, 0, 0};
+  size_t numRecomputedVoxels_ = 0;
+
+  // buffers of the distance transform
+  std::vector<float> squaredDistanceBuffer_;
+  std::vector<size_t> vBuffer_;
+  std::vector<float> zBuffer_;
+
+  // double buffering of the snapshots
+  std::shared_ptr<GridDistanceTransform> backSnapshotPtr_;
+  std::shared_ptr<GridDistanceTransform> frontSnapshotPtr_;
+  mutable std::mutex snapshotMutex_;
+};
+
+}  // namespace ocs2
@@ -60,6 +60,12 @@ class EndEffectorDistanceConstraint final : public ocs2::StateConstraint {
   void set(scalar_t clearance, const DistanceTransformInterface& distanceTransform);
   void set(const scalar_array_t& clearances, const DistanceTransformInterface& distanceTransform);
 
+  /**
+   * Sets a shared snapshot of the distance-transform (e.g., RollingDistanceTransform::getSnapshot()). The constraint keeps
+   * the snapshot alive, therefore it remains unchanged while the solver is running.
+   */
+  void set(scalar_t clearance, std::shared_ptr<const DistanceTransformInterface> distanceTransformPtr);
+
   EndEffectorDistanceConstraint* clone() const override { return new EndEffectorDistanceConstraint(*this); }
   size_t getNumConstraints(scalar_t time) const override { return kinematicsPtr_->getIds().size(); }
   const std::vector<std::string>& getIDs() const { return kinematicsPtr_->getIds(); }
@@ -81,6 +87,7 @@ class EndEffectorDistanceConstraint final : public ocs2::StateConstraint {
 
   scalar_array_t clearances_;
   const DistanceTransformInterface* distanceTransformPtr_ = nullptr;
+  std::shared_ptr<const DistanceTransformInterface> distanceTransformSnapshotPtr_;
 };
 
 }  // namespace ocs2
@@ -65,6 +65,12 @@ class EndEffectorDistanceConstraintCppAd final : public ocs2::StateInputConstrai
   void set(scalar_t clearance, const DistanceTransformInterface& distanceTransform);
   void set(vector_t clearances, const DistanceTransformInterface& distanceTransform);
 
+  /**
+   * Sets a shared snapshot of the distance-transform (e.g., RollingDistanceTransform::getSnapshot()). The constraint keeps
+   * the snapshot alive, therefore it remains unchanged while the solver is running.
+   */
+  void set(scalar_t clearance, std::shared_ptr<const DistanceTransformInterface> distanceTransformPtr);
+
   EndEffectorDistanceConstraintCppAd* clone() const override { return new EndEffectorDistanceConstraintCppAd(*this); }
   size_t getNumConstraints(scalar_t time) const override { return adKinematicsPtr_->getIds().size(); }
   const std::vector<std::string>& getIDs() const { return adKinematicsPtr_->getIds(); }
@@ -90,6 +96,7 @@ class EndEffectorDistanceConstraintCppAd final : public ocs2::StateInputConstrai
 
   vector_t clearances_;
   const DistanceTransformInterface* distanceTransformPtr_ = nullptr;
+  std::shared_ptr<const DistanceTransformInterface> distanceTransformSnapshotPtr_;
 };
 
 }  // namespace ocs2
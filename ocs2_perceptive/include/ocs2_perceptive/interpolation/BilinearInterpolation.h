@@ -29,7 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <utility>
 
 #include <ocs2_core/Types.h>
@@ -82,5 +84,211 @@ std::pair<Scalar, Eigen::Matrix<Scalar, 2, 1>> getLinearApproximation(Scalar res
   return {value, gradient};
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+/*
+ * Batch kernels
+ *
+ * Points are packed in structure-of-arrays form: one point per row, such that each coordinate (and each corner value) is a contiguous
+ * column. The kernels process the points in blocks of fixed size, which Eigen maps onto the SIMD instruction set enabled at compile
+ * time (SSE2 by default on x86-64, AVX/AVX2 with -march=native, NEON on ARM). The remainder is evaluated point by point.
+ */
+template <typename Scalar>
+using packed_scalar_t = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+template <typename Scalar>
+using packed_vector2_t = Eigen::Matrix<Scalar, Eigen::Dynamic, 2>;
+template <typename Scalar>
+using packed_corners_t = Eigen::Matrix<Scalar, Eigen::Dynamic, 4>;
+
+namespace detail {
+
+/** Number of points evaluated per block in the batch kernels */
+constexpr int kBatchBlockSize = 16;
+
+/** Pointers to the contiguous columns of the packed inputs and outputs */
+template <typename Scalar>
+struct PackedColumns {
+  const Scalar* px;
+  const Scalar* py;
+  const Scalar* rx;
+  const Scalar* ry;
+  const Scalar* c0;
+  const Scalar* c1;
+  const Scalar* c2;
+  const Scalar* c3;
+  Scalar* value;
+  Scalar* dx;  // nullptr if the gradient is not requested
+  Scalar* dy;  // nullptr if the gradient is not requested
+};
+
+/** Evaluates the points [k, k + N) */
+template <int N, typename Scalar>
+void evaluateBlock(Eigen::Index k, Scalar r_inv, const PackedColumns<Scalar>& columns) {
+  using array_t = Eigen::Array<Scalar, N, 1>;
+  using const_map_t = Eigen::Map<const array_t>;
+  using map_t = Eigen::Map<array_t>;
+
+  const array_t x = (const_map_t(columns.px + k) - const_map_t(columns.rx + k)) * r_inv;
+  const array_t y = (const_map_t(columns.py + k) - const_map_t(columns.ry + k)) * r_inv;
+  const array_t c0 = const_map_t(columns.c0 + k);
+  const array_t cx = const_map_t(columns.c1 + k) - c0;
+  const array_t cy = const_map_t(columns.c2 + k) - c0;
+  const array_t cxy = const_map_t(columns.c3 + k) - const_map_t(columns.c2 + k) - cx;
+
+  map_t(columns.value + k) = c0 + x * cx + y * (cy + x * cxy);
+  if (columns.dx != nullptr) {
+    map_t(columns.dx + k) = (cx + y * cxy) * r_inv;
+    map_t(columns.dy + k) = (cy + x * cxy) * r_inv;
+  }
+}
+
+template <typename Scalar>
+void evaluate(Scalar resolution, const packed_vector2_t<Scalar>& referenceCorners, const packed_corners_t<Scalar>& cornerValues,
+              const packed_vector2_t<Scalar>& positions, packed_scalar_t<Scalar>& values, packed_vector2_t<Scalar>* gradients) {
+  const Scalar r_inv = 1.0 / resolution;
+  const Eigen::Index numPoints = positions.rows();
+  values.resize(numPoints);
+  if (gradients != nullptr) {
+    gradients->resize(numPoints, 2);
+  }
+
+  PackedColumns<Scalar> columns;
+  columns.px = positions.col(0).data();
+  columns.py = positions.col(1).data();
+  columns.rx = referenceCorners.col(0).data();
+  columns.ry = referenceCorners.col(1).data();
+  columns.c0 = cornerValues.col(0).data();
+  columns.c1 = cornerValues.col(1).data();
+  columns.c2 = cornerValues.col(2).data();
+  columns.c3 = cornerValues.col(3).data();
+  columns.value = values.data();
+  columns.dx = (gradients != nullptr) ? gradients->col(0).data() : nullptr;
+  columns.dy = (gradients != nullptr) ? gradients->col(1).data() : nullptr;
+
+  Eigen::Index k = 0;
+  for (; k + kBatchBlockSize <= numPoints; k += kBatchBlockSize) {
+    evaluateBlock<kBatchBlockSize>(k, r_inv, columns);
+  }
+  for (; k < numPoints; ++k) {
+    evaluateBlock<1>(k, r_inv, columns);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Batch version of getValue(). Row i of the inputs holds the arguments of the i-th point.
+ *
+ * @param [in] resolution: The grid resolution.
+ * @param [in] referenceCorners: The reference corner of each point's cell.
+ * @param [in] cornerValues: The corner values of each point's cell in the order of getValue().
+ * @param [in] positions: The query positions.
+ * @param [out] values: The interpolated values.
+ */
+template <typename Scalar>
+void getValues(Scalar resolution, const packed_vector2_t<Scalar>& referenceCorners, const packed_corners_t<Scalar>& cornerValues,
+               const packed_vector2_t<Scalar>& positions, packed_scalar_t<Scalar>& values) {
+  detail::evaluate<Scalar>(resolution, referenceCorners, cornerValues, positions, values, nullptr);
+}
+
+/**
+ * Batch version of getLinearApproximation(). Row i of the inputs holds the arguments of the i-th point.
+ *
+ * @param [in] resolution: The grid resolution.
+ * @param [in] referenceCorners: The reference corner of each point's cell.
+ * @param [in] cornerValues: The corner values of each point's cell in the order of getValue().
+ * @param [in] positions: The query positions.
+ * @param [out] values: The interpolated values.
+ * @param [out] gradients: The gradients of the interpolated values w.r.t. the positions.
+ */
+template <typename Scalar>
+void getLinearApproximations(Scalar resolution, const packed_vector2_t<Scalar>& referenceCorners,
+                             const packed_corners_t<Scalar>& cornerValues, const packed_vector2_t<Scalar>& positions,
+                             packed_scalar_t<Scalar>& values, packed_vector2_t<Scalar>& gradients) {
+  detail::evaluate<Scalar>(resolution, referenceCorners, cornerValues, positions, values, &gradients);
+}
+
+/**
+ * Gathers the cells of the query positions from a regular grid. The grid value grid(i, j) is located at
+ * gridOrigin + resolution * (i, j). The grid can be stored in either row-major or column-major order. Positions outside of the grid
+ * use the nearest boundary cell, i.e., the interpolation is linearly extrapolated.
+ *
+ * @param [in] resolution: The grid resolution.
+ * @param [in] gridOrigin: The position of grid(0, 0).
+ * @param [in] grid: The grid values with at least two rows and two columns.
+ * @param [in] positions: The query positions.
+ * @param [out] referenceCorners: The reference corner of each point's cell.
+ * @param [out] cornerValues: The corner values of each point's cell in the order of getValue().
+ */
+template <typename Derived>
+void gatherCells(typename Derived::Scalar resolution, const Eigen::Matrix<typename Derived::Scalar, 2, 1>& gridOrigin,
+                 const Eigen::DenseBase<Derived>& grid, const packed_vector2_t<typename Derived::Scalar>& positions,
+                 packed_vector2_t<typename Derived::Scalar>& referenceCorners,
+                 packed_corners_t<typename Derived::Scalar>& cornerValues) {
+  using scalar_type = typename Derived::Scalar;
+  const scalar_type r_inv = 1.0 / resolution;
+  const Eigen::Index maxI = grid.rows() - 2;
+  const Eigen::Index maxJ = grid.cols() - 2;
+
+  auto cellIndex = [r_inv](scalar_type position, scalar_type origin, Eigen::Index maxIndex) {
+    const auto index = static_cast<Eigen::Index>(std::floor((position - origin) * r_inv));
+    return std::min(std::max(index, Eigen::Index(0)), maxIndex);
+  };
+
+  referenceCorners.resize(positions.rows(), 2);
+  cornerValues.resize(positions.rows(), 4);
+  for (Eigen::Index k = 0; k < positions.rows(); ++k) {
+    const auto i = cellIndex(positions(k, 0), gridOrigin.x(), maxI);
+    const auto j = cellIndex(positions(k, 1), gridOrigin.y(), maxJ);
+    referenceCorners(k, 0) = gridOrigin.x() + i * resolution;
+    referenceCorners(k, 1) = gridOrigin.y() + j * resolution;
+    cornerValues(k, 0) = grid.derived().coeff(i, j);
+    cornerValues(k, 1) = grid.derived().coeff(i + 1, j);
+    cornerValues(k, 2) = grid.derived().coeff(i, j + 1);
+    cornerValues(k, 3) = grid.derived().coeff(i + 1, j + 1);
+  }  // end of k loop
+}
+
+/**
+ * Interpolates a regular grid at a batch of positions. See gatherCells() for the grid convention.
+ *
+ * @param [in] resolution: The grid resolution.
+ * @param [in] gridOrigin: The position of grid(0, 0).
+ * @param [in] grid: The grid values with at least two rows and two columns, in row-major or column-major order.
+ * @param [in] positions: The query positions.
+ * @param [out] values: The interpolated values.
+ */
+template <typename Derived>
+void getGridValues(typename Derived::Scalar resolution, const Eigen::Matrix<typename Derived::Scalar, 2, 1>& gridOrigin,
+                   const Eigen::DenseBase<Derived>& grid, const packed_vector2_t<typename Derived::Scalar>& positions,
+                   packed_scalar_t<typename Derived::Scalar>& values) {
+  packed_vector2_t<typename Derived::Scalar> referenceCorners;
+  packed_corners_t<typename Derived::Scalar> cornerValues;
+  gatherCells(resolution, gridOrigin, grid, positions, referenceCorners, cornerValues);
+  getValues(resolution, referenceCorners, cornerValues, positions, values);
+}
+
+/**
+ * Interpolates a regular grid and its gradient at a batch of positions. See gatherCells() for the grid convention.
+ *
+ * @param [in] resolution: The grid resolution.
+ * @param [in] gridOrigin: The position of grid(0, 0).
+ * @param [in] grid: The grid values with at least two rows and two columns, in row-major or column-major order.
+ * @param [in] positions: The query positions.
+ * @param [out] values: The interpolated values.
+ * @param [out] gradients: The gradients of the interpolated values w.r.t. the positions.
+ */
+template <typename Derived>
+void getGridLinearApproximations(typename Derived::Scalar resolution, const Eigen::Matrix<typename Derived::Scalar, 2, 1>& gridOrigin,
+                                 const Eigen::DenseBase<Derived>& grid, const packed_vector2_t<typename Derived::Scalar>& positions,
+                                 packed_scalar_t<typename Derived::Scalar>& values,
+                                 packed_vector2_t<typename Derived::Scalar>& gradients) {
+  packed_vector2_t<typename Derived::Scalar> referenceCorners;
+  packed_corners_t<typename Derived::Scalar> cornerValues;
+  gatherCells(resolution, gridOrigin, grid, positions, referenceCorners, cornerValues);
+  getLinearApproximations(resolution, referenceCorners, cornerValues, positions, values, gradients);
+}
+
 }  // namespace bilinear_interpolation
 }  // namespace ocs2
@@ -0,0 +1,260 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_perceptive/distance_transform/GridDistanceTransform.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+GridDistanceTransform::GridDistanceTransform(Config config) : config_(std::move(config)) {
+  if (config_.sizeX < 2 || config_.sizeY < 2 || config_.sizeZ < 2) {
+    throw std::runtime_error("[GridDistanceTransform] The grid should have at least two voxels along each axis!");
+  }
+  if (config_.resolution <= 0.0) {
+    throw std::runtime_error("[GridDistanceTransform] The resolution should be positive!");
+  }
+  data_.resize(config_.sizeX * config_.sizeY * config_.sizeZ, 0.0);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GridDistanceTransform::set(std::ptrdiff_t originX, std::ptrdiff_t originY, const std::vector<float>& data) {
+  if (data.size() != data_.size()) {
+    throw std::runtime_error("[GridDistanceTransform] The size of the data doesn't match the grid size!");
+  }
+  originX_ = originX;
+  originY_ = originY;
+  startX_ = wrapIndex(originX, config_.sizeX);
+  startY_ = wrapIndex(originY, config_.sizeY);
+  data_ = data;  // reuses the allocated memory
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto GridDistanceTransform::getInterpolationCell(const vector3_t& p) const -> InterpolationCell {
+  const scalar_t resolutionInv = 1.0 / config_.resolution;
+  const vector3_t u((p.x() - originX_ * config_.resolution) * resolutionInv - 0.5,
+                    (p.y() - originY_ * config_.resolution) * resolutionInv - 0.5, (p.z() - config_.minZ) * resolutionInv - 0.5);
+  const std::array<size_t, 3> sizes{config_.sizeX, config_.sizeY, config_.sizeZ};
+
+  InterpolationCell cell;
+  std::array<size_t, 3> index;
+  for (size_t a = 0; a < 3; a++) {
+    const auto upperBound = static_cast<scalar_t>(sizes[a] - 1);
+    cell.isInside(a) = u(a) >= 0.0 && u(a) <= upperBound;
+    const scalar_t uClamped = std::min(std::max(u(a), 0.0), upperBound);
+    index[a] = std::min(static_cast<size_t>(uClamped), sizes[a] - 2);
+    cell.offset(a) = uClamped - static_cast<scalar_t>(index[a]);
+  }  // end of a loop
+  cell.i = index[0];
+  cell.j = index[1];
+  cell.k = index[2];
+
+  return cell;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::array<scalar_t, 8> GridDistanceTransform::getCornerValues(const InterpolationCell& cell) const {
+  // the z-axis is the innermost dimension, therefore the two values along z are adjacent in memory
+  const size_t i00 = getIndex(cell.i, cell.j, cell.k);
+  const size_t i01 = getIndex(cell.i, cell.j + 1, cell.k);
+  const size_t i10 = getIndex(cell.i + 1, cell.j, cell.k);
+  const size_t i11 = getIndex(cell.i + 1, cell.j + 1, cell.k);
+  return {data_[i00], data_[i00 + 1], data_[i01], data_[i01 + 1], data_[i10], data_[i10 + 1], data_[i11], data_[i11 + 1]};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t GridDistanceTransform::getValue(const vector3_t& p) const {
+  const auto cell = getInterpolationCell(p);
+  const auto v = getCornerValues(cell);
+  const scalar_t c00 = v[0] + cell.offset.x() * (v[4] - v[0]);
+  const scalar_t c10 = v[2] + cell.offset.x() * (v[6] - v[2]);
+  const scalar_t c01 = v[1] + cell.offset.x() * (v[5] - v[1]);
+  const scalar_t c11 = v[3] + cell.offset.x() * (v[7] - v[3]);
+  const scalar_t c0 = c00 + cell.offset.y() * (c10 - c00);
+  const scalar_t c1 = c01 + cell.offset.y() * (c11 - c01);
+  return c0 + cell.offset.z() * (c1 - c0);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto GridDistanceTransform::getProjectedPoint(const vector3_t& p) const -> vector3_t {
+  const auto distanceValueGradient = getLinearApproximation(p);
+  const scalar_t gradientNorm = distanceValueGradient.second.norm();
+  if (gradientNorm > 1e-6) {
+    return p - distanceValueGradient.first / gradientNorm * distanceValueGradient.second;
+  } else {
+    return p;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto GridDistanceTransform::getLinearApproximation(const vector3_t& p) const -> std::pair<scalar_t, vector3_t> {
+  const auto cell = getInterpolationCell(p);
+  const scalar_t tx = cell.offset.x();
+  const scalar_t ty = cell.offset.y();
+  const scalar_t tz = cell.offset.z();
+
+  const auto v = getCornerValues(cell);
+  const scalar_t v000 = v[0], v001 = v[1], v010 = v[2], v011 = v[3];
+  const scalar_t v100 = v[4], v101 = v[5], v110 = v[6], v111 = v[7];
+
+  // interpolate along x
+  const scalar_t c00 = v000 + tx * (v100 - v000);
+  const scalar_t c10 = v010 + tx * (v110 - v010);
+  const scalar_t c01 = v001 + tx * (v101 - v001);
+  const scalar_t c11 = v011 + tx * (v111 - v011);
+  // interpolate along y
+  const scalar_t c0 = c00 + ty * (c10 - c00);
+  const scalar_t c1 = c01 + ty * (c11 - c01);
+  // interpolate along z
+  const scalar_t value = c0 + tz * (c1 - c0);
+
+  const scalar_t resolutionInv = 1.0 / config_.resolution;
+  vector3_t gradient;
+  gradient.x() = ((1.0 - ty) * (1.0 - tz) * (v100 - v000) + ty * (1.0 - tz) * (v110 - v010) + (1.0 - ty) * tz * (v101 - v001) +
+                  ty * tz * (v111 - v011)) *
+                 resolutionInv;
+  gradient.y() = ((1.0 - tz) * (c10 - c00) + tz * (c11 - c01)) * resolutionInv;
+  gradient.z() = (c1 - c0) * resolutionInv;
+  // outside of the grid the field is extended with a constant value
+  for (size_t a = 0; a < 3; a++) {
+    if (!cell.isInside(a)) {
+      gradient(a) = 0.0;
+    }
+  }  // end of a loop
+
+  return {value, gradient};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GridDistanceTransform::getInterpolationBatch(const Eigen::Ref<const matrix3x_t>& points, InterpolationBatch& batch) const {
+  const auto numPoints = points.cols();
+  batch.cornerValues.resize(numPoints, 8);
+  batch.offsets.resize(numPoints, 3);
+  batch.isInside.resize(numPoints, 3);
+
+  // locate the cells and prefetch their voxel pairs, such that the gathers below find them in the cache
+  std::vector<size_t> indices(4 * numPoints);
+  for (Eigen::Index n = 0; n < numPoints; n++) {
+    const auto cell = getInterpolationCell(points.col(n));
+    batch.offsets.row(n) = cell.offset.transpose();
+    batch.isInside.row(n) = cell.isInside.transpose();
+    for (size_t c = 0; c < 4; c++) {
+      const size_t index = getIndex(cell.i + c / 2, cell.j + c % 2, cell.k);
+      indices[4 * n + c] = index;
+#if defined(__GNUC__)
+      __builtin_prefetch(&data_[index]);
+#endif
+    }  // end of c loop
+  }    // end of n loop
+
+  // gather
+  for (Eigen::Index n = 0; n < numPoints; n++) {
+    for (size_t c = 0; c < 4; c++) {
+      const size_t index = indices[4 * n + c];
+      batch.cornerValues(n, 2 * c) = data_[index];
+      batch.cornerValues(n, 2 * c + 1) = data_[index + 1];
+    }  // end of c loop
+  }    // end of n loop
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GridDistanceTransform::getValues(const Eigen::Ref<const matrix3x_t>& points, vector_t& values) const {
+  InterpolationBatch batch;
+  getInterpolationBatch(points, batch);
+
+  const auto& v = batch.cornerValues;
+  const auto tx = batch.offsets.col(0).array();
+  const auto ty = batch.offsets.col(1).array();
+  const auto tz = batch.offsets.col(2).array();
+
+  const Eigen::ArrayXd c00 = v.col(0).array() + tx * (v.col(4).array() - v.col(0).array());
+  const Eigen::ArrayXd c10 = v.col(2).array() + tx * (v.col(6).array() - v.col(2).array());
+  const Eigen::ArrayXd c01 = v.col(1).array() + tx * (v.col(5).array() - v.col(1).array());
+  const Eigen::ArrayXd c11 = v.col(3).array() + tx * (v.col(7).array() - v.col(3).array());
+  const Eigen::ArrayXd c0 = c00 + ty * (c10 - c00);
+  const Eigen::ArrayXd c1 = c01 + ty * (c11 - c01);
+  values = (c0 + tz * (c1 - c0)).matrix();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GridDistanceTransform::getLinearApproximations(const Eigen::Ref<const matrix3x_t>& points, vector_t& values,
+                                                    matrix3x_t& gradients) const {
+  InterpolationBatch batch;
+  getInterpolationBatch(points, batch);
+
+  const auto& v = batch.cornerValues;
+  const auto tx = batch.offsets.col(0).array();
+  const auto ty = batch.offsets.col(1).array();
+  const auto tz = batch.offsets.col(2).array();
+
+  const Eigen::ArrayXd c00 = v.col(0).array() + tx * (v.col(4).array() - v.col(0).array());
+  const Eigen::ArrayXd c10 = v.col(2).array() + tx * (v.col(6).array() - v.col(2).array());
+  const Eigen::ArrayXd c01 = v.col(1).array() + tx * (v.col(5).array() - v.col(1).array());
+  const Eigen::ArrayXd c11 = v.col(3).array() + tx * (v.col(7).array() - v.col(3).array());
+  const Eigen::ArrayXd c0 = c00 + ty * (c10 - c00);
+  const Eigen::ArrayXd c1 = c01 + ty * (c11 - c01);
+  values = (c0 + tz * (c1 - c0)).matrix();
+
+  const scalar_t resolutionInv = 1.0 / config_.resolution;
+  const Eigen::ArrayXd dx = (1.0 - ty) * (1.0 - tz) * (v.col(4).array() - v.col(0).array()) +
+                            ty * (1.0 - tz) * (v.col(6).array() - v.col(2).array()) +
+                            (1.0 - ty) * tz * (v.col(5).array() - v.col(1).array()) + ty * tz * (v.col(7).array() - v.col(3).array());
+  const Eigen::ArrayXd dy = (1.0 - tz) * (c10 - c00) + tz * (c11 - c01);
+  gradients.resize(3, points.cols());
+  gradients.row(0) = resolutionInv * dx.matrix().transpose();
+  gradients.row(1) = resolutionInv * dy.matrix().transpose();
+  gradients.row(2) = resolutionInv * (c1 - c0).matrix().transpose();
+  // outside of the grid the field is extended with a constant value
+  gradients.array() *= batch.isInside.transpose().cast<scalar_t>().array();
+}
+
+}  // namespace ocs2
@@ -0,0 +1,301 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_perceptive/distance_transform/RollingDistanceTransform.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "ocs2_perceptive/distance_transform/ComputeDistanceTransform.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RollingDistanceTransform::RollingDistanceTransform(GridDistanceTransform::Config config, scalar_t maxDistance, const vector2_t& center)
+    : config_(std::move(config)),
+      maxDistance_(maxDistance),
+      maxDistanceInCells_(static_cast<std::ptrdiff_t>(std::ceil(maxDistance / config_.resolution))),
+      sizeX_(static_cast<std::ptrdiff_t>(config_.sizeX)),
+      sizeY_(static_cast<std::ptrdiff_t>(config_.sizeY)) {
+  if (maxDistance_ <= 0.0) {
+    throw std::runtime_error("[RollingDistanceTransform] maxDistance should be positive!");
+  }
+
+  originX_ = getCellIndex(center.x()) - sizeX_ / 2;
+  originY_ = getCellIndex(center.y()) - sizeY_ / 2;
+  elevation_.assign(config_.sizeX * config_.sizeY, -std::numeric_limits<scalar_t>::infinity());
+  distance_.assign(config_.sizeX * config_.sizeY * config_.sizeZ, static_cast<float>(maxDistance_));
+  publish();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RollingDistanceTransform::reset(const vector2_t& center, const elevation_function_t& getElevation) {
+  originX_ = getCellIndex(center.x()) - sizeX_ / 2;
+  originY_ = getCellIndex(center.y()) - sizeY_ / 2;
+  fillElevation(getWindow(), getElevation);
+
+  changedBoxes_.assign(1, getWindow());
+  changedCellsBox_ = Box{0, 0, 0, 0};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RollingDistanceTransform::moveTo(const vector2_t& center, const elevation_function_t& getElevation) {
+  const auto newOriginX = getCellIndex(center.x()) - sizeX_ / 2;
+  const auto newOriginY = getCellIndex(center.y()) - sizeY_ / 2;
+  const auto shiftX = newOriginX - originX_;
+  const auto shiftY = newOriginY - originY_;
+
+  if (shiftX == 0 && shiftY == 0) {
+    return;
+  } else if (std::abs(shiftX) >= sizeX_ || std::abs(shiftY) >= sizeY_) {
+    reset(center, getElevation);
+    return;
+  }
+
+  const Box oldWindow = getWindow();
+  originX_ = newOriginX;
+  originY_ = newOriginY;
+  const Box newWindow = getWindow();
+
+  // The newly exposed strips occupy the same memory as the cells which left the window. The x-strip spans the whole
+  // window along y, and the y-strip covers the remaining columns.
+  Box exposedX{0, 0, 0, 0}, leftX{0, 0, 0, 0};
+  if (shiftX > 0) {
+    exposedX = Box{oldWindow.x1, newWindow.y0, newWindow.x1, newWindow.y1};
+    leftX = Box{oldWindow.x0, oldWindow.y0, newWindow.x0, oldWindow.y1};
+  } else if (shiftX < 0) {
+    exposedX = Box{newWindow.x0, newWindow.y0, oldWindow.x0, newWindow.y1};
+    leftX = Box{newWindow.x1, oldWindow.y0, oldWindow.x1, oldWindow.y1};
+  }
+
+  const auto commonX0 = std::max(oldWindow.x0, newWindow.x0);
+  const auto commonX1 = std::min(oldWindow.x1, newWindow.x1);
+  Box exposedY{0, 0, 0, 0}, leftY{0, 0, 0, 0};
+  if (shiftY > 0) {
+    exposedY = Box{commonX0, oldWindow.y1, commonX1, newWindow.y1};
+    leftY = Box{oldWindow.x0, oldWindow.y0, oldWindow.x1, newWindow.y0};
+  } else if (shiftY < 0) {
+    exposedY = Box{commonX0, newWindow.y0, commonX1, oldWindow.y0};
+    leftY = Box{oldWindow.x0, newWindow.y1, oldWindow.x1, oldWindow.y1};
+  }
+
+  fillElevation(exposedX, getElevation);
+  fillElevation(exposedY, getElevation);
+
+  // the cells which left the window influence the distances of the cells close to the opposite border
+  for (const auto& box : {exposedX, exposedY, leftX, leftY}) {
+    if (!box.isEmpty()) {
+      changedBoxes_.push_back(box);
+    }
+  }  // end of box loop
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RollingDistanceTransform::setElevation(const vector2_t& position, scalar_t elevation) {
+  const auto ix = getCellIndex(position.x());
+  const auto iy = getCellIndex(position.y());
+  const Box window = getWindow();
+  if (ix < window.x0 || ix >= window.x1 || iy < window.y0 || iy >= window.y1) {
+    return;
+  }
+
+  auto& cellElevation = elevation_[GridDistanceTransform::wrapIndex(ix, config_.sizeX) * config_.sizeY +
+                                   GridDistanceTransform::wrapIndex(iy, config_.sizeY)];
+  if (cellElevation == elevation) {
+    return;
+  }
+  cellElevation = elevation;
+
+  if (changedCellsBox_.isEmpty()) {
+    changedCellsBox_ = Box{ix, iy, ix + 1, iy + 1};
+  } else {
+    changedCellsBox_.x0 = std::min(changedCellsBox_.x0, ix);
+    changedCellsBox_.y0 = std::min(changedCellsBox_.y0, iy);
+    changedCellsBox_.x1 = std::max(changedCellsBox_.x1, ix + 1);
+    changedCellsBox_.y1 = std::max(changedCellsBox_.y1, iy + 1);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RollingDistanceTransform::update() {
+  if (!changedCellsBox_.isEmpty()) {
+    changedBoxes_.push_back(changedCellsBox_);
+    changedCellsBox_ = Box{0, 0, 0, 0};
+  }
+
+  // the region which is influenced by the changed cells
+  const Box window = getWindow();
+  std::vector<Box> targets;
+  size_t targetsArea = 0;
+  for (const auto& box : changedBoxes_) {
+    const auto target = dilateAndClip(box, maxDistanceInCells_);
+    if (!target.isEmpty()) {
+      targets.push_back(target);
+      targetsArea += target.area();
+    }
+  }  // end of box loop
+  changedBoxes_.clear();
+
+  numRecomputedVoxels_ = 0;
+  if (targets.empty()) {
+    return;
+  } else if (targetsArea >= window.area()) {
+    targets.assign(1, window);
+  }
+
+  for (const auto& target : targets) {
+    recompute(target, dilateAndClip(target, maxDistanceInCells_));
+    numRecomputedVoxels_ += target.area() * config_.sizeZ;
+  }  // end of target loop
+
+  publish();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<const GridDistanceTransform> RollingDistanceTransform::getSnapshot() const {
+  std::lock_guard<std::mutex> lock(snapshotMutex_);
+  return frontSnapshotPtr_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::ptrdiff_t RollingDistanceTransform::getCellIndex(scalar_t coordinate) const {
+  return static_cast<std::ptrdiff_t>(std::floor(coordinate / config_.resolution));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto RollingDistanceTransform::dilateAndClip(const Box& box, std::ptrdiff_t margin) const -> Box {
+  const Box window = getWindow();
+  return Box{std::max(box.x0 - margin, window.x0), std::max(box.y0 - margin, window.y0), std::min(box.x1 + margin, window.x1),
+             std::min(box.y1 + margin, window.y1)};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RollingDistanceTransform::fillElevation(const Box& box, const elevation_function_t& getElevation) {
+  for (auto ix = box.x0; ix < box.x1; ix++) {
+    const size_t x = GridDistanceTransform::wrapIndex(ix, config_.sizeX);
+    for (auto iy = box.y0; iy < box.y1; iy++) {
+      const vector2_t cellCenter((ix + 0.5) * config_.resolution, (iy + 0.5) * config_.resolution);
+      elevation_[x * config_.sizeY + GridDistanceTransform::wrapIndex(iy, config_.sizeY)] = getElevation(cellCenter);
+    }  // end of iy loop
+  }    // end of ix loop
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+float RollingDistanceTransform::getColumnSquaredDistance(std::ptrdiff_t ix, std::ptrdiff_t iy, size_t k) const {
+  const scalar_t elevation =
+      elevation_[GridDistanceTransform::wrapIndex(ix, config_.sizeX) * config_.sizeY + GridDistanceTransform::wrapIndex(iy, config_.sizeY)];
+  // the index of the highest voxel whose center is below the terrain (it can be negative or -infinity)
+  const scalar_t terrainIndex = std::floor((elevation - config_.minZ) / config_.resolution - 0.5);
+  const scalar_t distance = static_cast<scalar_t>(k) - terrainIndex;
+  const auto cap = static_cast<scalar_t>(maxDistanceInCells_ + 1);
+
+  if (distance <= 0.0) {
+    return 0.0;
+  } else if (distance < cap) {
+    return static_cast<float>(distance * distance);
+  } else {  // also unknown (NaN) elevations
+    return static_cast<float>(cap * cap);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RollingDistanceTransform::recompute(const Box& target, const Box& source) {
+  const auto numSourceX = static_cast<size_t>(source.x1 - source.x0);
+  const auto numSourceY = static_cast<size_t>(source.y1 - source.y0);
+  squaredDistanceBuffer_.resize(numSourceX * numSourceY);
+
+  // The separable distance transform: the z-pass is analytical since each column is occupied up to its elevation. The
+  // truncation guarantees that the nearest occupied voxel of any target voxel with distance below maxDistance is inside
+  // the source box.
+  for (size_t k = 0; k < config_.sizeZ; k++) {
+    // y-pass over the whole source box
+    for (size_t a = 0; a < numSourceX; a++) {
+      const auto ix = source.x0 + static_cast<std::ptrdiff_t>(a);
+      auto getValue = [&](size_t b) { return getColumnSquaredDistance(ix, source.y0 + static_cast<std::ptrdiff_t>(b), k); };
+      auto setValue = [&](size_t b, float val) { squaredDistanceBuffer_[a * numSourceY + b] = val; };
+      computeDistanceTransform(numSourceY, getValue, setValue, 0, numSourceY, vBuffer_, zBuffer_);
+    }  // end of a loop
+
+    // x-pass only over the target rows
+    for (auto iy = target.y0; iy < target.y1; iy++) {
+      const auto b = static_cast<size_t>(iy - source.y0);
+      const size_t y = GridDistanceTransform::wrapIndex(iy, config_.sizeY);
+      auto getValue = [&](size_t a) { return squaredDistanceBuffer_[a * numSourceY + b]; };
+      auto setValue = [&](size_t a, float val) {
+        const auto ix = source.x0 + static_cast<std::ptrdiff_t>(a);
+        if (ix >= target.x0 && ix < target.x1) {
+          const size_t x = GridDistanceTransform::wrapIndex(ix, config_.sizeX);
+          const auto distance = std::min(std::sqrt(val) * config_.resolution, maxDistance_);
+          distance_[(x * config_.sizeY + y) * config_.sizeZ + k] = static_cast<float>(distance);
+        }
+      };
+      computeDistanceTransform(numSourceX, getValue, setValue, 0, numSourceX, vBuffer_, zBuffer_);
+    }  // end of iy loop
+  }    // end of k loop
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RollingDistanceTransform::publish() {
+  // a snapshot which is still held by a reader is not reused
+  if (backSnapshotPtr_ == nullptr || backSnapshotPtr_.use_count() > 1) {
+    backSnapshotPtr_ = std::make_shared<GridDistanceTransform>(config_);
+  }
+  backSnapshotPtr_->set(originX_, originY_, distance_);
+
+  std::lock_guard<std::mutex> lock(snapshotMutex_);
+  std::swap(frontSnapshotPtr_, backSnapshotPtr_);
+}
+
+}  // namespace ocs2
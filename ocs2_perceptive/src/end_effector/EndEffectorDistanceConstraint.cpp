@@ -66,12 +66,15 @@ EndEffectorDistanceConstraint::EndEffectorDistanceConstraint(const EndEffectorDi
       stateDim_(other.stateDim_),
       weight_(other.weight_),
       kinematicsPtr_(other.kinematicsPtr_->clone()),
-      clearances_(other.clearances_) {}
+      clearances_(other.clearances_),
+      distanceTransformPtr_(other.distanceTransformSnapshotPtr_.get()),
+      distanceTransformSnapshotPtr_(other.distanceTransformSnapshotPtr_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void EndEffectorDistanceConstraint::set(const DistanceTransformInterface& distanceTransform) {
+  distanceTransformSnapshotPtr_.reset();
   distanceTransformPtr_ = &distanceTransform;
 }
 
@@ -80,6 +83,7 @@ void EndEffectorDistanceConstraint::set(const DistanceTransformInterface& distan
 /******************************************************************************************************/
 void EndEffectorDistanceConstraint::set(scalar_t clearance, const DistanceTransformInterface& distanceTransform) {
   clearances_.assign(kinematicsPtr_->getIds().size(), clearance);
+  distanceTransformSnapshotPtr_.reset();
   distanceTransformPtr_ = &distanceTransform;
 }
 
@@ -89,9 +93,19 @@ void EndEffectorDistanceConstraint::set(scalar_t clearance, const DistanceTransf
 void EndEffectorDistanceConstraint::set(const scalar_array_t& clearances, const DistanceTransformInterface& distanceTransform) {
   assert(clearances.size() == kinematicsPtr_->getIds().size());
   clearances_ = clearances;
+  distanceTransformSnapshotPtr_.reset();
   distanceTransformPtr_ = &distanceTransform;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void EndEffectorDistanceConstraint::set(scalar_t clearance, std::shared_ptr<const DistanceTransformInterface> distanceTransformPtr) {
+  clearances_.assign(kinematicsPtr_->getIds().size(), clearance);
+  distanceTransformSnapshotPtr_ = std::move(distanceTransformPtr);
+  distanceTransformPtr_ = distanceTransformSnapshotPtr_.get();
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -103,12 +117,16 @@ vector_t EndEffectorDistanceConstraint::getValue(scalar_t time, const vector_t&
   const auto numEEs = kinematicsPtr_->getIds().size();
   const auto eePositions = kinematicsPtr_->getPosition(state);
 
-  vector_t g(numEEs);
+  DistanceTransformInterface::matrix3x_t points(3, numEEs);
   for (size_t i = 0; i < numEEs; i++) {
-    g(i) = weight_ * (distanceTransformPtr_->getValue(eePositions[i]) - clearances_[i]);
+    points.col(i) = eePositions[i];
   }  // end of i loop
 
-  return g;
+  vector_t distances;
+  distanceTransformPtr_->getValues(points, distances);
+  const Eigen::Map<const vector_t> clearances(clearances_.data(), numEEs);
+
+  return weight_ * (distances - clearances);
 }
 
 /******************************************************************************************************/
@@ -123,11 +141,20 @@ VectorFunctionLinearApproximation EndEffectorDistanceConstraint::getLinearApprox
   const auto numEEs = kinematicsPtr_->getIds().size();
   const auto eePosLinApprox = kinematicsPtr_->getPositionLinearApproximation(state);
 
+  DistanceTransformInterface::matrix3x_t points(3, numEEs);
+  for (size_t i = 0; i < numEEs; i++) {
+    points.col(i) = eePosLinApprox[i].f;
+  }  // end of i loop
+
+  vector_t distances;
+  DistanceTransformInterface::matrix3x_t gradients;
+  distanceTransformPtr_->getLinearApproximations(points, distances, gradients);
+  const Eigen::Map<const vector_t> clearances(clearances_.data(), numEEs);
+
   VectorFunctionLinearApproximation approx = VectorFunctionLinearApproximation::Zero(numEEs, stateDim_, 0);
+  approx.f = weight_ * (distances - clearances);
   for (size_t i = 0; i < numEEs; i++) {
-    const auto distanceValueGradient = distanceTransformPtr_->getLinearApproximation(eePosLinApprox[i].f);
-    approx.f(i) = weight_ * (distanceValueGradient.first - clearances_[i]);
-    approx.dfdx.row(i).noalias() = weight_ * (distanceValueGradient.second.transpose() * eePosLinApprox[i].dfdx);
+    approx.dfdx.row(i).noalias() = weight_ * (gradients.col(i).transpose() * eePosLinApprox[i].dfdx);
   }  // end of i loop
 
   return approx;
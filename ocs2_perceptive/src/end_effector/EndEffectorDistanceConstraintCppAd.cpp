@@ -72,7 +72,9 @@ EndEffectorDistanceConstraintCppAd::EndEffectorDistanceConstraintCppAd(const End
       inputDim_(other.inputDim_),
       config_(other.config_),
       adKinematicsPtr_(other.adKinematicsPtr_->clone()),
-      kinematicsModelPtr_(new CppAdInterface(*other.kinematicsModelPtr_)) {}
+      kinematicsModelPtr_(new CppAdInterface(*other.kinematicsModelPtr_)),
+      distanceTransformPtr_(other.distanceTransformSnapshotPtr_.get()),
+      distanceTransformSnapshotPtr_(other.distanceTransformSnapshotPtr_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -80,6 +82,7 @@ EndEffectorDistanceConstraintCppAd::EndEffectorDistanceConstraintCppAd(const End
 void EndEffectorDistanceConstraintCppAd::set(scalar_t clearance, const DistanceTransformInterface& distanceTransform) {
   const auto numEEs = adKinematicsPtr_->getIds().size();
   clearances_ = vector_t::Ones(numEEs) * clearance;
+  distanceTransformSnapshotPtr_.reset();
   distanceTransformPtr_ = &distanceTransform;
 }
 
@@ -94,9 +97,20 @@ void EndEffectorDistanceConstraintCppAd::set(vector_t clearances, const Distance
   }
 
   clearances_ = clearances;
+  distanceTransformSnapshotPtr_.reset();
   distanceTransformPtr_ = &distanceTransform;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void EndEffectorDistanceConstraintCppAd::set(scalar_t clearance, std::shared_ptr<const DistanceTransformInterface> distanceTransformPtr) {
+  const auto numEEs = adKinematicsPtr_->getIds().size();
+  clearances_ = vector_t::Ones(numEEs) * clearance;
+  distanceTransformSnapshotPtr_ = std::move(distanceTransformPtr);
+  distanceTransformPtr_ = distanceTransformSnapshotPtr_.get();
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -106,12 +120,11 @@ vector_t EndEffectorDistanceConstraintCppAd::getValue(scalar_t time, const vecto
   const auto eePositions = kinematicsModelPtr_->getFunctionValue(state);
   assert(eePositions.size() == 3 * numEEs);
 
-  vector_t g(numEEs);
-  for (size_t i = 0; i < numEEs; i++) {
-    g(i) = config_.weight * (distanceTransformPtr_->getValue(eePositions.segment<3>(3 * i)) - clearances_[i]);
-  }  // end of i loop
+  // the positions are stacked, therefore they can be viewed as a (3 x numEEs) matrix
+  vector_t distances;
+  distanceTransformPtr_->getValues(Eigen::Map<const DistanceTransformInterface::matrix3x_t>(eePositions.data(), 3, numEEs), distances);
 
-  return g;
+  return config_.weight * (distances - clearances_);
 }
 
 /******************************************************************************************************/
@@ -127,11 +140,15 @@ VectorFunctionLinearApproximation EndEffectorDistanceConstraintCppAd::getLinearA
   assert(eeJacobians.rows() == 3 * numEEs);
   assert(eeJacobians.cols() == stateDim_);
 
+  vector_t distances;
+  DistanceTransformInterface::matrix3x_t gradients;
+  distanceTransformPtr_->getLinearApproximations(Eigen::Map<const DistanceTransformInterface::matrix3x_t>(eePositions.data(), 3, numEEs),
+                                                 distances, gradients);
+
   VectorFunctionLinearApproximation approx = VectorFunctionLinearApproximation::Zero(numEEs, stateDim_, inputDim_);
+  approx.f = config_.weight * (distances - clearances_);
   for (size_t i = 0; i < numEEs; i++) {
-    const auto distanceValueGradient = distanceTransformPtr_->getLinearApproximation(eePositions.segment<3>(3 * i));
-    approx.f(i) = config_.weight * (distanceValueGradient.first - clearances_[i]);
-    approx.dfdx.row(i).noalias() = config_.weight * (distanceValueGradient.second.transpose() * eeJacobians.middleRows<3>(3 * i));
+    approx.dfdx.row(i).noalias() = config_.weight * (gradients.col(i).transpose() * eeJacobians.middleRows<3>(3 * i));
   }  // end of i loop
 
   return approx;
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_perceptive/distance_transform/ComputeDistanceTransform.h>
 #include <ocs2_perceptive/distance_transform/DistanceTransformInterface.h>
+#include <ocs2_perceptive/distance_transform/GridDistanceTransform.h>
+#include <ocs2_perceptive/distance_transform/RollingDistanceTransform.h>
 
 #include <ocs2_perceptive/end_effector/EndEffectorDistanceConstraint.h>
 #include <ocs2_perceptive/end_effector/EndEffectorDistanceConstraintCppAd.h>
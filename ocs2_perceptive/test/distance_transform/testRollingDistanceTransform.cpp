@@ -0,0 +1,228 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include "ocs2_perceptive/distance_transform/RollingDistanceTransform.h"
+
+namespace ocs2 {
+
+class TestRollingDistanceTransform : public ::testing::Test {
+ protected:
+  using vector2_t = RollingDistanceTransform::vector2_t;
+  using vector3_t = GridDistanceTransform::vector3_t;
+
+  TestRollingDistanceTransform() {
+    config.resolution = resolution;
+    config.sizeX = 24;
+    config.sizeY = 20;
+    config.sizeZ = 8;
+    config.minZ = -0.1;
+  }
+
+  /** A terrain with a few boxes and an unknown area. */
+  static scalar_t getElevation(const vector2_t& p) {
+    if (p.x() > 0.3 && p.x() < 0.45 && p.y() > -0.2 && p.y() < 0.1) {
+      return 0.15;
+    } else if (p.x() > -0.6 && p.x() < -0.5 && p.y() > 0.2) {
+      return 0.25;
+    } else if (p.x() > 1.0 && p.x() < 1.2 && p.y() > 0.5 && p.y() < 0.7) {
+      return -std::numeric_limits<scalar_t>::infinity();
+    } else {
+      return 0.02 * std::sin(5.0 * p.x()) * std::cos(3.0 * p.y());
+    }
+  }
+
+  /** Brute-force truncated distance of voxel (i, j, k) of the snapshot's window. */
+  scalar_t getTrueDistance(const GridDistanceTransform& snapshot, std::ptrdiff_t i, std::ptrdiff_t j, std::ptrdiff_t k) const {
+    scalar_t squaredDistance = std::numeric_limits<scalar_t>::max();
+    for (std::ptrdiff_t ii = 0; ii < static_cast<std::ptrdiff_t>(config.sizeX); ii++) {
+      for (std::ptrdiff_t jj = 0; jj < static_cast<std::ptrdiff_t>(config.sizeY); jj++) {
+        const vector2_t cellCenter((snapshot.getOriginX() + ii + 0.5) * resolution, (snapshot.getOriginY() + jj + 0.5) * resolution);
+        const scalar_t terrainIndex = std::floor((getElevation(cellCenter) - config.minZ) / resolution - 0.5);
+        const scalar_t dz = std::max(static_cast<scalar_t>(k) - terrainIndex, 0.0);
+        squaredDistance = std::min(squaredDistance, static_cast<scalar_t>((i - ii) * (i - ii) + (j - jj) * (j - jj)) + dz * dz);
+      }
+    }
+    return std::min(std::sqrt(squaredDistance) * resolution, maxDistance);
+  }
+
+  /** Checks whether all voxels of the two snapshots are the same. */
+  bool isEqual(const GridDistanceTransform& lhs, const GridDistanceTransform& rhs) const {
+    if (lhs.getOriginX() != rhs.getOriginX() || lhs.getOriginY() != rhs.getOriginY()) {
+      return false;
+    }
+    for (size_t i = 0; i < config.sizeX; i++) {
+      for (size_t j = 0; j < config.sizeY; j++) {
+        for (size_t k = 0; k < config.sizeZ; k++) {
+          if (std::abs(lhs.getVoxelValue(i, j, k) - rhs.getVoxelValue(i, j, k)) > precision) {
+            return false;
+          }
+        }
+      }
+    }
+    return true;
+  }
+
+  static constexpr scalar_t resolution = 0.05;
+  static constexpr scalar_t maxDistance = 0.2;
+  static constexpr scalar_t precision = 1e-5;
+  GridDistanceTransform::Config config;
+};
+
+constexpr scalar_t TestRollingDistanceTransform::resolution;
+constexpr scalar_t TestRollingDistanceTransform::maxDistance;
+constexpr scalar_t TestRollingDistanceTransform::precision;
+
+TEST_F(TestRollingDistanceTransform, bruteForce) {
+  RollingDistanceTransform rollingDistanceTransform(config, maxDistance, vector2_t(0.4, 0.0));
+  rollingDistanceTransform.reset(vector2_t(0.4, 0.0), getElevation);
+  rollingDistanceTransform.update();
+  const auto snapshotPtr = rollingDistanceTransform.getSnapshot();
+
+  for (size_t i = 0; i < config.sizeX; i++) {
+    for (size_t j = 0; j < config.sizeY; j++) {
+      for (size_t k = 0; k < config.sizeZ; k++) {
+        const scalar_t trueDistance = getTrueDistance(*snapshotPtr, i, j, k);
+        ASSERT_NEAR(snapshotPtr->getVoxelValue(i, j, k), trueDistance, precision) << "at voxel (" << i << ", " << j << ", " << k << ")";
+      }
+    }
+  }
+}
+
+TEST_F(TestRollingDistanceTransform, moveWindow) {
+  const std::vector<vector2_t> trajectory{{0.0, 0.0}, {0.12, 0.03}, {0.31, -0.1}, {0.2, -0.4}, {-0.5, 0.3}, {-0.45, 0.33}, {1.1, 0.6}};
+
+  RollingDistanceTransform rollingDistanceTransform(config, maxDistance, trajectory.front());
+  rollingDistanceTransform.reset(trajectory.front(), getElevation);
+  rollingDistanceTransform.update();
+  const size_t numVoxels = config.sizeX * config.sizeY * config.sizeZ;
+  EXPECT_EQ(rollingDistanceTransform.getNumRecomputedVoxels(), numVoxels);
+
+  for (const auto& center : trajectory) {
+    rollingDistanceTransform.moveTo(center, getElevation);
+    rollingDistanceTransform.update();
+
+    RollingDistanceTransform fullDistanceTransform(config, maxDistance, center);
+    fullDistanceTransform.reset(center, getElevation);
+    fullDistanceTransform.update();
+
+    EXPECT_TRUE(isEqual(*rollingDistanceTransform.getSnapshot(), *fullDistanceTransform.getSnapshot()));
+  }
+
+  // a small move only recomputes the influence region of the exposed strip
+  rollingDistanceTransform.moveTo(trajectory.back() + vector2_t(resolution, 0.0), getElevation);
+  rollingDistanceTransform.update();
+  EXPECT_LT(rollingDistanceTransform.getNumRecomputedVoxels(), numVoxels);
+}
+
+TEST_F(TestRollingDistanceTransform, setElevation) {
+  const vector2_t center(0.0, 0.0);
+  const vector2_t obstacle(0.125, 0.125);  // a cell center
+  auto getElevationWithObstacle = [&](const vector2_t& p) {
+    return (p - obstacle).cwiseAbs().maxCoeff() < 0.5 * resolution ? 0.3 : getElevation(p);
+  };
+
+  RollingDistanceTransform rollingDistanceTransform(config, maxDistance, center);
+  rollingDistanceTransform.reset(center, getElevation);
+  rollingDistanceTransform.update();
+
+  rollingDistanceTransform.setElevation(obstacle, getElevationWithObstacle(obstacle));
+  rollingDistanceTransform.update();
+  EXPECT_LT(rollingDistanceTransform.getNumRecomputedVoxels(), config.sizeX * config.sizeY * config.sizeZ);
+
+  RollingDistanceTransform fullDistanceTransform(config, maxDistance, center);
+  fullDistanceTransform.reset(center, getElevationWithObstacle);
+  fullDistanceTransform.update();
+
+  EXPECT_TRUE(isEqual(*rollingDistanceTransform.getSnapshot(), *fullDistanceTransform.getSnapshot()));
+}
+
+TEST_F(TestRollingDistanceTransform, snapshot) {
+  RollingDistanceTransform rollingDistanceTransform(config, maxDistance, vector2_t::Zero());
+  rollingDistanceTransform.reset(vector2_t::Zero(), getElevation);
+  rollingDistanceTransform.update();
+
+  // the held snapshot is not modified by the updates
+  const auto snapshotPtr = rollingDistanceTransform.getSnapshot();
+  const vector3_t p(0.05, 0.0, 0.1);
+  const scalar_t value = snapshotPtr->getValue(p);
+  for (size_t i = 1; i < 4; i++) {
+    rollingDistanceTransform.moveTo(vector2_t(0.2 * i, 0.0), getElevation);
+    rollingDistanceTransform.update();
+  }
+  EXPECT_NE(rollingDistanceTransform.getSnapshot(), snapshotPtr);
+  EXPECT_DOUBLE_EQ(snapshotPtr->getValue(p), value);
+
+  // linear approximation is consistent with finite differences
+  const auto newSnapshotPtr = rollingDistanceTransform.getSnapshot();
+  const vector3_t q(0.63, 0.02, 0.13);
+  const auto linApprox = newSnapshotPtr->getLinearApproximation(q);
+  EXPECT_NEAR(linApprox.first, newSnapshotPtr->getValue(q), precision);
+  const scalar_t eps = 1e-6;
+  for (size_t a = 0; a < 3; a++) {
+    const vector3_t dq = vector3_t::Unit(a) * eps;
+    const scalar_t finiteDifference = (newSnapshotPtr->getValue(q + dq) - newSnapshotPtr->getValue(q - dq)) / (2.0 * eps);
+    EXPECT_NEAR(linApprox.second(a), finiteDifference, 1e-4);
+  }
+}
+
+TEST_F(TestRollingDistanceTransform, batchQueries) {
+  RollingDistanceTransform rollingDistanceTransform(config, maxDistance, vector2_t(0.4, 0.0));
+  rollingDistanceTransform.reset(vector2_t(0.4, 0.0), getElevation);
+  rollingDistanceTransform.update();
+  const auto snapshotPtr = rollingDistanceTransform.getSnapshot();
+
+  // random points inside and around the window
+  constexpr size_t numPoints = 100;
+  DistanceTransformInterface::matrix3x_t points = DistanceTransformInterface::matrix3x_t::Random(3, numPoints);
+  points.row(0) = 0.4 + 0.8 * points.row(0).array();
+  points.row(1) = 0.6 * points.row(1).array();
+  points.row(2) = 0.1 + 0.3 * points.row(2).array();
+
+  vector_t values, batchValues;
+  DistanceTransformInterface::matrix3x_t gradients;
+  snapshotPtr->getValues(points, values);
+  snapshotPtr->getLinearApproximations(points, batchValues, gradients);
+  ASSERT_EQ(values.size(), numPoints);
+  ASSERT_EQ(gradients.cols(), numPoints);
+
+  for (size_t i = 0; i < numPoints; i++) {
+    const auto linApprox = snapshotPtr->getLinearApproximation(points.col(i));
+    EXPECT_NEAR(values(i), snapshotPtr->getValue(points.col(i)), precision);
+    EXPECT_NEAR(batchValues(i), linApprox.first, precision);
+    EXPECT_TRUE(gradients.col(i).isApprox(linApprox.second, precision)) << "at point " << points.col(i).transpose();
+  }
+}
+
+}  // namespace ocs2
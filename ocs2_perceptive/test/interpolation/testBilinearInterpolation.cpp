@@ -27,13 +27,17 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <iostream>
 #include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
+#include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/misc/Numerics.h>
 
 #include "ocs2_perceptive/interpolation/BilinearInterpolation.h"
@@ -154,5 +158,120 @@ TEST_F(TestBilinearInterpolation, testBilinearInterpolation) {
   }  // end of i loop
 }
 
+TEST(TestBilinearInterpolationBatch, testBatchKernels) {
+  constexpr size_t numPoints = 101;  // not a multiple of the packet size
+  constexpr scalar_t resolution = 0.05;
+  constexpr scalar_t precision = 1e-9;
+
+  const packed_vector2_t<scalar_t> positions = packed_vector2_t<scalar_t>::Random(numPoints, 2);
+  const packed_vector2_t<scalar_t> referenceCorners = packed_vector2_t<scalar_t>::Random(numPoints, 2);
+  const packed_corners_t<scalar_t> cornerValues = packed_corners_t<scalar_t>::Random(numPoints, 4);
+
+  packed_scalar_t<scalar_t> values, linApproxValues;
+  packed_vector2_t<scalar_t> gradients;
+  getValues(resolution, referenceCorners, cornerValues, positions, values);
+  getLinearApproximations(resolution, referenceCorners, cornerValues, positions, linApproxValues, gradients);
+
+  for (size_t i = 0; i < numPoints; i++) {
+    const Eigen::Matrix<scalar_t, 2, 1> position = positions.row(i).transpose();
+    const Eigen::Matrix<scalar_t, 2, 1> referenceCorner = referenceCorners.row(i).transpose();
+    const std::array<scalar_t, 4> corners = {cornerValues(i, 0), cornerValues(i, 1), cornerValues(i, 2), cornerValues(i, 3)};
+
+    const auto trueValue = getValue(resolution, referenceCorner, corners, position);
+    const auto trueLinApprox = getLinearApproximation(resolution, referenceCorner, corners, position);
+
+    EXPECT_NEAR(values(i), trueValue, precision * (1.0 + std::abs(trueValue)));
+    EXPECT_NEAR(linApproxValues(i), trueLinApprox.first, precision * (1.0 + std::abs(trueValue)));
+    EXPECT_TRUE(gradients.row(i).transpose().isApprox(trueLinApprox.second, precision));
+  }  // end of i loop
+}
+
+TEST(TestBilinearInterpolationBatch, testGridLayouts) {
+  constexpr size_t numPoints = 100;
+  constexpr scalar_t resolution = 0.1;
+  constexpr scalar_t precision = 1e-9;
+  const Eigen::Matrix<scalar_t, 2, 1> gridOrigin(-1.0, -0.5);
+
+  using col_major_grid_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>;
+  using row_major_grid_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+  const col_major_grid_t colMajorGrid = col_major_grid_t::Random(21, 11);
+  const row_major_grid_t rowMajorGrid = colMajorGrid;
+
+  // include points outside of the grid
+  packed_vector2_t<scalar_t> positions = packed_vector2_t<scalar_t>::Random(numPoints, 2);
+  positions.col(0) *= 1.2;
+  positions.col(1) = 0.6 * (positions.col(1).array() + 0.5);
+
+  packed_scalar_t<scalar_t> colMajorValues, rowMajorValues;
+  packed_vector2_t<scalar_t> colMajorGradients, rowMajorGradients;
+  getGridLinearApproximations(resolution, gridOrigin, colMajorGrid, positions, colMajorValues, colMajorGradients);
+  getGridLinearApproximations(resolution, gridOrigin, rowMajorGrid, positions, rowMajorValues, rowMajorGradients);
+
+  packed_scalar_t<scalar_t> values;
+  getGridValues(resolution, gridOrigin, rowMajorGrid, positions, values);
+
+  for (size_t k = 0; k < numPoints; k++) {
+    const Eigen::Matrix<scalar_t, 2, 1> position = positions.row(k).transpose();
+    const Eigen::Matrix<scalar_t, 2, 1> index = ((position - gridOrigin) / resolution).array().floor();
+    const size_t i = std::min<size_t>(std::max<scalar_t>(index.x(), 0.0), colMajorGrid.rows() - 2);
+    const size_t j = std::min<size_t>(std::max<scalar_t>(index.y(), 0.0), colMajorGrid.cols() - 2);
+    const Eigen::Matrix<scalar_t, 2, 1> referenceCorner = gridOrigin + resolution * Eigen::Matrix<scalar_t, 2, 1>(i, j);
+    const std::array<scalar_t, 4> corners = {colMajorGrid(i, j), colMajorGrid(i + 1, j), colMajorGrid(i, j + 1),
+                                             colMajorGrid(i + 1, j + 1)};
+
+    const auto trueLinApprox = getLinearApproximation(resolution, referenceCorner, corners, position);
+
+    EXPECT_NEAR(colMajorValues(k), trueLinApprox.first, precision);
+    EXPECT_NEAR(rowMajorValues(k), trueLinApprox.first, precision);
+    EXPECT_NEAR(values(k), trueLinApprox.first, precision);
+    EXPECT_TRUE(colMajorGradients.row(k).transpose().isApprox(trueLinApprox.second, precision));
+    EXPECT_TRUE(rowMajorGradients.row(k).transpose().isApprox(trueLinApprox.second, precision));
+  }  // end of k loop
+}
+
+TEST(TestBilinearInterpolationBatch, benchmark) {
+  constexpr size_t numPoints = 4096;
+  constexpr size_t numRepetitions = 2000;
+  constexpr scalar_t resolution = 0.05;
+
+  const packed_vector2_t<scalar_t> positions = packed_vector2_t<scalar_t>::Random(numPoints, 2);
+  const packed_vector2_t<scalar_t> referenceCorners = packed_vector2_t<scalar_t>::Random(numPoints, 2);
+  const packed_corners_t<scalar_t> cornerValues = packed_corners_t<scalar_t>::Random(numPoints, 4);
+
+  std::vector<Eigen::Matrix<scalar_t, 2, 1>> positionArray(numPoints), referenceCornerArray(numPoints);
+  std::vector<std::array<scalar_t, 4>> cornerValuesArray(numPoints);
+  for (size_t i = 0; i < numPoints; i++) {
+    positionArray[i] = positions.row(i).transpose();
+    referenceCornerArray[i] = referenceCorners.row(i).transpose();
+    cornerValuesArray[i] = {cornerValues(i, 0), cornerValues(i, 1), cornerValues(i, 2), cornerValues(i, 3)};
+  }
+
+  benchmark::RepeatedTimer scalarTimer, batchTimer;
+  scalar_t checksum = 0.0;
+  packed_scalar_t<scalar_t> values;
+  packed_vector2_t<scalar_t> gradients;
+  for (size_t n = 0; n < numRepetitions; n++) {
+    scalarTimer.startTimer();
+    for (size_t i = 0; i < numPoints; i++) {
+      const auto linApprox = getLinearApproximation(resolution, referenceCornerArray[i], cornerValuesArray[i], positionArray[i]);
+      checksum += linApprox.first + linApprox.second.x();
+    }
+    scalarTimer.endTimer();
+
+    batchTimer.startTimer();
+    getLinearApproximations(resolution, referenceCorners, cornerValues, positions, values, gradients);
+    batchTimer.endTimer();
+    checksum -= values.sum() + gradients.col(0).sum();
+  }  // end of n loop
+
+  const auto throughput = [](scalar_t milliseconds) { return numPoints / (1e3 * milliseconds); };
+  std::cerr << "[TestBilinearInterpolationBatch] linear approximation of " << numPoints << " points\n";
+  std::cerr << "  scalar: " << scalarTimer.getAverageInMilliseconds() << " [ms] (" << throughput(scalarTimer.getAverageInMilliseconds())
+            << " [Mpoints/s])\n";
+  std::cerr << "  batch:  " << batchTimer.getAverageInMilliseconds() << " [ms] (" << throughput(batchTimer.getAverageInMilliseconds())
+            << " [Mpoints/s])\n";
+  EXPECT_NEAR(checksum, 0.0, 1e-6 * numPoints * numRepetitions);
+}
+
 }  // namespace bilinear_interpolation
 }  // namespace ocs2
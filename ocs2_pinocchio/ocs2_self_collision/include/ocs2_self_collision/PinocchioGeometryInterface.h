@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <mutex>
 #include <utility>
 
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
@@ -46,6 +49,16 @@ namespace ocs2 {
 
 class PinocchioGeometryInterface final {
  public:
+  /** Settings of the GJK warm start in computeDistances */
+  struct WarmStartSettings {
+    // Whether to warm-start GJK with the result of the previous query at the same time
+    bool enable = false;
+    // Queries whose times are closer than this tolerance share their warm start
+    scalar_t timeTolerance = 1e-6;
+    // The maximum number of cached times. When exceeded, the earliest times are dropped.
+    size_t maxNumTimes = 1000;
+  };
+
   /**
    * Constructor
    *
@@ -77,6 +90,34 @@ class PinocchioGeometryInterface final {
    */
   std::vector<hpp::fcl::DistanceResult> computeDistances(const PinocchioInterface& pinocchioInterface) const;
 
+  /**
+   * Compute collision pair distances with a broad phase and an optionally warm-started narrow phase
+   *
+   * The broad phase bounds each collision object by its world-aligned AABB. Pairs whose boxes are further apart than the
+   * activation distance skip the narrow phase: their result holds the (lower-bound) box distance as min_distance, which is larger
+   * than activationDistance, and the object origins as nearest points. The size of the returned array is always the number of
+   * collision pairs.
+   *
+   * If the warm start is enabled, GJK of each pair is initialized with the guess cached from the previous query of the same pair at the
+   * same time (up to WarmStartSettings::timeTolerance), i.e., each node of the discretization reuses its own result of the previous
+   * iteration, also after the MPC horizon has shifted. The cache is shared between the copies of this instance, such that the hit rate
+   * does not depend on which solver worker evaluates a node. It is locked only while the guesses are copied in and out. Nodes at the same
+   * time, e.g., before and after an event, share their guess. This only affects the GJK initialization, not the result.
+   *
+   * @note Requires pinocchioInterface with updated joint placements by calling forwardKinematics().
+   *
+   * @param [in] pinocchioInterface: pinocchio interface of the robot model
+   * @param [in] activationDistance: Pairs with bounding boxes further apart than this distance are not evaluated.
+   * @param [in] warmStartSettings: The settings of the GJK warm start.
+   * @param [in] time: The time of the query, used as the key of the warm-start cache.
+   * @return An array of distances between pairs of collision bodies defined in the constructor.
+   */
+  std::vector<hpp::fcl::DistanceResult> computeDistances(const PinocchioInterface& pinocchioInterface, scalar_t activationDistance,
+                                                         const WarmStartSettings& warmStartSettings, scalar_t time) const;
+
+  /** Clears the GJK warm-start cache. */
+  void resetWarmStart() const;
+
   /** Get the number of collision pairs */
   size_t getNumCollisionPairs() const;
 
@@ -91,8 +132,25 @@ class PinocchioGeometryInterface final {
                                const std::vector<std::pair<size_t, size_t>>& collisionObjectPairs);
   void addCollisionLinkPairs(const PinocchioInterface& pinocchioInterface,
                              const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs);
+  void computeLocalBoundingBoxes();
 
   std::shared_ptr<pinocchio::GeometryModel> geometryModelPtr_;
+
+  // AABB of each geometry object in its own frame, one column per object
+  Eigen::Matrix<scalar_t, 3, Eigen::Dynamic> localBoxCenters_;
+  Eigen::Matrix<scalar_t, 3, Eigen::Dynamic> localBoxHalfExtents_;
+
+  // Result of the last narrow-phase query of each pair, used as GJK guess
+  struct WarmStartEntry {
+    std::vector<hpp::fcl::DistanceResult> results;
+    std::vector<bool> valid;
+  };
+  // One entry per query time, shared between the copies
+  struct WarmStartCache {
+    std::mutex mutex;
+    std::map<scalar_t, WarmStartEntry> entries;
+  };
+  std::shared_ptr<WarmStartCache> warmStartCachePtr_;
 };
 
 }  // namespace ocs2
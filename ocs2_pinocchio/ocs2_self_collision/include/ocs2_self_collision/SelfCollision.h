@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <limits>
+
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
 #include <ocs2_self_collision/PinocchioGeometryInterface.h>
 
@@ -43,8 +45,13 @@ class SelfCollision {
    *
    * @param [in] pinocchioGeometryInterface: pinocchio geometry interface of the robot model
    * @parma [in] minimumDistance: minimum allowed distance between each collision pair
+   * @param [in] activationDistance: Pairs further apart than this distance are culled in the broad phase. Their violation is clamped to
+   *                                 (activationDistance - minimumDistance) with a zero derivative, so the constraint dimension stays fixed.
+   * @param [in] warmStartSettings: The settings of the GJK warm start of each pair from the previous evaluation at the same time.
    */
-  SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance);
+  SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance,
+                scalar_t activationDistance = std::numeric_limits<scalar_t>::infinity(),
+                PinocchioGeometryInterface::WarmStartSettings warmStartSettings = PinocchioGeometryInterface::WarmStartSettings());
 
   /** Get the number of collision pairs */
   size_t getNumCollisionPairs() const { return pinocchioGeometryInterface_.getNumCollisionPairs(); }
@@ -57,9 +64,10 @@ class SelfCollision {
    * @note Requires updated forwardKinematics() on pinocchioInterface.
    *
    * @param [in] pinocchioInterface: pinocchio interface of the robot model
+   * @param [in] time: The time of the query. Used as the key of the GJK warm start.
    * @return: The differences between the distance of each collision pair and the minimum distance
    */
-  vector_t getValue(const PinocchioInterface& pinocchioInterface) const;
+  vector_t getValue(const PinocchioInterface& pinocchioInterface, scalar_t time = 0.0) const;
 
   /**
    * Evaluate the linear approximation of the distance function
@@ -69,13 +77,16 @@ class SelfCollision {
    *
    * @param [in] pinocchioInterface: pinocchio interface of the robot model
    * @param [in] pinocchioGeometryInterface: pinocchio geometry interface of the robot model
+   * @param [in] time: The time of the query. Used as the key of the GJK warm start.
    * @return: The pair of the distance violation and the first derivative of the distance against q
    */
-  std::pair<vector_t, matrix_t> getLinearApproximation(const PinocchioInterface& pinocchioInterface) const;
+  std::pair<vector_t, matrix_t> getLinearApproximation(const PinocchioInterface& pinocchioInterface, scalar_t time = 0.0) const;
 
  private:
   PinocchioGeometryInterface pinocchioGeometryInterface_;
   scalar_t minimumDistance_;
+  scalar_t activationDistance_;
+  PinocchioGeometryInterface::WarmStartSettings warmStartSettings_;
 };
 
 }  // namespace ocs2
@@ -49,9 +49,14 @@ class SelfCollisionConstraint : public StateConstraint {
    * @param [in] mapping: The pinocchio mapping from pinocchio states to ocs2 states.
    * @param [in] pinocchioGeometryInterface: Pinocchio geometry interface of the robot model.
    * @param [in] minimumDistance: The minimum allowed distance between collision pairs.
+   * @param [in] activationDistance: Pairs further apart than this distance are culled and their constraint is clamped.
+   * @param [in] warmStartSettings: The settings of the GJK warm start. If enabled, GJK of each pair is warm-started from the previous
+   *                                evaluation at the same time.
    */
   SelfCollisionConstraint(const PinocchioStateInputMapping<scalar_t>& mapping, PinocchioGeometryInterface pinocchioGeometryInterface,
-                          scalar_t minimumDistance);
+                          scalar_t minimumDistance, scalar_t activationDistance = std::numeric_limits<scalar_t>::infinity(),
+                          PinocchioGeometryInterface::WarmStartSettings warmStartSettings =
+                              PinocchioGeometryInterface::WarmStartSettings());
 
   ~SelfCollisionConstraint() override = default;
 
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <limits>
+
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
 
@@ -52,10 +54,15 @@ class SelfCollisionCppAd {
    * @param [in] recompileLibraries : If true, the model library will be newly compiled. If false, an existing library will be loaded if
    *                                  available.
    * @param [in] verbose : print information.
+   * @param [in] activationDistance: Pairs further apart than this distance are culled in the broad phase. Their violation is clamped to
+   *                                 (activationDistance - minimumDistance) with a zero derivative, so the constraint dimension stays fixed.
+   * @param [in] warmStartSettings: The settings of the GJK warm start of each pair from the previous evaluation at the same time.
    */
   SelfCollisionCppAd(const PinocchioInterface& pinocchioInterface, PinocchioGeometryInterface pinocchioGeometryInterface,
                      scalar_t minimumDistance, const std::string& modelName, const std::string& modelFolder = "/tmp/ocs2",
-                     bool recompileLibraries = true, bool verbose = true);
+                     bool recompileLibraries = true, bool verbose = true,
+                     scalar_t activationDistance = std::numeric_limits<scalar_t>::infinity(),
+                     PinocchioGeometryInterface::WarmStartSettings warmStartSettings = PinocchioGeometryInterface::WarmStartSettings());
 
   /** Default destructor */
   ~SelfCollisionCppAd() = default;
@@ -74,9 +81,10 @@ class SelfCollisionCppAd {
    * @note Requires updated forwardKinematics() on pinocchioInterface.
    *
    * @param [in] pinocchioInterface: pinocchio interface of the robot model
+   * @param [in] time: The time of the query. Used as the key of the GJK warm start.
    * @return: the differences between the distance of each collision pair and the minimum distance
    */
-  vector_t getValue(const PinocchioInterface& pinocchioInterface) const;
+  vector_t getValue(const PinocchioInterface& pinocchioInterface, scalar_t time = 0.0) const;
 
   /**
    * Evaluate the linear approximation of the distance function
@@ -85,9 +93,11 @@ class SelfCollisionCppAd {
    *
    * @param [in] pinocchioInterface: pinocchio interface of the robot model
    * @param [in] q: pinocchio coordinates
+   * @param [in] time: The time of the query. Used as the key of the GJK warm start.
    * @return: the pair of the distance violation and the first derivative of the distance against q
    */
-  std::pair<vector_t, matrix_t> getLinearApproximation(const PinocchioInterface& pinocchioInterface, const vector_t& q) const;
+  std::pair<vector_t, matrix_t> getLinearApproximation(const PinocchioInterface& pinocchioInterface, const vector_t& q,
+                                                       scalar_t time = 0.0) const;
 
  private:
   /**
@@ -113,6 +123,8 @@ class SelfCollisionCppAd {
 
   PinocchioGeometryInterface pinocchioGeometryInterface_;
   scalar_t minimumDistance_;
+  scalar_t activationDistance_;
+  PinocchioGeometryInterface::WarmStartSettings warmStartSettings_;
 };
 
 } /* namespace ocs2 */
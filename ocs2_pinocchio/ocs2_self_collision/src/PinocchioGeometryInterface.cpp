@@ -38,6 +38,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <pinocchio/multibody/model.hpp>
 #include <pinocchio/parsers/urdf.hpp>
 
+#include <hpp/fcl/distance.h>
+
 #include <urdf_parser/urdf_parser.h>
 
 namespace ocs2 {
@@ -47,8 +49,9 @@ namespace ocs2 {
 /******************************************************************************************************/
 PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface& pinocchioInterface,
                                                        const std::vector<std::pair<size_t, size_t>>& collisionObjectPairs)
-    : geometryModelPtr_(new pinocchio::GeometryModel) {
+    : geometryModelPtr_(new pinocchio::GeometryModel), warmStartCachePtr_(new WarmStartCache) {
   buildGeomFromPinocchioInterface(pinocchioInterface, *geometryModelPtr_);
+  computeLocalBoundingBoxes();
 
   addCollisionObjectPairs(pinocchioInterface, collisionObjectPairs);
 }
@@ -56,8 +59,9 @@ PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface&
 PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface& pinocchioInterface,
                                                        const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs,
                                                        const std::vector<std::pair<size_t, size_t>>& collisionObjectPairs)
-    : geometryModelPtr_(new pinocchio::GeometryModel) {
+    : geometryModelPtr_(new pinocchio::GeometryModel), warmStartCachePtr_(new WarmStartCache) {
   buildGeomFromPinocchioInterface(pinocchioInterface, *geometryModelPtr_);
+  computeLocalBoundingBoxes();
 
   addCollisionObjectPairs(pinocchioInterface, collisionObjectPairs);
   addCollisionLinkPairs(pinocchioInterface, collisionLinkPairs);
@@ -75,6 +79,105 @@ std::vector<hpp::fcl::DistanceResult> PinocchioGeometryInterface::computeDistanc
   return std::move(geometryData.distanceResults);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<hpp::fcl::DistanceResult> PinocchioGeometryInterface::computeDistances(const PinocchioInterface& pinocchioInterface,
+                                                                                   scalar_t activationDistance,
+                                                                                   const WarmStartSettings& warmStartSettings,
+                                                                                   scalar_t time) const {
+  const auto& data = pinocchioInterface.getData();
+  const auto& geometryObjects = geometryModelPtr_->geometryObjects;
+  const auto& collisionPairs = geometryModelPtr_->collisionPairs;
+  const size_t numObjects = geometryObjects.size();
+  const size_t numPairs = collisionPairs.size();
+
+  if (static_cast<size_t>(localBoxCenters_.cols()) != numObjects) {
+    throw std::runtime_error("[PinocchioGeometryInterface] Geometry objects were modified after construction!");
+  }
+
+  // Broad phase: world-aligned AABB of every object
+  PINOCCHIO_ALIGNED_STD_VECTOR(pinocchio::SE3) placements(numObjects);
+  Eigen::Matrix<scalar_t, 3, Eigen::Dynamic> boxCenters(3, numObjects);
+  Eigen::Matrix<scalar_t, 3, Eigen::Dynamic> boxHalfExtents(3, numObjects);
+  for (size_t i = 0; i < numObjects; ++i) {
+    placements[i] = data.oMi[geometryObjects[i].parentJoint] * geometryObjects[i].placement;
+    boxCenters.col(i) = placements[i].translation() + placements[i].rotation() * localBoxCenters_.col(i);
+    boxHalfExtents.col(i).noalias() = placements[i].rotation().cwiseAbs() * localBoxHalfExtents_.col(i);
+  }  // end of i loop
+
+  // Copy the guesses of the previous query at the same time, the lock is not held during the narrow phase
+  WarmStartEntry warmStartEntry;
+  if (warmStartSettings.enable) {
+    std::lock_guard<std::mutex> lock(warmStartCachePtr_->mutex);
+    const auto itr = warmStartCachePtr_->entries.lower_bound(time - warmStartSettings.timeTolerance);
+    if (itr != warmStartCachePtr_->entries.end() && itr->first <= time + warmStartSettings.timeTolerance) {
+      warmStartEntry = itr->second;
+    }
+  }
+  if (warmStartEntry.results.size() != numPairs) {
+    warmStartEntry.results.assign(numPairs, hpp::fcl::DistanceResult());
+    warmStartEntry.valid.assign(numPairs, false);
+  }
+
+  std::vector<hpp::fcl::DistanceResult> distanceResults(numPairs);
+  for (size_t i = 0; i < numPairs; ++i) {
+    const auto first = collisionPairs[i].first;
+    const auto second = collisionPairs[i].second;
+
+    const scalar_t boxDistance = ((boxCenters.col(first) - boxCenters.col(second)).cwiseAbs() -
+                                  (boxHalfExtents.col(first) + boxHalfExtents.col(second)))
+                                     .cwiseMax(0.0)
+                                     .norm();
+    if (boxDistance > activationDistance) {
+      distanceResults[i].min_distance = boxDistance;
+      distanceResults[i].nearest_points[0] = placements[first].translation();
+      distanceResults[i].nearest_points[1] = placements[second].translation();
+      continue;
+    }
+
+    // Narrow phase
+    hpp::fcl::DistanceRequest request(true);
+    if (warmStartSettings.enable && warmStartEntry.valid[i]) {
+      request.enable_cached_gjk_guess = true;
+      request.cached_gjk_guess = warmStartEntry.results[i].cached_gjk_guess;
+      request.cached_support_func_guess = warmStartEntry.results[i].cached_support_func_guess;
+    }
+    const hpp::fcl::Transform3f transform1(placements[first].rotation(), placements[first].translation());
+    const hpp::fcl::Transform3f transform2(placements[second].rotation(), placements[second].translation());
+    hpp::fcl::distance(geometryObjects[first].geometry.get(), transform1, geometryObjects[second].geometry.get(), transform2, request,
+                       distanceResults[i]);
+
+    warmStartEntry.results[i] = distanceResults[i];
+    warmStartEntry.valid[i] = true;
+  }  // end of i loop
+
+  // Store the guesses of this query, the earliest times are dropped first since the MPC horizon only moves forward
+  if (warmStartSettings.enable) {
+    std::lock_guard<std::mutex> lock(warmStartCachePtr_->mutex);
+    auto& entries = warmStartCachePtr_->entries;
+    const auto itr = entries.lower_bound(time - warmStartSettings.timeTolerance);
+    if (itr != entries.end() && itr->first <= time + warmStartSettings.timeTolerance) {
+      itr->second = std::move(warmStartEntry);
+    } else {
+      entries.emplace_hint(itr, time, std::move(warmStartEntry));
+    }
+    while (entries.size() > warmStartSettings.maxNumTimes) {
+      entries.erase(entries.begin());
+    }
+  }
+
+  return distanceResults;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioGeometryInterface::resetWarmStart() const {
+  std::lock_guard<std::mutex> lock(warmStartCachePtr_->mutex);
+  warmStartCachePtr_->entries.clear();
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -101,6 +204,21 @@ void PinocchioGeometryInterface::buildGeomFromPinocchioInterface(const Pinocchio
 
   pinocchio::urdf::buildGeom(pinocchioInterface.getModel(), urdfAsStringStream, pinocchio::COLLISION, geomModel);
 }
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioGeometryInterface::computeLocalBoundingBoxes() {
+  const auto& geometryObjects = geometryModelPtr_->geometryObjects;
+  localBoxCenters_.resize(3, geometryObjects.size());
+  localBoxHalfExtents_.resize(3, geometryObjects.size());
+  for (size_t i = 0; i < geometryObjects.size(); ++i) {
+    geometryObjects[i].geometry->computeLocalAABB();
+    const hpp::fcl::AABB& box = geometryObjects[i].geometry->aabb_local;
+    localBoxCenters_.col(i) = 0.5 * (box.max_ + box.min_);
+    localBoxHalfExtents_.col(i) = 0.5 * (box.max_ - box.min_);
+  }  // end of i loop
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
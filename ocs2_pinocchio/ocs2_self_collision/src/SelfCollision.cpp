@@ -42,18 +42,27 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-SelfCollision::SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance)
-    : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)), minimumDistance_(minimumDistance) {}
+SelfCollision::SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance, scalar_t activationDistance,
+                             PinocchioGeometryInterface::WarmStartSettings warmStartSettings)
+    : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)),
+      minimumDistance_(minimumDistance),
+      activationDistance_(activationDistance),
+      warmStartSettings_(warmStartSettings) {
+  if (activationDistance_ <= minimumDistance_) {
+    throw std::runtime_error("[SelfCollision] activationDistance should be larger than minimumDistance!");
+  }
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-vector_t SelfCollision::getValue(const PinocchioInterface& pinocchioInterface) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+vector_t SelfCollision::getValue(const PinocchioInterface& pinocchioInterface, scalar_t time) const {
+  const std::vector<hpp::fcl::DistanceResult> distanceArray =
+      pinocchioGeometryInterface_.computeDistances(pinocchioInterface, activationDistance_, warmStartSettings_, time);
 
   vector_t violations = vector_t::Zero(distanceArray.size());
   for (size_t i = 0; i < distanceArray.size(); ++i) {
-    violations[i] = distanceArray[i].min_distance - minimumDistance_;
+    violations[i] = std::min(distanceArray[i].min_distance, activationDistance_) - minimumDistance_;
   }
 
   return violations;
@@ -62,8 +71,10 @@ vector_t SelfCollision::getValue(const PinocchioInterface& pinocchioInterface) c
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-std::pair<vector_t, matrix_t> SelfCollision::getLinearApproximation(const PinocchioInterface& pinocchioInterface) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+std::pair<vector_t, matrix_t> SelfCollision::getLinearApproximation(const PinocchioInterface& pinocchioInterface,
+                                                                    scalar_t time) const {
+  const std::vector<hpp::fcl::DistanceResult> distanceArray =
+      pinocchioGeometryInterface_.computeDistances(pinocchioInterface, activationDistance_, warmStartSettings_, time);
 
   const auto& model = pinocchioInterface.getModel();
   const auto& data = pinocchioInterface.getData();
@@ -73,6 +84,13 @@ std::pair<vector_t, matrix_t> SelfCollision::getLinearApproximation(const Pinocc
   vector_t f(distanceArray.size());
   matrix_t dfdq(distanceArray.size(), model.nq);
   for (size_t i = 0; i < distanceArray.size(); ++i) {
+    // Inactive pair: clamped violation with zero derivative
+    if (distanceArray[i].min_distance >= activationDistance_) {
+      f[i] = activationDistance_ - minimumDistance_;
+      dfdq.row(i).setZero();
+      continue;
+    }
+
     // Distance violation
     f[i] = distanceArray[i].min_distance - minimumDistance_;
 
@@ -44,8 +44,15 @@ namespace ocs2 {
 /******************************************************************************************************/
 SelfCollisionCppAd::SelfCollisionCppAd(const PinocchioInterface& pinocchioInterface, PinocchioGeometryInterface pinocchioGeometryInterface,
                                        scalar_t minimumDistance, const std::string& modelName, const std::string& modelFolder,
-                                       bool recompileLibraries, bool verbose)
-    : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)), minimumDistance_(minimumDistance) {
+                                       bool recompileLibraries, bool verbose, scalar_t activationDistance,
+                                       PinocchioGeometryInterface::WarmStartSettings warmStartSettings)
+    : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)),
+      minimumDistance_(minimumDistance),
+      activationDistance_(activationDistance),
+      warmStartSettings_(warmStartSettings) {
+  if (activationDistance_ <= minimumDistance_) {
+    throw std::runtime_error("[SelfCollisionCppAd] activationDistance should be larger than minimumDistance!");
+  }
   PinocchioInterfaceCppAd pinocchioInterfaceAd = pinocchioInterface.toCppAd();
   setADInterfaces(pinocchioInterfaceAd, modelName, modelFolder);
   if (recompileLibraries) {
@@ -62,6 +69,8 @@ SelfCollisionCppAd::SelfCollisionCppAd(const PinocchioInterface& pinocchioInterf
 /******************************************************************************************************/
 SelfCollisionCppAd::SelfCollisionCppAd(const SelfCollisionCppAd& rhs)
     : minimumDistance_(rhs.minimumDistance_),
+      activationDistance_(rhs.activationDistance_),
+      warmStartSettings_(rhs.warmStartSettings_),
       pinocchioGeometryInterface_(rhs.pinocchioGeometryInterface_),
       cppAdInterfaceDistanceCalculation_(new CppAdInterface(*rhs.cppAdInterfaceDistanceCalculation_)),
       cppAdInterfaceLinkPoints_(new CppAdInterface(*rhs.cppAdInterfaceLinkPoints_)) {}
@@ -69,12 +78,13 @@ SelfCollisionCppAd::SelfCollisionCppAd(const SelfCollisionCppAd& rhs)
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-vector_t SelfCollisionCppAd::getValue(const PinocchioInterface& pinocchioInterface) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+vector_t SelfCollisionCppAd::getValue(const PinocchioInterface& pinocchioInterface, scalar_t time) const {
+  const std::vector<hpp::fcl::DistanceResult> distanceArray =
+      pinocchioGeometryInterface_.computeDistances(pinocchioInterface, activationDistance_, warmStartSettings_, time);
 
   vector_t violations = vector_t::Zero(distanceArray.size());
   for (size_t i = 0; i < distanceArray.size(); ++i) {
-    violations[i] = distanceArray[i].min_distance - minimumDistance_;
+    violations[i] = std::min(distanceArray[i].min_distance, activationDistance_) - minimumDistance_;
   }
 
   return violations;
@@ -84,8 +94,9 @@ vector_t SelfCollisionCppAd::getValue(const PinocchioInterface& pinocchioInterfa
 /******************************************************************************************************/
 /******************************************************************************************************/
 std::pair<vector_t, matrix_t> SelfCollisionCppAd::getLinearApproximation(const PinocchioInterface& pinocchioInterface,
-                                                                         const vector_t& q) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+                                                                         const vector_t& q, scalar_t time) const {
+  const std::vector<hpp::fcl::DistanceResult> distanceArray =
+      pinocchioGeometryInterface_.computeDistances(pinocchioInterface, activationDistance_, warmStartSettings_, time);
 
   vector_t pointsInWorldFrame(distanceArray.size() * numberOfParamsPerResult_);
   for (size_t i = 0; i < distanceArray.size(); ++i) {
@@ -95,8 +106,16 @@ std::pair<vector_t, matrix_t> SelfCollisionCppAd::getLinearApproximation(const P
   }
 
   const auto pointsInLinkFrame = cppAdInterfaceLinkPoints_->getFunctionValue(q, pointsInWorldFrame);
-  const auto f = cppAdInterfaceDistanceCalculation_->getFunctionValue(q, pointsInLinkFrame);
-  const auto dfdq = cppAdInterfaceDistanceCalculation_->getJacobian(q, pointsInLinkFrame);
+  vector_t f = cppAdInterfaceDistanceCalculation_->getFunctionValue(q, pointsInLinkFrame);
+  matrix_t dfdq = cppAdInterfaceDistanceCalculation_->getJacobian(q, pointsInLinkFrame);
+
+  // Inactive pairs: clamped violation with zero derivative
+  for (size_t i = 0; i < distanceArray.size(); ++i) {
+    if (distanceArray[i].min_distance >= activationDistance_) {
+      f[i] = activationDistance_ - minimumDistance_;
+      dfdq.row(i).setZero();
+    }
+  }  // end of i loop
 
   return std::make_pair(f, dfdq);
 }
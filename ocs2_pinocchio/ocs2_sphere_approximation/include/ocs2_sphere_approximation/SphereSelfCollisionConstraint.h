@@ -0,0 +1,121 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/constraint/StateConstraint.h>
+#include <ocs2_sphere_approximation/PinocchioSphereKinematics.h>
+
+namespace ocs2 {
+
+/**
+ * Self-collision constraint based on the sphere approximation of the collision links. It is a cheap alternative to
+ * SelfCollisionConstraint, which computes the distances between the original collision primitives with hpp-fcl.
+ *
+ * There is one constraint per pair of primitive shapes. Its value is the minimum distance between the spheres of the two
+ * shapes minus the minimum allowed distance. The pairs whose axis-aligned bounding boxes are farther apart than the
+ * activation distance are pruned before the sphere distances are computed. In order to keep the constraint continuous,
+ * all the distances are clamped at the activation distance, where the gradient is zero.
+ *
+ * Similar to SelfCollisionConstraint, it is the user's responsibility to call the required updates on the
+ * PinocchioInterface in pre-computation requests.
+ */
+class SphereSelfCollisionConstraint : public StateConstraint {
+ public:
+  using vector3_t = PinocchioSphereKinematics::vector3_t;
+
+  /**
+   * Constructor
+   *
+   * @param [in] sphereKinematics: The sphere kinematics of the collision links.
+   * @param [in] collisionLinkPairs: List of collision link pairs by name. All the primitive shape combinations of the two
+   *                                 links are added.
+   * @param [in] minimumDistance: The minimum allowed distance between the collision pairs.
+   * @param [in] activationDistance: The distance beyond which a pair is considered as inactive.
+   */
+  SphereSelfCollisionConstraint(const PinocchioSphereKinematics& sphereKinematics,
+                                const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs, scalar_t minimumDistance,
+                                scalar_t activationDistance = std::numeric_limits<scalar_t>::infinity());
+
+  ~SphereSelfCollisionConstraint() override = default;
+
+  size_t getNumConstraints(scalar_t time) const final { return collisionPairs_.size(); }
+
+  /** Get the pairs of the primitive shape indices (see PinocchioSphereInterface::getSphereApproximations()). */
+  const std::vector<std::pair<size_t, size_t>>& getCollisionPairs() const { return collisionPairs_; }
+
+  /** Get the self collision distance values
+   *
+   * @note Requires pinocchio::forwardKinematics(),
+   *                pinocchio::updateFramePlacements().
+   */
+  vector_t getValue(scalar_t time, const vector_t& state, const PreComputation& preComputation) const final;
+
+  /** Get the self collision distance approximation
+   *
+   * @note Requires pinocchio::forwardKinematics(),
+   *                pinocchio::updateFramePlacements(),
+   *                pinocchio::computeJointJacobians().
+   * @note In the cases that PinocchioStateInputMapping requires some additional update calls on PinocchioInterface,
+   * you should also call them as well.
+   */
+  VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state,
+                                                           const PreComputation& preComputation) const final;
+
+ protected:
+  /** Get the pinocchio interface updated with the requested computation. */
+  virtual const PinocchioInterface& getPinocchioInterface(const PreComputation& preComputation) const = 0;
+
+  SphereSelfCollisionConstraint(const SphereSelfCollisionConstraint& rhs);
+
+ private:
+  /** The closest sphere pair of a collision pair. */
+  struct PairDistance {
+    scalar_t distance;
+    size_t sphere1;
+    size_t sphere2;
+    bool isActive;
+  };
+
+  std::vector<PairDistance> computeDistances(const std::vector<vector3_t>& sphereCenters) const;
+
+  std::unique_ptr<PinocchioSphereKinematics> sphereKinematicsPtr_;
+  std::vector<std::pair<size_t, size_t>> collisionPairs_;
+  size_array_t sphereOffsets_;
+  const scalar_t minimumDistance_;
+  const scalar_t activationDistance_;
+};
+
+}  // namespace ocs2
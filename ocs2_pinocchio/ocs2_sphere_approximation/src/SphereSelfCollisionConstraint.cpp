@@ -0,0 +1,194 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <Eigen/Geometry>
+
+#include "ocs2_sphere_approximation/SphereSelfCollisionConstraint.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SphereSelfCollisionConstraint::SphereSelfCollisionConstraint(const PinocchioSphereKinematics& sphereKinematics,
+                                                             const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs,
+                                                             scalar_t minimumDistance, scalar_t activationDistance)
+    : StateConstraint(ConstraintOrder::Linear),
+      sphereKinematicsPtr_(sphereKinematics.clone()),
+      minimumDistance_(minimumDistance),
+      activationDistance_(activationDistance) {
+  const auto& sphereInterface = sphereKinematicsPtr_->getPinocchioSphereInterface();
+  const auto& linkOfEachPrimitiveShape = sphereInterface.getCollisionLinkOfEachPrimitveShape();
+  const auto& numSpheres = sphereInterface.getNumSpheres();
+  const size_t numPrimitiveShapes = sphereInterface.getNumPrimitiveShapes();
+
+  sphereOffsets_.resize(numPrimitiveShapes);
+  size_t count = 0;
+  for (size_t i = 0; i < numPrimitiveShapes; i++) {
+    sphereOffsets_[i] = count;
+    count += numSpheres[i];
+  }
+
+  for (const auto& linkPair : collisionLinkPairs) {
+    for (size_t i = 0; i < numPrimitiveShapes; i++) {
+      for (size_t j = 0; j < numPrimitiveShapes; j++) {
+        if (i != j && linkOfEachPrimitiveShape[i] == linkPair.first && linkOfEachPrimitiveShape[j] == linkPair.second) {
+          collisionPairs_.emplace_back(i, j);
+        }
+      }
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SphereSelfCollisionConstraint::SphereSelfCollisionConstraint(const SphereSelfCollisionConstraint& rhs)
+    : StateConstraint(rhs),
+      sphereKinematicsPtr_(rhs.sphereKinematicsPtr_->clone()),
+      collisionPairs_(rhs.collisionPairs_),
+      sphereOffsets_(rhs.sphereOffsets_),
+      minimumDistance_(rhs.minimumDistance_),
+      activationDistance_(rhs.activationDistance_) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t SphereSelfCollisionConstraint::getValue(scalar_t time, const vector_t& state, const PreComputation& preComputation) const {
+  sphereKinematicsPtr_->setPinocchioInterface(getPinocchioInterface(preComputation));
+  const auto sphereCenters = sphereKinematicsPtr_->getPosition(state);
+  const auto distances = computeDistances(sphereCenters);
+
+  vector_t violations(distances.size());
+  for (size_t i = 0; i < distances.size(); i++) {
+    violations(i) = distances[i].distance - minimumDistance_;
+  }
+  return violations;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation SphereSelfCollisionConstraint::getLinearApproximation(scalar_t time, const vector_t& state,
+                                                                                        const PreComputation& preComputation) const {
+  sphereKinematicsPtr_->setPinocchioInterface(getPinocchioInterface(preComputation));
+  const auto spherePositions = sphereKinematicsPtr_->getPositionLinearApproximation(state);
+
+  std::vector<vector3_t> sphereCenters(spherePositions.size());
+  for (size_t i = 0; i < spherePositions.size(); i++) {
+    sphereCenters[i] = spherePositions[i].f;
+  }
+  const auto distances = computeDistances(sphereCenters);
+
+  auto constraint = VectorFunctionLinearApproximation::Zero(distances.size(), state.size(), 0);
+  for (size_t i = 0; i < distances.size(); i++) {
+    constraint.f(i) = distances[i].distance - minimumDistance_;
+
+    // d = |c1 - c2| - r1 - r2  =>  dd/dx = n' * (dc1/dx - dc2/dx) with n = (c1 - c2) / |c1 - c2|
+    if (distances[i].isActive) {
+      const size_t s1 = distances[i].sphere1;
+      const size_t s2 = distances[i].sphere2;
+      const vector3_t centerDifference = sphereCenters[s1] - sphereCenters[s2];
+      const scalar_t centerDistance = centerDifference.norm();
+      if (centerDistance > std::numeric_limits<scalar_t>::epsilon()) {
+        constraint.dfdx.row(i).noalias() =
+            (centerDifference / centerDistance).transpose() * (spherePositions[s1].dfdx - spherePositions[s2].dfdx);
+      }
+    }
+  }  // end of i loop
+
+  return constraint;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto SphereSelfCollisionConstraint::computeDistances(const std::vector<vector3_t>& sphereCenters) const -> std::vector<PairDistance> {
+  using box_t = Eigen::AlignedBox<scalar_t, 3>;
+  using matrix3x_t = Eigen::Matrix<scalar_t, 3, Eigen::Dynamic>;
+
+  const auto& sphereInterface = sphereKinematicsPtr_->getPinocchioSphereInterface();
+  const auto& numSpheres = sphereInterface.getNumSpheres();
+  const auto& sphereRadii = sphereInterface.getSphereRadii();
+  const size_t numPrimitiveShapes = sphereInterface.getNumPrimitiveShapes();
+
+  // broad phase: the bounding box of each primitive shape's spheres
+  std::vector<box_t> boundingBoxes(numPrimitiveShapes);
+  for (size_t i = 0; i < numPrimitiveShapes; i++) {
+    for (size_t s = sphereOffsets_[i]; s < sphereOffsets_[i] + numSpheres[i]; s++) {
+      const vector3_t radius = vector3_t::Constant(sphereRadii[s]);
+      boundingBoxes[i].extend(sphereCenters[s] - radius);
+      boundingBoxes[i].extend(sphereCenters[s] + radius);
+    }
+  }
+
+  std::vector<PairDistance> distances;
+  distances.reserve(collisionPairs_.size());
+  for (const auto& pair : collisionPairs_) {
+    PairDistance pairDistance{activationDistance_, 0, 0, false};
+
+    if (boundingBoxes[pair.first].exteriorDistance(boundingBoxes[pair.second]) < activationDistance_) {
+      // narrow phase: the distances between all the sphere pairs of the two shapes at once (n1 x n2)
+      const size_t offset1 = sphereOffsets_[pair.first];
+      const size_t offset2 = sphereOffsets_[pair.second];
+      const Eigen::Index n1 = numSpheres[pair.first];
+      const Eigen::Index n2 = numSpheres[pair.second];
+      const Eigen::Map<const matrix3x_t> centers1(sphereCenters[offset1].data(), 3, n1);
+      const Eigen::Map<const matrix3x_t> centers2(sphereCenters[offset2].data(), 3, n2);
+      const Eigen::Map<const vector_t> radii1(sphereRadii.data() + offset1, n1);
+      const Eigen::Map<const vector_t> radii2(sphereRadii.data() + offset2, n2);
+
+      matrix_t squaredCenterDistances = -2.0 * centers1.transpose() * centers2;
+      squaredCenterDistances.colwise() += centers1.colwise().squaredNorm().transpose();
+      squaredCenterDistances.rowwise() += centers2.colwise().squaredNorm();
+      matrix_t sphereDistances = squaredCenterDistances.cwiseMax(0.0).cwiseSqrt();
+      sphereDistances.colwise() -= radii1;
+      sphereDistances.rowwise() -= radii2.transpose();
+
+      Eigen::Index i1, i2;
+      sphereDistances.minCoeff(&i1, &i2);
+      pairDistance.sphere1 = offset1 + i1;
+      pairDistance.sphere2 = offset2 + i2;
+
+      // recompute the closest pair without the cancellation error of the expansion above
+      const scalar_t distance = (sphereCenters[pairDistance.sphere1] - sphereCenters[pairDistance.sphere2]).norm() -
+                                sphereRadii[pairDistance.sphere1] - sphereRadii[pairDistance.sphere2];
+      if (distance < activationDistance_) {
+        pairDistance.distance = distance;
+        pairDistance.isActive = true;
+      }
+    }
+
+    distances.push_back(pairDistance);
+  }  // end of pair loop
+
+  return distances;
+}
+
+}  // namespace ocs2
@@ -0,0 +1,186 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>
+
+#include <pinocchio/algorithm/frames.hpp>
+#include <pinocchio/algorithm/jacobian.hpp>
+#include <pinocchio/algorithm/kinematics.hpp>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_pinocchio_interface/urdf.h>
+#include <ocs2_robotic_assets/package_path.h>
+#include <ocs2_self_collision/SelfCollision.h>
+#include <ocs2_sphere_approximation/SphereSelfCollisionConstraint.h>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+class DummyMapping final : public ocs2::PinocchioStateInputMapping<ocs2::scalar_t> {
+ public:
+  DummyMapping() = default;
+  ~DummyMapping() override = default;
+  DummyMapping* clone() const override { return new DummyMapping(*this); }
+
+  ocs2::vector_t getPinocchioJointPosition(const ocs2::vector_t& state) const override { return state; }
+  ocs2::vector_t getPinocchioJointVelocity(const ocs2::vector_t& state, const ocs2::vector_t& input) const override { return input; }
+  std::pair<ocs2::matrix_t, ocs2::matrix_t> getOcs2Jacobian(const ocs2::vector_t& state, const ocs2::matrix_t& Jq,
+                                                            const ocs2::matrix_t& Jv) const override {
+    return {Jq, Jv};
+  }
+};
+
+class DummySphereSelfCollisionConstraint final : public ocs2::SphereSelfCollisionConstraint {
+ public:
+  DummySphereSelfCollisionConstraint(const ocs2::PinocchioInterface& pinocchioInterface, const ocs2::PinocchioSphereKinematics& kinematics,
+                                     const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs,
+                                     ocs2::scalar_t minimumDistance, ocs2::scalar_t activationDistance)
+      : SphereSelfCollisionConstraint(kinematics, collisionLinkPairs, minimumDistance, activationDistance),
+        pinocchioInterfacePtr_(&pinocchioInterface) {}
+  ~DummySphereSelfCollisionConstraint() override = default;
+  DummySphereSelfCollisionConstraint* clone() const override { return new DummySphereSelfCollisionConstraint(*this); }
+
+ protected:
+  const ocs2::PinocchioInterface& getPinocchioInterface(const ocs2::PreComputation&) const override { return *pinocchioInterfacePtr_; }
+
+ private:
+  DummySphereSelfCollisionConstraint(const DummySphereSelfCollisionConstraint& other) = default;
+
+  const ocs2::PinocchioInterface* pinocchioInterfacePtr_;
+};
+
+}  // unnamed namespace
+
+class TestSphereSelfCollisionConstraint : public ::testing::Test {
+ public:
+  TestSphereSelfCollisionConstraint() {
+    const std::string urdfFile = ocs2::robotic_assets::getPath() + "/resources/mobile_manipulator/mabi_mobile/urdf/mabi_mobile.urdf";
+    pinocchioInterfacePtr.reset(new ocs2::PinocchioInterface(ocs2::getPinocchioInterfaceFromUrdfFile(urdfFile)));
+    ocs2::PinocchioSphereInterface sphereInterface(*pinocchioInterfacePtr, {"ARM", "SHOULDER", "FOREARM", "WRIST_1"},
+                                                   {0.20, 0.10, 0.05, 0.05}, 0.7);
+    sphereKinematicsPtr.reset(new ocs2::PinocchioSphereKinematics(std::move(sphereInterface), mapping));
+
+    // taken form config/mpc/task.info
+    x.setZero(pinocchioInterfacePtr->getModel().njoints);
+    x.head<6>() << 2.5, -1.0, 1.5, 0.0, 1.0, 0.0;
+  }
+
+  /** Updates the pinocchio data as requested by the constraints. */
+  void updatePinocchio(const ocs2::vector_t& state) {
+    const auto& model = pinocchioInterfacePtr->getModel();
+    auto& data = pinocchioInterfacePtr->getData();
+    const ocs2::vector_t q = mapping.getPinocchioJointPosition(state);
+    pinocchio::forwardKinematics(model, data, q);
+    pinocchio::updateFramePlacements(model, data);
+    pinocchio::computeJointJacobians(model, data);
+  }
+
+  std::unique_ptr<ocs2::SphereSelfCollisionConstraint> getConstraint(ocs2::scalar_t activationDistance) const {
+    return std::unique_ptr<ocs2::SphereSelfCollisionConstraint>(new DummySphereSelfCollisionConstraint(
+        *pinocchioInterfacePtr, *sphereKinematicsPtr, collisionLinkPairs, minimumDistance, activationDistance));
+  }
+
+  const std::vector<std::pair<std::string, std::string>> collisionLinkPairs{{"SHOULDER", "FOREARM"}, {"SHOULDER", "WRIST_1"}, {"ARM", "WRIST_1"}};
+  const ocs2::scalar_t minimumDistance = 0.05;
+  const ocs2::scalar_t infinity = std::numeric_limits<ocs2::scalar_t>::infinity();
+  ocs2::vector_t x;
+  DummyMapping mapping;
+  ocs2::PreComputation preComputation;
+  std::unique_ptr<ocs2::PinocchioInterface> pinocchioInterfacePtr;
+  std::unique_ptr<ocs2::PinocchioSphereKinematics> sphereKinematicsPtr;
+};
+
+TEST_F(TestSphereSelfCollisionConstraint, testLinearApproximation) {
+  const auto constraintPtr = getConstraint(infinity);
+  ASSERT_GT(constraintPtr->getNumConstraints(0.0), 0u);
+
+  updatePinocchio(x);
+  const auto linearApproximation = constraintPtr->getLinearApproximation(0.0, x, preComputation);
+  EXPECT_TRUE(linearApproximation.f.isApprox(constraintPtr->getValue(0.0, x, preComputation)));
+
+  // central finite differences
+  const ocs2::scalar_t eps = 1e-6;
+  ocs2::matrix_t dfdx(linearApproximation.f.size(), x.size());
+  for (int i = 0; i < x.size(); i++) {
+    const ocs2::vector_t dx = ocs2::vector_t::Unit(x.size(), i) * eps;
+    updatePinocchio(x + dx);
+    const ocs2::vector_t fPlus = constraintPtr->getValue(0.0, x + dx, preComputation);
+    updatePinocchio(x - dx);
+    const ocs2::vector_t fMinus = constraintPtr->getValue(0.0, x - dx, preComputation);
+    dfdx.col(i) = (fPlus - fMinus) / (2.0 * eps);
+  }
+  EXPECT_TRUE(linearApproximation.dfdx.isApprox(dfdx, 1e-4)) << "dfdx:\n" << linearApproximation.dfdx << "\nfinite difference:\n" << dfdx;
+}
+
+TEST_F(TestSphereSelfCollisionConstraint, testActivationDistance) {
+  const ocs2::scalar_t activationDistance = 0.2;
+  const auto constraintPtr = getConstraint(infinity);
+  const auto prunedConstraintPtr = getConstraint(activationDistance);
+
+  updatePinocchio(x);
+  const ocs2::vector_t clampedValue = constraintPtr->getValue(0.0, x, preComputation).cwiseMin(activationDistance - minimumDistance);
+  const auto prunedApproximation = prunedConstraintPtr->getLinearApproximation(0.0, x, preComputation);
+  EXPECT_TRUE(prunedApproximation.f.isApprox(clampedValue));
+
+  for (int i = 0; i < clampedValue.size(); i++) {
+    if (clampedValue(i) >= activationDistance - minimumDistance) {
+      EXPECT_TRUE(prunedApproximation.dfdx.row(i).isZero());
+    }
+  }
+}
+
+TEST_F(TestSphereSelfCollisionConstraint, benchmarkAgainstFcl) {
+  constexpr size_t numSamples = 1000;
+  const auto constraintPtr = getConstraint(0.3);
+  ocs2::SelfCollision selfCollision(ocs2::PinocchioGeometryInterface(*pinocchioInterfacePtr, collisionLinkPairs), minimumDistance);
+
+  ocs2::benchmark::RepeatedTimer sphereTimer;
+  ocs2::benchmark::RepeatedTimer fclTimer;
+  for (size_t i = 0; i < numSamples; i++) {
+    const ocs2::vector_t state = x + 0.5 * ocs2::vector_t::Random(x.size());
+    updatePinocchio(state);
+
+    sphereTimer.startTimer();
+    const auto sphereApproximation = constraintPtr->getLinearApproximation(0.0, state, preComputation);
+    sphereTimer.endTimer();
+
+    fclTimer.startTimer();
+    const auto fclApproximation = selfCollision.getLinearApproximation(*pinocchioInterfacePtr);
+    fclTimer.endTimer();
+
+    ASSERT_TRUE(sphereApproximation.f.allFinite());
+    ASSERT_TRUE(fclApproximation.first.allFinite());
+  }
+
+  std::cerr << "[SphereSelfCollisionConstraint] " << constraintPtr->getNumConstraints(0.0)
+            << " pairs, average time: " << sphereTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cerr << "[SelfCollision (hpp-fcl)] " << selfCollision.getNumCollisionPairs()
+            << " pairs, average time: " << fclTimer.getAverageInMilliseconds() << " [ms]\n";
+}
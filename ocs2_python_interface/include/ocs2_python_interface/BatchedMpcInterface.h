@@ -0,0 +1,155 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_mpc/MPC_MRT_Interface.h>
+
+#include "ocs2_python_interface/PythonInterface.h"
+
+namespace ocs2 {
+
+/**
+ * BatchedMpcInterface owns N independent MPC instances of the same robot and advances them concurrently
+ * on a thread pool. It is meant for data generation where many instances with different initial conditions
+ * and targets are solved at the same time from Python. The long calls release the GIL, therefore all the calls
+ * which access the instances are serialized by an internal mutex.
+ */
+class BatchedMpcInterface {
+ public:
+  using row_matrix_t = PythonInterface::row_matrix_t;
+  using mpc_factory_t = std::function<std::unique_ptr<MPC_BASE>()>;
+
+ protected:
+  /** Constructor */
+  BatchedMpcInterface() = default;
+
+  /**
+   * Initialize the batched interface
+   * @note This should be called from derived class constructor.
+   * @param [in] numInstances: The number of MPC instances.
+   * @param [in] mpcFactory: Creates a new MPC instance. The instances should not share mutable modules, e.g. the ReferenceManager.
+   * @param [in] numThreads: The number of threads which advance the instances.
+   */
+  void init(size_t numInstances, const mpc_factory_t& mpcFactory, size_t numThreads);
+
+ public:
+  /** Destructor */
+  virtual ~BatchedMpcInterface() = default;
+
+  /** Gets the state dimension of the dynamics system. */
+  int getStateDim() const { return stateDim_; }
+
+  /** Gets the input dimension of the dynamics system. */
+  int getInputDim() const { return inputDim_; }
+
+  /** Gets the number of MPC instances. */
+  size_t getNumInstances() const { return instances_.size(); }
+
+  /**
+   * @brief Resets all MPC instances to their original state
+   * @param[in] targetTrajectories: The new target of each instance
+   */
+  void reset(const std::vector<TargetTrajectories>& targetTrajectories);
+
+  /**
+   * @brief Sets the target trajectories of all MPC instances
+   * @param[in] targetTrajectories: The target of each instance
+   */
+  void setTargetTrajectories(const std::vector<TargetTrajectories>& targetTrajectories);
+
+  /**
+   * @brief Provides the MPC instances with new starting times and states. Row i is the observation of instance i.
+   * @param[in] t: current times, (N,)
+   * @param[in] x: current states, (N, stateDim)
+   * @param[in] u: current inputs, (N, inputDim)
+   */
+  void setObservations(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x, Eigen::Ref<const row_matrix_t> u);
+
+  /**
+   * @brief Runs one MPC iteration of all instances concurrently
+   * @note This call is blocking
+   */
+  void advanceMpc();
+
+  /**
+   * @brief Evaluates the latest policy of each instance. Row i is the query of instance i.
+   * @param[in] t: query times, (N,)
+   * @param[in] x: query states, (N, stateDim)
+   * @return The tuple of the optimal states (N, stateDim) and the optimal inputs (N, inputDim)
+   */
+  std::tuple<row_matrix_t, row_matrix_t> evaluatePolicies(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x);
+
+  /**
+   * @brief Updates the policies and stores the MPC solution of each instance in new contiguous trajectories. The getters
+   * below share them without copies, as in PythonInterface::updateMpcSolution.
+   */
+  void updateMpcSolutions();
+
+  /** The time trajectory of instance i of the last updateMpcSolutions call, (N_i,) */
+  std::shared_ptr<const vector_t> getMpcSolutionTimeTrajectory(size_t i) const;
+
+  /** The state trajectory of instance i of the last updateMpcSolutions call, (N_i, stateDim) */
+  std::shared_ptr<const row_matrix_t> getMpcSolutionStateTrajectory(size_t i) const;
+
+  /** The input trajectory of instance i of the last updateMpcSolutions call, (N_i, inputDim) */
+  std::shared_ptr<const row_matrix_t> getMpcSolutionInputTrajectory(size_t i) const;
+
+ protected:
+  int stateDim_ = -1;  // -1 indicates that it is not initialized
+  int inputDim_ = -1;  // -1 indicates that it is not initialized
+
+ private:
+  struct Instance {
+    std::unique_ptr<MPC_BASE> mpcPtr;
+    std::unique_ptr<MPC_MRT_Interface> mpcMrtInterfacePtr;
+    std::shared_ptr<const vector_t> timeTrajectoryPtr = std::make_shared<const vector_t>();
+    std::shared_ptr<const row_matrix_t> stateTrajectoryPtr = std::make_shared<const row_matrix_t>();
+    std::shared_ptr<const row_matrix_t> inputTrajectoryPtr = std::make_shared<const row_matrix_t>();
+  };
+
+  /** Checks the number of rows of a batch */
+  void checkBatchSize(Eigen::Index numRows) const;
+
+  /** Runs the given function for all instances in the thread pool. The first exception is rethrown after all instances are done. */
+  void runForAllInstances(const std::function<void(Instance&)>& function);
+
+  std::vector<Instance> instances_;
+  mutable std::mutex instancesMutex_;  // guards the instances, since advanceMpc and updateMpcSolutions run without the GIL
+  std::unique_ptr<ThreadPool> threadPoolPtr_;
+  size_t numThreads_ = 1;
+};
+
+}  // namespace ocs2
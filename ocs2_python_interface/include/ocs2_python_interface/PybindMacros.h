@@ -29,7 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <memory>
+
 #include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -37,6 +40,38 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 using namespace pybind11::literals;
 
+namespace ocs2 {
+namespace python_interface {
+
+/**
+ * Wraps a shared Eigen matrix in a read-only NumPy array without copying it. The array owns a copy of the shared pointer
+ * through a capsule, so the buffer outlives the C++ owner as long as the array is referenced.
+ */
+template <typename Matrix>
+pybind11::array toSharedNumpyArray(std::shared_ptr<const Matrix> matrixPtr) {
+  static_assert(Matrix::IsRowMajor || Matrix::ColsAtCompileTime == 1, "Only row-major matrices and vectors are supported.");
+  using scalar_type = typename Matrix::Scalar;
+
+  const auto* data = matrixPtr->data();
+  const auto rows = static_cast<pybind11::ssize_t>(matrixPtr->rows());
+  const auto cols = static_cast<pybind11::ssize_t>(matrixPtr->cols());
+  auto* ownerPtr = new std::shared_ptr<const Matrix>(std::move(matrixPtr));
+  pybind11::capsule owner(ownerPtr, [](void* p) { delete static_cast<std::shared_ptr<const Matrix>*>(p); });
+
+  pybind11::array array;
+  if (Matrix::ColsAtCompileTime == 1) {
+    array = pybind11::array_t<scalar_type>({rows}, {static_cast<pybind11::ssize_t>(sizeof(scalar_type))}, data, owner);
+  } else {
+    const auto rowStride = static_cast<pybind11::ssize_t>(sizeof(scalar_type)) * cols;
+    array = pybind11::array_t<scalar_type>({rows, cols}, {rowStride, static_cast<pybind11::ssize_t>(sizeof(scalar_type))}, data, owner);
+  }
+  array.attr("setflags")("write"_a = false);
+  return array;
+}
+
+}  // namespace python_interface
+}  // namespace ocs2
+
 //! convenience macro to bind all kinds of std::vector-like types
 #define VECTOR_TYPE_BINDING(VTYPE, NAME)                                                    \
   pybind11::class_<VTYPE>(m, NAME)                                                          \
@@ -60,65 +95,133 @@ using namespace pybind11::literals;
           "__iter__", [](VTYPE& v) { return pybind11::make_iterator(v.begin(), v.end()); }, \
           pybind11::keep_alive<0, 1>()); /* Keep vector alive while iterator is used */
 
+/**
+ * @brief Convenience macro to bind the vector types, the approximation classes, TargetTrajectories, and the robot interface.
+ * @note It should be used inside a PYBIND11_MODULE with the module variable m.
+ */
+#define ROBOT_PYTHON_BINDINGS(PY_INTERFACE)                                                                                                \
+  /* bind vector types so they can be used natively in python */                                                                           \
+  VECTOR_TYPE_BINDING(ocs2::scalar_array_t, "scalar_array")                                                                                \
+  VECTOR_TYPE_BINDING(ocs2::vector_array_t, "vector_array")                                                                                \
+  VECTOR_TYPE_BINDING(ocs2::matrix_array_t, "matrix_array")                                                                                \
+  /* bind approximation classes */                                                                                                         \
+  pybind11::class_<ocs2::VectorFunctionLinearApproximation>(m, "VectorFunctionLinearApproximation")                                        \
+      .def_readwrite("f", &ocs2::VectorFunctionLinearApproximation::f)                                                                     \
+      .def_readwrite("dfdx", &ocs2::VectorFunctionLinearApproximation::dfdx)                                                               \
+      .def_readwrite("dfdu", &ocs2::VectorFunctionLinearApproximation::dfdu);                                                              \
+  pybind11::class_<ocs2::VectorFunctionQuadraticApproximation>(m, "VectorFunctionQuadraticApproximation")                                  \
+      .def_readwrite("f", &ocs2::VectorFunctionQuadraticApproximation::f)                                                                  \
+      .def_readwrite("dfdx", &ocs2::VectorFunctionQuadraticApproximation::dfdx)                                                            \
+      .def_readwrite("dfdu", &ocs2::VectorFunctionQuadraticApproximation::dfdu)                                                            \
+      .def_readwrite("dfdxx", &ocs2::VectorFunctionQuadraticApproximation::dfdxx)                                                          \
+      .def_readwrite("dfdux", &ocs2::VectorFunctionQuadraticApproximation::dfdux)                                                          \
+      .def_readwrite("dfduu", &ocs2::VectorFunctionQuadraticApproximation::dfduu);                                                         \
+  pybind11::class_<ocs2::ScalarFunctionQuadraticApproximation>(m, "ScalarFunctionQuadraticApproximation")                                  \
+      .def_readwrite("f", &ocs2::ScalarFunctionQuadraticApproximation::f)                                                                  \
+      .def_readwrite("dfdx", &ocs2::ScalarFunctionQuadraticApproximation::dfdx)                                                            \
+      .def_readwrite("dfdu", &ocs2::ScalarFunctionQuadraticApproximation::dfdu)                                                            \
+      .def_readwrite("dfdxx", &ocs2::ScalarFunctionQuadraticApproximation::dfdxx)                                                          \
+      .def_readwrite("dfdux", &ocs2::ScalarFunctionQuadraticApproximation::dfdux)                                                          \
+      .def_readwrite("dfduu", &ocs2::ScalarFunctionQuadraticApproximation::dfduu);                                                         \
+  /* bind TargetTrajectories class */                                                                                                      \
+  pybind11::class_<ocs2::TargetTrajectories>(m, "TargetTrajectories")                                                                      \
+      .def(pybind11::init<ocs2::scalar_array_t, ocs2::vector_array_t, ocs2::vector_array_t>());                                            \
+  /* bind the actual mpc interface */                                                                                                      \
+  pybind11::class_<PY_INTERFACE>(m, "mpc_interface")                                                                                       \
+      .def(pybind11::init<const std::string&, const std::string&, const std::string&>(), "taskFile"_a, "libFolder"_a, "urdfFile"_a = "")   \
+      .def("getStateDim", &PY_INTERFACE::getStateDim)                                                                                      \
+      .def("getInputDim", &PY_INTERFACE::getInputDim)                                                                                      \
+      .def("setObservation", &PY_INTERFACE::setObservation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())                                   \
+      .def("setTargetTrajectories", &PY_INTERFACE::setTargetTrajectories, "targetTrajectories"_a)                                          \
+      .def("reset", &PY_INTERFACE::reset, "targetTrajectories"_a)                                                                          \
+      .def("advanceMpc", &PY_INTERFACE::advanceMpc)                                                                                        \
+      .def("getMpcSolution", &PY_INTERFACE::getMpcSolution, "t"_a.noconvert(), "x"_a.noconvert(), "u"_a.noconvert())                       \
+      .def("updateMpcSolution", &PY_INTERFACE::updateMpcSolution)                                                                          \
+      .def("getMpcSolutionTimeTrajectory",                                                                                                 \
+           [](const PY_INTERFACE& p) { return ocs2::python_interface::toSharedNumpyArray(p.getMpcSolutionTimeTrajectory()); })             \
+      .def("getMpcSolutionStateTrajectory",                                                                                                \
+           [](const PY_INTERFACE& p) { return ocs2::python_interface::toSharedNumpyArray(p.getMpcSolutionStateTrajectory()); })            \
+      .def("getMpcSolutionInputTrajectory",                                                                                                \
+           [](const PY_INTERFACE& p) { return ocs2::python_interface::toSharedNumpyArray(p.getMpcSolutionInputTrajectory()); })            \
+      .def("getLinearFeedbackGain", &PY_INTERFACE::getLinearFeedbackGain, "t"_a.noconvert())                                               \
+      .def("flowMap", &PY_INTERFACE::flowMap, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())                                                 \
+      .def("flowMapLinearApproximation", &PY_INTERFACE::flowMapLinearApproximation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())           \
+      .def("cost", &PY_INTERFACE::cost, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())                                                       \
+      /* batched evaluations: C-contiguous float64 arrays are mapped without copies and the GIL is released */                             \
+      .def("flowMapBatch", &PY_INTERFACE::flowMapBatch, "t"_a, "x"_a, "u"_a, pybind11::call_guard<pybind11::gil_scoped_release>())         \
+      .def("flowMapLinearApproximationBatch", &PY_INTERFACE::flowMapLinearApproximationBatch, "t"_a, "x"_a, "u"_a,                         \
+           pybind11::call_guard<pybind11::gil_scoped_release>())                                                                           \
+      .def("costBatch", &PY_INTERFACE::costBatch, "t"_a, "x"_a, "u"_a, pybind11::call_guard<pybind11::gil_scoped_release>())               \
+      .def("costQuadraticApproximation", &PY_INTERFACE::costQuadraticApproximation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())           \
+      .def("valueFunction", &PY_INTERFACE::valueFunction, "t"_a, "x"_a.noconvert())                                                        \
+      .def("valueFunctionStateDerivative", &PY_INTERFACE::valueFunctionStateDerivative, "t"_a, "x"_a.noconvert())                          \
+      .def("stateInputEqualityConstraint", &PY_INTERFACE::stateInputEqualityConstraint, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())       \
+      .def("stateInputEqualityConstraintLinearApproximation", &PY_INTERFACE::stateInputEqualityConstraintLinearApproximation, "t"_a,       \
+           "x"_a.noconvert(), "u"_a.noconvert())                                                                                           \
+      .def("stateInputEqualityConstraintLagrangian", &PY_INTERFACE::stateInputEqualityConstraintLagrangian, "t"_a, "x"_a.noconvert(),      \
+           "u"_a.noconvert())                                                                                                              \
+      .def("visualizeTrajectory", &PY_INTERFACE::visualizeTrajectory, "t"_a.noconvert(), "x"_a.noconvert(), "u"_a.noconvert(),             \
+           "speed"_a);
+
+/**
+ * @brief Convenience macro to bind a BatchedMpcInterface as "batched_mpc_interface".
+ * @note It should be used inside a PYBIND11_MODULE with the module variable m.
+ */
+#define BATCHED_MPC_INTERFACE_BINDING(BATCHED_INTERFACE)                                                                                   \
+  pybind11::class_<BATCHED_INTERFACE>(m, "batched_mpc_interface")                                                                          \
+      .def(pybind11::init<const std::string&, const std::string&, size_t, size_t, const std::string&>(), "taskFile"_a, "libFolder"_a,      \
+           "numInstances"_a, "numThreads"_a, "urdfFile"_a = "")                                                                            \
+      .def("getStateDim", &BATCHED_INTERFACE::getStateDim)                                                                                 \
+      .def("getInputDim", &BATCHED_INTERFACE::getInputDim)                                                                                 \
+      .def("getNumInstances", &BATCHED_INTERFACE::getNumInstances)                                                                         \
+      .def("reset", &BATCHED_INTERFACE::reset, "targetTrajectories"_a)                                                                     \
+      .def("setTargetTrajectories", &BATCHED_INTERFACE::setTargetTrajectories, "targetTrajectories"_a)                                     \
+      .def("setObservations", &BATCHED_INTERFACE::setObservations, "t"_a, "x"_a, "u"_a)                                                    \
+      .def("advanceMpc", &BATCHED_INTERFACE::advanceMpc, pybind11::call_guard<pybind11::gil_scoped_release>())                             \
+      .def("evaluatePolicies", &BATCHED_INTERFACE::evaluatePolicies, "t"_a, "x"_a)                                                         \
+      .def("updateMpcSolutions", &BATCHED_INTERFACE::updateMpcSolutions, pybind11::call_guard<pybind11::gil_scoped_release>())             \
+      .def(                                                                                                                                \
+          "getMpcSolutionTimeTrajectory",                                                                                                  \
+          [](const BATCHED_INTERFACE& b, size_t i) {                                                                                       \
+            return ocs2::python_interface::toSharedNumpyArray(b.getMpcSolutionTimeTrajectory(i));                                          \
+          },                                                                                                                               \
+          "i"_a)                                                                                                                           \
+      .def(                                                                                                                                \
+          "getMpcSolutionStateTrajectory",                                                                                                 \
+          [](const BATCHED_INTERFACE& b, size_t i) {                                                                                       \
+            return ocs2::python_interface::toSharedNumpyArray(b.getMpcSolutionStateTrajectory(i));                                         \
+          },                                                                                                                               \
+          "i"_a)                                                                                                                           \
+      .def(                                                                                                                                \
+          "getMpcSolutionInputTrajectory",                                                                                                 \
+          [](const BATCHED_INTERFACE& b, size_t i) {                                                                                       \
+            return ocs2::python_interface::toSharedNumpyArray(b.getMpcSolutionInputTrajectory(i));                                         \
+          },                                                                                                                               \
+          "i"_a);
+
 /**
  * @brief Convenience macro to bind robot interface with all required vectors.
  * @note LIB_NAME must match target name in CMakeLists
  */
 #define CREATE_ROBOT_PYTHON_BINDINGS(PY_INTERFACE, LIB_NAME)                                                                               \
+  /* make vector types opaque so they are not converted to python lists */                                                                 \
+  PYBIND11_MAKE_OPAQUE(ocs2::scalar_array_t)                                                                                               \
+  PYBIND11_MAKE_OPAQUE(ocs2::vector_array_t)                                                                                               \
+  PYBIND11_MAKE_OPAQUE(ocs2::matrix_array_t)                                                                                               \
+  /* create a python module */                                                                                                             \
+  PYBIND11_MODULE(LIB_NAME, m) { ROBOT_PYTHON_BINDINGS(PY_INTERFACE) }
+
+/**
+ * @brief Convenience macro to bind robot interface with all required vectors and a BatchedMpcInterface of the same robot.
+ * @note LIB_NAME must match target name in CMakeLists
+ */
+#define CREATE_ROBOT_BATCHED_PYTHON_BINDINGS(PY_INTERFACE, BATCHED_INTERFACE, LIB_NAME)                                                    \
   /* make vector types opaque so they are not converted to python lists */                                                                 \
   PYBIND11_MAKE_OPAQUE(ocs2::scalar_array_t)                                                                                               \
   PYBIND11_MAKE_OPAQUE(ocs2::vector_array_t)                                                                                               \
   PYBIND11_MAKE_OPAQUE(ocs2::matrix_array_t)                                                                                               \
   /* create a python module */                                                                                                             \
   PYBIND11_MODULE(LIB_NAME, m) {                                                                                                           \
-    /* bind vector types so they can be used natively in python */                                                                         \
-    VECTOR_TYPE_BINDING(ocs2::scalar_array_t, "scalar_array")                                                                              \
-    VECTOR_TYPE_BINDING(ocs2::vector_array_t, "vector_array")                                                                              \
-    VECTOR_TYPE_BINDING(ocs2::matrix_array_t, "matrix_array")                                                                              \
-    /* bind approximation classes */                                                                                                       \
-    pybind11::class_<ocs2::VectorFunctionLinearApproximation>(m, "VectorFunctionLinearApproximation")                                      \
-        .def_readwrite("f", &ocs2::VectorFunctionLinearApproximation::f)                                                                   \
-        .def_readwrite("dfdx", &ocs2::VectorFunctionLinearApproximation::dfdx)                                                             \
-        .def_readwrite("dfdu", &ocs2::VectorFunctionLinearApproximation::dfdu);                                                            \
-    pybind11::class_<ocs2::VectorFunctionQuadraticApproximation>(m, "VectorFunctionQuadraticApproximation")                                \
-        .def_readwrite("f", &ocs2::VectorFunctionQuadraticApproximation::f)                                                                \
-        .def_readwrite("dfdx", &ocs2::VectorFunctionQuadraticApproximation::dfdx)                                                          \
-        .def_readwrite("dfdu", &ocs2::VectorFunctionQuadraticApproximation::dfdu)                                                          \
-        .def_readwrite("dfdxx", &ocs2::VectorFunctionQuadraticApproximation::dfdxx)                                                        \
-        .def_readwrite("dfdux", &ocs2::VectorFunctionQuadraticApproximation::dfdux)                                                        \
-        .def_readwrite("dfduu", &ocs2::VectorFunctionQuadraticApproximation::dfduu);                                                       \
-    pybind11::class_<ocs2::ScalarFunctionQuadraticApproximation>(m, "ScalarFunctionQuadraticApproximation")                                \
-        .def_readwrite("f", &ocs2::ScalarFunctionQuadraticApproximation::f)                                                                \
-        .def_readwrite("dfdx", &ocs2::ScalarFunctionQuadraticApproximation::dfdx)                                                          \
-        .def_readwrite("dfdu", &ocs2::ScalarFunctionQuadraticApproximation::dfdu)                                                          \
-        .def_readwrite("dfdxx", &ocs2::ScalarFunctionQuadraticApproximation::dfdxx)                                                        \
-        .def_readwrite("dfdux", &ocs2::ScalarFunctionQuadraticApproximation::dfdux)                                                        \
-        .def_readwrite("dfduu", &ocs2::ScalarFunctionQuadraticApproximation::dfduu);                                                       \
-    /* bind TargetTrajectories class */                                                                                                    \
-    pybind11::class_<ocs2::TargetTrajectories>(m, "TargetTrajectories")                                                                    \
-        .def(pybind11::init<ocs2::scalar_array_t, ocs2::vector_array_t, ocs2::vector_array_t>());                                          \
-    /* bind the actual mpc interface */                                                                                                    \
-    pybind11::class_<PY_INTERFACE>(m, "mpc_interface")                                                                                     \
-        .def(pybind11::init<const std::string&, const std::string&, const std::string&>(), "taskFile"_a, "libFolder"_a, "urdfFile"_a = "") \
-        .def("getStateDim", &PY_INTERFACE::getStateDim)                                                                                    \
-        .def("getInputDim", &PY_INTERFACE::getInputDim)                                                                                    \
-        .def("setObservation", &PY_INTERFACE::setObservation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())                                 \
-        .def("setTargetTrajectories", &PY_INTERFACE::setTargetTrajectories, "targetTrajectories"_a)                                        \
-        .def("reset", &PY_INTERFACE::reset, "targetTrajectories"_a)                                                                        \
-        .def("advanceMpc", &PY_INTERFACE::advanceMpc)                                                                                      \
-        .def("getMpcSolution", &PY_INTERFACE::getMpcSolution, "t"_a.noconvert(), "x"_a.noconvert(), "u"_a.noconvert())                     \
-        .def("getLinearFeedbackGain", &PY_INTERFACE::getLinearFeedbackGain, "t"_a.noconvert())                                             \
-        .def("flowMap", &PY_INTERFACE::flowMap, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())                                               \
-        .def("flowMapLinearApproximation", &PY_INTERFACE::flowMapLinearApproximation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())         \
-        .def("cost", &PY_INTERFACE::cost, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())                                                     \
-        .def("costQuadraticApproximation", &PY_INTERFACE::costQuadraticApproximation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())         \
-        .def("valueFunction", &PY_INTERFACE::valueFunction, "t"_a, "x"_a.noconvert())                                                      \
-        .def("valueFunctionStateDerivative", &PY_INTERFACE::valueFunctionStateDerivative, "t"_a, "x"_a.noconvert())                        \
-        .def("stateInputEqualityConstraint", &PY_INTERFACE::stateInputEqualityConstraint, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())     \
-        .def("stateInputEqualityConstraintLinearApproximation", &PY_INTERFACE::stateInputEqualityConstraintLinearApproximation, "t"_a,     \
-             "x"_a.noconvert(), "u"_a.noconvert())                                                                                         \
-        .def("stateInputEqualityConstraintLagrangian", &PY_INTERFACE::stateInputEqualityConstraintLagrangian, "t"_a, "x"_a.noconvert(),    \
-             "u"_a.noconvert())                                                                                                            \
-        .def("visualizeTrajectory", &PY_INTERFACE::visualizeTrajectory, "t"_a.noconvert(), "x"_a.noconvert(), "u"_a.noconvert(),           \
-             "speed"_a);                                                                                                                   \
+    ROBOT_PYTHON_BINDINGS(PY_INTERFACE)                                                                                                    \
+    BATCHED_MPC_INTERFACE_BINDING(BATCHED_INTERFACE)                                                                                       \
   }
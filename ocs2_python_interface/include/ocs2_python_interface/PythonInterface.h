@@ -29,8 +29,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
 #include <ocs2_core/dynamics/SystemDynamicsBase.h>
 #include <ocs2_core/penalties/penalties/PenaltyBase.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
 #include <ocs2_mpc/MPC_MRT_Interface.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_robotic_tools/common/RobotInterface.h>
@@ -42,6 +48,10 @@ namespace ocs2 {
  * to the MPC_MRT_Interface to be used for Python bindings
  */
 class PythonInterface {
+ public:
+  /** Row-major matrix which maps to a C-contiguous (N, n) NumPy array without copies. */
+  using row_matrix_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
  protected:
   /** Constructor */
   PythonInterface() = default;
@@ -51,8 +61,9 @@ class PythonInterface {
    * @note This should be called from derived class constructor.
    * @param [in] robot: Robot interface.
    * @param [in] mpcPtr: The Python interface takes ownership of the mpcPtr
+   * @param [in] numThreads: The number of threads for the batched evaluations.
    */
-  void init(const RobotInterface& robot, std::unique_ptr<MPC_BASE> mpcPtr);
+  void init(const RobotInterface& robot, std::unique_ptr<MPC_BASE> mpcPtr, size_t numThreads = 1);
 
  public:
   /** Destructor */
@@ -106,6 +117,21 @@ class PythonInterface {
    */
   void getMpcSolution(scalar_array_t& t, vector_array_t& x, vector_array_t& u);
 
+  /**
+   * @brief Updates the policy and stores the MPC solution in new contiguous trajectories. The getters below share
+   * them without copies: the NumPy arrays on the Python side keep their buffers alive, which the next call does not modify.
+   */
+  void updateMpcSolution();
+
+  /** The time trajectory of the last updateMpcSolution call, (N,) */
+  std::shared_ptr<const vector_t> getMpcSolutionTimeTrajectory() const;
+
+  /** The state trajectory of the last updateMpcSolution call, (N, stateDim) */
+  std::shared_ptr<const row_matrix_t> getMpcSolutionStateTrajectory() const;
+
+  /** The input trajectory of the last updateMpcSolution call, (N, inputDim) */
+  std::shared_ptr<const row_matrix_t> getMpcSolutionInputTrajectory() const;
+
   /**
    * @brief Obtains feedback gain matrix, if the underlying MPC algorithm computes it
    * @param[in] t: Query time
@@ -122,6 +148,35 @@ class PythonInterface {
   /** Cost function with added penalty term */
   scalar_t cost(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u);
 
+  /**
+   * Batched system dynamics. Each row of x and u is a query point. The queries are evaluated in parallel.
+   * @param[in] t: Query times, (N,)
+   * @param[in] x: Query states, (N, stateDim)
+   * @param[in] u: Query inputs, (N, inputDim)
+   * @return The flow maps, (N, stateDim)
+   */
+  row_matrix_t flowMapBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x, Eigen::Ref<const row_matrix_t> u);
+
+  /**
+   * Batched system dynamics linearization. The Jacobians of each query are stored as flattened row-major rows.
+   * @param[in] t: Query times, (N,)
+   * @param[in] x: Query states, (N, stateDim)
+   * @param[in] u: Query inputs, (N, inputDim)
+   * @return The tuple of the flow maps (N, stateDim), dfdx (N, stateDim * stateDim), and dfdu (N, stateDim * inputDim)
+   */
+  std::tuple<row_matrix_t, row_matrix_t, row_matrix_t> flowMapLinearApproximationBatch(Eigen::Ref<const vector_t> t,
+                                                                                       Eigen::Ref<const row_matrix_t> x,
+                                                                                       Eigen::Ref<const row_matrix_t> u);
+
+  /**
+   * Batched cost function with added penalty term.
+   * @param[in] t: Query times, (N,)
+   * @param[in] x: Query states, (N, stateDim)
+   * @param[in] u: Query inputs, (N, inputDim)
+   * @return The costs, (N,)
+   */
+  vector_t costBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x, Eigen::Ref<const row_matrix_t> u);
+
   /** Cost function quadratic approximation with added penalty term */
   ScalarFunctionQuadraticApproximation costQuadraticApproximation(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u);
 
@@ -186,11 +241,31 @@ class PythonInterface {
   int inputDim_ = -1;  // -1 indicates that it is not initialized
 
  private:
+  /** Checks the dimensions of a batch and returns the number of queries. */
+  size_t checkBatch(const Eigen::Ref<const vector_t>& t, const Eigen::Ref<const row_matrix_t>& x,
+                    const Eigen::Ref<const row_matrix_t>& u) const;
+
+  /**
+   * Runs the evaluation of the queries in the thread pool, each worker with its own copy of the optimal control problem.
+   * The batched calls release the GIL, therefore concurrent batches from different Python threads are serialized here.
+   */
+  void runBatch(size_t numQueries, const std::function<void(OptimalControlProblem&, size_t)>& evaluate);
+
   std::unique_ptr<MPC_BASE> mpcPtr_;
   std::unique_ptr<MPC_MRT_Interface> mpcMrtInterface_;
+  // guards the MPC solution, the policy and the solution buffers, since costBatch reads the dual solution without the GIL
+  mutable std::mutex solutionMutex_;
 
   TargetTrajectories targetTrajectories_;
   OptimalControlProblem problem_;
+
+  std::unique_ptr<ThreadPool> threadPoolPtr_;
+  std::vector<OptimalControlProblem> problemStock_;  // one per worker for the batched evaluations
+  std::mutex batchMutex_;                            // guards threadPoolPtr_, problemStock_ and targetTrajectories_
+
+  std::shared_ptr<const vector_t> timeTrajectoryPtr_ = std::make_shared<const vector_t>();
+  std::shared_ptr<const row_matrix_t> stateTrajectoryPtr_ = std::make_shared<const row_matrix_t>();
+  std::shared_ptr<const row_matrix_t> inputTrajectoryPtr_ = std::make_shared<const row_matrix_t>();
 };
 
 }  // namespace ocs2
@@ -0,0 +1,225 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_python_interface/BatchedMpcInterface.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <string>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchedMpcInterface::init(size_t numInstances, const mpc_factory_t& mpcFactory, size_t numThreads) {
+  if (numInstances == 0) {
+    throw std::runtime_error("[BatchedMpcInterface] The number of MPC instances should be positive.");
+  }
+
+  instances_.clear();
+  instances_.reserve(numInstances);
+  for (size_t i = 0; i < numInstances; i++) {
+    Instance instance;
+    instance.mpcPtr = mpcFactory();
+    if (!instance.mpcPtr) {
+      throw std::runtime_error("[BatchedMpcInterface] The MPC factory returned a nullptr.");
+    }
+    instance.mpcMrtInterfacePtr.reset(new MPC_MRT_Interface(*instance.mpcPtr));
+    instances_.push_back(std::move(instance));
+  }  // end of i loop
+
+  // the calling thread is also a worker
+  numThreads_ = std::max(std::min(numThreads, numInstances), size_t(1));
+  threadPoolPtr_.reset(new ThreadPool(numThreads_ - 1));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchedMpcInterface::checkBatchSize(Eigen::Index numRows) const {
+  if (numRows != static_cast<Eigen::Index>(instances_.size())) {
+    throw std::runtime_error("[BatchedMpcInterface] The batch size (" + std::to_string(numRows) +
+                             ") should be equal to the number of MPC instances (" + std::to_string(instances_.size()) + ").");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchedMpcInterface::runForAllInstances(const std::function<void(Instance&)>& function) {
+  // an exception may not leave a task since runParallel would not wait for the other workers
+  std::vector<std::exception_ptr> exceptions(instances_.size());
+  std::atomic_size_t nextInstance{0};
+  auto task = [&](int) {
+    size_t i = nextInstance++;
+    while (i < instances_.size()) {
+      try {
+        function(instances_[i]);
+      } catch (...) {
+        exceptions[i] = std::current_exception();
+      }
+      i = nextInstance++;
+    }
+  };
+  threadPoolPtr_->runParallel(task, numThreads_);
+
+  for (const auto& exceptionPtr : exceptions) {
+    if (exceptionPtr) {
+      std::rethrow_exception(exceptionPtr);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchedMpcInterface::reset(const std::vector<TargetTrajectories>& targetTrajectories) {
+  checkBatchSize(targetTrajectories.size());
+  std::lock_guard<std::mutex> lock(instancesMutex_);
+  for (size_t i = 0; i < instances_.size(); i++) {
+    instances_[i].mpcMrtInterfacePtr->resetMpcNode(targetTrajectories[i]);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchedMpcInterface::setTargetTrajectories(const std::vector<TargetTrajectories>& targetTrajectories) {
+  checkBatchSize(targetTrajectories.size());
+  std::lock_guard<std::mutex> lock(instancesMutex_);
+  for (size_t i = 0; i < instances_.size(); i++) {
+    instances_[i].mpcMrtInterfacePtr->getReferenceManager().setTargetTrajectories(targetTrajectories[i]);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchedMpcInterface::setObservations(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x,
+                                          Eigen::Ref<const row_matrix_t> u) {
+  checkBatchSize(t.size());
+  checkBatchSize(x.rows());
+  checkBatchSize(u.rows());
+  std::lock_guard<std::mutex> lock(instancesMutex_);
+  for (size_t i = 0; i < instances_.size(); i++) {
+    SystemObservation observation;
+    observation.time = t(i);
+    observation.state = x.row(i).transpose();
+    observation.input = u.row(i).transpose();
+    instances_[i].mpcMrtInterfacePtr->setCurrentObservation(observation);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchedMpcInterface::advanceMpc() {
+  std::lock_guard<std::mutex> lock(instancesMutex_);
+  runForAllInstances([](Instance& instance) { instance.mpcMrtInterfacePtr->advanceMpc(); });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::tuple<BatchedMpcInterface::row_matrix_t, BatchedMpcInterface::row_matrix_t> BatchedMpcInterface::evaluatePolicies(
+    Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x) {
+  checkBatchSize(t.size());
+  checkBatchSize(x.rows());
+  std::lock_guard<std::mutex> lock(instancesMutex_);
+
+  row_matrix_t optimalStates;
+  row_matrix_t optimalInputs;
+  vector_t mpcState;
+  vector_t mpcInput;
+  size_t mode;
+  for (size_t i = 0; i < instances_.size(); i++) {
+    auto& mpcMrtInterface = *instances_[i].mpcMrtInterfacePtr;
+    mpcMrtInterface.updatePolicy();
+    mpcMrtInterface.evaluatePolicy(t(i), x.row(i).transpose(), mpcState, mpcInput, mode);
+    if (i == 0) {
+      optimalStates.resize(instances_.size(), mpcState.size());
+      optimalInputs.resize(instances_.size(), mpcInput.size());
+    }
+    optimalStates.row(i) = mpcState.transpose();
+    optimalInputs.row(i) = mpcInput.transpose();
+  }  // end of i loop
+
+  return std::make_tuple(std::move(optimalStates), std::move(optimalInputs));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchedMpcInterface::updateMpcSolutions() {
+  std::lock_guard<std::mutex> lock(instancesMutex_);
+  runForAllInstances([](Instance& instance) {
+    instance.mpcMrtInterfacePtr->updatePolicy();
+    const auto& policy = instance.mpcMrtInterfacePtr->getPolicy();
+    const size_t N = policy.timeTrajectory_.size();
+
+    auto stateTrajectoryPtr = std::make_shared<row_matrix_t>(N, N > 0 ? policy.stateTrajectory_.front().size() : 0);
+    auto inputTrajectoryPtr = std::make_shared<row_matrix_t>(N, N > 0 ? policy.inputTrajectory_.front().size() : 0);
+    for (size_t k = 0; k < N; k++) {
+      stateTrajectoryPtr->row(k) = policy.stateTrajectory_[k].transpose();
+      inputTrajectoryPtr->row(k) = policy.inputTrajectory_[k].transpose();
+    }
+
+    instance.timeTrajectoryPtr = std::make_shared<const vector_t>(Eigen::Map<const vector_t>(policy.timeTrajectory_.data(), N));
+    instance.stateTrajectoryPtr = std::move(stateTrajectoryPtr);
+    instance.inputTrajectoryPtr = std::move(inputTrajectoryPtr);
+  });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<const vector_t> BatchedMpcInterface::getMpcSolutionTimeTrajectory(size_t i) const {
+  std::lock_guard<std::mutex> lock(instancesMutex_);
+  return instances_.at(i).timeTrajectoryPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<const BatchedMpcInterface::row_matrix_t> BatchedMpcInterface::getMpcSolutionStateTrajectory(size_t i) const {
+  std::lock_guard<std::mutex> lock(instancesMutex_);
+  return instances_.at(i).stateTrajectoryPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<const BatchedMpcInterface::row_matrix_t> BatchedMpcInterface::getMpcSolutionInputTrajectory(size_t i) const {
+  std::lock_guard<std::mutex> lock(instancesMutex_);
+  return instances_.at(i).inputTrajectoryPtr;
+}
+
+}  // namespace ocs2
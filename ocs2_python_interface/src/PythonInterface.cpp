@@ -29,17 +29,50 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_python_interface/PythonInterface.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_core/penalties/MultidimensionalPenalty.h>
 
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
 
 namespace ocs2 {
+namespace {
+
+/** Cost function with added Lagrangian penalty terms for the given multipliers */
+scalar_t computeCostWithLagrangians(OptimalControlProblem& problem, scalar_t t, const vector_t& x, const vector_t& u,
+                                    const MultiplierCollection& m) {
+  auto& preComputation = *problem.preComputationPtr;
+  const auto request = Request::Cost + Request::SoftConstraint + Request::Constraint;
+  preComputation.request(request, t, x, u);
+
+  // cost
+  scalar_t cost = computeCost(problem, t, x, u);
+
+  // Lagrangians
+  if (!problem.stateEqualityLagrangianPtr->empty()) {
+    cost += sumPenalties(problem.stateEqualityLagrangianPtr->getValue(t, x, m.stateEq, preComputation));
+  }
+  if (!problem.stateInequalityLagrangianPtr->empty()) {
+    cost += sumPenalties(problem.stateInequalityLagrangianPtr->getValue(t, x, m.stateIneq, preComputation));
+  }
+  if (!problem.equalityLagrangianPtr->empty()) {
+    cost += sumPenalties(problem.equalityLagrangianPtr->getValue(t, x, u, m.stateInputEq, preComputation));
+  }
+  if (!problem.inequalityLagrangianPtr->empty()) {
+    cost += sumPenalties(problem.inequalityLagrangianPtr->getValue(t, x, u, m.stateInputIneq, preComputation));
+  }
+
+  return cost;
+}
+
+}  // unnamed namespace
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void PythonInterface::init(const RobotInterface& robot, std::unique_ptr<MPC_BASE> mpcPtr) {
+void PythonInterface::init(const RobotInterface& robot, std::unique_ptr<MPC_BASE> mpcPtr, size_t numThreads) {
   if (!mpcPtr) {
     throw std::runtime_error("[PythonInterface] Mpc pointer must be initialized before passing to the Python interface.");
   }
@@ -48,15 +81,29 @@ void PythonInterface::init(const RobotInterface& robot, std::unique_ptr<MPC_BASE
   mpcMrtInterface_.reset(new MPC_MRT_Interface(*mpcPtr_));
 
   problem_ = robot.getOptimalControlProblem();
+
+  // the calling thread is also a worker of the batched evaluations
+  numThreads = std::max(numThreads, size_t(1));
+  threadPoolPtr_.reset(new ThreadPool(numThreads - 1));
+  problemStock_.clear();
+  problemStock_.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; i++) {
+    problemStock_.push_back(problem_);
+  }
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void PythonInterface::reset(TargetTrajectories targetTrajectories) {
+  std::lock_guard<std::mutex> lock(solutionMutex_);
+  std::lock_guard<std::mutex> batchLock(batchMutex_);  // the targets are read by the batches
   targetTrajectories_ = std::move(targetTrajectories);
   mpcMrtInterface_->resetMpcNode(targetTrajectories_);
   problem_.targetTrajectoriesPtr = &targetTrajectories_;
+  for (auto& problem : problemStock_) {
+    problem.targetTrajectoriesPtr = &targetTrajectories_;
+  }
 }
 
 /******************************************************************************************************/
@@ -74,8 +121,12 @@ void PythonInterface::setObservation(scalar_t t, Eigen::Ref<const vector_t> x, E
 /******************************************************************************************************/
 /******************************************************************************************************/
 void PythonInterface::setTargetTrajectories(TargetTrajectories targetTrajectories) {
+  std::lock_guard<std::mutex> batchLock(batchMutex_);
   targetTrajectories_ = std::move(targetTrajectories);
   problem_.targetTrajectoriesPtr = &targetTrajectories_;
+  for (auto& problem : problemStock_) {
+    problem.targetTrajectoriesPtr = &targetTrajectories_;
+  }
   mpcMrtInterface_->getReferenceManager().setTargetTrajectories(targetTrajectories_);
 }
 
@@ -83,6 +134,7 @@ void PythonInterface::setTargetTrajectories(TargetTrajectories targetTrajectorie
 /******************************************************************************************************/
 /******************************************************************************************************/
 void PythonInterface::advanceMpc() {
+  std::lock_guard<std::mutex> lock(solutionMutex_);
   mpcMrtInterface_->advanceMpc();
 }
 
@@ -90,12 +142,60 @@ void PythonInterface::advanceMpc() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void PythonInterface::getMpcSolution(scalar_array_t& t, vector_array_t& x, vector_array_t& u) {
+  std::lock_guard<std::mutex> lock(solutionMutex_);
   mpcMrtInterface_->updatePolicy();
   t = mpcMrtInterface_->getPolicy().timeTrajectory_;
   x = mpcMrtInterface_->getPolicy().stateTrajectory_;
   u = mpcMrtInterface_->getPolicy().inputTrajectory_;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PythonInterface::updateMpcSolution() {
+  std::lock_guard<std::mutex> lock(solutionMutex_);
+  mpcMrtInterface_->updatePolicy();
+  const auto& policy = mpcMrtInterface_->getPolicy();
+  const size_t N = policy.timeTrajectory_.size();
+
+  // new buffers, since the previous ones might still be referenced by NumPy arrays
+  auto timeTrajectoryPtr = std::make_shared<vector_t>(Eigen::Map<const vector_t>(policy.timeTrajectory_.data(), N));
+  auto stateTrajectoryPtr = std::make_shared<row_matrix_t>(N, N > 0 ? policy.stateTrajectory_.front().size() : 0);
+  auto inputTrajectoryPtr = std::make_shared<row_matrix_t>(N, N > 0 ? policy.inputTrajectory_.front().size() : 0);
+  for (size_t i = 0; i < N; i++) {
+    stateTrajectoryPtr->row(i) = policy.stateTrajectory_[i].transpose();
+    inputTrajectoryPtr->row(i) = policy.inputTrajectory_[i].transpose();
+  }
+
+  timeTrajectoryPtr_ = std::move(timeTrajectoryPtr);
+  stateTrajectoryPtr_ = std::move(stateTrajectoryPtr);
+  inputTrajectoryPtr_ = std::move(inputTrajectoryPtr);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<const vector_t> PythonInterface::getMpcSolutionTimeTrajectory() const {
+  std::lock_guard<std::mutex> lock(solutionMutex_);
+  return timeTrajectoryPtr_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<const PythonInterface::row_matrix_t> PythonInterface::getMpcSolutionStateTrajectory() const {
+  std::lock_guard<std::mutex> lock(solutionMutex_);
+  return stateTrajectoryPtr_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<const PythonInterface::row_matrix_t> PythonInterface::getMpcSolutionInputTrajectory() const {
+  std::lock_guard<std::mutex> lock(solutionMutex_);
+  return inputTrajectoryPtr_;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -122,28 +222,98 @@ VectorFunctionLinearApproximation PythonInterface::flowMapLinearApproximation(sc
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t PythonInterface::cost(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u) {
-  auto& preComputation = *problem_.preComputationPtr;
-  const auto request = Request::Cost + Request::SoftConstraint + Request::Constraint;
-  preComputation.request(request, t, x, u);
-
-  // cost
-  scalar_t cost = computeCost(problem_, t, x, u);
+  return computeCostWithLagrangians(problem_, t, x, u, mpcMrtInterface_->getIntermediateDualSolution(t));
+}
 
-  // Lagrangians
-  const auto m = mpcMrtInterface_->getIntermediateDualSolution(t);
-  if (!problem_.stateEqualityLagrangianPtr->empty()) {
-    cost += sumPenalties(problem_.stateEqualityLagrangianPtr->getValue(t, x, m.stateEq, preComputation));
-  }
-  if (!problem_.stateInequalityLagrangianPtr->empty()) {
-    cost += sumPenalties(problem_.stateInequalityLagrangianPtr->getValue(t, x, m.stateIneq, preComputation));
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t PythonInterface::checkBatch(const Eigen::Ref<const vector_t>& t, const Eigen::Ref<const row_matrix_t>& x,
+                                   const Eigen::Ref<const row_matrix_t>& u) const {
+  if (x.rows() != t.size() || u.rows() != t.size()) {
+    throw std::runtime_error("[PythonInterface] The number of rows of x and u should be equal to the number of query times.");
   }
-  if (!problem_.equalityLagrangianPtr->empty()) {
-    cost += sumPenalties(problem_.equalityLagrangianPtr->getValue(t, x, u, m.stateInputEq, preComputation));
+  if ((stateDim_ >= 0 && x.cols() != stateDim_) || (inputDim_ >= 0 && u.cols() != inputDim_)) {
+    throw std::runtime_error("[PythonInterface] The number of columns of x and u should be equal to the state and input dimensions.");
   }
-  if (!problem_.inequalityLagrangianPtr->empty()) {
-    cost += sumPenalties(problem_.inequalityLagrangianPtr->getValue(t, x, u, m.stateInputIneq, preComputation));
+  return t.size();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PythonInterface::runBatch(size_t numQueries, const std::function<void(OptimalControlProblem&, size_t)>& evaluate) {
+  std::lock_guard<std::mutex> lock(batchMutex_);
+  std::atomic_size_t nextQuery{0};
+  auto task = [&](int workerIndex) {
+    auto& problem = problemStock_[workerIndex];
+    size_t i = nextQuery++;
+    while (i < numQueries) {
+      evaluate(problem, i);
+      i = nextQuery++;
+    }
+  };
+  threadPoolPtr_->runParallel(task, problemStock_.size());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PythonInterface::row_matrix_t PythonInterface::flowMapBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x,
+                                                            Eigen::Ref<const row_matrix_t> u) {
+  const size_t N = checkBatch(t, x, u);
+  row_matrix_t dxdt(N, x.cols());
+  runBatch(N, [&](OptimalControlProblem& problem, size_t i) {
+    const vector_t xi = x.row(i).transpose();
+    const vector_t ui = u.row(i).transpose();
+    dxdt.row(i) = problem.dynamicsPtr->computeFlowMap(t(i), xi, ui).transpose();
+  });
+  return dxdt;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::tuple<PythonInterface::row_matrix_t, PythonInterface::row_matrix_t, PythonInterface::row_matrix_t>
+PythonInterface::flowMapLinearApproximationBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x,
+                                                 Eigen::Ref<const row_matrix_t> u) {
+  const size_t N = checkBatch(t, x, u);
+  const size_t nx = x.cols();
+  const size_t nu = u.cols();
+  row_matrix_t f(N, nx);
+  row_matrix_t dfdx(N, nx * nx);
+  row_matrix_t dfdu(N, nx * nu);
+  runBatch(N, [&](OptimalControlProblem& problem, size_t i) {
+    const vector_t xi = x.row(i).transpose();
+    const vector_t ui = u.row(i).transpose();
+    const auto approximation = problem.dynamicsPtr->linearApproximation(t(i), xi, ui);
+    f.row(i) = approximation.f.transpose();
+    Eigen::Map<row_matrix_t>(dfdx.row(i).data(), nx, nx) = approximation.dfdx;
+    Eigen::Map<row_matrix_t>(dfdu.row(i).data(), nx, nu) = approximation.dfdu;
+  });
+  return std::make_tuple(std::move(f), std::move(dfdx), std::move(dfdu));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t PythonInterface::costBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x, Eigen::Ref<const row_matrix_t> u) {
+  const size_t N = checkBatch(t, x, u);
+
+  // snapshot of the dual solution, it runs without the GIL and hence is serialized with the solution updates by the mutex
+  std::vector<MultiplierCollection> multipliers;
+  multipliers.reserve(N);
+  {
+    std::lock_guard<std::mutex> lock(solutionMutex_);
+    for (size_t i = 0; i < N; i++) {
+      multipliers.push_back(mpcMrtInterface_->getIntermediateDualSolution(t(i)));
+    }
   }
 
+  vector_t cost(N);
+  runBatch(N, [&](OptimalControlProblem& problem, size_t i) {
+    cost(i) = computeCostWithLagrangians(problem, t(i), x.row(i).transpose(), u.row(i).transpose(), multipliers[i]);
+  });
   return cost;
 }
 
@@ -1,14 +1,18 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/cost/QuadraticStateCost.h>
 #include <ocs2_core/cost/QuadraticStateInputCost.h>
 #include <ocs2_core/dynamics/LinearSystemDynamics.h>
 #include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_ddp/GaussNewtonDDP_MPC.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 
+#include <ocs2_python_interface/BatchedMpcInterface.h>
 #include <ocs2_python_interface/PythonInterface.h>
 #include <ocs2_robotic_tools/common/RobotInterface.h>
 
@@ -60,7 +64,15 @@ class DummyPyBindings final : public PythonInterface {
 
   DummyPyBindings() {
     DummyInterface robot;
-    PythonInterface::init(robot, robot.getMpc());
+    PythonInterface::init(robot, robot.getMpc(), 2);
+  }
+};
+
+class DummyBatchedPyBindings final : public BatchedMpcInterface {
+ public:
+  DummyBatchedPyBindings(size_t numInstances, size_t numThreads) {
+    DummyInterface robot;
+    BatchedMpcInterface::init(numInstances, [&]() { return std::unique_ptr<MPC_BASE>(robot.getMpc()); }, numThreads);
   }
 };
 
@@ -70,3 +82,196 @@ class DummyPyBindings final : public PythonInterface {
 TEST(OCS2PyBindingsTest, createDummyPyBindings) {
   ocs2::pybindings_test::DummyPyBindings dummy;
 }
+
+TEST(OCS2PyBindingsTest, batchedEvaluation) {
+  using row_matrix_t = ocs2::PythonInterface::row_matrix_t;
+  ocs2::pybindings_test::DummyPyBindings dummy;
+
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();
+  dummy.reset(ocs2::TargetTrajectories({0.0}, {ocs2::vector_t::Zero(2)}, {ocs2::vector_t::Zero(1)}));
+  dummy.setObservation(0.0, initState, ocs2::vector_t::Zero(1));
+  dummy.advanceMpc();
+
+  // contiguous solution
+  dummy.updateMpcSolution();
+  const ocs2::vector_t t = *dummy.getMpcSolutionTimeTrajectory();
+  const row_matrix_t x = *dummy.getMpcSolutionStateTrajectory();
+  const row_matrix_t u = *dummy.getMpcSolutionInputTrajectory();
+  ocs2::scalar_array_t tArray;
+  ocs2::vector_array_t xArray, uArray;
+  dummy.getMpcSolution(tArray, xArray, uArray);
+  ASSERT_EQ(t.size(), tArray.size());
+  ASSERT_EQ(x.rows(), xArray.size());
+  ASSERT_EQ(u.rows(), uArray.size());
+  for (size_t i = 0; i < tArray.size(); i++) {
+    EXPECT_DOUBLE_EQ(t(i), tArray[i]);
+    EXPECT_TRUE(x.row(i).transpose().isApprox(xArray[i]));
+    EXPECT_TRUE(u.row(i).transpose().isApprox(uArray[i]));
+  }
+
+  // batched evaluations are equal to the single-point ones
+  const row_matrix_t flowMaps = dummy.flowMapBatch(t, x, u);
+  const auto linearApproximations = dummy.flowMapLinearApproximationBatch(t, x, u);
+  const ocs2::vector_t costs = dummy.costBatch(t, x, u);
+  for (size_t i = 0; i < tArray.size(); i++) {
+    EXPECT_TRUE(flowMaps.row(i).transpose().isApprox(dummy.flowMap(t(i), xArray[i], uArray[i])));
+    const auto linearApproximation = dummy.flowMapLinearApproximation(t(i), xArray[i], uArray[i]);
+    EXPECT_TRUE(std::get<0>(linearApproximations).row(i).transpose().isApprox(linearApproximation.f));
+    EXPECT_TRUE(Eigen::Map<const row_matrix_t>(std::get<1>(linearApproximations).row(i).data(), 2, 2).isApprox(linearApproximation.dfdx));
+    EXPECT_TRUE(Eigen::Map<const row_matrix_t>(std::get<2>(linearApproximations).row(i).data(), 2, 1).isApprox(linearApproximation.dfdu));
+    EXPECT_NEAR(costs(i), dummy.cost(t(i), xArray[i], uArray[i]), 1e-12);
+  }
+
+  EXPECT_THROW(dummy.flowMapBatch(t, x.topRows(1), u), std::runtime_error);
+
+  // concurrent batches, as from Python threads while the GIL is released
+  std::vector<ocs2::vector_t> concurrentCosts(4);
+  std::vector<std::thread> threads;
+  for (size_t j = 0; j < concurrentCosts.size(); j++) {
+    threads.emplace_back([&, j]() { concurrentCosts[j] = dummy.costBatch(t, x, u); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& c : concurrentCosts) {
+    EXPECT_TRUE(c.isApprox(costs));
+  }
+
+  // batches concurrent to the MPC updates, which swap the policy buffers that hold the dual solution
+  std::thread batchThread([&]() {
+    for (size_t j = 0; j < 20; j++) {
+      EXPECT_EQ(dummy.costBatch(t, x, u).size(), t.size());
+    }
+  });
+  for (size_t j = 0; j < 20; j++) {
+    dummy.setObservation(0.0, initState, ocs2::vector_t::Zero(1));
+    dummy.advanceMpc();
+    dummy.updateMpcSolution();
+  }
+  batchThread.join();
+}
+
+TEST(OCS2PyBindingsTest, sharedSolutionBuffers) {
+  ocs2::pybindings_test::DummyPyBindings dummy;
+
+  dummy.reset(ocs2::TargetTrajectories({0.0}, {ocs2::vector_t::Zero(2)}, {ocs2::vector_t::Zero(1)}));
+  dummy.setObservation(0.0, (ocs2::vector_t(2) << 1.0, 0.0).finished(), ocs2::vector_t::Zero(1));
+  dummy.advanceMpc();
+  dummy.updateMpcSolution();
+
+  // the getters share the buffers without copies
+  const auto timeTrajectoryPtr = dummy.getMpcSolutionTimeTrajectory();
+  const auto stateTrajectoryPtr = dummy.getMpcSolutionStateTrajectory();
+  EXPECT_EQ(timeTrajectoryPtr->data(), dummy.getMpcSolutionTimeTrajectory()->data());
+  EXPECT_EQ(stateTrajectoryPtr->data(), dummy.getMpcSolutionStateTrajectory()->data());
+  const ocs2::vector_t timeTrajectory = *timeTrajectoryPtr;
+  const ocs2::PythonInterface::row_matrix_t stateTrajectory = *stateTrajectoryPtr;
+
+  // a new solution does not modify the buffers which are still referenced, e.g. by NumPy arrays
+  dummy.setObservation(0.1, (ocs2::vector_t(2) << -1.0, 0.5).finished(), ocs2::vector_t::Zero(1));
+  dummy.advanceMpc();
+  dummy.updateMpcSolution();
+  EXPECT_NE(timeTrajectoryPtr, dummy.getMpcSolutionTimeTrajectory());
+  EXPECT_NE(stateTrajectoryPtr, dummy.getMpcSolutionStateTrajectory());
+  EXPECT_TRUE(timeTrajectoryPtr->isApprox(timeTrajectory));
+  EXPECT_TRUE(stateTrajectoryPtr->isApprox(stateTrajectory));
+  EXPECT_FALSE(dummy.getMpcSolutionStateTrajectory()->row(0).isApprox(stateTrajectory.row(0)));
+}
+
+TEST(OCS2PyBindingsTest, batchedMpc) {
+  using row_matrix_t = ocs2::BatchedMpcInterface::row_matrix_t;
+  constexpr size_t numInstances = 4;
+  ocs2::pybindings_test::DummyBatchedPyBindings batchedMpc(numInstances, 2);
+  ASSERT_EQ(batchedMpc.getNumInstances(), numInstances);
+
+  // different initial conditions and targets
+  const ocs2::vector_t t = ocs2::vector_t::Zero(numInstances);
+  const row_matrix_t x = row_matrix_t::Random(numInstances, 2);
+  const row_matrix_t u = row_matrix_t::Zero(numInstances, 1);
+  std::vector<ocs2::TargetTrajectories> targetTrajectories;
+  for (size_t i = 0; i < numInstances; i++) {
+    targetTrajectories.emplace_back(ocs2::scalar_array_t{0.0}, ocs2::vector_array_t{ocs2::vector_t::Constant(2, 0.1 * i)},
+                                    ocs2::vector_array_t{ocs2::vector_t::Zero(1)});
+  }
+
+  batchedMpc.reset(targetTrajectories);
+  batchedMpc.setObservations(t, x, u);
+  batchedMpc.advanceMpc();
+  batchedMpc.updateMpcSolutions();
+  const auto policies = batchedMpc.evaluatePolicies(t, x);
+  ASSERT_EQ(std::get<0>(policies).rows(), numInstances);
+  ASSERT_EQ(std::get<1>(policies).rows(), numInstances);
+
+  // each instance is equal to a single MPC with the same observation and target
+  for (size_t i = 0; i < numInstances; i++) {
+    ocs2::pybindings_test::DummyPyBindings mpc;
+    mpc.reset(targetTrajectories[i]);
+    mpc.setObservation(t(i), x.row(i).transpose(), u.row(i).transpose());
+    mpc.advanceMpc();
+    mpc.updateMpcSolution();
+
+    EXPECT_TRUE(batchedMpc.getMpcSolutionTimeTrajectory(i)->isApprox(*mpc.getMpcSolutionTimeTrajectory()));
+    EXPECT_TRUE(batchedMpc.getMpcSolutionStateTrajectory(i)->isApprox(*mpc.getMpcSolutionStateTrajectory()));
+    EXPECT_TRUE(batchedMpc.getMpcSolutionInputTrajectory(i)->isApprox(*mpc.getMpcSolutionInputTrajectory()));
+    EXPECT_TRUE(std::get<1>(policies).row(i).isApprox(mpc.getMpcSolutionInputTrajectory()->row(0)));
+  }
+
+  EXPECT_THROW(batchedMpc.setObservations(t.head(1), x, u), std::runtime_error);
+}
+
+TEST(OCS2PyBindingsTest, batchedMpcConcurrentAccess) {
+  using row_matrix_t = ocs2::BatchedMpcInterface::row_matrix_t;
+  constexpr size_t numInstances = 4;
+  ocs2::pybindings_test::DummyBatchedPyBindings batchedMpc(numInstances, 2);
+
+  const ocs2::vector_t t = ocs2::vector_t::Zero(numInstances);
+  const row_matrix_t x = row_matrix_t::Random(numInstances, 2);
+  const row_matrix_t u = row_matrix_t::Zero(numInstances, 1);
+  batchedMpc.reset(std::vector<ocs2::TargetTrajectories>(numInstances, ocs2::TargetTrajectories({0.0}, {ocs2::vector_t::Zero(2)},
+                                                                                                 {ocs2::vector_t::Zero(1)})));
+  batchedMpc.setObservations(t, x, u);
+  batchedMpc.advanceMpc();
+  batchedMpc.updateMpcSolutions();
+
+  // the solutions are read while another thread updates them, as from Python while the GIL is released
+  std::thread updateThread([&]() {
+    for (size_t j = 0; j < 20; j++) {
+      batchedMpc.setObservations(t, x, u);
+      batchedMpc.advanceMpc();
+      batchedMpc.updateMpcSolutions();
+    }
+  });
+  for (size_t j = 0; j < 100; j++) {
+    const size_t i = j % numInstances;
+    const auto timeTrajectoryPtr = batchedMpc.getMpcSolutionTimeTrajectory(i);
+    const auto stateTrajectoryPtr = batchedMpc.getMpcSolutionStateTrajectory(i);
+    EXPECT_GT(timeTrajectoryPtr->size(), 0);
+    EXPECT_EQ(stateTrajectoryPtr->cols(), 2);
+  }
+  updateThread.join();
+}
+
+TEST(OCS2PyBindingsTest, batchedMpcScaling) {
+  using row_matrix_t = ocs2::BatchedMpcInterface::row_matrix_t;
+  constexpr size_t numInstances = 8;
+  constexpr size_t numRepetitions = 5;
+  const ocs2::vector_t t = ocs2::vector_t::Zero(numInstances);
+  const row_matrix_t x = row_matrix_t::Random(numInstances, 2);
+  const row_matrix_t u = row_matrix_t::Zero(numInstances, 1);
+  const std::vector<ocs2::TargetTrajectories> targetTrajectories(
+      numInstances, ocs2::TargetTrajectories({0.0}, {ocs2::vector_t::Zero(2)}, {ocs2::vector_t::Zero(1)}));
+
+  std::cerr << "[BatchedMpcInterface] " << numInstances << " instances, " << std::thread::hardware_concurrency() << " cores\n";
+  for (size_t numThreads : {1, 2, 4}) {
+    ocs2::pybindings_test::DummyBatchedPyBindings batchedMpc(numInstances, numThreads);
+    ocs2::benchmark::RepeatedTimer timer;
+    for (size_t j = 0; j < numRepetitions; j++) {
+      batchedMpc.reset(targetTrajectories);
+      batchedMpc.setObservations(t, x, u);
+      timer.startTimer();
+      batchedMpc.advanceMpc();
+      timer.endTimer();
+    }
+    std::cerr << "  " << numThreads << " threads, average time of advanceMpc: " << timer.getAverageInMilliseconds() << " [ms]\n";
+  }
+}
@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <ocs2_ddp/GaussNewtonDDP_MPC.h>
+#include <ocs2_python_interface/BatchedMpcInterface.h>
 #include <ocs2_python_interface/PythonInterface.h>
 
 #include "ocs2_ballbot/BallbotInterface.h"
@@ -65,7 +66,49 @@ class BallbotPyBindings final : public PythonInterface {
     mpcPtr->getSolverPtr()->setReferenceManager(ballbotInterface.getReferenceManagerPtr());
 
     // Python interface
-    PythonInterface::init(ballbotInterface, std::move(mpcPtr));
+    PythonInterface::init(ballbotInterface, std::move(mpcPtr), ballbotInterface.ddpSettings().nThreads_);
+  }
+};
+
+class BallbotBatchedPyBindings final : public BatchedMpcInterface {
+ public:
+  /**
+   * Constructor
+   *
+   * @note Creates directory for generated library into if it does not exist.
+   * @throw Invalid argument error if input task file does not exist.
+   *
+   * @param [in] taskFile: The absolute path to the configuration file for the MPC.
+   * @param [in] libraryFolder: The absolute path to the directory to generate CppAD library into.
+   * @param [in] numInstances: The number of MPC instances.
+   * @param [in] numThreads: The number of threads which advance the instances.
+   * @param [in] urdfFile: The absolute path to the URDF of the robot. This is not used for ballbot.
+   */
+  BallbotBatchedPyBindings(const std::string& taskFile, const std::string& libraryFolder, size_t numInstances, size_t numThreads,
+                           const std::string urdfFile = "") {
+    // System dimensions
+    stateDim_ = static_cast<int>(STATE_DIM);
+    inputDim_ = static_cast<int>(INPUT_DIM);
+
+    // Robot interface
+    BallbotInterface ballbotInterface(taskFile, libraryFolder);
+
+    // the instances run in parallel, hence each solver is single threaded
+    ddp::Settings ddpSettings = ballbotInterface.ddpSettings();
+    ddpSettings.nThreads_ = 1;
+
+    // MPC instances, each with its own ReferenceManager
+    auto mpcFactory = [&]() {
+      std::unique_ptr<GaussNewtonDDP_MPC> mpcPtr(new GaussNewtonDDP_MPC(ballbotInterface.mpcSettings(), ddpSettings,
+                                                                        ballbotInterface.getRollout(),
+                                                                        ballbotInterface.getOptimalControlProblem(),
+                                                                        ballbotInterface.getInitializer()));
+      mpcPtr->getSolverPtr()->setReferenceManager(std::make_shared<ReferenceManager>());
+      return std::unique_ptr<MPC_BASE>(std::move(mpcPtr));
+    };
+
+    // Batched interface
+    BatchedMpcInterface::init(numInstances, mpcFactory, numThreads);
   }
 };
 
@@ -1,2 +1,2 @@
-from ocs2_ballbot.BallbotPyBindings import mpc_interface
+from ocs2_ballbot.BallbotPyBindings import mpc_interface, batched_mpc_interface
 from ocs2_ballbot.BallbotPyBindings import scalar_array, vector_array, matrix_array, TargetTrajectories
@@ -1,4 +1,4 @@
 #include <ocs2_ballbot/BallbotPyBindings.h>
 #include <ocs2_python_interface/PybindMacros.h>
 
-CREATE_ROBOT_PYTHON_BINDINGS(ocs2::ballbot::BallbotPyBindings, BallbotPyBindings)
+CREATE_ROBOT_BATCHED_PYTHON_BINDINGS(ocs2::ballbot::BallbotPyBindings, ocs2::ballbot::BallbotBatchedPyBindings, BallbotPyBindings)
@@ -0,0 +1,139 @@
+"""
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+"""
+
+"""
+Compares the single-point Python bindings of the ballbot against the contiguous
+and batched ones. Run with: python benchmarkBallbotPyBindings.py [numQueries]
+"""
+
+import os
+import sys
+import timeit
+
+import numpy as np
+import rospkg
+
+from ocs2_ballbot import mpc_interface
+from ocs2_ballbot import (
+    scalar_array,
+    vector_array,
+    TargetTrajectories,
+)
+
+
+def benchmark(name, function, repetitions):
+    duration = min(timeit.repeat(function, number=1, repeat=repetitions))
+    print("{:<45s} {:10.3f} [ms]".format(name, 1e3 * duration))
+    return duration
+
+
+def main(numQueries):
+    packageDir = rospkg.RosPack().get_path('ocs2_ballbot')
+    taskFile = os.path.join(packageDir, 'config/mpc/task.info')
+    libFolder = os.path.join(packageDir, 'auto_generated')
+    mpc = mpc_interface(taskFile, libFolder)
+    stateDim = mpc.getStateDim()
+    inputDim = mpc.getInputDim()
+
+    # solve the MPC once
+    desiredTimeTraj = scalar_array()
+    desiredTimeTraj.push_back(2.0)
+    desiredStateTraj = vector_array()
+    desiredStateTraj.push_back(np.zeros(stateDim))
+    desiredInputTraj = vector_array()
+    desiredInputTraj.push_back(np.zeros(inputDim))
+    mpc.reset(TargetTrajectories(desiredTimeTraj, desiredStateTraj, desiredInputTraj))
+    x0 = np.zeros(stateDim)
+    x0[0] = 0.3
+    x0[1] = 0.5
+    mpc.setObservation(0.0, x0, np.zeros(inputDim))
+    mpc.advanceMpc()
+
+    repetitions = 5
+    print("### MPC solution")
+
+    def solutionAsList():
+        t_result = scalar_array()
+        x_result = vector_array()
+        u_result = vector_array()
+        mpc.getMpcSolution(t_result, x_result, u_result)
+        return np.array(list(t_result)), np.array(list(x_result)), np.array(list(u_result))
+
+    def solutionAsArrays():
+        mpc.updateMpcSolution()
+        return mpc.getMpcSolutionTimeTrajectory(), mpc.getMpcSolutionStateTrajectory(), mpc.getMpcSolutionInputTrajectory()
+
+    benchmark("getMpcSolution + conversion to arrays", solutionAsList, repetitions)
+    benchmark("updateMpcSolution + NumPy arrays", solutionAsArrays, repetitions)
+
+    # random queries around the optimal trajectory
+    print("\n### {} queries".format(numQueries))
+    t_sol, x_sol, u_sol = solutionAsArrays()
+    rng = np.random.default_rng(0)
+    indices = rng.integers(0, len(t_sol), numQueries)
+    t = np.ascontiguousarray(t_sol[indices])
+    x = np.ascontiguousarray(x_sol[indices] + 0.01 * rng.standard_normal((numQueries, stateDim)))
+    u = np.ascontiguousarray(u_sol[indices] + 0.01 * rng.standard_normal((numQueries, inputDim)))
+
+    def checkedSpeedup(name, single, batched, compare):
+        singleDuration = benchmark(name, single, repetitions)
+        batchedDuration = benchmark(name + "Batch", batched, repetitions)
+        compare(single(), batched())
+        print("{:<45s} {:10.1f}x".format("speedup", singleDuration / batchedDuration))
+
+    checkedSpeedup(
+        "flowMap",
+        lambda: np.array([mpc.flowMap(t[i], x[i], u[i]) for i in range(numQueries)]),
+        lambda: mpc.flowMapBatch(t, x, u),
+        lambda a, b: np.testing.assert_allclose(a, b, rtol=1e-9, atol=1e-12),
+    )
+
+    def linearizations():
+        approximations = [mpc.flowMapLinearApproximation(t[i], x[i], u[i]) for i in range(numQueries)]
+        return (np.array([a.f for a in approximations]),
+                np.array([a.dfdx.reshape(-1) for a in approximations]),
+                np.array([a.dfdu.reshape(-1) for a in approximations]))
+
+    checkedSpeedup(
+        "flowMapLinearApproximation",
+        linearizations,
+        lambda: mpc.flowMapLinearApproximationBatch(t, x, u),
+        lambda a, b: [np.testing.assert_allclose(ai, bi, rtol=1e-9, atol=1e-12) for ai, bi in zip(a, b)],
+    )
+
+    checkedSpeedup(
+        "cost",
+        lambda: np.array([mpc.cost(t[i], x[i], u[i]) for i in range(numQueries)]),
+        lambda: mpc.costBatch(t, x, u),
+        lambda a, b: np.testing.assert_allclose(a, b, rtol=1e-9, atol=1e-12),
+    )
+
+
+if __name__ == "__main__":
+    main(int(sys.argv[1]) if len(sys.argv) > 1 else 10000)
@@ -33,7 +33,7 @@ import os
 
 import rospkg
 
-from ocs2_ballbot import mpc_interface
+from ocs2_ballbot import mpc_interface, batched_mpc_interface
 from ocs2_ballbot import (
     scalar_array,
     vector_array,
@@ -104,6 +104,42 @@ class ballbot_python_tests(unittest.TestCase):
         print("dLdx", L.dfdx)
         print("dLdu", L.dfdu)
 
+    def test_run_batched_mpc(self):
+        packageDir = rospkg.RosPack().get_path('ocs2_ballbot')
+        taskFile = os.path.join(packageDir, 'config/mpc/task.info')
+        libFolder = os.path.join(packageDir, 'auto_generated')
+        numInstances = 4
+        batchedMpc = batched_mpc_interface(taskFile, libFolder, numInstances, 2)
+        self.assertEqual(batchedMpc.getNumInstances(), numInstances)
+
+        targetTrajectories = []
+        for i in range(numInstances):
+            desiredTimeTraj = scalar_array()
+            desiredTimeTraj.push_back(2.0)
+            desiredStateTraj = vector_array()
+            desiredStateTraj.push_back(0.1 * i * np.ones(self.stateDim))
+            desiredInputTraj = vector_array()
+            desiredInputTraj.push_back(np.zeros(self.inputDim))
+            targetTrajectories.append(TargetTrajectories(desiredTimeTraj, desiredStateTraj, desiredInputTraj))
+        batchedMpc.reset(targetTrajectories)
+
+        t = np.zeros(numInstances)
+        x = np.zeros((numInstances, self.stateDim))
+        x[:, 0] = np.linspace(0.0, 0.3, numInstances)
+        u = np.zeros((numInstances, self.inputDim))
+        batchedMpc.setObservations(t, x, u)
+        batchedMpc.advanceMpc()
+
+        optimalStates, optimalInputs = batchedMpc.evaluatePolicies(t, x)
+        self.assertEqual(optimalStates.shape, (numInstances, self.stateDim))
+        self.assertEqual(optimalInputs.shape, (numInstances, self.inputDim))
+
+        batchedMpc.updateMpcSolutions()
+        for i in range(numInstances):
+            stateTrajectory = batchedMpc.getMpcSolutionStateTrajectory(i)
+            self.assertEqual(stateTrajectory.shape[0], batchedMpc.getMpcSolutionTimeTrajectory(i).shape[0])
+            self.assertEqual(stateTrajectory.shape[1], self.stateDim)
+
 
 if __name__ == "__main__":
     unittest.main()
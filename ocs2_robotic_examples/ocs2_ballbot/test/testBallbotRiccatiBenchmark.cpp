@@ -0,0 +1,85 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/AllocationCounterHooks.h>  // reports the heap allocations per iteration in getBenchmarkingInfo()
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_ddp/SLQ.h>
+
+#include <ocs2_ballbot/BallbotInterface.h>
+#include <ocs2_ballbot/package_path.h>
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST(Ballbot, RiccatiBenchmark) {
+  constexpr size_t numRuns = 20;
+
+  const std::string taskFile = ocs2::ballbot::getPath() + "/config/mpc/task.info";
+  const std::string libFolder = ocs2::ballbot::getPath() + "/auto_generated";
+  ocs2::ballbot::BallbotInterface ballbotInterface(taskFile, libFolder);
+
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = startTime + ballbotInterface.mpcSettings().timeHorizon_;
+  const ocs2::vector_t initState = ballbotInterface.getInitialState();
+  ocs2::vector_t targetState = initState;
+  targetState(0) += 1.0;
+  ballbotInterface.getReferenceManagerPtr()->setTargetTrajectories(
+      ocs2::TargetTrajectories({startTime}, {targetState}, {ocs2::vector_t::Zero(ocs2::ballbot::INPUT_DIM)}));
+
+  auto runSlq = [&](bool fixedGridRiccati, ocs2::benchmark::RepeatedTimer& timer) {
+    auto ddpSettings = ballbotInterface.ddpSettings();
+    ddpSettings.fixedGridRiccati_ = fixedGridRiccati;
+    ddpSettings.displayInfo_ = false;
+    ddpSettings.displayShortSummary_ = false;
+    ocs2::SLQ slq(ddpSettings, ballbotInterface.getRollout(), ballbotInterface.getOptimalControlProblem(),
+                  ballbotInterface.getInitializer());
+    slq.setReferenceManager(ballbotInterface.getReferenceManagerPtr());
+
+    for (size_t i = 0; i < numRuns; i++) {
+      slq.reset();
+      timer.startTimer();
+      slq.run(startTime, initState, finalTime);
+      timer.endTimer();
+    }
+    std::cerr << "\n#### SLQ with " << (fixedGridRiccati ? "fixed-grid Riccati" : "adaptive Riccati integrator")
+              << slq.getBenchmarkingInfo();
+    return slq.getPerformanceIndeces();
+  };
+
+  ocs2::benchmark::RepeatedTimer adaptiveTimer, fixedGridTimer;
+  const auto adaptivePerformance = runSlq(false, adaptiveTimer);
+  const auto fixedGridPerformance = runSlq(true, fixedGridTimer);
+
+  std::cerr << "\n#### Average SLQ run time [ms]: adaptive " << adaptiveTimer.getAverageInMilliseconds() << ", fixed-grid "
+            << fixedGridTimer.getAverageInMilliseconds() << "\n";
+
+  EXPECT_NEAR(fixedGridPerformance.merit, adaptivePerformance.merit, 1e-2 * std::abs(adaptivePerformance.merit));
+}
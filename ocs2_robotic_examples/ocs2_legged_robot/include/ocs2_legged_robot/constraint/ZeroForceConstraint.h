@@ -55,6 +55,9 @@ class ZeroForceConstraint final : public StateInputConstraint {
   vector_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp) const override;
   VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                            const PreComputation& preComp) const override;
+  VectorFunctionLinearApproximation getSparseLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                 const PreComputation& preComp,
+                                                                 ApproximationSparsity& sparsity) const override;
 
  private:
   ZeroForceConstraint(const ZeroForceConstraint& other) = default;
@@ -71,5 +71,21 @@ VectorFunctionLinearApproximation ZeroForceConstraint::getLinearApproximation(sc
   return approx;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation ZeroForceConstraint::getSparseLinearApproximation(scalar_t time, const vector_t& state,
+                                                                                    const vector_t& input, const PreComputation& preComp,
+                                                                                    ApproximationSparsity& sparsity) const {
+  const size_t forceStartIndex = 3 * contactPointIndex_;
+  sparsity.setSparse({}, {forceStartIndex, forceStartIndex + 1, forceStartIndex + 2});
+
+  VectorFunctionLinearApproximation approx;
+  approx.f = getValue(time, state, input, preComp);
+  approx.dfdx.resize(3, 0);
+  approx.dfdu = matrix_t::Identity(3, 3);
+  return approx;
+}
+
 }  // namespace legged_robot
 }  // namespace ocs2
@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // OCS2
 #include <ocs2_core/Types.h>
 #include <ocs2_core/initialization/Initializer.h>
+#include <ocs2_core/soft_constraint/InequalityActivityTracker.h>
 #include <ocs2_ddp/DDP_Settings.h>
 #include <ocs2_mpc/MPC_Settings.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
@@ -79,6 +80,12 @@ class MobileManipulatorInterface final : public RobotInterface {
 
   const ManipulatorModelInfo& getManipulatorModelInfo() const { return manipulatorModelInfo_; }
 
+  /**
+   * Gets the activity tracker of the self-collision constraint, nullptr if it is disabled in the task file. Its advanceIteration
+   * should be registered as an iteration callback of the solver.
+   */
+  std::shared_ptr<InequalityActivityTracker> getSelfCollisionActivityTracker() const { return selfCollisionActivityTrackerPtr_; }
+
  private:
   std::unique_ptr<StateInputCost> getQuadraticInputCost(const std::string& taskFile);
   std::unique_ptr<StateCost> getEndEffectorConstraint(const PinocchioInterface& pinocchioInterface, const std::string& taskFile,
@@ -99,6 +106,7 @@ class MobileManipulatorInterface final : public RobotInterface {
   std::unique_ptr<Initializer> initializerPtr_;
 
   std::unique_ptr<PinocchioInterface> pinocchioInterfacePtr_;
+  std::shared_ptr<InequalityActivityTracker> selfCollisionActivityTrackerPtr_;
   ManipulatorModelInfo manipulatorModelInfo_;
 
   vector_t initialState_;
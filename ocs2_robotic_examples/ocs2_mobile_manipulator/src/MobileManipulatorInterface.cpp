@@ -304,6 +304,8 @@ std::unique_ptr<StateCost> MobileManipulatorInterface::getSelfCollisionConstrain
   scalar_t mu = 1e-2;
   scalar_t delta = 1e-3;
   scalar_t minimumDistance = 0.0;
+  InequalityActivityTracker::Settings activitySettings;
+  activitySettings.numInactiveIterations = 0;  // disabled by default
 
   boost::property_tree::ptree pt;
   boost::property_tree::read_info(taskFile, pt);
@@ -312,6 +314,8 @@ std::unique_ptr<StateCost> MobileManipulatorInterface::getSelfCollisionConstrain
   loadData::loadPtreeValue(pt, mu, prefix + ".mu", true);
   loadData::loadPtreeValue(pt, delta, prefix + ".delta", true);
   loadData::loadPtreeValue(pt, minimumDistance, prefix + ".minimumDistance", true);
+  loadData::loadPtreeValue(pt, activitySettings.derivativeTolerance, prefix + ".activityDerivativeTolerance", true);
+  loadData::loadPtreeValue(pt, activitySettings.numInactiveIterations, prefix + ".activityIterations", true);
   loadData::loadStdVectorOfPair(taskFile, prefix + ".collisionObjectPairs", collisionObjectPairs, true);
   loadData::loadStdVectorOfPair(taskFile, prefix + ".collisionLinkPairs", collisionLinkPairs, true);
   std::cerr << " #### =============================================================================\n";
@@ -333,7 +337,13 @@ std::unique_ptr<StateCost> MobileManipulatorInterface::getSelfCollisionConstrain
 
   std::unique_ptr<PenaltyBase> penalty(new RelaxedBarrierPenalty({mu, delta}));
 
-  return std::unique_ptr<StateCost>(new StateSoftConstraint(std::move(constraint), std::move(penalty)));
+  std::unique_ptr<StateSoftConstraint> softConstraint(new StateSoftConstraint(std::move(constraint), std::move(penalty)));
+  if (activitySettings.numInactiveIterations > 0) {
+    selfCollisionActivityTrackerPtr_ = std::make_shared<InequalityActivityTracker>(activitySettings);
+    softConstraint->setActivityTracker(selfCollisionActivityTrackerPtr_);
+  }
+
+  return std::unique_ptr<StateCost>(std::move(softConstraint));
 }
 
 /******************************************************************************************************/
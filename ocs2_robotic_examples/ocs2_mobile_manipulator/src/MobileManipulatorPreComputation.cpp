@@ -59,18 +59,24 @@ void MobileManipulatorPreComputation::request(RequestSet request, scalar_t t, co
     return;
   }
 
+  // the kinematics only depend on the request arguments, so repeated requests at the same point are skipped
+  const auto cached = updateRequestCache(CallbackType::Intermediate, request, t, x, u);
+  if (cached.missing.empty()) {
+    return;
+  }
+
   const auto& model = pinocchioInterface_.getModel();
   auto& data = pinocchioInterface_.getData();
-  const auto q = pinocchioMapping_.getPinocchioJointPosition(x);
 
-  if (request.contains(Request::Approximation)) {
+  if (!cached.computed.containsAny(Request::Cost + Request::Constraint + Request::SoftConstraint)) {
+    const auto q = pinocchioMapping_.getPinocchioJointPosition(x);
     pinocchio::forwardKinematics(model, data, q);
     pinocchio::updateFramePlacements(model, data);
+  }
+
+  if (request.contains(Request::Approximation) && !cached.computed.contains(Request::Approximation)) {
     pinocchio::computeJointJacobians(model, data);
     pinocchio::updateGlobalPlacements(model, data);
-  } else {
-    pinocchio::forwardKinematics(model, data, q);
-    pinocchio::updateFramePlacements(model, data);
   }
 }
 
@@ -82,17 +88,22 @@ void MobileManipulatorPreComputation::requestFinal(RequestSet request, scalar_t
     return;
   }
 
+  const auto cached = updateRequestCache(CallbackType::Final, request, t, x);
+  if (cached.missing.empty()) {
+    return;
+  }
+
   const auto& model = pinocchioInterface_.getModel();
   auto& data = pinocchioInterface_.getData();
-  const auto q = pinocchioMapping_.getPinocchioJointPosition(x);
 
-  if (request.contains(Request::Approximation)) {
+  if (!cached.computed.containsAny(Request::Cost + Request::Constraint + Request::SoftConstraint)) {
+    const auto q = pinocchioMapping_.getPinocchioJointPosition(x);
     pinocchio::forwardKinematics(model, data, q);
     pinocchio::updateFramePlacements(model, data);
+  }
+
+  if (request.contains(Request::Approximation) && !cached.computed.contains(Request::Approximation)) {
     pinocchio::computeJointJacobians(model, data);
-  } else {
-    pinocchio::forwardKinematics(model, data, q);
-    pinocchio::updateFramePlacements(model, data);
   }
 }
 
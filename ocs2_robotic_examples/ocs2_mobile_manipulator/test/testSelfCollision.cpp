@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <pinocchio/fwd.hpp>
 
+#include <algorithm>
+#include <limits>
+
 #include <pinocchio/algorithm/frames.hpp>
 #include <pinocchio/algorithm/kinematics.hpp>
 #include <pinocchio/multibody/geometry.hpp>
@@ -156,3 +159,39 @@ TEST_F(TestSelfCollision, testRandomJointPositions) {
     ASSERT_TRUE(Jd1.isApprox(Jd2));
   }
 }
+
+TEST_F(TestSelfCollision, broadPhaseAndWarmStart) {
+  PinocchioGeometryInterface::WarmStartSettings warmStartSettings;
+  warmStartSettings.enable = true;
+  SelfCollision selfCollision(geometryInterface, minDistance);
+  SelfCollision selfCollisionWarmStart(geometryInterface, minDistance, std::numeric_limits<scalar_t>::infinity(), warmStartSettings);
+
+  for (int i = 0; i < 10; i++) {
+    const vector_t q = vector_t::Random(9);
+    computeLinearApproximation(pinocchioInterface, q);
+
+    const vector_t d = selfCollision.getValue(pinocchioInterface);
+    ASSERT_TRUE(d.isApprox(selfCollisionWarmStart.getValue(pinocchioInterface, 0.1 * (i % 3)), 1e-6));
+
+    // clamp at the median distance such that both active and culled pairs exist
+    vector_t sorted = d;
+    std::sort(sorted.data(), sorted.data() + sorted.size());
+    const scalar_t activationDistance = sorted[sorted.size() / 2] + minDistance;
+    SelfCollision selfCollisionCulled(geometryInterface, minDistance, activationDistance, warmStartSettings);
+
+    vector_t d1, d2;
+    matrix_t Jd1, Jd2;
+    std::tie(d1, Jd1) = selfCollision.getLinearApproximation(pinocchioInterface);
+    std::tie(d2, Jd2) = selfCollisionCulled.getLinearApproximation(pinocchioInterface);
+    ASSERT_EQ(d1.size(), d2.size());
+    for (int j = 0; j < d1.size(); ++j) {
+      if (d1[j] + minDistance < activationDistance) {
+        EXPECT_NEAR(d1[j], d2[j], 1e-6);
+        EXPECT_TRUE(Jd1.row(j).isApprox(Jd2.row(j), 1e-6));
+      } else {
+        EXPECT_DOUBLE_EQ(d2[j], activationDistance - minDistance);
+        EXPECT_TRUE(Jd2.row(j).isZero());
+      }
+    }
+  }
+}
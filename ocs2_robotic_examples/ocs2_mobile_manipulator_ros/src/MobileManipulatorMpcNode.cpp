@@ -65,6 +65,10 @@ int main(int argc, char** argv) {
   ocs2::GaussNewtonDDP_MPC mpc(interface.mpcSettings(), interface.ddpSettings(), interface.getRollout(),
                                interface.getOptimalControlProblem(), interface.getInitializer());
   mpc.getSolverPtr()->setReferenceManager(rosReferenceManagerPtr);
+  if (auto activityTrackerPtr = interface.getSelfCollisionActivityTracker()) {
+    mpc.getSolverPtr()->addIterationCallback(
+        [activityTrackerPtr](const scalar_array_t& timeTrajectory) { activityTrackerPtr->advanceIteration(timeTrajectory); });
+  }
 
   // Launch MPC ROS node
   MPC_ROS_Interface mpcNode(mpc, robotName);
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/initialization/Initializer.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 
 namespace ocs2 {
@@ -62,6 +63,19 @@ inline std::pair<vector_t, vector_t> initializeIntermediateNode(Initializer& ini
  */
 std::pair<vector_t, vector_t> initializeIntermediateNode(PrimalSolution& primalSolution, scalar_t t, scalar_t tNext, const vector_t& x);
 
+/**
+ * Interpolate a primal solution for state-input initialization at a intermediate node, using precomputed interpolation
+ * coefficients (e.g. from LinearInterpolation::timeSegments over the whole time discretization).
+ *
+ * @param primalSolution : previous solution
+ * @param indexAlpha : Interpolation coefficients of the start of the discrete interval
+ * @param indexAlphaNext : Interpolation coefficients of the end of the discrete interval
+ * @param x : Starting state of the discrete interval
+ * @return {u(t), x(tNext)} : input and state transition
+ */
+std::pair<vector_t, vector_t> initializeIntermediateNode(PrimalSolution& primalSolution, LinearInterpolation::index_alpha_t indexAlpha,
+                                                         LinearInterpolation::index_alpha_t indexAlphaNext, const vector_t& x);
+
 /**
  * Initialize the state jump at an event node.
  *
@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/initialization/Initializer.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 #include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
@@ -171,6 +172,9 @@ class MultipleShootingSolver : public SolverBase {
   std::vector<OptimalControlProblem> ocpDefinitions_;
   std::unique_ptr<Initializer> initializerPtr_;
 
+  // Copy of the active reference, resampled on the time discretization of the current run
+  TargetTrajectories targetTrajectories_;
+
   // Threading
   ThreadPool threadPool_;
 
@@ -189,6 +193,10 @@ class MultipleShootingSolver : public SolverBase {
   std::vector<VectorFunctionLinearApproximation> constraints_;
   std::vector<VectorFunctionLinearApproximation> constraintsProjection_;
 
+  // Line-search trial trajectories, kept across iterations to reuse their memory
+  vector_array_t xNew_;
+  vector_array_t uNew_;
+
   // Iteration performance log
   std::vector<PerformanceIndex> performanceIndeces_;
 
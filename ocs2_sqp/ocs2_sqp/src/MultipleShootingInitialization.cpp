@@ -39,5 +39,11 @@ std::pair<vector_t, vector_t> initializeIntermediateNode(PrimalSolution& primalS
           LinearInterpolation::interpolate(tNext, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_)};
 }
 
+std::pair<vector_t, vector_t> initializeIntermediateNode(PrimalSolution& primalSolution, LinearInterpolation::index_alpha_t indexAlpha,
+                                                         LinearInterpolation::index_alpha_t indexAlphaNext, const vector_t& x) {
+  return {LinearInterpolation::interpolate(indexAlpha, primalSolution.inputTrajectory_),
+          LinearInterpolation::interpolate(indexAlphaNext, primalSolution.stateTrajectory_)};
+}
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
\ No newline at end of file
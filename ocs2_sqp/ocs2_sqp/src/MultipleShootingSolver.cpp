@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/MultipleShootingSolver.h"
 
+#include <algorithm>
 #include <iostream>
 #include <numeric>
 
@@ -76,6 +77,7 @@ MultipleShootingSolver::~MultipleShootingSolver() {
 void MultipleShootingSolver::reset() {
   // Clear solution
   primalSolution_ = PrimalSolution();
+  targetTrajectories_.clear();
   valueFunction_.clear();
   performanceIndeces_.clear();
 
@@ -158,10 +160,14 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
   vector_array_t x, u;
   initializeStateInputTrajectories(initState, timeDiscretization, x, u);
 
-  // Initialize references
+  // Initialize references: sample them once on the node times, which are shared by all iterations and line search trials
+  targetTrajectories_ = this->getReferenceManager().getTargetTrajectories();
+  scalar_array_t nodeTimes(timeDiscretization.size());
+  std::transform(timeDiscretization.begin(), timeDiscretization.end(), nodeTimes.begin(),
+                 [](const AnnotatedTime& annotatedTime) { return getIntervalStart(annotatedTime); });
+  targetTrajectories_.resample(nodeTimes);
   for (auto& ocpDefinition : ocpDefinitions_) {
-    const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
-    ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
+    ocpDefinition.targetTrajectoriesPtr = &targetTrajectories_;
   }
 
   // Bookkeeping
@@ -174,6 +180,7 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
       std::cerr << "\nSQP iteration: " << iter << "\n";
     }
     // Make QP approximation
+    iterationCallbacks(nodeTimes);
     linearQuadraticApproximationTimer_.startTimer();
     const auto baselinePerformance = setupQuadraticSubproblem(timeDiscretization, initState, x, u);
     linearQuadraticApproximationTimer_.endTimer();
@@ -234,6 +241,18 @@ void MultipleShootingSolver::initializeStateInputTrajectories(const vector_t& in
     interpolateInputTill = primalSolution_.timeTrajectory_[primalSolution_.timeTrajectory_.size() - 2];
   }
 
+  // Interpolation coefficients of the previous solution at all the (sorted) interval boundaries, found in a single sweep
+  std::vector<LinearInterpolation::index_alpha_t> startIndexAlpha, endIndexAlpha;
+  if (primalSolution_.timeTrajectory_.size() >= 2) {
+    scalar_array_t startTimes(N), endTimes(N);
+    for (int i = 0; i < N; i++) {
+      startTimes[i] = getIntervalStart(timeDiscretization[i]);
+      endTimes[i] = getIntervalEnd(timeDiscretization[i + 1]);
+    }
+    LinearInterpolation::timeSegments(startTimes, primalSolution_.timeTrajectory_, startIndexAlpha);
+    LinearInterpolation::timeSegments(endTimes, primalSolution_.timeTrajectory_, endIndexAlpha);
+  }
+
   // Initial state
   const scalar_t initTime = getIntervalStart(timeDiscretization[0]);
   if (initTime < interpolateStateTill) {
@@ -257,7 +276,8 @@ void MultipleShootingSolver::initializeStateInputTrajectories(const vector_t& in
         std::tie(input, nextState) =
             multiple_shooting::initializeIntermediateNode(*initializerPtr_, time, nextTime, stateTrajectory.back());
       } else {  // interpolate previous solution
-        std::tie(input, nextState) = multiple_shooting::initializeIntermediateNode(primalSolution_, time, nextTime, stateTrajectory.back());
+        std::tie(input, nextState) =
+            multiple_shooting::initializeIntermediateNode(primalSolution_, startIndexAlpha[i], endIndexAlpha[i], stateTrajectory.back());
       }
       inputTrajectory.push_back(std::move(input));
       stateTrajectory.push_back(std::move(nextState));
@@ -536,21 +556,23 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
   multiple_shooting::StepInfo stepInfo;
 
   scalar_t alpha = 1.0;
-  vector_array_t xNew(x.size());
-  vector_array_t uNew(u.size());
+  xNew_.resize(x.size());
+  uNew_.resize(u.size());
   do {
     // Compute step
     for (int i = 0; i < u.size(); i++) {
       if (du[i].size() > 0) {  // account for absence of inputs at events.
-        uNew[i] = u[i] + alpha * du[i];
+        uNew_[i] = u[i] + alpha * du[i];
+      } else {
+        uNew_[i].resize(0);
       }
     }
     for (int i = 0; i < x.size(); i++) {
-      xNew[i] = x[i] + alpha * dx[i];
+      xNew_[i] = x[i] + alpha * dx[i];
     }
 
     // Compute cost and constraints
-    const PerformanceIndex performanceNew = computePerformance(timeDiscretization, initState, xNew, uNew);
+    const PerformanceIndex performanceNew = computePerformance(timeDiscretization, initState, xNew_, uNew_);
     const scalar_t newConstraintViolation = totalConstraintViolation(performanceNew);
 
     // Step acceptance and record step type
@@ -580,8 +602,9 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
     }
 
     if (stepAccepted) {  // Return if step accepted
-      x = std::move(xNew);
-      u = std::move(uNew);
+      // swap such that the buffers of the previous iterate are reused by the next line-search
+      x.swap(xNew_);
+      u.swap(uNew_);
 
       stepInfo.stepSize = alpha;
       stepInfo.dx_norm = alpha * deltaXnorm;